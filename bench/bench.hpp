@@ -0,0 +1,179 @@
+#ifndef CGLA_BENCH_HPP
+#define CGLA_BENCH_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cgla/cgla.hpp>
+
+namespace bench {
+
+// number of distinct inputs cycled through by the micro-benchmarks (a power of two)
+constexpr std::size_t inputCount = 256;
+
+// runs the given number of iterations
+using Run = std::function<void(std::size_t)>;
+
+struct Benchmark
+{
+    std::string name;
+    std::size_t items; // items processed by one iteration
+    std::function<Run()> setup; // allocates the inputs, called only when the benchmark runs, which releases them afterwards
+};
+
+class Registry
+{
+    public:
+        void add(std::string name, std::size_t items, std::function<Run()> setup)
+        {
+            entries.push_back({std::move(name), items, std::move(setup)});
+        }
+
+        const std::vector<Benchmark>& benchmarks() const
+        {
+            return entries;
+        }
+
+    private:
+        std::vector<Benchmark> entries;
+};
+
+void registerVectorBenchmarks(Registry& registry);
+void registerMatrixBenchmarks(Registry& registry);
+void registerTransformBenchmarks(Registry& registry);
+void registerMacroBenchmarks(Registry& registry);
+void registerSkinningBenchmarks(Registry& registry);
+void registerRayBenchmarks(Registry& registry);
+void registerParallelBenchmarks(Registry& registry);
+
+// prevents the compiler from discarding a computed value
+template<typename T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+    *reinterpret_cast<const volatile char*>(sink);
+#endif
+}
+
+// reseeded before each setup, so that the inputs of a benchmark do not depend on the ones that ran before it
+constexpr std::mt19937::result_type seed = 42;
+
+inline std::mt19937& rng()
+{
+    static std::mt19937 engine{seed};
+    return engine;
+}
+
+// values in [0.5, 1.5] keep every operation (division, normalization, inversion) well-defined
+template<typename T>
+inline void randomize(T& v)
+{
+    v = std::uniform_real_distribution<T>{static_cast<T>(0.5), static_cast<T>(1.5)}(rng());
+}
+
+template<typename T, std::size_t N>
+inline void randomize(cgla::Vector<T, N>& v)
+{
+    for (std::size_t i = 0; i < N; ++i)
+        randomize(v[i]);
+}
+
+template<typename T, std::size_t M, std::size_t N>
+inline void randomize(cgla::Matrix<T, M, N>& m)
+{
+    for (std::size_t i = 0; i < M * N; ++i)
+        randomize(m[i]);
+
+    // diagonally dominant, hence invertible
+    for (std::size_t i = 0; i < M && i < N; ++i)
+        m(i, i) += static_cast<T>(N);
+}
+
+template<typename A>
+inline std::shared_ptr<std::vector<A>> randomInputs(std::size_t count = inputCount)
+{
+    auto inputs = std::make_shared<std::vector<A>>(count);
+
+    for (A& a : *inputs)
+        randomize(a);
+
+    return inputs;
+}
+
+template<typename A, typename F>
+inline void addUnary(Registry& registry, const std::string& name, F f)
+{
+    registry.add(name, 1, [f]
+    {
+        auto a = randomInputs<A>();
+
+        return Run{[a, f](std::size_t iterations)
+        {
+            const A* pa = a->data();
+
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                auto res = f(pa[i & (inputCount - 1)]);
+                doNotOptimize(res);
+            }
+        }};
+    });
+}
+
+template<typename A, typename B, typename F>
+inline void addBinary(Registry& registry, const std::string& name, F f)
+{
+    registry.add(name, 1, [f]
+    {
+        auto a = randomInputs<A>();
+        auto b = randomInputs<B>();
+
+        return Run{[a, b, f](std::size_t iterations)
+        {
+            const A* pa = a->data();
+            const B* pb = b->data();
+
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                auto res = f(pa[i & (inputCount - 1)], pb[(i + 1) & (inputCount - 1)]);
+                doNotOptimize(res);
+            }
+        }};
+    });
+}
+
+template<typename A, typename B, typename F>
+inline void addAssign(Registry& registry, const std::string& name, F f)
+{
+    registry.add(name, 1, [f]
+    {
+        auto a = randomInputs<A>();
+        auto b = randomInputs<B>();
+
+        return Run{[a, b, f](std::size_t iterations)
+        {
+            const A* pa = a->data();
+            const B* pb = b->data();
+
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                A res = pa[i & (inputCount - 1)];
+                f(res, pb[(i + 1) & (inputCount - 1)]);
+                doNotOptimize(res);
+            }
+        }};
+    });
+}
+
+}
+
+#endif
@@ -0,0 +1,764 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cgla/cgla.hpp>
+#include "bench.hpp"
+
+namespace bench {
+
+namespace {
+
+constexpr std::size_t vertexCount = 1000000;
+constexpr std::size_t matrixCount = 100000;
+constexpr std::size_t nodeCount = 100000;
+constexpr std::size_t instanceCount = 500000;
+
+void registerVertexBuffer(Registry& registry)
+{
+    using Mat = cgla::Matrix<float, 4, 4>;
+    using V3 = cgla::Vector<float, 3>;
+    using V4 = cgla::Vector<float, 4>;
+
+    registry.add("Macro/transformPoints/1M", vertexCount, []
+    {
+        auto mat = randomInputs<Mat>(1);
+        auto in = randomInputs<V3>(vertexCount);
+        auto out = std::make_shared<std::vector<V3>>(vertexCount);
+
+        return Run{[mat, in, out](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                cgla::transformPoints((*mat)[0], in->data(), out->data(), vertexCount);
+                doNotOptimize(*out->data());
+            }
+        }};
+    });
+
+    registry.add("Macro/transformPointsLoop/1M", vertexCount, []
+    {
+        auto mat = randomInputs<Mat>(1);
+        auto in = randomInputs<V3>(vertexCount);
+        auto out = std::make_shared<std::vector<V3>>(vertexCount);
+
+        return Run{[mat, in, out](std::size_t iterations)
+        {
+            const Mat& m = (*mat)[0];
+
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                for (std::size_t j = 0; j < vertexCount; ++j)
+                {
+                    const V3& p = (*in)[j];
+                    (*out)[j] = cgla::xyz(V4(m * V4{p[0], p[1], p[2], 1.f}));
+                }
+
+                doNotOptimize(*out->data());
+            }
+        }};
+    });
+
+    // screen positions and visibility of a vertex cloud around the origin, as for labels and picking
+    Mat viewProjection = cgla::perspective(0.8f, 16.f / 9.f, 0.1f, 100.f) * cgla::lookAt(V3{0.f, 0.f, -3.f}, V3{}, V3{0.f, 1.f, 0.f});
+    V4 rect{0.f, 0.f, 1920.f, 1080.f};
+
+    registry.add("Macro/projectPoints/1M", vertexCount, [viewProjection, rect]
+    {
+        auto in = randomInputs<V3>(vertexCount);
+        auto out = std::make_shared<std::vector<V3>>(vertexCount);
+        auto mask = std::make_shared<std::vector<std::uint32_t>>((vertexCount + 31) / 32);
+
+        return Run{[viewProjection, rect, in, out, mask](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                cgla::projectPoints(viewProjection, rect, in->data(), out->data(), mask->data(), vertexCount);
+                doNotOptimize(*mask->data());
+            }
+        }};
+    });
+
+    registry.add("Macro/projectPointsLoop/1M", vertexCount, [viewProjection, rect]
+    {
+        auto in = randomInputs<V3>(vertexCount);
+        auto out = std::make_shared<std::vector<V3>>(vertexCount);
+        auto mask = std::make_shared<std::vector<std::uint32_t>>((vertexCount + 31) / 32);
+
+        return Run{[viewProjection, rect, in, out, mask](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                std::fill(mask->begin(), mask->end(), 0u);
+
+                for (std::size_t j = 0; j < vertexCount; ++j)
+                {
+                    const V3& p = (*in)[j];
+                    V4 clip = viewProjection * V4{p[0], p[1], p[2], 1.f};
+                    bool inside = clip[3] > 0.f && std::abs(clip[0]) <= clip[3] && std::abs(clip[1]) <= clip[3] && std::abs(clip[2]) <= clip[3];
+                    clip /= clip[3];
+                    (*out)[j] = V3{rect[0] + (clip[0] + 1.f) * 0.5f * rect[2], rect[1] + (clip[1] + 1.f) * 0.5f * rect[3], (clip[2] + 1.f) * 0.5f};
+
+                    if (inside)
+                        (*mask)[j / 32] |= 1u << (j % 32);
+                }
+
+                doNotOptimize(*mask->data());
+            }
+        }};
+    });
+}
+
+template<typename T, typename F>
+void addMatrixBuffer(Registry& registry, const std::string& name, F f)
+{
+    using Mat = cgla::Matrix<T, 4, 4>;
+
+    registry.add(name, matrixCount, [f]
+    {
+        auto in = randomInputs<Mat>(matrixCount);
+        auto out = std::make_shared<std::vector<Mat>>(matrixCount);
+
+        return Run{[in, out, f](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                for (std::size_t j = 0; j < matrixCount; ++j)
+                    (*out)[j] = f((*in)[j]);
+
+                doNotOptimize(*out->data());
+            }
+        }};
+    });
+}
+
+template<typename T>
+void registerInverses(Registry& registry, const std::string& type)
+{
+    using Mat = cgla::Matrix<T, 4, 4>;
+
+    addMatrixBuffer<T>(registry, "Macro/inverse/" + type + "/100k", [](const Mat& m) { return cgla::inverse(m); });
+    addMatrixBuffer<T>(registry, "Macro/inverseGaussJordan/" + type + "/100k", [](const Mat& m)
+    {
+        // the generic elimination, bypassing the closed-form 4x4 overload
+        Mat res{cgla::uninitialized};
+        cgla::detail::invert<T, 4>(m, res);
+        return res;
+    });
+    addMatrixBuffer<T>(registry, "Macro/affineInverse/" + type + "/100k", [](const Mat& m) { return cgla::affineInverse(m); });
+    addMatrixBuffer<T>(registry, "Macro/rigidInverse/" + type + "/100k", [](const Mat& m) { return cgla::rigidInverse(m); });
+}
+
+// 100k small systems, made symmetric positive definite so that every solver applies
+template<typename T, std::size_t M>
+struct Systems
+{
+    using Mat = cgla::Matrix<T, M, M>;
+    using V = cgla::Vector<T, M>;
+
+    std::shared_ptr<std::vector<Mat>> mats = randomInputs<Mat>(matrixCount);
+    std::shared_ptr<std::vector<V>> rhs = randomInputs<V>(matrixCount);
+    std::vector<V> out = std::vector<V>(matrixCount);
+
+    Systems()
+    {
+        for (Mat& m : *mats)
+            m = cgla::transpose(m) * m + Mat{static_cast<T>(1)};
+    }
+};
+
+template<typename T, std::size_t M>
+void registerSolves(Registry& registry, const std::string& type)
+{
+    registry.add("Macro/inverse*Vector/" + type + "/100k", matrixCount, []
+    {
+        auto s = std::make_shared<Systems<T, M>>();
+
+        return Run{[s](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                for (std::size_t j = 0; j < matrixCount; ++j)
+                    s->out[j] = cgla::inverse((*s->mats)[j]) * (*s->rhs)[j];
+
+                doNotOptimize(*s->out.data());
+            }
+        }};
+    });
+    registry.add("Macro/solveLU/" + type + "/100k", matrixCount, []
+    {
+        auto s = std::make_shared<Systems<T, M>>();
+
+        return Run{[s](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                bool solved = cgla::solveLU(s->mats->data(), s->rhs->data(), s->out.data(), matrixCount);
+                doNotOptimize(solved);
+            }
+        }};
+    });
+    registry.add("Macro/solveCholesky/" + type + "/100k", matrixCount, []
+    {
+        auto s = std::make_shared<Systems<T, M>>();
+
+        return Run{[s](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                bool solved = cgla::solveCholesky(s->mats->data(), s->rhs->data(), s->out.data(), matrixCount);
+                doNotOptimize(solved);
+            }
+        }};
+    });
+}
+
+// 100k 3x3 matrices one at a time and side by side
+template<typename T>
+struct Decompositions
+{
+    using Mat = cgla::Matrix<T, 3, 3>;
+    using V = cgla::Vector<T, 3>;
+
+    std::shared_ptr<std::vector<Mat>> mats = randomInputs<Mat>(matrixCount);
+    std::vector<Mat> u = std::vector<Mat>(matrixCount);
+    std::vector<Mat> v = std::vector<Mat>(matrixCount);
+    std::vector<V> sigma = std::vector<V>(matrixCount);
+};
+
+template<typename T>
+void registerDecompositions(Registry& registry, const std::string& type)
+{
+    registry.add("Macro/svd/" + type + "/100k", matrixCount, []
+    {
+        auto d = std::make_shared<Decompositions<T>>();
+
+        return Run{[d](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                for (std::size_t j = 0; j < matrixCount; ++j)
+                    cgla::svd((*d->mats)[j], d->u[j], d->sigma[j], d->v[j]);
+
+                doNotOptimize(*d->sigma.data());
+            }
+        }};
+    });
+    registry.add("Macro/svd(batch)/" + type + "/100k", matrixCount, []
+    {
+        auto d = std::make_shared<Decompositions<T>>();
+
+        return Run{[d](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                cgla::svd(d->mats->data(), d->u.data(), d->sigma.data(), d->v.data(), matrixCount);
+                doNotOptimize(*d->sigma.data());
+            }
+        }};
+    });
+    registry.add("Macro/polarDecomposition(batch)/" + type + "/100k", matrixCount, []
+    {
+        auto d = std::make_shared<Decompositions<T>>();
+
+        return Run{[d](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                cgla::polarDecomposition(d->mats->data(), d->u.data(), d->v.data(), matrixCount);
+                doNotOptimize(*d->u.data());
+            }
+        }};
+    });
+}
+
+// eyes, targets (also used as scales) and perspective parameters, and the rotations and TRS matrices made from them
+template<typename T>
+struct Builders
+{
+    using Mat = cgla::Matrix<T, 4, 4>;
+    using V3 = cgla::Vector<T, 3>;
+    using V4 = cgla::Vector<T, 4>;
+
+    std::shared_ptr<std::vector<V3>> eyes = randomInputs<V3>(matrixCount);
+    std::shared_ptr<std::vector<V3>> targets = randomInputs<V3>(matrixCount);
+    std::shared_ptr<std::vector<V4>> params = randomInputs<V4>(matrixCount);
+    std::vector<cgla::Quaternion<T>> rotations = std::vector<cgla::Quaternion<T>>(matrixCount);
+    std::vector<Mat> trs = std::vector<Mat>(matrixCount);
+    std::vector<Mat> out = std::vector<Mat>(matrixCount);
+
+    Builders()
+    {
+        for (std::size_t j = 0; j < matrixCount; ++j)
+            rotations[j] = cgla::normalize(cgla::Quaternion<T>{(*params)[j]});
+        cgla::composeTRS(eyes->data(), rotations.data(), targets->data(), trs.data(), matrixCount);
+    }
+};
+
+template<typename T>
+void registerBuilders(Registry& registry, const std::string& type)
+{
+    using V3 = cgla::Vector<T, 3>;
+    using V4 = cgla::Vector<T, 4>;
+
+    registry.add("Macro/lookAt/" + type + "/100k", matrixCount, []
+    {
+        auto b = std::make_shared<Builders<T>>();
+
+        return Run{[b](std::size_t iterations)
+        {
+            V3 up{static_cast<T>(0), static_cast<T>(1), static_cast<T>(0)};
+
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                for (std::size_t j = 0; j < matrixCount; ++j)
+                    b->out[j] = cgla::lookAt((*b->eyes)[j], V3(-(*b->targets)[j]), up);
+
+                doNotOptimize(*b->out.data());
+            }
+        }};
+    });
+
+    registry.add("Macro/perspective/" + type + "/100k", matrixCount, []
+    {
+        auto b = std::make_shared<Builders<T>>();
+
+        return Run{[b](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                for (std::size_t j = 0; j < matrixCount; ++j)
+                {
+                    const V4& p = (*b->params)[j];
+                    b->out[j] = cgla::perspective(p[0], p[1], p[2] * static_cast<T>(0.1), p[3] * static_cast<T>(100));
+                }
+
+                doNotOptimize(*b->out.data());
+            }
+        }};
+    });
+
+    // round trips through translation, rotation and scale, as when blending transforms
+    registry.add("Macro/composeTRS/" + type + "/100k", matrixCount, []
+    {
+        auto b = std::make_shared<Builders<T>>();
+
+        return Run{[b](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                cgla::composeTRS(b->eyes->data(), b->rotations.data(), b->targets->data(), b->out.data(), matrixCount);
+                doNotOptimize(*b->out.data());
+            }
+        }};
+    });
+    registry.add("Macro/decomposeTRS/" + type + "/100k", matrixCount, []
+    {
+        auto b = std::make_shared<Builders<T>>();
+
+        return Run{[b](std::size_t iterations)
+        {
+            std::vector<V3> translations(matrixCount);
+            std::vector<cgla::Quaternion<T>> rotations(matrixCount);
+            std::vector<V3> scales(matrixCount);
+
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                bool regular = cgla::decomposeTRS(b->trs.data(), translations.data(), rotations.data(), scales.data(), matrixCount);
+                doNotOptimize(regular);
+            }
+        }};
+    });
+}
+
+// view-projection-model chains of 100k instances, dense and keeping the known zeros of the projection and of the affine transforms
+template<typename T>
+struct Chains
+{
+    using Mat = cgla::Matrix<T, 4, 4>;
+    using V3 = cgla::Vector<T, 3>;
+
+    Mat projection = cgla::perspective(static_cast<T>(0.8), static_cast<T>(1.5), static_cast<T>(0.1), static_cast<T>(100));
+    Mat view = cgla::lookAt(V3{static_cast<T>(1), static_cast<T>(2), static_cast<T>(3)}, V3{}, V3{static_cast<T>(0), static_cast<T>(1), static_cast<T>(0)});
+    Mat viewProjection = projection * view;
+    cgla::Perspective<T> structuredProjection{projection};
+    cgla::Affine<T, 3> structuredView{view};
+
+    std::shared_ptr<std::vector<Mat>> models = randomInputs<Mat>(matrixCount);
+    std::vector<cgla::Affine<T, 3>> affines;
+    std::vector<Mat> out = std::vector<Mat>(matrixCount);
+
+    Chains()
+    {
+        for (const Mat& m : *models)
+            affines.push_back(cgla::Affine<T, 3>{m});
+        for (std::size_t j = 0; j < matrixCount; ++j)
+            (*models)[j] = cgla::toMatrix(affines[j]);
+    }
+};
+
+template<typename T>
+void registerChains(Registry& registry, const std::string& type)
+{
+    registry.add("Macro/viewProjection*model/" + type + "/100k", matrixCount, []
+    {
+        auto c = std::make_shared<Chains<T>>();
+
+        return Run{[c](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                for (std::size_t j = 0; j < matrixCount; ++j)
+                    c->out[j] = c->viewProjection * (*c->models)[j];
+
+                doNotOptimize(*c->out.data());
+            }
+        }};
+    });
+    registry.add("Macro/viewProjection*Affine/" + type + "/100k", matrixCount, []
+    {
+        auto c = std::make_shared<Chains<T>>();
+
+        return Run{[c](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                for (std::size_t j = 0; j < matrixCount; ++j)
+                    c->out[j] = c->viewProjection * c->affines[j];
+
+                doNotOptimize(*c->out.data());
+            }
+        }};
+    });
+    registry.add("Macro/projection*view*model/" + type + "/100k", matrixCount, []
+    {
+        auto c = std::make_shared<Chains<T>>();
+
+        return Run{[c](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                for (std::size_t j = 0; j < matrixCount; ++j)
+                    c->out[j] = c->projection * (c->view * (*c->models)[j]);
+
+                doNotOptimize(*c->out.data());
+            }
+        }};
+    });
+    registry.add("Macro/Perspective*Affine*Affine/" + type + "/100k", matrixCount, []
+    {
+        auto c = std::make_shared<Chains<T>>();
+
+        return Run{[c](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                for (std::size_t j = 0; j < matrixCount; ++j)
+                    c->out[j] = c->structuredProjection * (c->structuredView * c->affines[j]);
+
+                doNotOptimize(*c->out.data());
+            }
+        }};
+    });
+}
+
+// 100k double world transforms a few hundred units around a camera far from the origin, narrowed to float model-view matrices
+struct CameraRelative
+{
+    using V3 = cgla::Vector<double, 3>;
+
+    V3 eye{1.0e7, -3.0e6, 2.0e7};
+    cgla::Matrix4d view = cgla::lookAt(eye, V3{eye[0] + 1.0, eye[1], eye[2] - 2.0}, V3{0.0, 1.0, 0.0});
+    std::vector<cgla::Matrix4d> models = std::vector<cgla::Matrix4d>(matrixCount);
+    std::vector<cgla::Matrix4f> out = std::vector<cgla::Matrix4f>(matrixCount);
+
+    CameraRelative()
+    {
+        auto offsets = randomInputs<V3>(matrixCount);
+        auto rotations = randomInputs<cgla::Vector<double, 4>>(matrixCount);
+
+        for (std::size_t j = 0; j < matrixCount; ++j)
+            models[j] = cgla::composeTRS(eye + (*offsets)[j] * 300.0, cgla::normalize(cgla::Quaternion<double>{(*rotations)[j]}), V3{1.0});
+    }
+};
+
+void registerCameraRelative(Registry& registry)
+{
+    registry.add("Macro/modelView/Matrix4x4d/100k", matrixCount, []
+    {
+        auto c = std::make_shared<CameraRelative>();
+
+        return Run{[c](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                cgla::modelView<float>(c->view, c->models.data(), c->out.data(), matrixCount);
+                doNotOptimize(*c->out.data());
+            }
+        }};
+    });
+    registry.add("Macro/modelViewLoop/Matrix4x4d/100k", matrixCount, []
+    {
+        auto c = std::make_shared<CameraRelative>();
+
+        return Run{[c](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                for (std::size_t j = 0; j < matrixCount; ++j)
+                    c->out[j] = cgla::Matrix4f(c->view * c->models[j]);
+
+                doNotOptimize(*c->out.data());
+            }
+        }};
+    });
+    registry.add("Macro/relativeModel/Matrix4x4d/100k", matrixCount, []
+    {
+        auto c = std::make_shared<CameraRelative>();
+
+        return Run{[c](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                cgla::relativeModel<float>(c->models.data(), c->eye, c->out.data(), matrixCount);
+                doNotOptimize(*c->out.data());
+            }
+        }};
+    });
+}
+
+// a wide and shallow scene: four roots and eight children per node
+std::shared_ptr<cgla::TransformHierarchy<float>> makeHierarchy()
+{
+    std::vector<std::size_t> parents(nodeCount);
+
+    for (std::size_t i = 0; i < nodeCount; ++i)
+        parents[i] = i < 4 ? cgla::TransformHierarchy<float>::noParent : (i - 4) / 8;
+
+    auto hierarchy = std::make_shared<cgla::TransformHierarchy<float>>(parents);
+    auto locals = randomInputs<cgla::Matrix<float, 4, 4>>(nodeCount);
+
+    for (std::size_t i = 0; i < nodeCount; ++i)
+        hierarchy->setLocal(i, (*locals)[i]);
+
+    hierarchy->update();
+
+    return hierarchy;
+}
+
+void registerHierarchy(Registry& registry)
+{
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+
+    registry.add("Macro/hierarchy/full/100k", nodeCount, []
+    {
+        auto hierarchy = makeHierarchy();
+
+        return Run{[hierarchy](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                for (std::size_t j = 0; j < 4; ++j)
+                    hierarchy->markDirty(j);
+
+                hierarchy->update();
+                doNotOptimize(*hierarchy->worlds());
+            }
+        }};
+    });
+
+    registry.add("Macro/hierarchy/fullParallel/100k", nodeCount, [threads]
+    {
+        auto hierarchy = makeHierarchy();
+
+        return Run{[hierarchy, threads](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                for (std::size_t j = 0; j < 4; ++j)
+                    hierarchy->markDirty(j);
+
+                hierarchy->update(threads);
+                doNotOptimize(*hierarchy->worlds());
+            }
+        }};
+    });
+
+    // a hundred leaf-side nodes change per frame
+    registry.add("Macro/hierarchy/incremental/100k", nodeCount, []
+    {
+        auto hierarchy = makeHierarchy();
+
+        return Run{[hierarchy](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                for (std::size_t j = 0; j < 100; ++j)
+                    hierarchy->markDirty(nodeCount - 1 - j * 37);
+
+                hierarchy->update();
+                doNotOptimize(*hierarchy->worlds());
+            }
+        }};
+    });
+}
+
+// instances in [0.5, 1.5]^3 seen through a narrow perspective, about half of them are visible
+struct Instances
+{
+    using V3 = cgla::Vector<float, 3>;
+
+    cgla::VectorArray3f centers{*randomInputs<V3>(instanceCount)};
+    cgla::VectorArray3f extents{*randomInputs<V3>(instanceCount)};
+    cgla::VectorArray3f mins, maxs;
+    std::vector<float> radii;
+    std::vector<std::uint32_t> mask = std::vector<std::uint32_t>(cgla::cullMaskSize(instanceCount));
+
+    Instances()
+    {
+        extents *= 0.02f;
+        mins = centers - extents;
+        maxs = centers + extents;
+        radii = cgla::length(extents);
+    }
+};
+
+void registerCulling(Registry& registry)
+{
+    using V3 = cgla::Vector<float, 3>;
+
+    cgla::Matrix4f view = cgla::lookAt(V3{1.f, 1.f, -1.f}, V3{1.f, 1.f, 1.f}, V3{0.f, 1.f, 0.f});
+    cgla::Frustumf frustum{cgla::Matrix4f(cgla::perspective(0.35f, 1.f, 0.1f, 100.f) * view)};
+
+    registry.add("Macro/cullSpheres/500k", instanceCount, [frustum]
+    {
+        auto s = std::make_shared<Instances>();
+
+        return Run{[frustum, s](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                cgla::cullSpheres(frustum, s->centers, s->radii.data(), s->mask.data());
+                doNotOptimize(*s->mask.data());
+            }
+        }};
+    });
+
+    registry.add("Macro/cullBoxes/500k", instanceCount, [frustum]
+    {
+        auto s = std::make_shared<Instances>();
+
+        return Run{[frustum, s](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                cgla::cullBoxes(frustum, s->mins, s->maxs, s->mask.data());
+                doNotOptimize(*s->mask.data());
+            }
+        }};
+    });
+
+    registry.add("Macro/intersectsSphereLoop/500k", instanceCount, [frustum]
+    {
+        auto s = std::make_shared<Instances>();
+
+        return Run{[frustum, s](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                std::fill(s->mask.begin(), s->mask.end(), 0u);
+
+                for (std::size_t j = 0; j < instanceCount; ++j)
+                    if (frustum.intersectsSphere(s->centers[j], s->radii[j]))
+                        s->mask[j / 32] |= 1u << (j % 32);
+
+                doNotOptimize(*s->mask.data());
+            }
+        }};
+    });
+}
+
+void registerBounds(Registry& registry)
+{
+    using V3 = cgla::Vector<float, 3>;
+
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+
+    registry.add("Macro/computeBounds/1M", vertexCount, []
+    {
+        auto points = randomInputs<V3>(vertexCount);
+
+        return Run{[points](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+                doNotOptimize(cgla::computeBounds(points->data(), vertexCount));
+        }};
+    });
+
+    registry.add("Macro/computeBoundsParallel/1M", vertexCount, [threads]
+    {
+        auto points = randomInputs<V3>(vertexCount);
+
+        return Run{[points, threads](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+                doNotOptimize(cgla::computeBounds(points->data(), vertexCount, threads));
+        }};
+    });
+
+    registry.add("Macro/computeBounds/VectorArray3f/1M", vertexCount, []
+    {
+        auto soa = std::make_shared<cgla::VectorArray3f>(*randomInputs<V3>(vertexCount));
+
+        return Run{[soa](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+                doNotOptimize(cgla::computeBounds(*soa));
+        }};
+    });
+
+    registry.add("Macro/computeBoundsLoop/1M", vertexCount, []
+    {
+        auto points = randomInputs<V3>(vertexCount);
+
+        return Run{[points](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                cgla::AABB3f bounds;
+
+                for (const V3& p : *points)
+                    bounds = cgla::merge(bounds, p);
+
+                doNotOptimize(bounds);
+            }
+        }};
+    });
+}
+}
+
+void registerMacroBenchmarks(Registry& registry)
+{
+    registerVertexBuffer(registry);
+    registerInverses<float>(registry, "Matrix4x4f");
+    registerInverses<double>(registry, "Matrix4x4d");
+    registerSolves<float, 3>(registry, "Matrix3x3f");
+    registerSolves<double, 3>(registry, "Matrix3x3d");
+    registerSolves<double, 6>(registry, "Matrix6x6d");
+    registerDecompositions<float>(registry, "Matrix3x3f");
+    registerDecompositions<double>(registry, "Matrix3x3d");
+    registerBuilders<float>(registry, "f");
+    registerBuilders<double>(registry, "d");
+    registerChains<float>(registry, "Matrix4x4f");
+    registerChains<double>(registry, "Matrix4x4d");
+    registerCameraRelative(registry);
+    registerHierarchy(registry);
+    registerCulling(registry);
+    registerBounds(registry);
+}
+
+}
@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <cgla/cgla.hpp>
+#include "bench.hpp"
+
+namespace {
+
+struct Options
+{
+    std::string format = "json";
+    std::string filter;
+    double minTime = 0.05; // seconds per repetition
+    std::size_t repetitions = 5;
+    bool list = false;
+};
+
+struct Result
+{
+    std::string name;
+    std::size_t iterations;
+    double nsPerOp;
+    double itemsPerSecond;
+};
+
+void printUsage()
+{
+    std::printf("usage: cgla_bench [--format=json|csv] [--filter=<substring>] [--min-time=<seconds>] [--repetitions=<n>] [--list]\n");
+}
+
+bool parseOptions(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+
+        if (std::strncmp(arg, "--format=", 9) == 0)
+            options.format = arg + 9;
+        else if (std::strncmp(arg, "--filter=", 9) == 0)
+            options.filter = arg + 9;
+        else if (std::strncmp(arg, "--min-time=", 11) == 0)
+            options.minTime = std::atof(arg + 11);
+        else if (std::strncmp(arg, "--repetitions=", 14) == 0)
+            options.repetitions = static_cast<std::size_t>(std::strtoul(arg + 14, nullptr, 10));
+        else if (std::strcmp(arg, "--list") == 0)
+            options.list = true;
+        else
+            return false;
+    }
+
+    return (options.format == "json" || options.format == "csv") && options.minTime > 0.0 && options.repetitions > 0;
+}
+
+double elapsedSeconds(const bench::Run& run, std::size_t iterations)
+{
+    auto start = std::chrono::steady_clock::now();
+    run(iterations);
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double>(end - start).count();
+}
+
+// allocates the inputs, grows the iteration count until one repetition lasts about minTime, then keeps the median of the repetitions
+Result measure(const bench::Benchmark& benchmark, const Options& options)
+{
+    bench::rng().seed(bench::seed);
+    bench::Run run = benchmark.setup();
+
+    std::size_t iterations = 1;
+    double seconds = elapsedSeconds(run, iterations);
+
+    while (seconds < options.minTime)
+    {
+        double scale = seconds > 0.0 ? std::min(10.0, 1.2 * options.minTime / seconds) : 10.0;
+        iterations = std::max(iterations + 1, static_cast<std::size_t>(static_cast<double>(iterations) * scale));
+        seconds = elapsedSeconds(run, iterations);
+    }
+
+    std::vector<double> samples;
+
+    for (std::size_t r = 0; r < options.repetitions; ++r)
+        samples.push_back(elapsedSeconds(run, iterations) / static_cast<double>(iterations));
+
+    std::sort(samples.begin(), samples.end());
+    double secondsPerIteration = samples[samples.size() / 2];
+
+    Result result;
+    result.name = benchmark.name;
+    result.iterations = iterations;
+    result.nsPerOp = secondsPerIteration * 1e9 / static_cast<double>(benchmark.items);
+    result.itemsPerSecond = static_cast<double>(benchmark.items) / secondsPerIteration;
+
+    return result;
+}
+
+void printHeader(const Options& options)
+{
+    if (options.format == "csv")
+    {
+        std::printf("name,iterations,ns_per_op,items_per_second\n");
+        return;
+    }
+
+    std::printf("{\n");
+    std::printf("  \"context\": {\n");
+    #ifdef CGLA_SSE
+    std::printf("    \"cgla_sse\": true,\n");
+    #else
+    std::printf("    \"cgla_sse\": false,\n");
+    #endif
+    #ifdef CGLA_EXPRESSION_TEMPLATES
+    std::printf("    \"cgla_expression_templates\": true,\n");
+    #else
+    std::printf("    \"cgla_expression_templates\": false,\n");
+    #endif
+    std::printf("    \"min_time\": %g,\n", options.minTime);
+    std::printf("    \"repetitions\": %zu\n", options.repetitions);
+    std::printf("  },\n");
+    std::printf("  \"benchmarks\": [");
+}
+
+void printResult(const Result& result, const Options& options, bool first)
+{
+    if (options.format == "csv")
+        std::printf("\"%s\",%zu,%.4f,%.6e\n", result.name.c_str(), result.iterations, result.nsPerOp, result.itemsPerSecond);
+    else
+        std::printf("%s\n    {\"name\": \"%s\", \"iterations\": %zu, \"ns_per_op\": %.4f, \"items_per_second\": %.6e}", first ? "" : ",", result.name.c_str(), result.iterations, result.nsPerOp, result.itemsPerSecond);
+
+    std::fflush(stdout);
+}
+
+void printFooter(const Options& options)
+{
+    if (options.format == "json")
+        std::printf("\n  ]\n}\n");
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    if (!parseOptions(argc, argv, options))
+    {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    bench::Registry registry;
+    bench::registerVectorBenchmarks(registry);
+    bench::registerMatrixBenchmarks(registry);
+    bench::registerTransformBenchmarks(registry);
+    bench::registerMacroBenchmarks(registry);
+    bench::registerSkinningBenchmarks(registry);
+    bench::registerRayBenchmarks(registry);
+    bench::registerParallelBenchmarks(registry);
+
+    if (options.list)
+    {
+        for (const bench::Benchmark& benchmark : registry.benchmarks())
+            std::printf("%s\n", benchmark.name.c_str());
+
+        return EXIT_SUCCESS;
+    }
+
+    printHeader(options);
+
+    bool first = true;
+
+    for (const bench::Benchmark& benchmark : registry.benchmarks())
+    {
+        if (benchmark.name.find(options.filter) == std::string::npos)
+            continue;
+
+        printResult(measure(benchmark, options), options, first);
+        first = false;
+    }
+
+    printFooter(options);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <cgla/cgla.hpp>
+#include "bench.hpp"
+
+namespace bench {
+
+namespace {
+
+template<typename T, std::size_t M, std::size_t N>
+void registerSquare(Registry&, const std::string&, std::false_type)
+{
+}
+
+template<typename T, std::size_t M, std::size_t N>
+void registerSquare(Registry& registry, const std::string& type, std::true_type)
+{
+    using Mat = cgla::Matrix<T, M, M>;
+    using V = cgla::Vector<T, M>;
+
+    addUnary<Mat>(registry, type + "/determinant", [](const Mat& a) { return cgla::determinant(a); });
+    addUnary<Mat>(registry, type + "/inverse", [](const Mat& a) { return cgla::inverse(a); });
+    addUnary<Mat>(registry, type + "/tryInverse", [](const Mat& a)
+    {
+        Mat res{};
+        bool invertible = cgla::tryInverse(a, res);
+        doNotOptimize(invertible);
+        return res;
+    });
+    addBinary<Mat, V>(registry, type + "/inverse*Vector", [](const Mat& a, const V& b) { return V(cgla::inverse(a) * b); });
+    addBinary<Mat, V>(registry, type + "/LU::solve(Vector)", [](const Mat& a, const V& b) { return cgla::LU<T, M>{a}.solve(b); });
+    addBinary<Mat, V>(registry, type + "/QR::solve(Vector)", [](const Mat& a, const V& b) { return cgla::QR<T, M, M>{a}.solve(b); });
+}
+
+template<typename T, std::size_t M, std::size_t N>
+void registerMatrix(Registry& registry, const std::string& type)
+{
+    using Mat = cgla::Matrix<T, M, N>;
+    using Right = cgla::Matrix<T, N, N>;
+    using U = cgla::Vector<T, M>;
+    using V = cgla::Vector<T, N>;
+
+    addUnary<Mat>(registry, type + "/operator-(unary)", [](const Mat& a) { return Mat(-a); });
+    addBinary<Mat, Mat>(registry, type + "/operator+", [](const Mat& a, const Mat& b) { return Mat(a + b); });
+    addBinary<Mat, Mat>(registry, type + "/operator-", [](const Mat& a, const Mat& b) { return Mat(a - b); });
+    addBinary<Mat, T>(registry, type + "/operator*(scalar)", [](const Mat& a, T b) { return Mat(a * b); });
+    addBinary<T, Mat>(registry, type + "/operator*(scalar,Matrix)", [](T a, const Mat& b) { return Mat(a * b); });
+    addBinary<Mat, Right>(registry, type + "/operator*(Matrix)", [](const Mat& a, const Right& b) { return Mat(a * b); });
+    addBinary<Mat, V>(registry, type + "/operator*(Vector)", [](const Mat& a, const V& b) { return U(a * b); });
+    addBinary<U, Mat>(registry, type + "/operator*(Vector,Matrix)", [](const U& a, const Mat& b) { return V(a * b); });
+    addBinary<Mat, T>(registry, type + "/operator/(scalar)", [](const Mat& a, T b) { return Mat(a / b); });
+    addAssign<Mat, Mat>(registry, type + "/operator+=", [](Mat& a, const Mat& b) { a += b; });
+    addAssign<Mat, Mat>(registry, type + "/operator-=", [](Mat& a, const Mat& b) { a -= b; });
+    addAssign<Mat, T>(registry, type + "/operator*=(scalar)", [](Mat& a, T b) { a *= b; });
+    addAssign<Mat, T>(registry, type + "/operator/=(scalar)", [](Mat& a, T b) { a /= b; });
+    addBinary<Mat, Mat>(registry, type + "/operator==", [](const Mat& a, const Mat& b) { return a == b; });
+    addBinary<Mat, Mat>(registry, type + "/operator!=", [](const Mat& a, const Mat& b) { return a != b; });
+    addBinary<Mat, Mat>(registry, type + "/operator<", [](const Mat& a, const Mat& b) { return a < b; });
+    addUnary<Mat>(registry, type + "/transpose", [](const Mat& a) { return cgla::transpose(a); });
+    addBinary<Mat, Mat>(registry, type + "/matrixCompMult", [](const Mat& a, const Mat& b) { return cgla::matrixCompMult(a, b); });
+    addBinary<U, V>(registry, type + "/outerProduct", [](const U& a, const V& b) { return cgla::outerProduct(a, b); });
+
+    registerSquare<T, M, N>(registry, type, std::integral_constant<bool, M == N>{});
+}
+
+}
+
+void registerMatrixBenchmarks(Registry& registry)
+{
+    registerMatrix<float, 2, 2>(registry, "Matrix2x2f");
+    registerMatrix<float, 2, 3>(registry, "Matrix2x3f");
+    registerMatrix<float, 2, 4>(registry, "Matrix2x4f");
+    registerMatrix<float, 3, 2>(registry, "Matrix3x2f");
+    registerMatrix<float, 3, 3>(registry, "Matrix3x3f");
+    registerMatrix<float, 3, 4>(registry, "Matrix3x4f");
+    registerMatrix<float, 4, 2>(registry, "Matrix4x2f");
+    registerMatrix<float, 4, 3>(registry, "Matrix4x3f");
+    registerMatrix<float, 4, 4>(registry, "Matrix4x4f");
+    registerMatrix<double, 2, 2>(registry, "Matrix2x2d");
+    registerMatrix<double, 2, 3>(registry, "Matrix2x3d");
+    registerMatrix<double, 2, 4>(registry, "Matrix2x4d");
+    registerMatrix<double, 3, 2>(registry, "Matrix3x2d");
+    registerMatrix<double, 3, 3>(registry, "Matrix3x3d");
+    registerMatrix<double, 3, 4>(registry, "Matrix3x4d");
+    registerMatrix<double, 4, 2>(registry, "Matrix4x2d");
+    registerMatrix<double, 4, 3>(registry, "Matrix4x3d");
+    registerMatrix<double, 4, 4>(registry, "Matrix4x4d");
+    registerMatrix<float, 8, 8>(registry, "Matrix8x8f");
+    registerMatrix<double, 16, 16>(registry, "Matrix16x16d");
+    registerMatrix<double, 32, 32>(registry, "Matrix32x32d");
+    registerMatrix<double, 64, 64>(registry, "Matrix64x64d");
+}
+
+}
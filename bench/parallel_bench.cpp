@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cgla/cgla.hpp>
+#include "bench.hpp"
+
+namespace bench {
+
+namespace {
+
+constexpr std::size_t elementCount = 4000000;
+
+// 1, 2, 4, ... up to the hardware thread count, which is always included
+std::vector<std::size_t> threadCounts()
+{
+    std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::size_t> counts;
+
+    for (std::size_t n = 1; n < hardware; n *= 2)
+        counts.push_back(n);
+
+    counts.push_back(hardware);
+
+    return counts;
+}
+
+void registerKernels(Registry& registry, std::size_t threads)
+{
+    using V3 = cgla::Vector<float, 3>;
+
+    std::string suffix = "/4M/" + std::to_string(threads);
+
+    registry.add("Parallel/transformPoints" + suffix, elementCount, [threads]
+    {
+        auto mat = randomInputs<cgla::Matrix<float, 4, 4>>(1);
+        auto in = randomInputs<V3>(elementCount);
+        auto out = std::make_shared<std::vector<V3>>(elementCount);
+
+        return Run{[mat, in, out, threads](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                cgla::transformPoints((*mat)[0], in->data(), out->data(), elementCount, threads);
+                doNotOptimize(*out->data());
+            }
+        }};
+    });
+
+    registry.add("Parallel/computeBounds" + suffix, elementCount, [threads]
+    {
+        auto in = randomInputs<V3>(elementCount);
+
+        return Run{[in, threads](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+                doNotOptimize(cgla::computeBounds(in->data(), elementCount, threads));
+        }};
+    });
+}
+
+void registerAlgorithms(Registry& registry, std::size_t threads)
+{
+    using V3 = cgla::Vector<float, 3>;
+
+    std::string suffix = "/4M/" + std::to_string(threads);
+
+    registry.add("Parallel/parallelTransform/normalize" + suffix, elementCount, [threads]
+    {
+        auto pool = std::make_shared<cgla::ThreadPool>(threads - 1);
+        auto in = randomInputs<V3>(elementCount);
+        auto out = std::make_shared<std::vector<V3>>(elementCount);
+
+        return Run{[pool, in, out](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                cgla::parallelTransform(in->data(), elementCount, out->data(), [](const V3& v) { return cgla::normalize(v); }, cgla::defaultGrainSize, *pool);
+                doNotOptimize(*out->data());
+            }
+        }};
+    });
+
+    registry.add("Parallel/parallelForEach/scale" + suffix, elementCount, [threads]
+    {
+        auto pool = std::make_shared<cgla::ThreadPool>(threads - 1);
+        auto out = std::make_shared<std::vector<V3>>(elementCount);
+
+        return Run{[pool, out](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                cgla::parallelForEach(out->data(), elementCount, [](V3& v) { v *= 1.0001f; }, cgla::defaultGrainSize, *pool);
+                doNotOptimize(*out->data());
+            }
+        }};
+    });
+
+    registry.add("Parallel/parallelReduce/sum" + suffix, elementCount, [threads]
+    {
+        auto pool = std::make_shared<cgla::ThreadPool>(threads - 1);
+        auto in = randomInputs<V3>(elementCount);
+
+        return Run{[pool, in](std::size_t iterations)
+        {
+            auto add = [](const V3& a, const V3& b) { return V3(a + b); };
+
+            for (std::size_t i = 0; i < iterations; ++i)
+                doNotOptimize(cgla::parallelReduce(in->data(), elementCount, V3{}, add, add, cgla::defaultGrainSize, *pool));
+        }};
+    });
+}
+}
+
+void registerParallelBenchmarks(Registry& registry)
+{
+    for (std::size_t threads : threadCounts())
+    {
+        registerKernels(registry, threads);
+        registerAlgorithms(registry, threads);
+    }
+}
+
+}
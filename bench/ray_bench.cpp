@@ -0,0 +1,304 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cgla/cgla.hpp>
+#include "bench.hpp"
+
+namespace bench {
+
+namespace {
+
+// number of rays (or triangles) tested by one iteration
+constexpr std::size_t rayCount = 65536;
+
+// number of triangles in the BVH benchmarks
+constexpr std::size_t triangleCount = 100000;
+
+// rays from z = 3 towards the unit cube around the origin, so that about half of them hit
+std::shared_ptr<std::vector<cgla::Rayf>> makeRays()
+{
+    auto rays = std::make_shared<std::vector<cgla::Rayf>>(rayCount);
+
+    for (cgla::Rayf& ray : *rays)
+    {
+        cgla::Vector3f target;
+        randomize(target);
+        ray = cgla::Rayf{cgla::Vector3f{0.f, 0.f, 3.f}, cgla::Vector3f(target - cgla::Vector3f{1.f, 1.f, 4.f})};
+    }
+
+    return rays;
+}
+
+template<std::size_t K>
+struct Packets
+{
+    std::shared_ptr<std::vector<cgla::Rayf>> rays = makeRays();
+    std::vector<cgla::RayPacketf<K>> packets;
+    std::vector<cgla::TrianglePacketf<K>> triangles;
+
+    Packets() :
+        triangles(rayCount / K)
+    {
+        for (std::size_t i = 0; i < rayCount; i += K)
+            packets.emplace_back(rays->data() + i);
+
+        for (std::size_t i = 0; i < rayCount; ++i)
+        {
+            cgla::Vector3f v[3];
+            randomize(v[0]);
+            randomize(v[1]);
+            randomize(v[2]);
+            cgla::Vector3f center{1.f};
+            triangles[i / K].set(i % K, cgla::Vector3f(v[0] - center), cgla::Vector3f(v[1] - center), cgla::Vector3f(v[2] - center));
+        }
+    }
+};
+
+template<std::size_t K>
+void registerPackets(Registry& registry)
+{
+    std::string k = std::to_string(K);
+
+    registry.add("Ray/intersectTriangle/RayPacketf<" + k + ">", rayCount, []
+    {
+        auto data = std::make_shared<Packets<K>>();
+
+        return Run{[data](std::size_t iterations)
+        {
+            cgla::Vector3f v0{-0.5f, -0.5f, 0.f}, v1{0.5f, -0.5f, 0.f}, v2{0.f, 0.5f, 0.f};
+            cgla::PacketHit<float, K> hit;
+
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                std::uint32_t mask = 0;
+
+                for (const cgla::RayPacketf<K>& packet : data->packets)
+                    mask += cgla::intersectTriangle(packet, v0, v1, v2, hit);
+
+                doNotOptimize(mask);
+            }
+        }};
+    });
+
+    registry.add("Ray/intersectTriangles/TrianglePacketf<" + k + ">", rayCount, []
+    {
+        auto data = std::make_shared<Packets<K>>();
+
+        return Run{[data](std::size_t iterations)
+        {
+            cgla::PacketHit<float, K> hit;
+
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                std::uint32_t mask = 0;
+
+                for (const cgla::TrianglePacketf<K>& packet : data->triangles)
+                    mask += cgla::intersectTriangles((*data->rays)[0], packet, hit);
+
+                doNotOptimize(mask);
+            }
+        }};
+    });
+
+    registry.add("Ray/intersectBox/RayPacketf<" + k + ">", rayCount, []
+    {
+        auto data = std::make_shared<Packets<K>>();
+
+        return Run{[data](std::size_t iterations)
+        {
+            cgla::AABB3f box{cgla::Vector3f{-0.5f}, cgla::Vector3f{0.5f}};
+            float tNear[K];
+
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                std::uint32_t mask = 0;
+
+                for (const cgla::RayPacketf<K>& packet : data->packets)
+                    mask += cgla::intersectBox(packet, box, tNear);
+
+                doNotOptimize(mask);
+            }
+        }};
+    });
+}
+
+void registerSingleRays(Registry& registry)
+{
+    registry.add("Ray/intersectTriangle/Rayf", rayCount, []
+    {
+        auto rays = makeRays();
+
+        return Run{[rays](std::size_t iterations)
+        {
+            cgla::Vector3f v0{-0.5f, -0.5f, 0.f}, v1{0.5f, -0.5f, 0.f}, v2{0.f, 0.5f, 0.f};
+
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                std::size_t hits = 0;
+                float t, u, v;
+
+                for (const cgla::Rayf& ray : *rays)
+                    hits += cgla::intersectTriangle(ray, v0, v1, v2, t, u, v);
+
+                doNotOptimize(hits);
+            }
+        }};
+    });
+
+    registry.add("Ray/intersectBox/Rayf", rayCount, []
+    {
+        auto rays = makeRays();
+
+        return Run{[rays](std::size_t iterations)
+        {
+            cgla::AABB3f box{cgla::Vector3f{-0.5f}, cgla::Vector3f{0.5f}};
+
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                std::size_t hits = 0;
+                float tNear;
+
+                for (const cgla::Rayf& ray : *rays)
+                    hits += cgla::intersectBox(ray, box, tNear);
+
+                doNotOptimize(hits);
+            }
+        }};
+    });
+}
+
+// a soup of small random triangles filling [-1, 1]^3
+struct Soup
+{
+    std::vector<cgla::Vector3f> vertices;
+    std::vector<cgla::Vector3ui> triangles;
+
+    explicit Soup(std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            cgla::Vector3f center, v;
+            randomize(center);
+            unsigned int base = static_cast<unsigned int>(vertices.size());
+
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+                randomize(v);
+                vertices.push_back(cgla::Vector3f((center - cgla::Vector3f{1.f}) * 2.f + (v - cgla::Vector3f{1.f}) * 0.05f));
+            }
+
+            triangles.push_back({base, base + 1, base + 2});
+        }
+    }
+};
+
+// the triangle soup of the BVH benchmarks, its hierarchy and the rays traced through it
+struct Scene
+{
+    Soup soup{triangleCount};
+    cgla::MeshBVHf bvh{soup.vertices.data(), soup.triangles.data(), triangleCount};
+    std::shared_ptr<std::vector<cgla::Rayf>> rays = makeRays();
+};
+
+void registerBVH(Registry& registry)
+{
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+
+    registry.add("BVH/build/100k", triangleCount, []
+    {
+        auto soup = std::make_shared<Soup>(triangleCount);
+
+        return Run{[soup](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+                doNotOptimize(cgla::MeshBVHf{soup->vertices.data(), soup->triangles.data(), triangleCount});
+        }};
+    });
+
+    registry.add("BVH/buildParallel/100k", triangleCount, [threads]
+    {
+        auto soup = std::make_shared<Soup>(triangleCount);
+
+        return Run{[soup, threads](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+                doNotOptimize(cgla::MeshBVHf{soup->vertices.data(), soup->triangles.data(), triangleCount, threads});
+        }};
+    });
+
+    registry.add("BVH/closestHit/100k", rayCount, []
+    {
+        auto scene = std::make_shared<Scene>();
+
+        return Run{[scene](std::size_t iterations)
+        {
+            cgla::MeshHit<float> hit;
+
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                std::size_t hits = 0;
+
+                for (const cgla::Rayf& ray : *scene->rays)
+                    hits += scene->bvh.closestHit(ray, hit);
+
+                doNotOptimize(hits);
+            }
+        }};
+    });
+
+    registry.add("BVH/anyHit/100k", rayCount, []
+    {
+        auto scene = std::make_shared<Scene>();
+
+        return Run{[scene](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                std::size_t hits = 0;
+
+                for (const cgla::Rayf& ray : *scene->rays)
+                    hits += scene->bvh.anyHit(ray);
+
+                doNotOptimize(hits);
+            }
+        }};
+    });
+
+    registry.add("BVH/overlap/100k", inputCount, []
+    {
+        auto scene = std::make_shared<Scene>();
+        auto centers = randomInputs<cgla::Vector3f>();
+
+        return Run{[scene, centers](std::size_t iterations)
+        {
+            std::vector<std::size_t> result;
+
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                for (const cgla::Vector3f& c : *centers)
+                {
+                    result.clear();
+                    scene->bvh.overlap(cgla::AABB3f{cgla::Vector3f(c - cgla::Vector3f{1.1f}), cgla::Vector3f(c - cgla::Vector3f{0.9f})}, result);
+                }
+
+                doNotOptimize(result);
+            }
+        }};
+    });
+}
+}
+
+void registerRayBenchmarks(Registry& registry)
+{
+    registerSingleRays(registry);
+    registerPackets<4>(registry);
+    registerPackets<8>(registry);
+    registerPackets<16>(registry);
+    registerBVH(registry);
+}
+
+}
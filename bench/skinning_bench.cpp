@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cgla/cgla.hpp>
+#include "bench.hpp"
+
+namespace bench {
+
+namespace {
+
+constexpr std::size_t boneCount = 64;
+
+template<std::size_t K>
+struct Mesh
+{
+    std::vector<cgla::Vector<unsigned int, K>> indices;
+    std::vector<cgla::Vector<float, K>> weights;
+    std::vector<cgla::Vector3f> positions, normals, outPositions, outNormals;
+    std::vector<cgla::Vector4f> tangents, outTangents;
+    cgla::SkinStreams<float, K> streams;
+
+    explicit Mesh(std::size_t count) :
+        indices(count), weights(count), positions(count), normals(count), outPositions(count), outNormals(count), tangents(count), outTangents(count)
+    {
+        for (std::size_t v = 0; v < count; ++v)
+        {
+            randomize(weights[v]);
+            weights[v] /= (cgla::dot(weights[v], cgla::Vector<float, K>{1.f}));
+            randomize(positions[v]);
+            randomize(normals[v]);
+            randomize(tangents[v]);
+
+            for (std::size_t k = 0; k < K; ++k)
+                indices[v][k] = static_cast<unsigned int>(rng()() % boneCount);
+        }
+
+        streams.indices = indices.data();
+        streams.weights = weights.data();
+        streams.positions = positions.data();
+        streams.normals = normals.data();
+        streams.tangents = tangents.data();
+        streams.outPositions = outPositions.data();
+        streams.outNormals = outNormals.data();
+        streams.outTangents = outTangents.data();
+    }
+};
+
+struct Palettes
+{
+    std::vector<cgla::Matrix4f> matrices;
+    std::vector<cgla::Affine3f> affines;
+    std::vector<cgla::DualQuaternionf> dualQuaternions;
+
+    Palettes()
+    {
+        for (std::size_t b = 0; b < boneCount; ++b)
+        {
+            cgla::Vector4f q;
+            cgla::Vector3f t;
+            randomize(q);
+            randomize(t);
+
+            matrices.push_back(cgla::composeTRS(t, cgla::normalize(cgla::Quaternionf{q}), cgla::Vector3f{1.f}));
+            affines.push_back(cgla::Affine3f{matrices.back()});
+            dualQuaternions.push_back(cgla::toDualQuaternion(cgla::normalize(cgla::Quaternionf{q}), t));
+        }
+    }
+};
+
+template<std::size_t K, typename F>
+void addSkinning(Registry& registry, const std::string& name, std::size_t count, F f)
+{
+    registry.add(name, count, [count, f]
+    {
+        auto palettes = std::make_shared<Palettes>();
+        auto mesh = std::make_shared<Mesh<K>>(count);
+
+        return Run{[palettes, mesh, count, f](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                f(*palettes, mesh->streams, count);
+                doNotOptimize(*mesh->streams.outPositions);
+            }
+        }};
+    });
+}
+
+template<std::size_t K>
+void registerInfluences(Registry& registry, std::size_t count, const std::string& size)
+{
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string k = std::to_string(K);
+
+    addSkinning<K>(registry, "Macro/skinLinear/Matrix4x4f/" + k + "/" + size, count, [](const Palettes& p, const cgla::SkinStreams<float, K>& s, std::size_t n)
+    {
+        cgla::skinLinear(p.matrices.data(), s, n);
+    });
+    addSkinning<K>(registry, "Macro/skinLinear/Affine3f/" + k + "/" + size, count, [](const Palettes& p, const cgla::SkinStreams<float, K>& s, std::size_t n)
+    {
+        cgla::skinLinear(p.affines.data(), s, n);
+    });
+    addSkinning<K>(registry, "Macro/skinDualQuaternion/" + k + "/" + size, count, [](const Palettes& p, const cgla::SkinStreams<float, K>& s, std::size_t n)
+    {
+        cgla::skinDualQuaternion(p.dualQuaternions.data(), s, n);
+    });
+    addSkinning<K>(registry, "Macro/skinLinearParallel/Matrix4x4f/" + k + "/" + size, count, [threads](const Palettes& p, const cgla::SkinStreams<float, K>& s, std::size_t n)
+    {
+        cgla::skinLinear(p.matrices.data(), s, n, threads);
+    });
+}
+
+}
+
+void registerSkinningBenchmarks(Registry& registry)
+{
+    registerInfluences<4>(registry, 10000, "10k");
+    registerInfluences<4>(registry, 100000, "100k");
+    registerInfluences<4>(registry, 1000000, "1M");
+    registerInfluences<8>(registry, 10000, "10k");
+    registerInfluences<8>(registry, 100000, "100k");
+    registerInfluences<8>(registry, 1000000, "1M");
+}
+
+}
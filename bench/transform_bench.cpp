@@ -0,0 +1,102 @@
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <cgla/cgla.hpp>
+#include "bench.hpp"
+
+namespace bench {
+
+namespace {
+
+// number of points processed by one iteration of the batch transforms
+constexpr std::size_t batchSize = 1024;
+
+template<typename T, typename F>
+void addBatch(Registry& registry, const std::string& name, F f)
+{
+    using Mat = cgla::Matrix<T, 4, 4>;
+    using V = cgla::Vector<T, 3>;
+
+    registry.add(name, batchSize, [f]
+    {
+        auto mat = randomInputs<Mat>(1);
+        auto in = randomInputs<V>(batchSize);
+        auto out = std::make_shared<std::vector<V>>(batchSize);
+
+        return Run{[mat, in, out, f](std::size_t iterations)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                f((*mat)[0], in->data(), out->data(), batchSize);
+                doNotOptimize(*out->data());
+            }
+        }};
+    });
+}
+
+template<typename T>
+void registerTransform(Registry& registry, const std::string& prefix)
+{
+    using Mat = cgla::Matrix<T, 4, 4>;
+    using V2 = cgla::Vector<T, 2>;
+    using V3 = cgla::Vector<T, 3>;
+    using V4 = cgla::Vector<T, 4>;
+
+    addUnary<V3>(registry, prefix + "/translate", [](const V3& v) { return cgla::translate(v); });
+    addUnary<V3>(registry, prefix + "/scale", [](const V3& v) { return cgla::scale(v); });
+    addUnary<T>(registry, prefix + "/scale(uniform)", [](T v) { return cgla::scale(v); });
+    addUnary<T>(registry, prefix + "/rotateX", [](T angle) { return cgla::rotateX(angle); });
+    addUnary<T>(registry, prefix + "/rotateY", [](T angle) { return cgla::rotateY(angle); });
+    addUnary<T>(registry, prefix + "/rotateZ", [](T angle) { return cgla::rotateZ(angle); });
+    addBinary<T, V3>(registry, prefix + "/rotate", [](T angle, const V3& axis) { return cgla::rotate(angle, axis); });
+    addBinary<V3, V3>(registry, prefix + "/lookAt", [](const V3& eye, const V3& target)
+    {
+        return cgla::lookAt(eye, V3(-target), V3{static_cast<T>(0), static_cast<T>(1), static_cast<T>(0)});
+    });
+    addUnary<V2>(registry, prefix + "/orthographic", [](const V2& v) { return cgla::orthographic(-v[0], v[0], -v[1], v[1], -v[0], v[1]); });
+    addUnary<V2>(registry, prefix + "/frustum", [](const V2& v) { return cgla::frustum(-v[0], v[0], -v[1], v[1], v[0], v[1] * static_cast<T>(100)); });
+    addUnary<V4>(registry, prefix + "/perspective", [](const V4& v)
+    {
+        return cgla::perspective(v[0], v[1], v[2] * static_cast<T>(0.1), v[3] * static_cast<T>(100));
+    });
+    addBinary<Mat, V3>(registry, prefix + "/translate(Matrix)", [](const Mat& m, const V3& v) { return cgla::translate(m, v); });
+    addBinary<Mat, V3>(registry, prefix + "/scale(Matrix)", [](const Mat& m, const V3& v) { return cgla::scale(m, v); });
+    addBinary<Mat, T>(registry, prefix + "/scale(Matrix,uniform)", [](const Mat& m, T v) { return cgla::scale(m, v); });
+    addBinary<Mat, T>(registry, prefix + "/rotateX(Matrix)", [](const Mat& m, T angle) { return cgla::rotateX(m, angle); });
+    addBinary<Mat, T>(registry, prefix + "/rotateY(Matrix)", [](const Mat& m, T angle) { return cgla::rotateY(m, angle); });
+    addBinary<Mat, T>(registry, prefix + "/rotateZ(Matrix)", [](const Mat& m, T angle) { return cgla::rotateZ(m, angle); });
+    addBinary<Mat, V4>(registry, prefix + "/rotate(Matrix)", [](const Mat& m, const V4& v) { return cgla::rotate(m, v[3], cgla::xyz(v)); });
+    addBinary<V3, V4>(registry, prefix + "/composeTRS", [](const V3& v, const V4& q) { return cgla::composeTRS(v, cgla::Quaternion<T>{q}, v); });
+    addUnary<Mat>(registry, prefix + "/decomposeTRS", [](const Mat& m)
+    {
+        V3 translation, scale;
+        cgla::Quaternion<T> rotation;
+        cgla::decomposeTRS(m, translation, rotation, scale);
+        return rotation;
+    });
+    addUnary<Mat>(registry, prefix + "/affineInverse", [](const Mat& a) { return cgla::affineInverse(a); });
+    addUnary<Mat>(registry, prefix + "/rigidInverse", [](const Mat& a) { return cgla::rigidInverse(a); });
+
+    addBatch<T>(registry, prefix + "/transformPoints", [](const Mat& mat, const V3* in, V3* out, std::size_t count)
+    {
+        cgla::transformPoints(mat, in, out, count);
+    });
+    addBatch<T>(registry, prefix + "/transformPointsProjective", [](const Mat& mat, const V3* in, V3* out, std::size_t count)
+    {
+        cgla::transformPointsProjective(mat, in, out, count);
+    });
+    addBatch<T>(registry, prefix + "/transformDirections", [](const Mat& mat, const V3* in, V3* out, std::size_t count)
+    {
+        cgla::transformDirections(mat, in, out, count);
+    });
+}
+
+}
+
+void registerTransformBenchmarks(Registry& registry)
+{
+    registerTransform<float>(registry, "Transformf");
+    registerTransform<double>(registry, "Transformd");
+}
+
+}
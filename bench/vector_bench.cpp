@@ -0,0 +1,73 @@
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <cgla/cgla.hpp>
+#include "bench.hpp"
+
+namespace bench {
+
+namespace {
+
+template<typename T, std::size_t N>
+void registerCross(Registry&, const std::string&, std::false_type)
+{
+}
+
+template<typename T, std::size_t N>
+void registerCross(Registry& registry, const std::string& type, std::true_type)
+{
+    using V = cgla::Vector<T, N>;
+
+    addBinary<V, V>(registry, type + "/cross", [](const V& a, const V& b) { return cgla::cross(a, b); });
+    addUnary<V>(registry, type + "/xyz", [](const V& a) { return cgla::xyz(a); });
+}
+
+template<typename T, std::size_t N>
+void registerVector(Registry& registry, const std::string& type)
+{
+    using V = cgla::Vector<T, N>;
+
+    addUnary<V>(registry, type + "/operator-(unary)", [](const V& a) { return V(-a); });
+    addBinary<V, V>(registry, type + "/operator+", [](const V& a, const V& b) { return V(a + b); });
+    addBinary<V, V>(registry, type + "/operator-", [](const V& a, const V& b) { return V(a - b); });
+    addBinary<V, T>(registry, type + "/operator*(scalar)", [](const V& a, T b) { return V(a * b); });
+    addBinary<T, V>(registry, type + "/operator*(scalar,Vector)", [](T a, const V& b) { return V(a * b); });
+    addBinary<V, V>(registry, type + "/operator*(Vector)", [](const V& a, const V& b) { return V(a * b); });
+    addBinary<V, T>(registry, type + "/operator/(scalar)", [](const V& a, T b) { return V(a / b); });
+    addBinary<T, V>(registry, type + "/operator/(scalar,Vector)", [](T a, const V& b) { return V(a / b); });
+    addBinary<V, V>(registry, type + "/operator/(Vector)", [](const V& a, const V& b) { return V(a / b); });
+    addAssign<V, V>(registry, type + "/operator+=", [](V& a, const V& b) { a += b; });
+    addAssign<V, V>(registry, type + "/operator-=", [](V& a, const V& b) { a -= b; });
+    addAssign<V, T>(registry, type + "/operator*=(scalar)", [](V& a, T b) { a *= b; });
+    addAssign<V, V>(registry, type + "/operator*=(Vector)", [](V& a, const V& b) { a *= b; });
+    addAssign<V, T>(registry, type + "/operator/=(scalar)", [](V& a, T b) { a /= b; });
+    addAssign<V, V>(registry, type + "/operator/=(Vector)", [](V& a, const V& b) { a /= b; });
+    addBinary<V, V>(registry, type + "/operator==", [](const V& a, const V& b) { return a == b; });
+    addBinary<V, V>(registry, type + "/operator!=", [](const V& a, const V& b) { return a != b; });
+    addBinary<V, V>(registry, type + "/operator<", [](const V& a, const V& b) { return a < b; });
+    addBinary<V, V>(registry, type + "/dot", [](const V& a, const V& b) { return cgla::dot(a, b); });
+    addUnary<V>(registry, type + "/lengthSquared", [](const V& a) { return cgla::lengthSquared(a); });
+    addUnary<V>(registry, type + "/length", [](const V& a) { return cgla::length(a); });
+    addBinary<V, V>(registry, type + "/distanceSquared", [](const V& a, const V& b) { return cgla::distanceSquared(a, b); });
+    addBinary<V, V>(registry, type + "/distance", [](const V& a, const V& b) { return cgla::distance(a, b); });
+    addUnary<V>(registry, type + "/normalize", [](const V& a) { return cgla::normalize(a); });
+    addUnary<V>(registry, type + "/swizzle", [](const V& a) { return cgla::swizzle<0, 0>(a); });
+
+    registerCross<T, N>(registry, type, std::integral_constant<bool, N == 3>{});
+}
+
+}
+
+void registerVectorBenchmarks(Registry& registry)
+{
+    registerVector<float, 2>(registry, "Vector2f");
+    registerVector<float, 3>(registry, "Vector3f");
+    registerVector<float, 4>(registry, "Vector4f");
+    registerVector<double, 2>(registry, "Vector2d");
+    registerVector<double, 3>(registry, "Vector3d");
+    registerVector<double, 4>(registry, "Vector4d");
+    registerVector<float, 16>(registry, "Vector16f");
+    registerVector<double, 16>(registry, "Vector16d");
+}
+
+}
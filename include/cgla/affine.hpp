@@ -0,0 +1,64 @@
+#ifndef CGLA_AFFINE_HPP
+#define CGLA_AFFINE_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <type_traits>
+#include "config.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+
+namespace cgla {
+
+template<typename T, std::size_t N>
+class Affine
+{
+    static_assert(std::is_arithmetic<T>::value, "Argument T must be an arithmetic type");
+    static_assert(N > 0, "Argument N must be greater than zero");
+
+    public:
+        CGLA_CONSTEXPR Affine();
+        explicit Affine(Uninitialized);
+        CGLA_CONSTEXPR explicit Affine(const Matrix<T, N, N>& linear);
+        CGLA_CONSTEXPR Affine(const Matrix<T, N, N>& linear, const Vector<T, N>& translation);
+        CGLA_CONSTEXPR explicit Affine(const Matrix<T, N, N + 1>& mat);
+        CGLA_CONSTEXPR explicit Affine(const Matrix<T, N + 1, N + 1>& mat);
+
+        CGLA_CONSTEXPR T* data();
+        CGLA_CONSTEXPR const T* data() const;
+        CGLA_CONSTEXPR T& operator()(std::size_t i, std::size_t j);
+        CGLA_CONSTEXPR T operator()(std::size_t i, std::size_t j) const;
+        CGLA_CONSTEXPR const Matrix<T, N, N + 1>& matrix() const;
+        CGLA_CONSTEXPR Matrix<T, N, N> linear() const;
+        CGLA_CONSTEXPR Vector<T, N> translation() const;
+
+        CGLA_CONSTEXPR Affine<T, N>& operator*=(const Affine<T, N>& rhs);
+        CGLA_CONSTEXPR bool operator==(const Affine<T, N>& rhs) const;
+        CGLA_CONSTEXPR bool operator!=(const Affine<T, N>& rhs) const;
+
+    private:
+        Matrix<T, N, N + 1> values;
+};
+
+template<typename T, std::size_t N> CGLA_CONSTEXPR Affine<T, N> operator*(const Affine<T, N>& lhs, const Affine<T, N>& rhs);
+#ifdef CGLA_OSTREAM_OVERLOADS
+template<typename T, std::size_t N> std::ostream& operator<<(std::ostream& lhs, const Affine<T, N>& rhs);
+#endif
+
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, N> transformPoint(const Affine<T, N>& a, const Vector<T, N>& p);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, N> transformDirection(const Affine<T, N>& a, const Vector<T, N>& d);
+template<typename T, std::size_t N> Affine<T, N> inverse(const Affine<T, N>& a);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Matrix<T, N + 1, N + 1> toMatrix(const Affine<T, N>& a);
+
+#ifdef CGLA_TYPE_ALIASES
+using Affine2f = Affine<float, 2>; using Affine3f = Affine<float, 3>;
+using Affine2d = Affine<double, 2>; using Affine3d = Affine<double, 3>;
+#endif
+
+static_assert(sizeof(Affine<float, 3>) == sizeof(float[12]), "Affine<T, 3> must be stored as 3x4 components");
+
+}
+
+#include "affine.inl"
+
+#endif
@@ -0,0 +1,224 @@
+#include <cstddef>
+#include "config.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+
+namespace cgla {
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Affine<T, N>::Affine() :
+    values{static_cast<T>(1)}
+{
+}
+
+template<typename T, std::size_t N>
+inline Affine<T, N>::Affine(Uninitialized) :
+    values{uninitialized}
+{
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Affine<T, N>::Affine(const Matrix<T, N, N>& linear) :
+    values{}
+{
+    for (std::size_t i = 0; i < N * N; ++i)
+        values[i] = linear[i];
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Affine<T, N>::Affine(const Matrix<T, N, N>& linear, const Vector<T, N>& translation) :
+    values{}
+{
+    for (std::size_t i = 0; i < N * N; ++i)
+        values[i] = linear[i];
+
+    for (std::size_t i = 0; i < N; ++i)
+        values(i, N) = translation[i];
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Affine<T, N>::Affine(const Matrix<T, N, N + 1>& mat) :
+    values{mat}
+{
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Affine<T, N>::Affine(const Matrix<T, N + 1, N + 1>& mat) :
+    values{}
+{
+    for (std::size_t j = 0; j < N + 1; ++j)
+        for (std::size_t i = 0; i < N; ++i)
+            values(i, j) = mat(i, j);
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR T* Affine<T, N>::data()
+{
+    return values.data();
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR const T* Affine<T, N>::data() const
+{
+    return values.data();
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR T& Affine<T, N>::operator()(std::size_t i, std::size_t j)
+{
+    return values(i, j);
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR T Affine<T, N>::operator()(std::size_t i, std::size_t j) const
+{
+    return values(i, j);
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR const Matrix<T, N, N + 1>& Affine<T, N>::matrix() const
+{
+    return values;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Matrix<T, N, N> Affine<T, N>::linear() const
+{
+    Matrix<T, N, N> res{};
+
+    for (std::size_t i = 0; i < N * N; ++i)
+        res[i] = values[i];
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Vector<T, N> Affine<T, N>::translation() const
+{
+    Vector<T, N> res{};
+
+    for (std::size_t i = 0; i < N; ++i)
+        res[i] = values(i, N);
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Affine<T, N>& Affine<T, N>::operator*=(const Affine<T, N>& rhs)
+{
+    return *this = *this * rhs;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR bool Affine<T, N>::operator==(const Affine<T, N>& rhs) const
+{
+    return values == rhs.values;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR bool Affine<T, N>::operator!=(const Affine<T, N>& rhs) const
+{
+    return values != rhs.values;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Affine<T, N> operator*(const Affine<T, N>& lhs, const Affine<T, N>& rhs)
+{
+    // the implicit last row (0, ..., 0, 1) is never multiplied
+    Affine<T, N> res{Matrix<T, N, N + 1>{}};
+
+    for (std::size_t j = 0; j < N + 1; ++j)
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            T sum = (j == N) ? lhs(i, N) : static_cast<T>(0);
+
+            for (std::size_t k = 0; k < N; ++k)
+                sum += lhs(i, k) * rhs(k, j);
+
+            res(i, j) = sum;
+        }
+    }
+
+    return res;
+}
+
+#ifdef CGLA_OSTREAM_OVERLOADS
+template<typename T, std::size_t N>
+std::ostream& operator<<(std::ostream& lhs, const Affine<T, N>& rhs)
+{
+    return lhs << rhs.matrix();
+}
+#endif
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Vector<T, N> transformPoint(const Affine<T, N>& a, const Vector<T, N>& p)
+{
+    Vector<T, N> res{};
+
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        T sum = a(i, N);
+
+        for (std::size_t k = 0; k < N; ++k)
+            sum += a(i, k) * p[k];
+
+        res[i] = sum;
+    }
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Vector<T, N> transformDirection(const Affine<T, N>& a, const Vector<T, N>& d)
+{
+    Vector<T, N> res{};
+
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        T sum = static_cast<T>(0);
+
+        for (std::size_t k = 0; k < N; ++k)
+            sum += a(i, k) * d[k];
+
+        res[i] = sum;
+    }
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+Affine<T, N> inverse(const Affine<T, N>& a)
+{
+    // [L t]^-1 = [L^-1 -L^-1 t]
+    Matrix<T, N, N> inv = inverse(a.linear());
+    Affine<T, N> res{inv};
+
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        T sum = static_cast<T>(0);
+
+        for (std::size_t k = 0; k < N; ++k)
+            sum -= inv(i, k) * a(k, N);
+
+        res(i, N) = sum;
+    }
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Matrix<T, N + 1, N + 1> toMatrix(const Affine<T, N>& a)
+{
+    Matrix<T, N + 1, N + 1> res{};
+
+    for (std::size_t j = 0; j < N + 1; ++j)
+        for (std::size_t i = 0; i < N; ++i)
+            res(i, j) = a(i, j);
+
+    res(N, N) = static_cast<T>(1);
+
+    return res;
+}
+
+}
@@ -0,0 +1,82 @@
+#ifndef CGLA_BOUNDS_HPP
+#define CGLA_BOUNDS_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include "config.hpp"
+#include "vector.hpp"
+#include "vector_array.hpp"
+#include "matrix.hpp"
+
+namespace cgla {
+
+// axis-aligned box, empty when min > max on any axis
+template<typename T, std::size_t N>
+struct AABB
+{
+    static_assert(std::is_arithmetic<T>::value, "Argument T must be an arithmetic type");
+    static_assert(N > 0, "Argument N must be greater than zero");
+
+    CGLA_CONSTEXPR AABB();
+    CGLA_CONSTEXPR explicit AABB(const Vector<T, N>& point);
+    CGLA_CONSTEXPR AABB(const Vector<T, N>& min, const Vector<T, N>& max);
+
+    CGLA_CONSTEXPR bool empty() const;
+    CGLA_CONSTEXPR Vector<T, N> center() const;
+    CGLA_CONSTEXPR Vector<T, N> size() const;
+    CGLA_CONSTEXPR Vector<T, N> extents() const; // half the size
+
+    CGLA_CONSTEXPR bool operator==(const AABB<T, N>& rhs) const;
+    CGLA_CONSTEXPR bool operator!=(const AABB<T, N>& rhs) const;
+
+    Vector<T, N> min;
+    Vector<T, N> max;
+};
+
+template<typename T, std::size_t N>
+struct Sphere
+{
+    static_assert(std::is_floating_point<T>::value, "Argument T must be a floating point type");
+    static_assert(N > 0, "Argument N must be greater than zero");
+
+    CGLA_CONSTEXPR Sphere();
+    CGLA_CONSTEXPR Sphere(const Vector<T, N>& center, T radius);
+
+    CGLA_CONSTEXPR bool operator==(const Sphere<T, N>& rhs) const;
+    CGLA_CONSTEXPR bool operator!=(const Sphere<T, N>& rhs) const;
+
+    Vector<T, N> center;
+    T radius;
+};
+
+template<typename T, std::size_t N> CGLA_CONSTEXPR AABB<T, N> merge(const AABB<T, N>& a, const AABB<T, N>& b);
+template<typename T, std::size_t N> CGLA_CONSTEXPR AABB<T, N> merge(const AABB<T, N>& a, const Vector<T, N>& p);
+template<typename T, std::size_t N> CGLA_CONSTEXPR AABB<T, N> intersection(const AABB<T, N>& a, const AABB<T, N>& b);
+template<typename T, std::size_t N> CGLA_CONSTEXPR bool overlaps(const AABB<T, N>& a, const AABB<T, N>& b);
+template<typename T, std::size_t N> CGLA_CONSTEXPR bool contains(const AABB<T, N>& a, const Vector<T, N>& p);
+template<typename T, std::size_t N> CGLA_CONSTEXPR bool contains(const AABB<T, N>& a, const AABB<T, N>& b);
+template<typename T> CGLA_CONSTEXPR AABB<T, 3> transform(const Matrix<T, 4, 4>& mat, const AABB<T, 3>& a);
+
+template<typename T, std::size_t N> Sphere<T, N> merge(const Sphere<T, N>& a, const Sphere<T, N>& b);
+template<typename T, std::size_t N> CGLA_CONSTEXPR bool overlaps(const Sphere<T, N>& a, const Sphere<T, N>& b);
+template<typename T, std::size_t N> CGLA_CONSTEXPR bool contains(const Sphere<T, N>& s, const Vector<T, N>& p);
+template<typename T> Sphere<T, 3> transform(const Matrix<T, 4, 4>& mat, const Sphere<T, 3>& s);
+template<typename T, std::size_t N> Sphere<T, N> boundingSphere(const AABB<T, N>& a);
+
+template<typename T, std::size_t N> AABB<T, N> computeBounds(const Vector<T, N>* points, std::size_t count, std::size_t threadCount = 1);
+template<typename T, std::size_t N> AABB<T, N> computeBounds(const VectorArray<T, N>& points, std::size_t threadCount = 1);
+template<typename T, std::size_t N> Sphere<T, N> computeBoundingSphere(const Vector<T, N>* points, std::size_t count, std::size_t threadCount = 1);
+
+#ifdef CGLA_TYPE_ALIASES
+using AABB2f = AABB<float, 2>; using AABB3f = AABB<float, 3>;
+using AABB2d = AABB<double, 2>; using AABB3d = AABB<double, 3>;
+using AABB2i = AABB<int, 2>; using AABB3i = AABB<int, 3>;
+using Sphere2f = Sphere<float, 2>; using Sphere3f = Sphere<float, 3>;
+using Sphere2d = Sphere<double, 2>; using Sphere3d = Sphere<double, 3>;
+#endif
+
+}
+
+#include "bounds.inl"
+
+#endif
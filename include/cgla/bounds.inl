@@ -0,0 +1,410 @@
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include "config.hpp"
+#include "vector.hpp"
+#include "vector_array.hpp"
+#include "matrix.hpp"
+#include "parallel.hpp"
+#ifdef CGLA_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace cgla {
+
+namespace detail {
+    // minimum number of points given to a thread
+    constexpr std::size_t boundsGrainSize = 16384;
+
+    template<typename T, std::size_t N> AABB<T, N> bounds(const Vector<T, N>* points, std::size_t count);
+    #ifdef CGLA_SSE
+    AABB<float, 3> bounds(const Vector<float, 3>* points, std::size_t count);
+    #endif
+    template<typename T> void minMax(const T* values, std::size_t count, T& min, T& max);
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR AABB<T, N>::AABB() :
+    min{std::numeric_limits<T>::max()},
+    max{std::numeric_limits<T>::lowest()}
+{
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR AABB<T, N>::AABB(const Vector<T, N>& point) :
+    min{point},
+    max{point}
+{
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR AABB<T, N>::AABB(const Vector<T, N>& min, const Vector<T, N>& max) :
+    min{min},
+    max{max}
+{
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR bool AABB<T, N>::empty() const
+{
+    for (std::size_t i = 0; i < N; ++i)
+        if (max[i] < min[i])
+            return true;
+
+    return false;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Vector<T, N> AABB<T, N>::center() const
+{
+    return (min + max) / static_cast<T>(2);
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Vector<T, N> AABB<T, N>::size() const
+{
+    return max - min;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Vector<T, N> AABB<T, N>::extents() const
+{
+    return (max - min) / static_cast<T>(2);
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR bool AABB<T, N>::operator==(const AABB<T, N>& rhs) const
+{
+    return min == rhs.min && max == rhs.max;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR bool AABB<T, N>::operator!=(const AABB<T, N>& rhs) const
+{
+    return !(*this == rhs);
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Sphere<T, N>::Sphere() :
+    center{},
+    radius{}
+{
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Sphere<T, N>::Sphere(const Vector<T, N>& center, T radius) :
+    center{center},
+    radius{radius}
+{
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR bool Sphere<T, N>::operator==(const Sphere<T, N>& rhs) const
+{
+    return center == rhs.center && radius == rhs.radius;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR bool Sphere<T, N>::operator!=(const Sphere<T, N>& rhs) const
+{
+    return !(*this == rhs);
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR AABB<T, N> merge(const AABB<T, N>& a, const AABB<T, N>& b)
+{
+    return {min(a.min, b.min), max(a.max, b.max)};
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR AABB<T, N> merge(const AABB<T, N>& a, const Vector<T, N>& p)
+{
+    return {min(a.min, p), max(a.max, p)};
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR AABB<T, N> intersection(const AABB<T, N>& a, const AABB<T, N>& b)
+{
+    return {max(a.min, b.min), min(a.max, b.max)};
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR bool overlaps(const AABB<T, N>& a, const AABB<T, N>& b)
+{
+    for (std::size_t i = 0; i < N; ++i)
+        if (a.max[i] < b.min[i] || b.max[i] < a.min[i])
+            return false;
+
+    return true;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR bool contains(const AABB<T, N>& a, const Vector<T, N>& p)
+{
+    for (std::size_t i = 0; i < N; ++i)
+        if (p[i] < a.min[i] || a.max[i] < p[i])
+            return false;
+
+    return true;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR bool contains(const AABB<T, N>& a, const AABB<T, N>& b)
+{
+    return contains(a, b.min) && contains(a, b.max);
+}
+
+template<typename T>
+CGLA_CONSTEXPR AABB<T, 3> transform(const Matrix<T, 4, 4>& mat, const AABB<T, 3>& a)
+{
+    if (a.empty())
+        return a;
+
+    // Arvo : each output axis is the translation plus the extreme products of a row with the input extents
+    AABB<T, 3> res{Vector<T, 3>{mat[12], mat[13], mat[14]}};
+
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            T e = mat[j * 4 + i] * a.min[j];
+            T f = mat[j * 4 + i] * a.max[j];
+
+            if (e < f)
+            {
+                res.min[i] += e;
+                res.max[i] += f;
+            }
+            else
+            {
+                res.min[i] += f;
+                res.max[i] += e;
+            }
+        }
+    }
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+Sphere<T, N> merge(const Sphere<T, N>& a, const Sphere<T, N>& b)
+{
+    Vector<T, N> d = b.center - a.center;
+    T dist = std::sqrt(lengthSquared(d));
+
+    if (dist + b.radius <= a.radius)
+        return a;
+
+    if (dist + a.radius <= b.radius)
+        return b;
+
+    T radius = (dist + a.radius + b.radius) / static_cast<T>(2);
+
+    return {a.center + d * ((radius - a.radius) / dist), radius};
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR bool overlaps(const Sphere<T, N>& a, const Sphere<T, N>& b)
+{
+    T r = a.radius + b.radius;
+
+    return distanceSquared(a.center, b.center) <= r * r;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR bool contains(const Sphere<T, N>& s, const Vector<T, N>& p)
+{
+    return distanceSquared(s.center, p) <= s.radius * s.radius;
+}
+
+template<typename T>
+Sphere<T, 3> transform(const Matrix<T, 4, 4>& mat, const Sphere<T, 3>& s)
+{
+    // the radius is scaled by a bound on the largest singular value of the 3x3 part : the largest row sum of the absolute
+    // values of its Gram matrix (Gershgorin), exact when the columns are orthogonal and conservative under shear
+    const Vector<T, 3>& c = s.center;
+    T gram[3][3];
+
+    for (std::size_t j = 0; j < 3; ++j)
+        for (std::size_t k = j; k < 3; ++k)
+            gram[j][k] = gram[k][j] = mat[j * 4] * mat[k * 4] + mat[j * 4 + 1] * mat[k * 4 + 1] + mat[j * 4 + 2] * mat[k * 4 + 2];
+
+    T scale = static_cast<T>(0);
+
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+        T l = std::abs(gram[j][0]) + std::abs(gram[j][1]) + std::abs(gram[j][2]);
+
+        if (scale < l)
+            scale = l;
+    }
+
+    return {Vector<T, 3>{mat[0] * c[0] + mat[4] * c[1] + mat[8] * c[2] + mat[12],
+                         mat[1] * c[0] + mat[5] * c[1] + mat[9] * c[2] + mat[13],
+                         mat[2] * c[0] + mat[6] * c[1] + mat[10] * c[2] + mat[14]},
+            s.radius * std::sqrt(scale)};
+}
+
+template<typename T, std::size_t N>
+inline Sphere<T, N> boundingSphere(const AABB<T, N>& a)
+{
+    return {a.center(), std::sqrt(lengthSquared(a.extents()))};
+}
+
+template<typename T, std::size_t N>
+AABB<T, N> computeBounds(const Vector<T, N>* points, std::size_t count, std::size_t threadCount)
+{
+    AABB<T, N> res;
+    std::mutex mutex;
+
+    detail::runChunked(count, threadCount, detail::boundsGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        AABB<T, N> chunk = detail::bounds(points + begin, end - begin);
+        std::lock_guard<std::mutex> lock{mutex};
+        res = merge(res, chunk);
+    });
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+AABB<T, N> computeBounds(const VectorArray<T, N>& points, std::size_t threadCount)
+{
+    AABB<T, N> res;
+    std::mutex mutex;
+
+    detail::runChunked(points.size(), threadCount, detail::boundsGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        AABB<T, N> chunk;
+
+        for (std::size_t i = 0; i < N; ++i)
+            detail::minMax(points.data(i) + begin, end - begin, chunk.min[i], chunk.max[i]);
+
+        std::lock_guard<std::mutex> lock{mutex};
+        res = merge(res, chunk);
+    });
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+Sphere<T, N> computeBoundingSphere(const Vector<T, N>* points, std::size_t count, std::size_t threadCount)
+{
+    // centered on the bounds, with the distance to the furthest point as radius
+    Vector<T, N> center = computeBounds(points, count, threadCount).center();
+    T radius = static_cast<T>(0);
+    std::mutex mutex;
+
+    detail::runChunked(count, threadCount, detail::boundsGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        T chunk = static_cast<T>(0);
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            T d = distanceSquared(center, points[i]);
+            chunk = chunk < d ? d : chunk;
+        }
+
+        std::lock_guard<std::mutex> lock{mutex};
+        radius = radius < chunk ? chunk : radius;
+    });
+
+    return {center, std::sqrt(radius)};
+}
+
+namespace detail {
+    template<typename T, std::size_t N>
+    inline AABB<T, N> bounds(const Vector<T, N>* points, std::size_t count)
+    {
+        AABB<T, N> res;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            for (std::size_t j = 0; j < N; ++j)
+            {
+                res.min[j] = points[i][j] < res.min[j] ? points[i][j] : res.min[j];
+                res.max[j] = res.max[j] < points[i][j] ? points[i][j] : res.max[j];
+            }
+        }
+
+        return res;
+    }
+
+    #ifdef CGLA_SSE
+    inline AABB<float, 3> bounds(const Vector<float, 3>* points, std::size_t count)
+    {
+        // 4 packed points are 3 registers holding {x, y, z, x}, {y, z, x, y} and {z, x, y, z}, reduced without shuffling
+        const float* p = points[0].data();
+        __m128 lo0 = _mm_set1_ps(std::numeric_limits<float>::max()), lo1 = lo0, lo2 = lo0;
+        __m128 hi0 = _mm_set1_ps(std::numeric_limits<float>::lowest()), hi1 = hi0, hi2 = hi0;
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4, p += 12)
+        {
+            __m128 a = _mm_loadu_ps(p), b = _mm_loadu_ps(p + 4), c = _mm_loadu_ps(p + 8);
+            lo0 = _mm_min_ps(lo0, a);
+            lo1 = _mm_min_ps(lo1, b);
+            lo2 = _mm_min_ps(lo2, c);
+            hi0 = _mm_max_ps(hi0, a);
+            hi1 = _mm_max_ps(hi1, b);
+            hi2 = _mm_max_ps(hi2, c);
+        }
+
+        alignas(16) float lo[12], hi[12];
+        _mm_store_ps(lo, lo0);
+        _mm_store_ps(lo + 4, lo1);
+        _mm_store_ps(lo + 8, lo2);
+        _mm_store_ps(hi, hi0);
+        _mm_store_ps(hi + 4, hi1);
+        _mm_store_ps(hi + 8, hi2);
+
+        AABB<float, 3> res = bounds<float, 3>(points + i, count - i);
+
+        for (std::size_t j = 0; j < 12; ++j)
+        {
+            res.min[j % 3] = lo[j] < res.min[j % 3] ? lo[j] : res.min[j % 3];
+            res.max[j % 3] = res.max[j % 3] < hi[j] ? hi[j] : res.max[j % 3];
+        }
+
+        return res;
+    }
+    #endif
+
+    template<typename T>
+    inline void minMax(const T* values, std::size_t count, T& min, T& max)
+    {
+        // eight independent lanes, which the compiler maps to packed min and max instructions
+        T lo[8], hi[8];
+        std::size_t i = 0;
+
+        for (std::size_t j = 0; j < 8; ++j)
+        {
+            lo[j] = min;
+            hi[j] = max;
+        }
+
+        for (; i + 8 <= count; i += 8)
+        {
+            for (std::size_t j = 0; j < 8; ++j)
+            {
+                lo[j] = values[i + j] < lo[j] ? values[i + j] : lo[j];
+                hi[j] = hi[j] < values[i + j] ? values[i + j] : hi[j];
+            }
+        }
+
+        for (; i < count; ++i)
+        {
+            lo[0] = values[i] < lo[0] ? values[i] : lo[0];
+            hi[0] = hi[0] < values[i] ? values[i] : hi[0];
+        }
+
+        for (std::size_t j = 0; j < 8; ++j)
+        {
+            min = lo[j] < min ? lo[j] : min;
+            max = max < hi[j] ? hi[j] : max;
+        }
+    }
+}
+
+}
@@ -0,0 +1,94 @@
+#ifndef CGLA_BVH_HPP
+#define CGLA_BVH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "config.hpp"
+#include "vector.hpp"
+#include "bounds.hpp"
+#include "ray.hpp"
+
+namespace cgla {
+
+// 4-wide bounding volume hierarchy over boxes, built with a binned surface area heuristic
+template<typename T>
+class BVH
+{
+    static_assert(std::is_floating_point<T>::value, "Argument T must be a floating point type");
+
+    public:
+        static constexpr std::size_t width = 4;
+        static constexpr std::uint32_t emptySlot = static_cast<std::uint32_t>(-1);
+
+        // the child boxes are stored as structure of arrays so that a ray is tested against all of them at once
+        struct Node
+        {
+            alignas(16) T min[3][width];
+            alignas(16) T max[3][width];
+            std::uint32_t child[width]; // inner node index, first index in primitiveOrder for a leaf, or emptySlot
+            std::uint32_t count[width]; // number of primitives of a leaf, 0 for an inner node
+        };
+
+        BVH();
+        BVH(const AABB<T, 3>* bounds, std::size_t count, std::size_t threadCount = 1);
+        BVH(const Vector<T, 3>* points, std::size_t count, std::size_t threadCount = 1);
+
+        std::size_t size() const;
+        AABB<T, 3> bounds() const;
+        const std::vector<Node>& nodes() const;
+        const std::vector<std::uint32_t>& primitiveOrder() const;
+
+        // f(primitive, tMax) tests a primitive, may shorten tMax to the distance of a hit and returns true to stop the traversal
+        template<typename F> void intersect(const Ray<T>& ray, F f) const;
+        // f(primitive) is called for every primitive whose box overlaps box
+        template<typename F> void overlap(const AABB<T, 3>& box, F f) const;
+
+    private:
+        void build(const AABB<T, 3>* bounds, std::size_t threadCount);
+
+        std::vector<Node> nodeArray; // the root is nodeArray[0]
+        std::vector<std::uint32_t> order;
+        AABB<T, 3> rootBounds;
+};
+
+template<typename T>
+struct MeshHit
+{
+    T t;
+    T u;
+    T v;
+    std::size_t triangle;
+};
+
+// BVH over an indexed triangle mesh, the vertex and index arrays must outlive it
+template<typename T>
+class MeshBVH
+{
+    public:
+        MeshBVH();
+        MeshBVH(const Vector<T, 3>* vertices, const Vector<unsigned int, 3>* triangles, std::size_t triangleCount, std::size_t threadCount = 1);
+
+        const BVH<T>& hierarchy() const;
+
+        bool closestHit(const Ray<T>& ray, MeshHit<T>& hit) const;
+        bool anyHit(const Ray<T>& ray) const;
+        void overlap(const AABB<T, 3>& box, std::vector<std::size_t>& triangles) const;
+
+    private:
+        const Vector<T, 3>* vertices;
+        const Vector<unsigned int, 3>* triangles;
+        BVH<T> bvh;
+};
+
+#ifdef CGLA_TYPE_ALIASES
+using BVHf = BVH<float>; using BVHd = BVH<double>;
+using MeshBVHf = MeshBVH<float>; using MeshBVHd = MeshBVH<double>;
+#endif
+
+}
+
+#include "bvh.inl"
+
+#endif
@@ -0,0 +1,594 @@
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "config.hpp"
+#include "vector.hpp"
+#include "bounds.hpp"
+#include "ray.hpp"
+#include "parallel.hpp"
+
+namespace cgla {
+
+namespace detail {
+    constexpr std::size_t bvhBinCount = 16;
+    constexpr std::size_t bvhMaxLeafSize = 4;
+    // minimum number of primitives of a subtree built as a separate task
+    constexpr std::size_t bvhGrainSize = 4096;
+
+    template<typename T> T halfArea(const AABB<T, 3>& a);
+
+    template<typename T>
+    class BVHBuilder
+    {
+        public:
+            using Node = typename BVH<T>::Node;
+
+            BVHBuilder(const AABB<T, 3>* bounds, std::size_t count, std::uint32_t* order);
+
+            bool split(std::size_t begin, std::size_t end, std::size_t& mid);
+            void build(std::size_t begin, std::size_t end, bool splittable, std::size_t mid, std::size_t threadCount, std::vector<Node>& nodes);
+
+        private:
+            struct Range
+            {
+                std::size_t begin;
+                std::size_t end;
+                bool splittable;
+                std::size_t mid;
+            };
+
+            AABB<T, 3> rangeBounds(std::size_t begin, std::size_t end) const;
+
+            const AABB<T, 3>* bounds;
+            std::vector<Vector<T, 3>> centroids;
+            std::uint32_t* order;
+    };
+
+    // LIFO of node indices, on the stack unless the tree is unusually deep
+    class NodeStack
+    {
+        public:
+            NodeStack();
+
+            bool empty() const;
+            void push(std::uint32_t node);
+            std::uint32_t pop();
+
+        private:
+            static constexpr std::size_t localSize = 128;
+
+            std::uint32_t local[localSize];
+            std::size_t top;
+            std::vector<std::uint32_t> overflow;
+    };
+}
+
+template<typename T>
+constexpr std::size_t BVH<T>::width;
+
+template<typename T>
+constexpr std::uint32_t BVH<T>::emptySlot;
+
+template<typename T>
+inline BVH<T>::BVH()
+{
+}
+
+template<typename T>
+BVH<T>::BVH(const AABB<T, 3>* bounds, std::size_t count, std::size_t threadCount) :
+    order(count)
+{
+    build(bounds, threadCount);
+}
+
+template<typename T>
+BVH<T>::BVH(const Vector<T, 3>* points, std::size_t count, std::size_t threadCount) :
+    order(count)
+{
+    std::vector<AABB<T, 3>> bounds(points, points + count);
+    build(bounds.data(), threadCount);
+}
+
+template<typename T>
+inline std::size_t BVH<T>::size() const
+{
+    return order.size();
+}
+
+template<typename T>
+inline AABB<T, 3> BVH<T>::bounds() const
+{
+    return rootBounds;
+}
+
+template<typename T>
+inline const std::vector<typename BVH<T>::Node>& BVH<T>::nodes() const
+{
+    return nodeArray;
+}
+
+template<typename T>
+inline const std::vector<std::uint32_t>& BVH<T>::primitiveOrder() const
+{
+    return order;
+}
+
+template<typename T>
+template<typename F>
+void BVH<T>::intersect(const Ray<T>& ray, F f) const
+{
+    if (nodeArray.empty())
+        return;
+
+    T inv[3] = {static_cast<T>(1) / ray.direction[0], static_cast<T>(1) / ray.direction[1], static_cast<T>(1) / ray.direction[2]};
+    T tMax = ray.tMax;
+    detail::NodeStack stack;
+    stack.push(0);
+
+    while (!stack.empty())
+    {
+        const Node& node = nodeArray[stack.pop()];
+        T tNear[width];
+        bool hit[width];
+
+        // slab test of the four children, see detail::intersectBoxLane
+        for (std::size_t s = 0; s < width; ++s)
+        {
+            T lo = static_cast<T>(0);
+            T hi = tMax;
+
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+                T a = (node.min[c][s] - ray.origin[c]) * inv[c];
+                T b = (node.max[c][s] - ray.origin[c]) * inv[c];
+                T t0 = inv[c] >= static_cast<T>(0) ? a : b;
+                T t1 = inv[c] >= static_cast<T>(0) ? b : a;
+                lo = t0 > lo ? t0 : lo;
+                hi = t1 < hi ? t1 : hi;
+            }
+
+            tNear[s] = lo;
+            hit[s] = lo <= hi && node.child[s] != emptySlot;
+        }
+
+        // nearest children first
+        std::size_t sorted[width];
+        std::size_t hitCount = 0;
+
+        for (std::size_t s = 0; s < width; ++s)
+        {
+            if (!hit[s])
+                continue;
+
+            std::size_t i = hitCount++;
+
+            for (; i > 0 && tNear[s] < tNear[sorted[i - 1]]; --i)
+                sorted[i] = sorted[i - 1];
+
+            sorted[i] = s;
+        }
+
+        for (std::size_t i = 0; i < hitCount; ++i)
+        {
+            std::size_t s = sorted[i];
+
+            if (node.count[s] == 0)
+                continue;
+
+            for (std::uint32_t k = node.child[s]; k < node.child[s] + node.count[s]; ++k)
+                if (f(static_cast<std::size_t>(order[k]), tMax))
+                    return;
+        }
+
+        for (std::size_t i = hitCount; i > 0; --i)
+            if (node.count[sorted[i - 1]] == 0)
+                stack.push(node.child[sorted[i - 1]]);
+    }
+}
+
+template<typename T>
+template<typename F>
+void BVH<T>::overlap(const AABB<T, 3>& box, F f) const
+{
+    if (nodeArray.empty())
+        return;
+
+    detail::NodeStack stack;
+    stack.push(0);
+
+    while (!stack.empty())
+    {
+        const Node& node = nodeArray[stack.pop()];
+
+        for (std::size_t s = 0; s < width; ++s)
+        {
+            if (node.child[s] == emptySlot)
+                continue;
+
+            bool overlaps = true;
+
+            for (std::size_t c = 0; c < 3; ++c)
+                overlaps &= !(node.max[c][s] < box.min[c] || box.max[c] < node.min[c][s]);
+
+            if (!overlaps)
+                continue;
+
+            if (node.count[s] == 0)
+                stack.push(node.child[s]);
+            else
+                for (std::uint32_t k = node.child[s]; k < node.child[s] + node.count[s]; ++k)
+                    f(static_cast<std::size_t>(order[k]));
+        }
+    }
+}
+
+template<typename T>
+void BVH<T>::build(const AABB<T, 3>* bounds, std::size_t threadCount)
+{
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = static_cast<std::uint32_t>(i);
+        rootBounds = merge(rootBounds, bounds[i]);
+    }
+
+    if (order.empty())
+        return;
+
+    detail::BVHBuilder<T> builder{bounds, order.size(), order.data()};
+    std::size_t mid = 0;
+    bool splittable = builder.split(0, order.size(), mid);
+    builder.build(0, order.size(), splittable, mid, threadCount, nodeArray);
+}
+
+template<typename T>
+MeshBVH<T>::MeshBVH() :
+    vertices{nullptr},
+    triangles{nullptr}
+{
+}
+
+template<typename T>
+MeshBVH<T>::MeshBVH(const Vector<T, 3>* vertices, const Vector<unsigned int, 3>* triangles, std::size_t triangleCount, std::size_t threadCount) :
+    vertices{vertices},
+    triangles{triangles}
+{
+    std::vector<AABB<T, 3>> bounds(triangleCount);
+
+    for (std::size_t i = 0; i < triangleCount; ++i)
+        bounds[i] = merge(merge(AABB<T, 3>{vertices[triangles[i][0]]}, vertices[triangles[i][1]]), vertices[triangles[i][2]]);
+
+    bvh = BVH<T>{bounds.data(), triangleCount, threadCount};
+}
+
+template<typename T>
+inline const BVH<T>& MeshBVH<T>::hierarchy() const
+{
+    return bvh;
+}
+
+template<typename T>
+bool MeshBVH<T>::closestHit(const Ray<T>& ray, MeshHit<T>& hit) const
+{
+    bool found = false;
+
+    bvh.intersect(ray, [&](std::size_t i, T& tMax)
+    {
+        const Vector<unsigned int, 3>& tri = triangles[i];
+        T t, u, v;
+
+        if (intersectTriangle(Ray<T>{ray.origin, ray.direction, tMax}, vertices[tri[0]], vertices[tri[1]], vertices[tri[2]], t, u, v))
+        {
+            hit = {t, u, v, i};
+            tMax = t;
+            found = true;
+        }
+
+        return false;
+    });
+
+    return found;
+}
+
+template<typename T>
+bool MeshBVH<T>::anyHit(const Ray<T>& ray) const
+{
+    bool found = false;
+
+    bvh.intersect(ray, [&](std::size_t i, T& tMax)
+    {
+        const Vector<unsigned int, 3>& tri = triangles[i];
+        T t, u, v;
+        found = intersectTriangle(Ray<T>{ray.origin, ray.direction, tMax}, vertices[tri[0]], vertices[tri[1]], vertices[tri[2]], t, u, v);
+
+        return found;
+    });
+
+    return found;
+}
+
+template<typename T>
+void MeshBVH<T>::overlap(const AABB<T, 3>& box, std::vector<std::size_t>& result) const
+{
+    bvh.overlap(box, [&](std::size_t i)
+    {
+        const Vector<unsigned int, 3>& tri = triangles[i];
+        AABB<T, 3> bounds = merge(merge(AABB<T, 3>{vertices[tri[0]]}, vertices[tri[1]]), vertices[tri[2]]);
+
+        if (overlaps(bounds, box))
+            result.push_back(i);
+    });
+}
+
+namespace detail {
+    template<typename T>
+    inline T halfArea(const AABB<T, 3>& a)
+    {
+        Vector<T, 3> s = a.size();
+
+        return s[0] * s[1] + s[1] * s[2] + s[2] * s[0];
+    }
+
+    template<typename T>
+    BVHBuilder<T>::BVHBuilder(const AABB<T, 3>* bounds, std::size_t count, std::uint32_t* order) :
+        bounds{bounds},
+        centroids(count),
+        order{order}
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            centroids[i] = bounds[i].center();
+    }
+
+    template<typename T>
+    AABB<T, 3> BVHBuilder<T>::rangeBounds(std::size_t begin, std::size_t end) const
+    {
+        AABB<T, 3> res;
+
+        for (std::size_t i = begin; i < end; ++i)
+            res = merge(res, bounds[order[i]]);
+
+        return res;
+    }
+
+    // partitions [begin, end) at mid and returns true, or returns false if the range is better kept as a leaf
+    template<typename T>
+    bool BVHBuilder<T>::split(std::size_t begin, std::size_t end, std::size_t& mid)
+    {
+        std::size_t n = end - begin;
+
+        if (n <= 1)
+            return false;
+
+        AABB<T, 3> centroidBounds;
+
+        for (std::size_t i = begin; i < end; ++i)
+            centroidBounds = merge(centroidBounds, centroids[order[i]]);
+
+        T bestCost = std::numeric_limits<T>::max();
+        std::size_t bestAxis = 0;
+        std::size_t bestBin = 0;
+
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            T lo = centroidBounds.min[axis];
+            T extent = centroidBounds.max[axis] - lo;
+
+            if (!(extent > static_cast<T>(0)))
+                continue;
+
+            T scale = static_cast<T>(bvhBinCount) / extent;
+            std::size_t counts[bvhBinCount] = {};
+            AABB<T, 3> bins[bvhBinCount];
+
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                std::size_t b = std::min(static_cast<std::size_t>((centroids[order[i]][axis] - lo) * scale), bvhBinCount - 1);
+                ++counts[b];
+                bins[b] = merge(bins[b], bounds[order[i]]);
+            }
+
+            // right[k] : area and count of the bins from k to the end
+            T rightArea[bvhBinCount];
+            std::size_t rightCount[bvhBinCount];
+            AABB<T, 3> acc;
+            std::size_t accCount = 0;
+
+            for (std::size_t k = bvhBinCount; k-- > 1;)
+            {
+                acc = merge(acc, bins[k]);
+                accCount += counts[k];
+                rightArea[k] = accCount ? halfArea(acc) : static_cast<T>(0);
+                rightCount[k] = accCount;
+            }
+
+            acc = AABB<T, 3>{};
+            accCount = 0;
+
+            for (std::size_t k = 1; k < bvhBinCount; ++k)
+            {
+                acc = merge(acc, bins[k - 1]);
+                accCount += counts[k - 1];
+
+                if (accCount == 0 || rightCount[k] == 0)
+                    continue;
+
+                T cost = halfArea(acc) * static_cast<T>(accCount) + rightArea[k] * static_cast<T>(rightCount[k]);
+
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = k;
+                }
+            }
+        }
+
+        if (bestCost == std::numeric_limits<T>::max())
+        {
+            // all centroids coincide : split by count to bound the leaf size
+            if (n <= bvhMaxLeafSize)
+                return false;
+
+            mid = begin + n / 2;
+            return true;
+        }
+
+        // cost of a split relative to intersecting every primitive, with a traversal step as expensive as a primitive test
+        T area = halfArea(rangeBounds(begin, end));
+        T splitCost = static_cast<T>(1) + (area > static_cast<T>(0) ? bestCost / area : static_cast<T>(n));
+
+        if (n <= bvhMaxLeafSize && static_cast<T>(n) <= splitCost)
+            return false;
+
+        T lo = centroidBounds.min[bestAxis];
+        T scale = static_cast<T>(bvhBinCount) / (centroidBounds.max[bestAxis] - lo);
+        std::uint32_t* it = std::partition(order + begin, order + end, [&](std::uint32_t i)
+        {
+            return std::min(static_cast<std::size_t>((centroids[i][bestAxis] - lo) * scale), bvhBinCount - 1) < bestBin;
+        });
+
+        mid = static_cast<std::size_t>(it - order);
+
+        if (mid == begin || mid == end)
+            mid = begin + n / 2;
+
+        return true;
+    }
+
+    // appends the subtree of [begin, end) to nodes, its root first
+    template<typename T>
+    void BVHBuilder<T>::build(std::size_t begin, std::size_t end, bool splittable, std::size_t mid, std::size_t threadCount, std::vector<Node>& nodes)
+    {
+        // collapse binary splits into up to 4 children, splitting the largest range first
+        Range ranges[BVH<T>::width] = {{begin, end, splittable, mid}};
+        std::size_t rangeCount = 1;
+
+        while (rangeCount < BVH<T>::width)
+        {
+            std::size_t best = rangeCount;
+
+            for (std::size_t i = 0; i < rangeCount; ++i)
+                if (ranges[i].splittable && (best == rangeCount || ranges[best].end - ranges[best].begin < ranges[i].end - ranges[i].begin))
+                    best = i;
+
+            if (best == rangeCount)
+                break;
+
+            Range r = ranges[best];
+            ranges[best] = {r.begin, r.mid, false, 0};
+            ranges[best].splittable = split(r.begin, r.mid, ranges[best].mid);
+            ranges[rangeCount] = {r.mid, r.end, false, 0};
+            ranges[rangeCount].splittable = split(r.mid, r.end, ranges[rangeCount].mid);
+            ++rangeCount;
+        }
+
+        std::size_t self = nodes.size();
+        nodes.emplace_back();
+
+        std::size_t innerCount = 0;
+
+        for (std::size_t s = 0; s < BVH<T>::width; ++s)
+        {
+            AABB<T, 3> box = s < rangeCount ? rangeBounds(ranges[s].begin, ranges[s].end) : AABB<T, 3>{};
+
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+                nodes[self].min[c][s] = box.min[c];
+                nodes[self].max[c][s] = box.max[c];
+            }
+
+            nodes[self].child[s] = BVH<T>::emptySlot;
+            nodes[self].count[s] = 0;
+
+            if (s < rangeCount && !ranges[s].splittable)
+            {
+                nodes[self].child[s] = static_cast<std::uint32_t>(ranges[s].begin);
+                nodes[self].count[s] = static_cast<std::uint32_t>(ranges[s].end - ranges[s].begin);
+            }
+
+            if (s < rangeCount && ranges[s].splittable)
+                ++innerCount;
+        }
+
+        // the large inner children are built as tasks of the global pool into separate arrays, then appended
+        std::size_t childThreads = innerCount ? std::max(threadCount / innerCount, static_cast<std::size_t>(1)) : 1;
+        std::vector<Node> subtrees[BVH<T>::width];
+        std::size_t parallel[BVH<T>::width];
+        std::size_t parallelCount = 0;
+
+        for (std::size_t s = 0; s < rangeCount; ++s)
+        {
+            const Range& r = ranges[s];
+
+            if (!r.splittable)
+                continue;
+
+            if (threadCount > 1 && r.end - r.begin >= bvhGrainSize)
+            {
+                parallel[parallelCount++] = s;
+            }
+            else
+            {
+                nodes[self].child[s] = static_cast<std::uint32_t>(nodes.size());
+                build(r.begin, r.end, true, r.mid, 1, nodes);
+            }
+        }
+
+        ThreadPool::global().parallelFor(parallelCount, 1, [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                const Range& r = ranges[parallel[i]];
+                build(r.begin, r.end, true, r.mid, childThreads, subtrees[parallel[i]]);
+            }
+        });
+
+        for (std::size_t s = 0; s < rangeCount; ++s)
+        {
+            if (subtrees[s].empty())
+                continue;
+
+            std::uint32_t offset = static_cast<std::uint32_t>(nodes.size());
+            nodes[self].child[s] = offset;
+
+            for (Node& node : subtrees[s])
+                for (std::size_t k = 0; k < BVH<T>::width; ++k)
+                    if (node.count[k] == 0 && node.child[k] != BVH<T>::emptySlot)
+                        node.child[k] += offset;
+
+            nodes.insert(nodes.end(), subtrees[s].begin(), subtrees[s].end());
+        }
+    }
+
+    inline NodeStack::NodeStack() :
+        top{0}
+    {
+    }
+
+    inline bool NodeStack::empty() const
+    {
+        return top == 0 && overflow.empty();
+    }
+
+    inline void NodeStack::push(std::uint32_t node)
+    {
+        if (top < localSize)
+            local[top++] = node;
+        else
+            overflow.push_back(node);
+    }
+
+    inline std::uint32_t NodeStack::pop()
+    {
+        if (overflow.empty())
+            return local[--top];
+
+        std::uint32_t node = overflow.back();
+        overflow.pop_back();
+
+        return node;
+    }
+}
+
+}
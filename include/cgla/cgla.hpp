@@ -3,7 +3,19 @@
 
 #include "config.hpp"
 #include "vector.hpp"
+#include "vector_array.hpp"
 #include "matrix.hpp"
+#include "factorization.hpp"
+#include "decomposition.hpp"
+#include "quaternion.hpp"
+#include "affine.hpp"
+#include "structured.hpp"
 #include "transform.hpp"
+#include "hierarchy.hpp"
+#include "skinning.hpp"
+#include "frustum.hpp"
+#include "bounds.hpp"
+#include "ray.hpp"
+#include "bvh.hpp"
 
 #endif
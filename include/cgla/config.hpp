@@ -13,4 +13,32 @@
 // define this to enable type aliases
 #define CGLA_TYPE_ALIASES
 
+// define this to evaluate element-wise Vector and Matrix arithmetic lazily with expression templates
+// #define CGLA_EXPRESSION_TEMPLATES
+
+// functions usable in constant expressions rely on C++14 relaxed constexpr rules
+#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+#define CGLA_CONSTEXPR constexpr
+#else
+#define CGLA_CONSTEXPR inline
+#endif
+
+// define this to enable SSE implementations of Matrix<float, 4, 4> operations
+// #define CGLA_SSE
+
+// the SSE implementations stay usable in constant expressions when the compiler can tell constant evaluation apart
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define CGLA_CONSTANT_EVALUATED
+#endif
+#elif (defined(__GNUC__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#define CGLA_CONSTANT_EVALUATED
+#endif
+
+#ifdef CGLA_CONSTANT_EVALUATED
+#define CGLA_SSE_CONSTEXPR CGLA_CONSTEXPR
+#else
+#define CGLA_SSE_CONSTEXPR inline
+#endif
+
 #endif
@@ -0,0 +1,28 @@
+#ifndef CGLA_DECOMPOSITION_HPP
+#define CGLA_DECOMPOSITION_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include "config.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+
+namespace cgla {
+
+// a = u * diag(sigma) * transpose(v) with u and v rotations, sigma sorted by decreasing magnitude and sigma[2] < 0 when a reflects
+template<typename T> void svd(const Matrix<T, 3, 3>& a, Matrix<T, 3, 3>& u, Vector<T, 3>& sigma, Matrix<T, 3, 3>& v);
+// s = vectors * diag(values) * transpose(vectors) for a symmetric s, with vectors a rotation and values sorted in decreasing order
+template<typename T> void symmetricEigen(const Matrix<T, 3, 3>& s, Matrix<T, 3, 3>& vectors, Vector<T, 3>& values);
+// a = r * s with r a rotation and s symmetric, s is indefinite when a reflects
+template<typename T> void polarDecomposition(const Matrix<T, 3, 3>& a, Matrix<T, 3, 3>& r, Matrix<T, 3, 3>& s);
+
+// decompose count matrices, several at a time side by side as structure of arrays
+template<typename T> void svd(const Matrix<T, 3, 3>* mats, Matrix<T, 3, 3>* u, Vector<T, 3>* sigma, Matrix<T, 3, 3>* v, std::size_t count, std::size_t threadCount = 1);
+template<typename T> void symmetricEigen(const Matrix<T, 3, 3>* mats, Matrix<T, 3, 3>* vectors, Vector<T, 3>* values, std::size_t count, std::size_t threadCount = 1);
+template<typename T> void polarDecomposition(const Matrix<T, 3, 3>* mats, Matrix<T, 3, 3>* r, Matrix<T, 3, 3>* s, std::size_t count, std::size_t threadCount = 1);
+
+}
+
+#include "decomposition.inl"
+
+#endif
@@ -0,0 +1,521 @@
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include "config.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "parallel.hpp"
+#ifdef CGLA_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace cgla {
+
+namespace detail {
+    // 3x3 decompositions after McAdams et al. : Jacobi sweeps of approximate Givens rotations, sorting and a Givens QR
+    // every step runs over K matrices stored as [row][column][lane] with selects instead of branches
+
+    constexpr std::size_t decompositionGrainSize = 1024;
+
+    // matrices decomposed side by side by the batched versions, four SSE registers per step for float
+    template<typename T> struct DecompositionLanes : std::integral_constant<std::size_t, sizeof(T) < 8 ? 16 : 8> {};
+
+    // the approximate rotations converge cubically, double needs a few more sweeps to reach its precision
+    template<typename T> struct JacobiSweeps : std::integral_constant<std::size_t, sizeof(T) < 8 ? 5 : 8> {};
+
+    // loads up to K matrices scaled by the inverse of their largest absolute entry, the missing lanes get the identity
+    template<typename T, std::size_t K>
+    inline void loadDecompositionLanes(const Matrix<T, 3, 3>* mats, std::size_t count, T (&a)[3][3][K], T (&scale)[K])
+    {
+        for (std::size_t l = 0; l < K; ++l)
+        {
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                for (std::size_t i = 0; i < 3; ++i)
+                    a[i][j][l] = l < count ? mats[l](i, j) : static_cast<T>(i == j ? 1 : 0);
+            }
+        }
+
+        for (std::size_t l = 0; l < K; ++l)
+        {
+            T m = static_cast<T>(0);
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                for (std::size_t j = 0; j < 3; ++j)
+                    m = std::abs(a[i][j][l]) > m ? std::abs(a[i][j][l]) : m;
+            }
+
+            // a zero matrix stays zero
+            scale[l] = m > static_cast<T>(0) ? m : static_cast<T>(1);
+            T inv = static_cast<T>(1) / scale[l];
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                for (std::size_t j = 0; j < 3; ++j)
+                    a[i][j][l] *= inv;
+            }
+        }
+    }
+
+    template<typename T, std::size_t K>
+    inline void storeDecompositionLanes(const T (&a)[3][3][K], std::size_t count, Matrix<T, 3, 3>* mats)
+    {
+        for (std::size_t l = 0; l < count; ++l)
+        {
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                for (std::size_t i = 0; i < 3; ++i)
+                    mats[l](i, j) = a[i][j][l];
+            }
+        }
+    }
+
+    template<typename T, std::size_t K>
+    inline void identityLanes(T (&a)[3][3][K])
+    {
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                for (std::size_t l = 0; l < K; ++l)
+                    a[i][j][l] = static_cast<T>(i == j ? 1 : 0);
+            }
+        }
+    }
+
+    // in place square roots and their reciprocals, kept apart from the arithmetic so that the lane loops around them
+    // stay vectorizable
+    template<typename T, std::size_t K>
+    inline void sqrtLanes(T (&x)[K])
+    {
+        for (std::size_t l = 0; l < K; ++l)
+            x[l] = std::sqrt(x[l]);
+    }
+
+    #ifdef CGLA_SSE
+    template<std::size_t K>
+    inline void sqrtLanes(float (&x)[K])
+    {
+        std::size_t l = 0;
+        for (; l + 4 <= K; l += 4)
+            _mm_storeu_ps(x + l, _mm_sqrt_ps(_mm_loadu_ps(x + l)));
+        for (; l < K; ++l)
+            x[l] = std::sqrt(x[l]);
+    }
+    #endif
+
+    template<typename T, std::size_t K>
+    inline void inverseSqrtLanes(T (&x)[K])
+    {
+        sqrtLanes(x);
+        for (std::size_t l = 0; l < K; ++l)
+            x[l] = static_cast<T>(1) / x[l];
+    }
+
+    // a <- a G in the plane (P, Q) for the rotations G of cosines c and sines sn
+    template<std::size_t P, std::size_t Q, typename T, std::size_t K>
+    inline void rotateLaneColumns(const T (&c)[K], const T (&sn)[K], T (&a)[3][3][K])
+    {
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            for (std::size_t l = 0; l < K; ++l)
+            {
+                T ap = a[i][P][l];
+                T aq = a[i][Q][l];
+                a[i][P][l] = c[l] * ap + sn[l] * aq;
+                a[i][Q][l] = c[l] * aq - sn[l] * ap;
+            }
+        }
+    }
+
+    // s <- G^T s G and v <- v G for an approximate Givens rotation G in the plane (P, Q) that reduces s(P, Q)
+    template<std::size_t P, std::size_t Q, typename T, std::size_t K>
+    inline void jacobiConjugate(T (&s)[3][3][K], T (&v)[3][3][K])
+    {
+        constexpr std::size_t R = 3 - P - Q;
+        const T gamma = static_cast<T>(5.82842712474619009760); // 3 + 2 * sqrt(2)
+        const T cosPi8 = static_cast<T>(0.92387953251128675613);
+        const T sinPi8 = static_cast<T>(0.38268343236508977173);
+        const T tiny = std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon();
+
+        // half angle of the rotation, clamped to pi / 8 when the approximation would overshoot. The choice is a blend
+        // by 0 or 1, exact for these finite values, as compilers completely unroll this short loop and turn selects
+        // into branches
+        T ch[K];
+        T sh[K];
+        T w[K];
+        for (std::size_t l = 0; l < K; ++l)
+        {
+            T h = static_cast<T>(2) * (s[P][P][l] - s[Q][Q][l]);
+            T g = s[P][Q][l];
+            T approximate = static_cast<T>(gamma * g * g < h * h);
+            h = approximate * h + (static_cast<T>(1) - approximate) * cosPi8;
+            g = approximate * g + (static_cast<T>(1) - approximate) * sinPi8;
+            ch[l] = h;
+            sh[l] = g;
+            w[l] = h * h + g * g;
+        }
+
+        inverseSqrtLanes(w);
+
+        T c[K];
+        T sn[K];
+        for (std::size_t l = 0; l < K; ++l)
+        {
+            T h = ch[l] * w[l];
+            T g = sh[l] * w[l];
+            c[l] = h * h - g * g;
+            sn[l] = static_cast<T>(2) * h * g;
+
+            T spp = s[P][P][l];
+            T sqq = s[Q][Q][l];
+            T spq = s[P][Q][l];
+            T spr = s[P][R][l];
+            T sqr = s[Q][R][l];
+            T cc = c[l] * c[l];
+            T ss = sn[l] * sn[l];
+            T cs = c[l] * sn[l];
+
+            // the off-diagonal entries converge to zero, flushing them before they turn denormal keeps the later
+            // sweeps at full speed
+            T pq = (cc - ss) * spq + cs * (sqq - spp);
+            T pr = c[l] * spr + sn[l] * sqr;
+            T qr = c[l] * sqr - sn[l] * spr;
+            pq = std::abs(pq) < tiny ? static_cast<T>(0) : pq;
+            pr = std::abs(pr) < tiny ? static_cast<T>(0) : pr;
+            qr = std::abs(qr) < tiny ? static_cast<T>(0) : qr;
+
+            s[P][P][l] = cc * spp + static_cast<T>(2) * cs * spq + ss * sqq;
+            s[Q][Q][l] = ss * spp - static_cast<T>(2) * cs * spq + cc * sqq;
+            s[P][Q][l] = s[Q][P][l] = pq;
+            s[P][R][l] = s[R][P][l] = pr;
+            s[Q][R][l] = s[R][Q][l] = qr;
+        }
+
+        rotateLaneColumns<P, Q>(c, sn, v);
+    }
+
+    // diagonalizes the symmetric s into its eigenvalues, v accumulates the eigenvectors as columns
+    template<typename T, std::size_t K>
+    inline void jacobiEigen(T (&s)[3][3][K], T (&v)[3][3][K])
+    {
+        identityLanes(v);
+
+        for (std::size_t sweep = 0; sweep < JacobiSweeps<T>::value; ++sweep)
+        {
+            jacobiConjugate<0, 1>(s, v);
+            jacobiConjugate<0, 2>(s, v);
+            jacobiConjugate<1, 2>(s, v);
+        }
+    }
+
+    // swaps the columns P and Q of a and b when key[P] < key[Q], negating one of them to keep the determinants
+    template<std::size_t P, std::size_t Q, typename T, std::size_t K>
+    inline void sortColumns(T (&key)[3][K], T (&a)[3][3][K], T (&b)[3][3][K])
+    {
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            for (std::size_t l = 0; l < K; ++l)
+            {
+                // the selects go through locals, selects stored directly are turned into branches
+                bool swap = key[P][l] < key[Q][l];
+                T ap = a[i][P][l];
+                T aq = a[i][Q][l];
+                T bp = b[i][P][l];
+                T bq = b[i][Q][l];
+                T ap2 = swap ? aq : ap;
+                T aq2 = swap ? -ap : aq;
+                T bp2 = swap ? bq : bp;
+                T bq2 = swap ? -bp : bq;
+                a[i][P][l] = ap2;
+                a[i][Q][l] = aq2;
+                b[i][P][l] = bp2;
+                b[i][Q][l] = bq2;
+            }
+        }
+
+        for (std::size_t l = 0; l < K; ++l)
+        {
+            T kp = key[P][l];
+            T kq = key[Q][l];
+            T kp2 = kp < kq ? kq : kp;
+            T kq2 = kp < kq ? kp : kq;
+            key[P][l] = kp2;
+            key[Q][l] = kq2;
+        }
+    }
+
+    // b <- G^T b and u <- u G for the Givens rotation G that zeroes b(Q, P) and leaves b(P, P) non-negative
+    template<std::size_t P, std::size_t Q, typename T, std::size_t K>
+    inline void givensReduce(T (&b)[3][3][K], T (&u)[3][3][K])
+    {
+        const T tiny = std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon();
+
+        T rho[K];
+        for (std::size_t l = 0; l < K; ++l)
+            rho[l] = b[P][P][l] * b[P][P][l] + b[Q][P][l] * b[Q][P][l];
+
+        sqrtLanes(rho);
+
+        // half angle of the rotation, computed without cancellation for a negative b(P, P) by swapping its sine and
+        // cosine
+        T ch[K];
+        T sh[K];
+        for (std::size_t l = 0; l < K; ++l)
+        {
+            T r = rho[l] > tiny ? rho[l] : tiny;
+            T g = rho[l] > tiny ? b[Q][P][l] : static_cast<T>(0);
+            ch[l] = std::abs(b[P][P][l]) + r;
+            sh[l] = g;
+        }
+
+        T w[K];
+        for (std::size_t l = 0; l < K; ++l)
+        {
+            bool negative = b[P][P][l] < static_cast<T>(0);
+            T h = ch[l];
+            T g = sh[l];
+            T h2 = negative ? g : h;
+            T g2 = negative ? h : g;
+            ch[l] = h2;
+            sh[l] = g2;
+            w[l] = h2 * h2 + g2 * g2;
+        }
+
+        inverseSqrtLanes(w);
+
+        T c[K];
+        T sn[K];
+        for (std::size_t l = 0; l < K; ++l)
+        {
+            T h = ch[l] * w[l];
+            T g = sh[l] * w[l];
+            c[l] = h * h - g * g;
+            sn[l] = static_cast<T>(2) * h * g;
+        }
+
+        // G^T b is b^T G transposed, the rows of b rotate like the columns of u
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            for (std::size_t l = 0; l < K; ++l)
+            {
+                T bp = b[P][j][l];
+                T bq = b[Q][j][l];
+                b[P][j][l] = c[l] * bp + sn[l] * bq;
+                b[Q][j][l] = c[l] * bq - sn[l] * bp;
+            }
+        }
+
+        rotateLaneColumns<P, Q>(c, sn, u);
+    }
+
+    // a = u * diag(sigma) * v^T of the K matrices of a, which must have been scaled to entries of at most 1 in magnitude
+    template<typename T, std::size_t K>
+    inline void svdLanes(const T (&a)[3][3][K], T (&u)[3][3][K], T (&sigma)[3][K], T (&v)[3][3][K])
+    {
+        // eigenvectors of a^T a are the right singular vectors
+        T s[3][3][K];
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                for (std::size_t l = 0; l < K; ++l)
+                    s[i][j][l] = a[0][i][l] * a[0][j][l] + a[1][i][l] * a[1][j][l] + a[2][i][l] * a[2][j][l];
+            }
+        }
+
+        jacobiEigen(s, v);
+
+        // b = a * v has orthogonal columns of the singular values as norms
+        T b[3][3][K];
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                for (std::size_t l = 0; l < K; ++l)
+                    b[i][j][l] = a[i][0][l] * v[0][j][l] + a[i][1][l] * v[1][j][l] + a[i][2][l] * v[2][j][l];
+            }
+        }
+
+        T norms[3][K];
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            for (std::size_t l = 0; l < K; ++l)
+                norms[j][l] = b[0][j][l] * b[0][j][l] + b[1][j][l] * b[1][j][l] + b[2][j][l] * b[2][j][l];
+        }
+
+        sortColumns<0, 1>(norms, b, v);
+        sortColumns<0, 2>(norms, b, v);
+        sortColumns<1, 2>(norms, b, v);
+
+        // b = u * r with r diagonal up to rounding, only r(2, 2) can be negative
+        identityLanes(u);
+        givensReduce<0, 1>(b, u);
+        givensReduce<0, 2>(b, u);
+        givensReduce<1, 2>(b, u);
+
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            for (std::size_t l = 0; l < K; ++l)
+                sigma[i][l] = b[i][i][l];
+        }
+    }
+
+    template<typename T, std::size_t K>
+    inline void svdLanes(const Matrix<T, 3, 3>* mats, std::size_t count, Matrix<T, 3, 3>* u, Vector<T, 3>* sigma, Matrix<T, 3, 3>* v)
+    {
+        T a[3][3][K];
+        T scale[K];
+        loadDecompositionLanes(mats, count, a, scale);
+
+        T ul[3][3][K];
+        T sl[3][K];
+        T vl[3][3][K];
+        svdLanes(a, ul, sl, vl);
+
+        storeDecompositionLanes(ul, count, u);
+        storeDecompositionLanes(vl, count, v);
+        for (std::size_t l = 0; l < count; ++l)
+        {
+            for (std::size_t i = 0; i < 3; ++i)
+                sigma[l][i] = sl[i][l] * scale[l];
+        }
+    }
+
+    template<typename T, std::size_t K>
+    inline void symmetricEigenLanes(const Matrix<T, 3, 3>* mats, std::size_t count, Matrix<T, 3, 3>* vectors, Vector<T, 3>* values)
+    {
+        T s[3][3][K];
+        T scale[K];
+        loadDecompositionLanes(mats, count, s, scale);
+
+        // only the symmetric part is decomposed
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            for (std::size_t j = i + 1; j < 3; ++j)
+            {
+                for (std::size_t l = 0; l < K; ++l)
+                    s[i][j][l] = s[j][i][l] = static_cast<T>(0.5) * (s[i][j][l] + s[j][i][l]);
+            }
+        }
+
+        T v[3][3][K];
+        jacobiEigen(s, v);
+
+        T d[3][K];
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            for (std::size_t l = 0; l < K; ++l)
+                d[i][l] = s[i][i][l];
+        }
+
+        // sortColumns permutes a second matrix along, the diagonal is reused as a scratch
+        sortColumns<0, 1>(d, v, s);
+        sortColumns<0, 2>(d, v, s);
+        sortColumns<1, 2>(d, v, s);
+
+        storeDecompositionLanes(v, count, vectors);
+        for (std::size_t l = 0; l < count; ++l)
+        {
+            for (std::size_t i = 0; i < 3; ++i)
+                values[l][i] = d[i][l] * scale[l];
+        }
+    }
+
+    template<typename T, std::size_t K>
+    inline void polarDecompositionLanes(const Matrix<T, 3, 3>* mats, std::size_t count, Matrix<T, 3, 3>* r, Matrix<T, 3, 3>* s)
+    {
+        T a[3][3][K];
+        T scale[K];
+        loadDecompositionLanes(mats, count, a, scale);
+
+        T u[3][3][K];
+        T sigma[3][K];
+        T v[3][3][K];
+        svdLanes(a, u, sigma, v);
+
+        // r = u * v^T and s = v * diag(sigma) * v^T
+        T rl[3][3][K];
+        T sl[3][3][K];
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                for (std::size_t l = 0; l < K; ++l)
+                {
+                    rl[i][j][l] = u[i][0][l] * v[j][0][l] + u[i][1][l] * v[j][1][l] + u[i][2][l] * v[j][2][l];
+                    sl[i][j][l] = (v[i][0][l] * sigma[0][l] * v[j][0][l] + v[i][1][l] * sigma[1][l] * v[j][1][l] +
+                                   v[i][2][l] * sigma[2][l] * v[j][2][l]) * scale[l];
+                }
+            }
+        }
+
+        storeDecompositionLanes(rl, count, r);
+        storeDecompositionLanes(sl, count, s);
+    }
+}
+
+template<typename T>
+void svd(const Matrix<T, 3, 3>& a, Matrix<T, 3, 3>& u, Vector<T, 3>& sigma, Matrix<T, 3, 3>& v)
+{
+    static_assert(std::is_floating_point<T>::value, "Argument T must be a floating point type");
+
+    detail::svdLanes<T, 1>(&a, 1, &u, &sigma, &v);
+}
+
+template<typename T>
+void symmetricEigen(const Matrix<T, 3, 3>& s, Matrix<T, 3, 3>& vectors, Vector<T, 3>& values)
+{
+    static_assert(std::is_floating_point<T>::value, "Argument T must be a floating point type");
+
+    detail::symmetricEigenLanes<T, 1>(&s, 1, &vectors, &values);
+}
+
+template<typename T>
+void polarDecomposition(const Matrix<T, 3, 3>& a, Matrix<T, 3, 3>& r, Matrix<T, 3, 3>& s)
+{
+    static_assert(std::is_floating_point<T>::value, "Argument T must be a floating point type");
+
+    detail::polarDecompositionLanes<T, 1>(&a, 1, &r, &s);
+}
+
+template<typename T>
+void svd(const Matrix<T, 3, 3>* mats, Matrix<T, 3, 3>* u, Vector<T, 3>* sigma, Matrix<T, 3, 3>* v, std::size_t count, std::size_t threadCount)
+{
+    static_assert(std::is_floating_point<T>::value, "Argument T must be a floating point type");
+    constexpr std::size_t K = detail::DecompositionLanes<T>::value;
+
+    detail::runChunked(count, threadCount, detail::decompositionGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; i += K)
+            detail::svdLanes<T, K>(mats + i, end - i < K ? end - i : K, u + i, sigma + i, v + i);
+    });
+}
+
+template<typename T>
+void symmetricEigen(const Matrix<T, 3, 3>* mats, Matrix<T, 3, 3>* vectors, Vector<T, 3>* values, std::size_t count, std::size_t threadCount)
+{
+    static_assert(std::is_floating_point<T>::value, "Argument T must be a floating point type");
+    constexpr std::size_t K = detail::DecompositionLanes<T>::value;
+
+    detail::runChunked(count, threadCount, detail::decompositionGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; i += K)
+            detail::symmetricEigenLanes<T, K>(mats + i, end - i < K ? end - i : K, vectors + i, values + i);
+    });
+}
+
+template<typename T>
+void polarDecomposition(const Matrix<T, 3, 3>* mats, Matrix<T, 3, 3>* r, Matrix<T, 3, 3>* s, std::size_t count, std::size_t threadCount)
+{
+    static_assert(std::is_floating_point<T>::value, "Argument T must be a floating point type");
+    constexpr std::size_t K = detail::DecompositionLanes<T>::value;
+
+    detail::runChunked(count, threadCount, detail::decompositionGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; i += K)
+            detail::polarDecompositionLanes<T, K>(mats + i, end - i < K ? end - i : K, r + i, s + i);
+    });
+}
+
+}
@@ -0,0 +1,144 @@
+#ifndef CGLA_EXPRESSION_HPP
+#define CGLA_EXPRESSION_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "config.hpp"
+#include "vector.hpp"
+
+namespace cgla {
+
+namespace detail {
+    // ExpressionTraits<E> describes the operands of element-wise expressions :
+    // Vector<T, N>, Matrix<T, M, N> and Expression<Op, L, R, Result>
+    template<typename E, typename = void> struct ExpressionTraits {};
+    template<typename L, typename R, typename = void> struct CommonResult {};
+    template<typename L, typename R, typename = void> struct CommonVectorResult {};
+    template<typename E, typename U, typename = void> struct ScalarResult {};
+    template<typename E, typename U, typename = void> struct ScalarVectorResult {};
+    template<typename E> struct Operand { using type = const E&; };
+    template<typename E> struct IsExpression : std::false_type {};
+    template<typename E, typename = void> struct IsVectorOperand : std::false_type {};
+    template<typename E, typename = void> struct IsMatrixOperand : std::false_type {};
+
+    template<typename U> class Scalar;
+    template<typename Op, typename L, typename R, typename Result> class Expression;
+
+    struct Add;
+    struct Subtract;
+    struct Multiply;
+    struct Divide;
+}
+
+template<typename L, typename R, typename Result = typename detail::CommonResult<L, R>::type> CGLA_CONSTEXPR detail::Expression<detail::Add, L, R, Result> operator+(const L& lhs, const R& rhs);
+template<typename L, typename R, typename Result = typename detail::CommonResult<L, R>::type> CGLA_CONSTEXPR detail::Expression<detail::Subtract, L, R, Result> operator-(const L& lhs, const R& rhs);
+template<typename E, typename Result = typename detail::ScalarResult<E, int>::type> CGLA_CONSTEXPR detail::Expression<detail::Multiply, E, detail::Scalar<int>, Result> operator-(const E& rhs);
+template<typename L, typename U, typename Result = typename detail::ScalarResult<L, U>::type> CGLA_CONSTEXPR detail::Expression<detail::Multiply, L, detail::Scalar<U>, Result> operator*(const L& lhs, U rhs);
+template<typename U, typename R, typename Result = typename detail::ScalarResult<R, U>::type> CGLA_CONSTEXPR detail::Expression<detail::Multiply, R, detail::Scalar<U>, Result> operator*(U lhs, const R& rhs);
+template<typename L, typename R, typename Result = typename detail::CommonVectorResult<L, R>::type> CGLA_CONSTEXPR detail::Expression<detail::Multiply, L, R, Result> operator*(const L& lhs, const R& rhs);
+template<typename L, typename U, typename Result = typename detail::ScalarResult<L, U>::type> CGLA_CONSTEXPR detail::Expression<detail::Divide, L, detail::Scalar<U>, Result> operator/(const L& lhs, U rhs);
+template<typename U, typename R, typename Result = typename detail::ScalarVectorResult<R, U>::type> CGLA_CONSTEXPR detail::Expression<detail::Divide, detail::Scalar<U>, R, Result> operator/(U lhs, const R& rhs);
+template<typename L, typename R, typename Result = typename detail::CommonVectorResult<L, R>::type> CGLA_CONSTEXPR detail::Expression<detail::Divide, L, R, Result> operator/(const L& lhs, const R& rhs);
+
+template<typename Op, typename L, typename R, typename Result> CGLA_CONSTEXPR Result eval(const detail::Expression<Op, L, R, Result>& e);
+
+namespace detail {
+    template<typename U>
+    class Scalar
+    {
+        public:
+            CGLA_CONSTEXPR explicit Scalar(U v);
+
+            CGLA_CONSTEXPR U operator[](std::size_t i) const;
+
+        private:
+            U value;
+    };
+
+    template<typename Op, typename L, typename R, typename Result>
+    class Expression
+    {
+        using T = typename ExpressionTraits<Result>::value_type;
+
+        public:
+            CGLA_CONSTEXPR Expression(const L& lhs, const R& rhs);
+
+            CGLA_CONSTEXPR T operator[](std::size_t i) const;
+
+        private:
+            typename Operand<L>::type lhs;
+            typename Operand<R>::type rhs;
+    };
+
+    template<typename T, std::size_t N>
+    struct ExpressionTraits<Vector<T, N>>
+    {
+        using result_type = Vector<T, N>;
+        using value_type = T;
+        static constexpr std::size_t size = N;
+        static constexpr bool vector = true;
+    };
+
+    template<typename Op, typename L, typename R, typename Result>
+    struct ExpressionTraits<Expression<Op, L, R, Result>> : ExpressionTraits<Result> {};
+
+    template<typename Op, typename L, typename R, typename Result>
+    struct IsExpression<Expression<Op, L, R, Result>> : std::true_type {};
+
+    template<typename E>
+    struct IsVectorOperand<E, typename std::enable_if<ExpressionTraits<E>::vector>::type> : std::true_type {};
+
+    template<typename E>
+    struct IsMatrixOperand<E, typename std::enable_if<!ExpressionTraits<E>::vector>::type> : std::true_type {};
+
+    // leaves are held by reference, nested expressions and scalars by value
+    template<typename U>
+    struct Operand<Scalar<U>>
+    {
+        using type = Scalar<U>;
+    };
+
+    template<typename Op, typename L, typename R, typename Result>
+    struct Operand<Expression<Op, L, R, Result>>
+    {
+        using type = Expression<Op, L, R, Result>;
+    };
+
+    template<typename L, typename R>
+    struct CommonResult<L, R, typename std::enable_if<std::is_same<typename ExpressionTraits<L>::result_type, typename ExpressionTraits<R>::result_type>::value>::type>
+    {
+        using type = typename ExpressionTraits<L>::result_type;
+    };
+
+    template<typename L, typename R>
+    struct CommonVectorResult<L, R, typename std::enable_if<std::is_same<typename ExpressionTraits<L>::result_type, typename ExpressionTraits<R>::result_type>::value && ExpressionTraits<L>::vector>::type>
+    {
+        using type = typename ExpressionTraits<L>::result_type;
+    };
+
+    template<typename E, typename U>
+    struct ScalarResult<E, U, typename std::enable_if<std::is_arithmetic<U>::value && (ExpressionTraits<E>::size > 0)>::type>
+    {
+        using type = typename ExpressionTraits<E>::result_type;
+    };
+
+    template<typename E, typename U>
+    struct ScalarVectorResult<E, U, typename std::enable_if<std::is_arithmetic<U>::value && ExpressionTraits<E>::vector>::type>
+    {
+        using type = typename ExpressionTraits<E>::result_type;
+    };
+
+    // whether one of the arguments of a function is an expression, which selects the overload evaluating it
+    template<>
+    struct AnyExpression<> : std::false_type {};
+
+    template<typename E, typename... Rest>
+    struct AnyExpression<E, Rest...> : std::integral_constant<bool, IsExpression<E>::value || AnyExpression<Rest...>::value> {};
+}
+
+}
+
+#include "expression.inl"
+
+#endif
@@ -0,0 +1,143 @@
+#include <cstddef>
+#include "config.hpp"
+#include "vector.hpp"
+
+namespace cgla {
+
+namespace detail {
+    struct Add
+    {
+        template<typename A, typename B>
+        static constexpr auto apply(A a, B b) -> decltype(a + b)
+        {
+            return a + b;
+        }
+    };
+
+    struct Subtract
+    {
+        template<typename A, typename B>
+        static constexpr auto apply(A a, B b) -> decltype(a - b)
+        {
+            return a - b;
+        }
+    };
+
+    struct Multiply
+    {
+        template<typename A, typename B>
+        static constexpr auto apply(A a, B b) -> decltype(a * b)
+        {
+            return a * b;
+        }
+    };
+
+    struct Divide
+    {
+        template<typename A, typename B>
+        static constexpr auto apply(A a, B b) -> decltype(a / b)
+        {
+            return a / b;
+        }
+    };
+
+    template<typename U>
+    CGLA_CONSTEXPR Scalar<U>::Scalar(U v) :
+        value{v}
+    {
+    }
+
+    template<typename U>
+    CGLA_CONSTEXPR U Scalar<U>::operator[](std::size_t) const
+    {
+        return value;
+    }
+
+    // arguments that are not expressions are passed through
+    template<typename E>
+    CGLA_CONSTEXPR const E& evaluate(const E& e)
+    {
+        return e;
+    }
+
+    template<typename Op, typename L, typename R, typename Result>
+    CGLA_CONSTEXPR Result evaluate(const Expression<Op, L, R, Result>& e)
+    {
+        return Result(e);
+    }
+
+    template<typename Op, typename L, typename R, typename Result>
+    CGLA_CONSTEXPR Expression<Op, L, R, Result>::Expression(const L& lhs, const R& rhs) :
+        lhs(lhs),
+        rhs(rhs)
+    {
+    }
+
+    template<typename Op, typename L, typename R, typename Result>
+    CGLA_CONSTEXPR typename ExpressionTraits<Result>::value_type Expression<Op, L, R, Result>::operator[](std::size_t i) const
+    {
+        return static_cast<T>(Op::apply(lhs[i], rhs[i]));
+    }
+}
+
+template<typename L, typename R, typename Result>
+CGLA_CONSTEXPR detail::Expression<detail::Add, L, R, Result> operator+(const L& lhs, const R& rhs)
+{
+    return {lhs, rhs};
+}
+
+template<typename L, typename R, typename Result>
+CGLA_CONSTEXPR detail::Expression<detail::Subtract, L, R, Result> operator-(const L& lhs, const R& rhs)
+{
+    return {lhs, rhs};
+}
+
+template<typename E, typename Result>
+CGLA_CONSTEXPR detail::Expression<detail::Multiply, E, detail::Scalar<int>, Result> operator-(const E& rhs)
+{
+    return {rhs, detail::Scalar<int>{-1}};
+}
+
+template<typename L, typename U, typename Result>
+CGLA_CONSTEXPR detail::Expression<detail::Multiply, L, detail::Scalar<U>, Result> operator*(const L& lhs, U rhs)
+{
+    return {lhs, detail::Scalar<U>{rhs}};
+}
+
+template<typename U, typename R, typename Result>
+CGLA_CONSTEXPR detail::Expression<detail::Multiply, R, detail::Scalar<U>, Result> operator*(U lhs, const R& rhs)
+{
+    return {rhs, detail::Scalar<U>{lhs}};
+}
+
+template<typename L, typename R, typename Result>
+CGLA_CONSTEXPR detail::Expression<detail::Multiply, L, R, Result> operator*(const L& lhs, const R& rhs)
+{
+    return {lhs, rhs};
+}
+
+template<typename L, typename U, typename Result>
+CGLA_CONSTEXPR detail::Expression<detail::Divide, L, detail::Scalar<U>, Result> operator/(const L& lhs, U rhs)
+{
+    return {lhs, detail::Scalar<U>{rhs}};
+}
+
+template<typename U, typename R, typename Result>
+CGLA_CONSTEXPR detail::Expression<detail::Divide, detail::Scalar<U>, R, Result> operator/(U lhs, const R& rhs)
+{
+    return {detail::Scalar<U>{lhs}, rhs};
+}
+
+template<typename L, typename R, typename Result>
+CGLA_CONSTEXPR detail::Expression<detail::Divide, L, R, Result> operator/(const L& lhs, const R& rhs)
+{
+    return {lhs, rhs};
+}
+
+template<typename Op, typename L, typename R, typename Result>
+CGLA_CONSTEXPR Result eval(const detail::Expression<Op, L, R, Result>& e)
+{
+    return Result(e);
+}
+
+}
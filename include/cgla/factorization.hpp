@@ -0,0 +1,108 @@
+#ifndef CGLA_FACTORIZATION_HPP
+#define CGLA_FACTORIZATION_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include "config.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+
+namespace cgla {
+
+// PA = LU with partial pivoting, L unit lower triangular, U upper triangular
+template<typename T, std::size_t M>
+class LU
+{
+    static_assert(std::is_floating_point<T>::value, "Argument T must be a floating point type");
+
+    public:
+        explicit LU(const Matrix<T, M, M>& mat);
+
+        bool invertible() const;
+        T determinant() const;
+        T rcond() const; // estimate of the reciprocal condition number in the 1-norm, 0 for a singular matrix
+
+        // the solutions are meaningless when the matrix is not invertible
+        Vector<T, M> solve(const Vector<T, M>& b) const;
+        template<std::size_t N> Matrix<T, M, N> solve(const Matrix<T, M, N>& b) const;
+        Matrix<T, M, M> inverse() const;
+
+    private:
+        Matrix<T, M, M> lu;
+        std::size_t pivots[M];
+        T inverseDiagonal[M]; // of U
+        T norm; // 1-norm of the factored matrix
+        bool regular;
+};
+
+// A = LL^T of a symmetric positive definite matrix, L lower triangular (only the lower triangle of A is read)
+template<typename T, std::size_t M>
+class Cholesky
+{
+    static_assert(std::is_floating_point<T>::value, "Argument T must be a floating point type");
+
+    public:
+        explicit Cholesky(const Matrix<T, M, M>& mat);
+
+        bool positiveDefinite() const;
+        T rcond() const; // estimate of the reciprocal condition number in the 1-norm, 0 when the matrix is not positive definite
+        Matrix<T, M, M> matrixL() const;
+
+        // the determinant and solutions are meaningless when the matrix is not positive definite
+        T determinant() const;
+        Vector<T, M> solve(const Vector<T, M>& b) const;
+        template<std::size_t N> Matrix<T, M, N> solve(const Matrix<T, M, N>& b) const;
+        Matrix<T, M, M> inverse() const;
+
+    private:
+        Matrix<T, M, M> l;
+        T inverseDiagonal[M];
+        T norm;
+        bool definite;
+};
+
+// AP = QR with Householder reflections and column pivoting, for M >= N
+template<typename T, std::size_t M, std::size_t N>
+class QR
+{
+    static_assert(std::is_floating_point<T>::value, "Argument T must be a floating point type");
+    static_assert(M >= N, "Argument M must be greater than or equal to N");
+
+    public:
+        explicit QR(const Matrix<T, M, N>& mat);
+
+        std::size_t rank() const; // diagonal entries of R below M * epsilon * |R(0, 0)| are treated as zero
+        T rcond() const; // ratio of the smallest to the largest diagonal entry of R, an estimate of the reciprocal condition number in the 2-norm
+        template<std::size_t P = M, typename = typename std::enable_if<P == N>::type> T determinant() const;
+        Matrix<T, M, M> matrixQ() const;
+        Matrix<T, M, N> matrixR() const; // R of the permuted matrix AP
+        std::size_t permutation(std::size_t i) const; // column of A at column i of AP
+
+        // least squares solutions, with zeros for the unknowns of the dropped columns when the matrix is rank deficient
+        Vector<T, N> solve(const Vector<T, M>& b) const;
+        template<std::size_t K> Matrix<T, N, K> solve(const Matrix<T, M, K>& b) const;
+
+    private:
+        Matrix<T, M, N> qr; // R on and above the diagonal, the Householder vectors below
+        T tau[N];
+        std::size_t columns[N];
+        std::size_t independent;
+        bool odd; // odd number of reflections and column swaps
+};
+
+// solve count systems mats[i] * res[i] = rhs[i], singular (or not positive definite) systems get a zero solution and make the result false
+template<typename T, std::size_t M> bool solveLU(const Matrix<T, M, M>* mats, const Vector<T, M>* rhs, Vector<T, M>* res, std::size_t count, std::size_t threadCount = 1);
+template<typename T, std::size_t M> bool solveCholesky(const Matrix<T, M, M>* mats, const Vector<T, M>* rhs, Vector<T, M>* res, std::size_t count, std::size_t threadCount = 1);
+
+#ifdef CGLA_TYPE_ALIASES
+using LU2f = LU<float, 2>; using LU3f = LU<float, 3>; using LU4f = LU<float, 4>;
+using LU2d = LU<double, 2>; using LU3d = LU<double, 3>; using LU4d = LU<double, 4>;
+using Cholesky2f = Cholesky<float, 2>; using Cholesky3f = Cholesky<float, 3>; using Cholesky4f = Cholesky<float, 4>;
+using Cholesky2d = Cholesky<double, 2>; using Cholesky3d = Cholesky<double, 3>; using Cholesky4d = Cholesky<double, 4>;
+#endif
+
+}
+
+#include "factorization.inl"
+
+#endif
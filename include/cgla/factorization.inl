@@ -0,0 +1,780 @@
+#include <atomic>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include "config.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "parallel.hpp"
+
+namespace cgla {
+
+namespace detail {
+    // minimum number of systems given to a thread by the batched solvers
+    constexpr std::size_t factorizationGrainSize = 1024;
+
+    template<typename T, std::size_t M>
+    inline T norm1(const Matrix<T, M, M>& mat)
+    {
+        T res = static_cast<T>(0);
+
+        for (std::size_t j = 0; j < M; ++j)
+        {
+            T sum = static_cast<T>(0);
+            for (std::size_t i = 0; i < M; ++i)
+                sum += std::abs(mat(i, j));
+            res = res < sum ? sum : res;
+        }
+
+        return res;
+    }
+
+    // solves A x = b in place of b given the factorization of A computed by luFactor and the reciprocals of the diagonal of U
+    template<typename T, std::size_t M>
+    inline void luSolveColumn(const T* a, const std::size_t* pivots, const T* inverseDiagonal, T* x)
+    {
+        for (std::size_t i = 0; i < M; ++i)
+            if (pivots[i] != i)
+                std::swap(x[i], x[pivots[i]]);
+
+        for (std::size_t j = 0; j < M; ++j)
+        {
+            T s = x[j];
+            for (std::size_t i = j + 1; i < M; ++i)
+                x[i] -= a[j * M + i] * s;
+        }
+
+        for (std::size_t j = M; j-- > 0;)
+        {
+            x[j] *= inverseDiagonal[j];
+            T s = x[j];
+            for (std::size_t i = 0; i < j; ++i)
+                x[i] -= a[j * M + i] * s;
+        }
+    }
+
+    // solves A^T x = b in place of b, with A^T = U^T L^T P
+    template<typename T, std::size_t M>
+    inline void luSolveTransposeColumn(const T* a, const std::size_t* pivots, const T* inverseDiagonal, T* x)
+    {
+        for (std::size_t j = 0; j < M; ++j)
+        {
+            T s = x[j];
+            for (std::size_t i = 0; i < j; ++i)
+                s -= a[j * M + i] * x[i];
+            x[j] = s * inverseDiagonal[j];
+        }
+
+        for (std::size_t j = M; j-- > 0;)
+        {
+            T s = x[j];
+            for (std::size_t i = j + 1; i < M; ++i)
+                s -= a[j * M + i] * x[i];
+            x[j] = s;
+        }
+
+        for (std::size_t i = M; i-- > 0;)
+            if (pivots[i] != i)
+                std::swap(x[i], x[pivots[i]]);
+    }
+
+    // in-place factorization of the lower triangle, column by column so that the inner loops run down contiguous columns
+    // the reciprocals of the diagonal of L are kept so that the solves do not divide
+    template<typename T, std::size_t M>
+    inline bool choleskyFactor(Matrix<T, M, M>& mat, T* inverseDiagonal)
+    {
+        T* a = mat.data();
+
+        for (std::size_t j = 0; j < M; ++j)
+        {
+            T* col = a + j * M;
+
+            for (std::size_t k = 0; k < j; ++k)
+            {
+                T s = a[k * M + j];
+                for (std::size_t i = j; i < M; ++i)
+                    col[i] -= a[k * M + i] * s;
+            }
+
+            if (!(col[j] > static_cast<T>(0)))
+                return false;
+
+            col[j] = std::sqrt(col[j]);
+            T inv = static_cast<T>(1) / col[j];
+            inverseDiagonal[j] = inv;
+            for (std::size_t i = j + 1; i < M; ++i)
+                col[i] *= inv;
+        }
+
+        return true;
+    }
+
+    // solves LL^T x = b in place of b
+    template<typename T, std::size_t M>
+    inline void choleskySolveColumn(const T* l, const T* inverseDiagonal, T* x)
+    {
+        for (std::size_t j = 0; j < M; ++j)
+        {
+            x[j] *= inverseDiagonal[j];
+            T s = x[j];
+            for (std::size_t i = j + 1; i < M; ++i)
+                x[i] -= l[j * M + i] * s;
+        }
+
+        for (std::size_t j = M; j-- > 0;)
+        {
+            T s = x[j];
+            for (std::size_t i = j + 1; i < M; ++i)
+                s -= l[j * M + i] * x[i];
+            x[j] = s * inverseDiagonal[j];
+        }
+    }
+
+    // applies Q^T to b and solves the leading rank x rank block of R, x receives the solution of the unpermuted system
+    template<typename T, std::size_t M, std::size_t N>
+    inline void qrSolveColumn(const T* a, const T* tau, const std::size_t* columns, std::size_t rank, T* b, T* x)
+    {
+        for (std::size_t k = 0; k < N; ++k)
+        {
+            if (tau[k] == static_cast<T>(0))
+                continue;
+
+            const T* v = a + k * M;
+            T w = b[k];
+            for (std::size_t i = k + 1; i < M; ++i)
+                w += v[i] * b[i];
+            w *= tau[k];
+            b[k] -= w;
+            for (std::size_t i = k + 1; i < M; ++i)
+                b[i] -= w * v[i];
+        }
+
+        for (std::size_t j = rank; j-- > 0;)
+        {
+            b[j] /= a[j * M + j];
+            T s = b[j];
+            for (std::size_t i = 0; i < j; ++i)
+                b[i] -= a[j * M + i] * s;
+        }
+
+        for (std::size_t k = 0; k < N; ++k)
+            x[columns[k]] = k < rank ? b[k] : static_cast<T>(0);
+    }
+
+    // Hager's estimate of the 1-norm of A^-1, from a few solves with A and A^T
+    template<typename T, std::size_t M, typename Solve, typename SolveTranspose>
+    inline T inverseNorm1(const Solve& solve, const SolveTranspose& solveTranspose)
+    {
+        Vector<T, M> x;
+        for (std::size_t i = 0; i < M; ++i)
+            x[i] = static_cast<T>(1) / static_cast<T>(M);
+
+        T res = static_cast<T>(0);
+
+        for (std::size_t iteration = 0; iteration < 5; ++iteration)
+        {
+            Vector<T, M> y{x};
+            solve(y.data());
+
+            T norm = static_cast<T>(0);
+            for (std::size_t i = 0; i < M; ++i)
+                norm += std::abs(y[i]);
+            if (iteration > 0 && norm <= res)
+                break;
+            res = norm;
+
+            Vector<T, M> z;
+            for (std::size_t i = 0; i < M; ++i)
+                z[i] = y[i] < static_cast<T>(0) ? static_cast<T>(-1) : static_cast<T>(1);
+            solveTranspose(z.data());
+
+            std::size_t j = 0;
+            for (std::size_t i = 1; i < M; ++i)
+                if (std::abs(z[i]) > std::abs(z[j]))
+                    j = i;
+
+            if (iteration > 0 && std::abs(z[j]) <= dot(z, x))
+                break;
+
+            x = Vector<T, M>{};
+            x[j] = static_cast<T>(1);
+        }
+
+        return res;
+    }
+
+    // systems solved side by side by the batched solvers, one per lane of structure of arrays so that every step is
+    // vectorized across systems and the pivoting is branchless
+    constexpr std::size_t solveLanes = 8;
+
+    // loads up to solveLanes systems as [row][column][lane], the missing lanes get the identity
+    template<typename T, std::size_t M>
+    inline void loadLanes(const Matrix<T, M, M>* mats, const Vector<T, M>* rhs, std::size_t count, T (&a)[M][M][solveLanes], T (&x)[M][solveLanes])
+    {
+        for (std::size_t l = 0; l < solveLanes; ++l)
+        {
+            for (std::size_t j = 0; j < M; ++j)
+            {
+                for (std::size_t i = 0; i < M; ++i)
+                    a[i][j][l] = l < count ? mats[l](i, j) : static_cast<T>(i == j ? 1 : 0);
+                x[j][l] = l < count ? rhs[l][j] : static_cast<T>(0);
+            }
+        }
+    }
+
+    // stores the solutions of the lanes that did not fail, zeros otherwise, and returns false if any lane failed
+    template<typename T, std::size_t M>
+    inline bool storeLanes(const T (&x)[M][solveLanes], const T (&failed)[solveLanes], std::size_t count, Vector<T, M>* res)
+    {
+        bool solved = true;
+
+        for (std::size_t l = 0; l < count; ++l)
+        {
+            bool fail = failed[l] != static_cast<T>(0);
+            for (std::size_t i = 0; i < M; ++i)
+                res[l][i] = fail ? static_cast<T>(0) : x[i][l];
+            solved = solved && !fail;
+        }
+
+        return solved;
+    }
+
+    // Gaussian elimination with partial pivoting of [A | b], the factorization of luFactor fused with the solve
+    template<typename T, std::size_t M>
+    inline bool gaussSolveLanes(const Matrix<T, M, M>* mats, const Vector<T, M>* rhs, std::size_t count, Vector<T, M>* res)
+    {
+        constexpr std::size_t K = solveLanes;
+        T a[M][M][K];
+        T x[M][K];
+        T inverseDiagonal[M][K];
+        T failed[K] = {};
+        loadLanes(mats, rhs, count, a, x);
+
+        for (std::size_t j = 0; j < M; ++j)
+        {
+            T pivot[K];
+            T pval[K];
+            for (std::size_t l = 0; l < K; ++l)
+            {
+                pivot[l] = static_cast<T>(j);
+                pval[l] = std::abs(a[j][j][l]);
+            }
+
+            for (std::size_t r = j + 1; r < M; ++r)
+            {
+                for (std::size_t l = 0; l < K; ++l)
+                {
+                    T val = std::abs(a[r][j][l]);
+                    pivot[l] = val > pval[l] ? static_cast<T>(r) : pivot[l];
+                    pval[l] = val > pval[l] ? val : pval[l];
+                }
+            }
+
+            for (std::size_t r = j + 1; r < M; ++r)
+            {
+                for (std::size_t l = 0; l < K; ++l)
+                {
+                    bool swap = pivot[l] == static_cast<T>(r);
+                    for (std::size_t c = j; c < M; ++c)
+                    {
+                        T u = a[j][c][l];
+                        T v = a[r][c][l];
+                        a[j][c][l] = swap ? v : u;
+                        a[r][c][l] = swap ? u : v;
+                    }
+                    T u = x[j][l];
+                    T v = x[r][l];
+                    x[j][l] = swap ? v : u;
+                    x[r][l] = swap ? u : v;
+                }
+            }
+
+            // a failed lane continues on a unit pivot so that no lane divides by zero
+            for (std::size_t l = 0; l < K; ++l)
+            {
+                bool singular = pval[l] == static_cast<T>(0);
+                failed[l] = singular ? static_cast<T>(1) : failed[l];
+                inverseDiagonal[j][l] = static_cast<T>(1) / (singular ? static_cast<T>(1) : a[j][j][l]);
+            }
+
+            for (std::size_t r = j + 1; r < M; ++r)
+            {
+                for (std::size_t l = 0; l < K; ++l)
+                {
+                    T f = a[r][j][l] * inverseDiagonal[j][l];
+                    for (std::size_t c = j + 1; c < M; ++c)
+                        a[r][c][l] -= f * a[j][c][l];
+                    x[r][l] -= f * x[j][l];
+                }
+            }
+        }
+
+        for (std::size_t j = M; j-- > 0;)
+        {
+            for (std::size_t l = 0; l < K; ++l)
+            {
+                T s = x[j][l];
+                for (std::size_t c = j + 1; c < M; ++c)
+                    s -= a[j][c][l] * x[c][l];
+                x[j][l] = s * inverseDiagonal[j][l];
+            }
+        }
+
+        return storeLanes(x, failed, count, res);
+    }
+
+    // Cholesky factorization of the lower triangles fused with the solve
+    template<typename T, std::size_t M>
+    inline bool choleskySolveLanes(const Matrix<T, M, M>* mats, const Vector<T, M>* rhs, std::size_t count, Vector<T, M>* res)
+    {
+        constexpr std::size_t K = solveLanes;
+        T a[M][M][K];
+        T x[M][K];
+        T inverseDiagonal[M][K];
+        T failed[K] = {};
+        loadLanes(mats, rhs, count, a, x);
+
+        for (std::size_t j = 0; j < M; ++j)
+        {
+            for (std::size_t l = 0; l < K; ++l)
+            {
+                T d = a[j][j][l];
+                for (std::size_t k = 0; k < j; ++k)
+                    d -= a[j][k][l] * a[j][k][l];
+
+                // a failed lane continues on a unit diagonal so that no lane takes the root of a negative number
+                bool indefinite = !(d > static_cast<T>(0));
+                failed[l] = indefinite ? static_cast<T>(1) : failed[l];
+                inverseDiagonal[j][l] = static_cast<T>(1) / std::sqrt(indefinite ? static_cast<T>(1) : d);
+            }
+
+            for (std::size_t i = j + 1; i < M; ++i)
+            {
+                for (std::size_t l = 0; l < K; ++l)
+                {
+                    T s = a[i][j][l];
+                    for (std::size_t k = 0; k < j; ++k)
+                        s -= a[i][k][l] * a[j][k][l];
+                    a[i][j][l] = s * inverseDiagonal[j][l];
+                }
+            }
+        }
+
+        for (std::size_t j = 0; j < M; ++j)
+        {
+            for (std::size_t l = 0; l < K; ++l)
+            {
+                T s = x[j][l];
+                for (std::size_t k = 0; k < j; ++k)
+                    s -= a[j][k][l] * x[k][l];
+                x[j][l] = s * inverseDiagonal[j][l];
+            }
+        }
+
+        for (std::size_t j = M; j-- > 0;)
+        {
+            for (std::size_t l = 0; l < K; ++l)
+            {
+                T s = x[j][l];
+                for (std::size_t i = j + 1; i < M; ++i)
+                    s -= a[i][j][l] * x[i][l];
+                x[j][l] = s * inverseDiagonal[j][l];
+            }
+        }
+
+        return storeLanes(x, failed, count, res);
+    }
+}
+
+template<typename T, std::size_t M>
+inline LU<T, M>::LU(const Matrix<T, M, M>& mat) :
+    lu{mat},
+    norm{detail::norm1(mat)}
+{
+    regular = detail::luFactor(lu, pivots);
+
+    for (std::size_t j = 0; j < M; ++j)
+        inverseDiagonal[j] = static_cast<T>(1) / lu(j, j);
+}
+
+template<typename T, std::size_t M>
+inline bool LU<T, M>::invertible() const
+{
+    return regular;
+}
+
+template<typename T, std::size_t M>
+inline T LU<T, M>::determinant() const
+{
+    if (!regular)
+        return static_cast<T>(0);
+
+    T det = static_cast<T>(1);
+    for (std::size_t j = 0; j < M; ++j)
+        det *= (pivots[j] != j) ? -lu(j, j) : lu(j, j);
+
+    return det;
+}
+
+template<typename T, std::size_t M>
+inline T LU<T, M>::rcond() const
+{
+    if (!regular || norm == static_cast<T>(0))
+        return static_cast<T>(0);
+
+    const T* a = lu.data();
+    const std::size_t* p = pivots;
+    const T* d = inverseDiagonal;
+    T inverseNorm = detail::inverseNorm1<T, M>([a, p, d](T* x) { detail::luSolveColumn<T, M>(a, p, d, x); },
+                                               [a, p, d](T* x) { detail::luSolveTransposeColumn<T, M>(a, p, d, x); });
+
+    return static_cast<T>(1) / (norm * inverseNorm);
+}
+
+template<typename T, std::size_t M>
+inline Vector<T, M> LU<T, M>::solve(const Vector<T, M>& b) const
+{
+    Vector<T, M> x{b};
+    detail::luSolveColumn<T, M>(lu.data(), pivots, inverseDiagonal, x.data());
+
+    return x;
+}
+
+template<typename T, std::size_t M>
+template<std::size_t N>
+inline Matrix<T, M, N> LU<T, M>::solve(const Matrix<T, M, N>& b) const
+{
+    Matrix<T, M, N> x{b};
+    detail::luSolve(lu, pivots, x);
+
+    return x;
+}
+
+template<typename T, std::size_t M>
+inline Matrix<T, M, M> LU<T, M>::inverse() const
+{
+    Matrix<T, M, M> x;
+    for (std::size_t i = 0; i < M; ++i)
+        x(i, i) = static_cast<T>(1);
+
+    detail::luSolve(lu, pivots, x);
+
+    return x;
+}
+
+template<typename T, std::size_t M>
+inline Cholesky<T, M>::Cholesky(const Matrix<T, M, M>& mat) :
+    l{mat},
+    inverseDiagonal{},
+    norm{static_cast<T>(0)}
+{
+    // 1-norm of the symmetric matrix defined by the lower triangle
+    for (std::size_t j = 0; j < M; ++j)
+    {
+        T sum = static_cast<T>(0);
+        for (std::size_t i = 0; i < j; ++i)
+            sum += std::abs(mat(j, i));
+        for (std::size_t i = j; i < M; ++i)
+            sum += std::abs(mat(i, j));
+        norm = norm < sum ? sum : norm;
+    }
+
+    definite = detail::choleskyFactor(l, inverseDiagonal);
+}
+
+template<typename T, std::size_t M>
+inline bool Cholesky<T, M>::positiveDefinite() const
+{
+    return definite;
+}
+
+template<typename T, std::size_t M>
+inline T Cholesky<T, M>::determinant() const
+{
+    if (!definite)
+        return static_cast<T>(0);
+
+    T det = static_cast<T>(1);
+    for (std::size_t j = 0; j < M; ++j)
+        det *= l(j, j) * l(j, j);
+
+    return det;
+}
+
+template<typename T, std::size_t M>
+inline T Cholesky<T, M>::rcond() const
+{
+    if (!definite)
+        return static_cast<T>(0);
+
+    const T* a = l.data();
+    const T* d = inverseDiagonal;
+    auto solve = [a, d](T* x) { detail::choleskySolveColumn<T, M>(a, d, x); };
+
+    return static_cast<T>(1) / (norm * detail::inverseNorm1<T, M>(solve, solve));
+}
+
+template<typename T, std::size_t M>
+inline Matrix<T, M, M> Cholesky<T, M>::matrixL() const
+{
+    Matrix<T, M, M> res;
+    for (std::size_t j = 0; j < M; ++j)
+        for (std::size_t i = j; i < M; ++i)
+            res(i, j) = l(i, j);
+
+    return res;
+}
+
+template<typename T, std::size_t M>
+inline Vector<T, M> Cholesky<T, M>::solve(const Vector<T, M>& b) const
+{
+    Vector<T, M> x{b};
+    detail::choleskySolveColumn<T, M>(l.data(), inverseDiagonal, x.data());
+
+    return x;
+}
+
+template<typename T, std::size_t M>
+template<std::size_t N>
+inline Matrix<T, M, N> Cholesky<T, M>::solve(const Matrix<T, M, N>& b) const
+{
+    Matrix<T, M, N> x{b};
+    for (std::size_t j = 0; j < N; ++j)
+        detail::choleskySolveColumn<T, M>(l.data(), inverseDiagonal, x.data() + j * M);
+
+    return x;
+}
+
+template<typename T, std::size_t M>
+inline Matrix<T, M, M> Cholesky<T, M>::inverse() const
+{
+    Matrix<T, M, M> x;
+    for (std::size_t j = 0; j < M; ++j)
+    {
+        x(j, j) = static_cast<T>(1);
+        detail::choleskySolveColumn<T, M>(l.data(), inverseDiagonal, x.data() + j * M);
+    }
+
+    return x;
+}
+
+template<typename T, std::size_t M, std::size_t N>
+inline QR<T, M, N>::QR(const Matrix<T, M, N>& mat) :
+    qr{mat},
+    independent{0},
+    odd{false}
+{
+    T* a = qr.data();
+
+    for (std::size_t j = 0; j < N; ++j)
+        columns[j] = j;
+
+    for (std::size_t k = 0; k < N; ++k)
+    {
+        // the remaining column of largest norm goes next (the norms are recomputed rather than downdated, which loses accuracy)
+        std::size_t p = k;
+        T pnorm = static_cast<T>(-1);
+
+        for (std::size_t j = k; j < N; ++j)
+        {
+            T norm = static_cast<T>(0);
+            for (std::size_t i = k; i < M; ++i)
+                norm += a[j * M + i] * a[j * M + i];
+
+            if (norm > pnorm)
+            {
+                p = j;
+                pnorm = norm;
+            }
+        }
+
+        if (p != k)
+        {
+            for (std::size_t i = 0; i < M; ++i)
+                std::swap(a[k * M + i], a[p * M + i]);
+            std::swap(columns[k], columns[p]);
+            odd = !odd;
+        }
+
+        // reflection H = I - tau * v * v^T with v = (1, v[k + 1], ..., v[M - 1]) mapping the column onto (beta, 0, ..., 0)
+        T* v = a + k * M;
+        T alpha = v[k];
+        T sigma = static_cast<T>(0);
+        for (std::size_t i = k + 1; i < M; ++i)
+            sigma += v[i] * v[i];
+
+        tau[k] = static_cast<T>(0);
+        if (sigma == static_cast<T>(0))
+            continue;
+
+        T beta = std::sqrt(alpha * alpha + sigma);
+        if (alpha > static_cast<T>(0))
+            beta = -beta;
+
+        tau[k] = (beta - alpha) / beta;
+        T scale = static_cast<T>(1) / (alpha - beta);
+        for (std::size_t i = k + 1; i < M; ++i)
+            v[i] *= scale;
+        v[k] = beta;
+        odd = !odd;
+
+        for (std::size_t j = k + 1; j < N; ++j)
+        {
+            T* col = a + j * M;
+            T w = col[k];
+            for (std::size_t i = k + 1; i < M; ++i)
+                w += v[i] * col[i];
+            w *= tau[k];
+            col[k] -= w;
+            for (std::size_t i = k + 1; i < M; ++i)
+                col[i] -= w * v[i];
+        }
+    }
+
+    T threshold = static_cast<T>(M) * std::numeric_limits<T>::epsilon() * std::abs(qr(0, 0));
+    while (independent < N && std::abs(qr(independent, independent)) > threshold)
+        ++independent;
+}
+
+template<typename T, std::size_t M, std::size_t N>
+inline std::size_t QR<T, M, N>::rank() const
+{
+    return independent;
+}
+
+template<typename T, std::size_t M, std::size_t N>
+inline T QR<T, M, N>::rcond() const
+{
+    T largest = std::abs(qr(0, 0));
+    if (largest == static_cast<T>(0))
+        return static_cast<T>(0);
+
+    return std::abs(qr(N - 1, N - 1)) / largest;
+}
+
+template<typename T, std::size_t M, std::size_t N>
+template<std::size_t P, typename>
+inline T QR<T, M, N>::determinant() const
+{
+    T det = odd ? static_cast<T>(-1) : static_cast<T>(1);
+    for (std::size_t j = 0; j < N; ++j)
+        det *= qr(j, j);
+
+    return det;
+}
+
+template<typename T, std::size_t M, std::size_t N>
+inline Matrix<T, M, M> QR<T, M, N>::matrixQ() const
+{
+    Matrix<T, M, M> res;
+    for (std::size_t i = 0; i < M; ++i)
+        res(i, i) = static_cast<T>(1);
+
+    // Q = H(0) H(1) ... H(N - 1), applied to the identity from the last reflection
+    for (std::size_t k = N; k-- > 0;)
+    {
+        if (tau[k] == static_cast<T>(0))
+            continue;
+
+        const T* v = qr.data() + k * M;
+        for (std::size_t j = 0; j < M; ++j)
+        {
+            T* col = res.data() + j * M;
+            T w = col[k];
+            for (std::size_t i = k + 1; i < M; ++i)
+                w += v[i] * col[i];
+            w *= tau[k];
+            col[k] -= w;
+            for (std::size_t i = k + 1; i < M; ++i)
+                col[i] -= w * v[i];
+        }
+    }
+
+    return res;
+}
+
+template<typename T, std::size_t M, std::size_t N>
+inline Matrix<T, M, N> QR<T, M, N>::matrixR() const
+{
+    Matrix<T, M, N> res;
+    for (std::size_t j = 0; j < N; ++j)
+        for (std::size_t i = 0; i <= j; ++i)
+            res(i, j) = qr(i, j);
+
+    return res;
+}
+
+template<typename T, std::size_t M, std::size_t N>
+inline std::size_t QR<T, M, N>::permutation(std::size_t i) const
+{
+    return columns[i];
+}
+
+template<typename T, std::size_t M, std::size_t N>
+inline Vector<T, N> QR<T, M, N>::solve(const Vector<T, M>& b) const
+{
+    Vector<T, M> y{b};
+    Vector<T, N> x{uninitialized};
+    detail::qrSolveColumn<T, M, N>(qr.data(), tau, columns, independent, y.data(), x.data());
+
+    return x;
+}
+
+template<typename T, std::size_t M, std::size_t N>
+template<std::size_t K>
+inline Matrix<T, N, K> QR<T, M, N>::solve(const Matrix<T, M, K>& b) const
+{
+    Matrix<T, M, K> y{b};
+    Matrix<T, N, K> x{uninitialized};
+    for (std::size_t j = 0; j < K; ++j)
+        detail::qrSolveColumn<T, M, N>(qr.data(), tau, columns, independent, y.data() + j * M, x.data() + j * N);
+
+    return x;
+}
+
+template<typename T, std::size_t M>
+bool solveLU(const Matrix<T, M, M>* mats, const Vector<T, M>* rhs, Vector<T, M>* res, std::size_t count, std::size_t threadCount)
+{
+    std::atomic<bool> solved{true};
+
+    detail::runChunked(count, threadCount, detail::factorizationGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        bool chunk = true;
+
+        for (std::size_t i = begin; i < end; i += detail::solveLanes)
+        {
+            std::size_t lanes = end - i < detail::solveLanes ? end - i : detail::solveLanes;
+            chunk = detail::gaussSolveLanes(mats + i, rhs + i, lanes, res + i) && chunk;
+        }
+
+        if (!chunk)
+            solved.store(false, std::memory_order_relaxed);
+    });
+
+    return solved.load(std::memory_order_relaxed);
+}
+
+template<typename T, std::size_t M>
+bool solveCholesky(const Matrix<T, M, M>* mats, const Vector<T, M>* rhs, Vector<T, M>* res, std::size_t count, std::size_t threadCount)
+{
+    std::atomic<bool> solved{true};
+
+    detail::runChunked(count, threadCount, detail::factorizationGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        bool chunk = true;
+
+        for (std::size_t i = begin; i < end; i += detail::solveLanes)
+        {
+            std::size_t lanes = end - i < detail::solveLanes ? end - i : detail::solveLanes;
+            chunk = detail::choleskySolveLanes(mats + i, rhs + i, lanes, res + i) && chunk;
+        }
+
+        if (!chunk)
+            solved.store(false, std::memory_order_relaxed);
+    });
+
+    return solved.load(std::memory_order_relaxed);
+}
+
+}
@@ -0,0 +1,56 @@
+#ifndef CGLA_FRUSTUM_HPP
+#define CGLA_FRUSTUM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "config.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "vector_array.hpp"
+
+namespace cgla {
+
+// six planes {a, b, c, d} with unit normals pointing inside, a point p is inside a plane if a * x + b * y + c * z + d >= 0
+template<typename T>
+class Frustum
+{
+    static_assert(std::is_floating_point<T>::value, "Argument T must be a floating point type");
+
+    public:
+        enum Plane : std::size_t
+        {
+            Left, Right, Bottom, Top, Near, Far
+        };
+
+        static constexpr std::size_t planeCount = 6;
+
+        Frustum();
+        explicit Frustum(const Matrix<T, 4, 4>& viewProjection);
+
+        const Vector<T, 4>& plane(std::size_t i) const;
+        const Vector<T, 4>* planes() const;
+
+        bool contains(const Vector<T, 3>& p) const;
+        bool intersectsSphere(const Vector<T, 3>& center, T radius) const;
+        bool intersectsBox(const Vector<T, 3>& min, const Vector<T, 3>& max) const;
+
+    private:
+        Vector<T, 4> values[planeCount];
+};
+
+// number of std::uint32_t words of a visibility mask of count objects, object i is bit i % 32 of word i / 32
+inline std::size_t cullMaskSize(std::size_t count);
+
+template<typename T> void cullSpheres(const Frustum<T>& frustum, const VectorArray<T, 3>& centers, const T* radii, std::uint32_t* mask);
+template<typename T> void cullBoxes(const Frustum<T>& frustum, const VectorArray<T, 3>& mins, const VectorArray<T, 3>& maxs, std::uint32_t* mask);
+
+#ifdef CGLA_TYPE_ALIASES
+using Frustumf = Frustum<float>; using Frustumd = Frustum<double>;
+#endif
+
+}
+
+#include "frustum.inl"
+
+#endif
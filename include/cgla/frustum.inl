@@ -0,0 +1,284 @@
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include "config.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "vector_array.hpp"
+#ifdef CGLA_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace cgla {
+
+namespace detail {
+    template<typename T> T planeDistance(const Vector<T, 4>& plane, T x, T y, T z);
+    std::uint32_t packMask(const unsigned char* inside, std::size_t n);
+    template<typename T> void cullSpheres(const Vector<T, 4>* planes, const T* x, const T* y, const T* z, const T* r, std::size_t count, std::uint32_t* mask);
+    template<typename T> void cullBoxes(const Vector<T, 4>* planes, const T* const* p, std::size_t count, std::uint32_t* mask);
+    #ifdef CGLA_SSE
+    void cullSpheres(const Vector<float, 4>* planes, const float* x, const float* y, const float* z, const float* r, std::size_t count, std::uint32_t* mask);
+    void cullBoxes(const Vector<float, 4>* planes, const float* const* p, std::size_t count, std::uint32_t* mask);
+    #endif
+}
+
+template<typename T>
+constexpr std::size_t Frustum<T>::planeCount;
+
+template<typename T>
+inline Frustum<T>::Frustum() :
+    Frustum{Matrix<T, 4, 4>{static_cast<T>(1)}}
+{
+}
+
+template<typename T>
+Frustum<T>::Frustum(const Matrix<T, 4, 4>& viewProjection)
+{
+    // Gribb-Hartmann : the clip planes are the last row plus or minus the other rows, for a [-1, 1] depth range
+    const Matrix<T, 4, 4>& m = viewProjection;
+
+    for (std::size_t j = 0; j < 4; ++j)
+    {
+        values[Left][j] = m(3, j) + m(0, j);
+        values[Right][j] = m(3, j) - m(0, j);
+        values[Bottom][j] = m(3, j) + m(1, j);
+        values[Top][j] = m(3, j) - m(1, j);
+        values[Near][j] = m(3, j) + m(2, j);
+        values[Far][j] = m(3, j) - m(2, j);
+    }
+
+    for (Vector<T, 4>& plane : values)
+        plane /= std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+}
+
+template<typename T>
+inline const Vector<T, 4>& Frustum<T>::plane(std::size_t i) const
+{
+    return values[i];
+}
+
+template<typename T>
+inline const Vector<T, 4>* Frustum<T>::planes() const
+{
+    return values;
+}
+
+template<typename T>
+bool Frustum<T>::contains(const Vector<T, 3>& p) const
+{
+    for (const Vector<T, 4>& plane : values)
+        if (detail::planeDistance(plane, p[0], p[1], p[2]) < static_cast<T>(0))
+            return false;
+
+    return true;
+}
+
+template<typename T>
+bool Frustum<T>::intersectsSphere(const Vector<T, 3>& center, T radius) const
+{
+    for (const Vector<T, 4>& plane : values)
+        if (detail::planeDistance(plane, center[0], center[1], center[2]) < -radius)
+            return false;
+
+    return true;
+}
+
+template<typename T>
+bool Frustum<T>::intersectsBox(const Vector<T, 3>& min, const Vector<T, 3>& max) const
+{
+    // the box is outside if its corner furthest along the normal of a plane is outside
+    for (const Vector<T, 4>& plane : values)
+    {
+        T x = plane[0] < static_cast<T>(0) ? min[0] : max[0];
+        T y = plane[1] < static_cast<T>(0) ? min[1] : max[1];
+        T z = plane[2] < static_cast<T>(0) ? min[2] : max[2];
+
+        if (detail::planeDistance(plane, x, y, z) < static_cast<T>(0))
+            return false;
+    }
+
+    return true;
+}
+
+inline std::size_t cullMaskSize(std::size_t count)
+{
+    return (count + 31) / 32;
+}
+
+template<typename T>
+inline void cullSpheres(const Frustum<T>& frustum, const VectorArray<T, 3>& centers, const T* radii, std::uint32_t* mask)
+{
+    detail::cullSpheres(frustum.planes(), centers.data(0), centers.data(1), centers.data(2), radii, centers.size(), mask);
+}
+
+template<typename T>
+void cullBoxes(const Frustum<T>& frustum, const VectorArray<T, 3>& mins, const VectorArray<T, 3>& maxs, std::uint32_t* mask)
+{
+    // the furthest corner along each plane normal is chosen once per plane instead of once per box
+    const T* p[Frustum<T>::planeCount * 3];
+
+    for (std::size_t i = 0; i < Frustum<T>::planeCount; ++i)
+        for (std::size_t c = 0; c < 3; ++c)
+            p[i * 3 + c] = frustum.plane(i)[c] < static_cast<T>(0) ? mins.data(c) : maxs.data(c);
+
+    detail::cullBoxes(frustum.planes(), p, mins.size(), mask);
+}
+
+namespace detail {
+    template<typename T>
+    inline T planeDistance(const Vector<T, 4>& plane, T x, T y, T z)
+    {
+        return plane[0] * x + plane[1] * y + plane[2] * z + plane[3];
+    }
+
+    inline std::uint32_t packMask(const unsigned char* inside, std::size_t n)
+    {
+        std::uint32_t bits = 0;
+
+        for (std::size_t j = 0; j < n; ++j)
+            bits |= static_cast<std::uint32_t>(inside[j]) << j;
+
+        return bits;
+    }
+
+    template<typename T>
+    inline void cullSpheres(const Vector<T, 4>* planes, const T* x, const T* y, const T* z, const T* r, std::size_t count, std::uint32_t* mask)
+    {
+        for (std::size_t base = 0; base < count; base += 32)
+        {
+            std::size_t n = std::min(count - base, static_cast<std::size_t>(32));
+            unsigned char inside[32];
+
+            // plane-major so that the inner loop vectorizes
+            for (std::size_t j = 0; j < n; ++j)
+                inside[j] = planeDistance(planes[0], x[base + j], y[base + j], z[base + j]) >= -r[base + j];
+
+            for (std::size_t k = 1; k < 6; ++k)
+                for (std::size_t j = 0; j < n; ++j)
+                    inside[j] &= planeDistance(planes[k], x[base + j], y[base + j], z[base + j]) >= -r[base + j];
+
+            mask[base / 32] = packMask(inside, n);
+        }
+    }
+
+    template<typename T>
+    inline void cullBoxes(const Vector<T, 4>* planes, const T* const* p, std::size_t count, std::uint32_t* mask)
+    {
+        for (std::size_t base = 0; base < count; base += 32)
+        {
+            std::size_t n = std::min(count - base, static_cast<std::size_t>(32));
+            unsigned char inside[32];
+
+            for (std::size_t j = 0; j < n; ++j)
+                inside[j] = planeDistance(planes[0], p[0][base + j], p[1][base + j], p[2][base + j]) >= static_cast<T>(0);
+
+            for (std::size_t k = 1; k < 6; ++k)
+            {
+                const T* x = p[k * 3] + base;
+                const T* y = p[k * 3 + 1] + base;
+                const T* z = p[k * 3 + 2] + base;
+
+                for (std::size_t j = 0; j < n; ++j)
+                    inside[j] &= planeDistance(planes[k], x[j], y[j], z[j]) >= static_cast<T>(0);
+            }
+
+            mask[base / 32] = packMask(inside, n);
+        }
+    }
+
+    #ifdef CGLA_SSE
+    // four objects per register, eight registers per mask word
+    inline void cullSpheres(const Vector<float, 4>* planes, const float* x, const float* y, const float* z, const float* r, std::size_t count, std::uint32_t* mask)
+    {
+        __m128 a[6], b[6], c[6], d[6];
+
+        for (std::size_t k = 0; k < 6; ++k)
+        {
+            a[k] = _mm_set1_ps(planes[k][0]);
+            b[k] = _mm_set1_ps(planes[k][1]);
+            c[k] = _mm_set1_ps(planes[k][2]);
+            d[k] = _mm_set1_ps(planes[k][3]);
+        }
+
+        const __m128 zero = _mm_setzero_ps();
+        std::size_t full = count & ~static_cast<std::size_t>(31);
+
+        for (std::size_t base = 0; base < full; base += 32)
+        {
+            std::uint32_t bits = 0;
+
+            for (std::size_t j = 0; j < 32; j += 4)
+            {
+                std::size_t i = base + j;
+                __m128 px = _mm_loadu_ps(x + i), py = _mm_loadu_ps(y + i), pz = _mm_loadu_ps(z + i);
+                __m128 nr = _mm_sub_ps(zero, _mm_loadu_ps(r + i));
+                __m128 inside = _mm_cmpge_ps(zero, zero); // all bits set
+
+                for (std::size_t k = 0; k < 6; ++k)
+                {
+                    __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[k], px), _mm_mul_ps(b[k], py)), _mm_add_ps(_mm_mul_ps(c[k], pz), d[k]));
+                    inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, nr));
+                }
+
+                bits |= static_cast<std::uint32_t>(_mm_movemask_ps(inside)) << j;
+            }
+
+            mask[base / 32] = bits;
+        }
+
+        if (full < count)
+            cullSpheres<float>(planes, x + full, y + full, z + full, r + full, count - full, mask + full / 32);
+    }
+
+    inline void cullBoxes(const Vector<float, 4>* planes, const float* const* p, std::size_t count, std::uint32_t* mask)
+    {
+        __m128 a[6], b[6], c[6], d[6];
+
+        for (std::size_t k = 0; k < 6; ++k)
+        {
+            a[k] = _mm_set1_ps(planes[k][0]);
+            b[k] = _mm_set1_ps(planes[k][1]);
+            c[k] = _mm_set1_ps(planes[k][2]);
+            d[k] = _mm_set1_ps(planes[k][3]);
+        }
+
+        const __m128 zero = _mm_setzero_ps();
+        std::size_t full = count & ~static_cast<std::size_t>(31);
+
+        for (std::size_t base = 0; base < full; base += 32)
+        {
+            std::uint32_t bits = 0;
+
+            for (std::size_t j = 0; j < 32; j += 4)
+            {
+                std::size_t i = base + j;
+                __m128 inside = _mm_cmpge_ps(zero, zero); // all bits set
+
+                for (std::size_t k = 0; k < 6; ++k)
+                {
+                    __m128 px = _mm_loadu_ps(p[k * 3] + i), py = _mm_loadu_ps(p[k * 3 + 1] + i), pz = _mm_loadu_ps(p[k * 3 + 2] + i);
+                    __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[k], px), _mm_mul_ps(b[k], py)), _mm_add_ps(_mm_mul_ps(c[k], pz), d[k]));
+                    inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, zero));
+                }
+
+                bits |= static_cast<std::uint32_t>(_mm_movemask_ps(inside)) << j;
+            }
+
+            mask[base / 32] = bits;
+        }
+
+        if (full < count)
+        {
+            const float* tail[18];
+
+            for (std::size_t k = 0; k < 18; ++k)
+                tail[k] = p[k] + full;
+
+            cullBoxes<float>(planes, tail, count - full, mask + full / 32);
+        }
+    }
+    #endif
+}
+
+}
@@ -0,0 +1,60 @@
+#ifndef CGLA_HIERARCHY_HPP
+#define CGLA_HIERARCHY_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include "config.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "quaternion.hpp"
+
+namespace cgla {
+
+template<typename T>
+class TransformHierarchy
+{
+    static_assert(std::is_floating_point<T>::value, "Argument T must be a floating point type");
+
+    public:
+        static constexpr std::size_t noParent = static_cast<std::size_t>(-1);
+
+        TransformHierarchy();
+        // parents[i] is the parent of node i, which must precede it (parents[i] < i), or noParent for a root
+        explicit TransformHierarchy(const std::vector<std::size_t>& parents);
+
+        std::size_t size() const;
+        std::size_t parent(std::size_t node) const;
+        std::size_t levelCount() const;
+
+        const Matrix<T, 4, 4>& local(std::size_t node) const;
+        void setLocal(std::size_t node, const Matrix<T, 4, 4>& local);
+        void setLocal(std::size_t node, const Vector<T, 3>& translation, const Quaternion<T>& rotation, const Vector<T, 3>& scale);
+        void markDirty(std::size_t node);
+        bool isDirty(std::size_t node) const;
+
+        void update(std::size_t threadCount = 1);
+        const Matrix<T, 4, 4>& world(std::size_t node) const;
+        const Matrix<T, 4, 4>* worlds() const;
+
+    private:
+        void updateNodes(const std::size_t* nodes, std::size_t count);
+
+        std::vector<std::size_t> parents;
+        std::vector<std::size_t> order; // nodes grouped by depth
+        std::vector<std::size_t> levelOffsets; // level l is order[levelOffsets[l]] to order[levelOffsets[l + 1] - 1]
+        std::vector<Matrix<T, 4, 4>> locals;
+        std::vector<Matrix<T, 4, 4>> worldMatrices;
+        std::vector<unsigned char> dirty;
+        bool anyDirty;
+};
+
+#ifdef CGLA_TYPE_ALIASES
+using TransformHierarchyf = TransformHierarchy<float>; using TransformHierarchyd = TransformHierarchy<double>;
+#endif
+
+}
+
+#include "hierarchy.inl"
+
+#endif
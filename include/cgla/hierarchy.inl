@@ -0,0 +1,167 @@
+#include <cstddef>
+#include <cassert>
+#include <algorithm>
+#include <vector>
+#include "config.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "quaternion.hpp"
+#include "transform.hpp"
+#include "parallel.hpp"
+
+namespace cgla {
+
+namespace detail {
+    // minimum number of nodes given to a thread when a level is updated in parallel
+    constexpr std::size_t hierarchyGrainSize = 1024;
+}
+
+template<typename T>
+constexpr std::size_t TransformHierarchy<T>::noParent;
+
+template<typename T>
+inline TransformHierarchy<T>::TransformHierarchy() :
+    anyDirty{false}
+{
+}
+
+template<typename T>
+TransformHierarchy<T>::TransformHierarchy(const std::vector<std::size_t>& parents) :
+    parents(parents),
+    order(parents.size()),
+    locals(parents.size(), Matrix<T, 4, 4>{static_cast<T>(1)}),
+    worldMatrices(parents.size(), Matrix<T, 4, 4>{static_cast<T>(1)}),
+    dirty(parents.size(), 1),
+    anyDirty{!parents.empty()}
+{
+    // parents precede their children, so depths are known in one pass
+    std::vector<std::size_t> depths(parents.size());
+    std::size_t levels = 0;
+
+    for (std::size_t i = 0; i < parents.size(); ++i)
+    {
+        assert(parents[i] == noParent || parents[i] < i);
+        depths[i] = parents[i] == noParent ? 0 : depths[parents[i]] + 1;
+        levels = std::max(levels, depths[i] + 1);
+    }
+
+    levelOffsets.assign(levels + 1, 0);
+
+    for (std::size_t i = 0; i < parents.size(); ++i)
+        ++levelOffsets[depths[i] + 1];
+
+    for (std::size_t l = 0; l < levels; ++l)
+        levelOffsets[l + 1] += levelOffsets[l];
+
+    std::vector<std::size_t> next(levelOffsets.begin(), levelOffsets.end() - 1);
+
+    for (std::size_t i = 0; i < parents.size(); ++i)
+        order[next[depths[i]]++] = i;
+}
+
+template<typename T>
+inline std::size_t TransformHierarchy<T>::size() const
+{
+    return parents.size();
+}
+
+template<typename T>
+inline std::size_t TransformHierarchy<T>::parent(std::size_t node) const
+{
+    return parents[node];
+}
+
+template<typename T>
+inline std::size_t TransformHierarchy<T>::levelCount() const
+{
+    return levelOffsets.empty() ? 0 : levelOffsets.size() - 1;
+}
+
+template<typename T>
+inline const Matrix<T, 4, 4>& TransformHierarchy<T>::local(std::size_t node) const
+{
+    return locals[node];
+}
+
+template<typename T>
+inline void TransformHierarchy<T>::setLocal(std::size_t node, const Matrix<T, 4, 4>& local)
+{
+    locals[node] = local;
+    markDirty(node);
+}
+
+template<typename T>
+inline void TransformHierarchy<T>::setLocal(std::size_t node, const Vector<T, 3>& translation, const Quaternion<T>& rotation, const Vector<T, 3>& scale)
+{
+    locals[node] = composeTRS(translation, rotation, scale);
+    markDirty(node);
+}
+
+template<typename T>
+inline void TransformHierarchy<T>::markDirty(std::size_t node)
+{
+    dirty[node] = 1;
+    anyDirty = true;
+}
+
+template<typename T>
+inline bool TransformHierarchy<T>::isDirty(std::size_t node) const
+{
+    return dirty[node] != 0;
+}
+
+template<typename T>
+void TransformHierarchy<T>::update(std::size_t threadCount)
+{
+    if (!anyDirty)
+        return;
+
+    // a dirty node invalidates its whole subtree
+    for (std::size_t i = 0; i < parents.size(); ++i)
+        if (parents[i] != noParent && dirty[parents[i]])
+            dirty[i] = 1;
+
+    // the nodes of a level only depend on the previous level
+    for (std::size_t l = 0; l + 1 < levelOffsets.size(); ++l)
+    {
+        const std::size_t* nodes = order.data() + levelOffsets[l];
+        std::size_t count = levelOffsets[l + 1] - levelOffsets[l];
+
+        detail::runChunked(count, threadCount, detail::hierarchyGrainSize, [this, nodes](std::size_t begin, std::size_t end)
+        {
+            updateNodes(nodes + begin, end - begin);
+        });
+    }
+
+    std::fill(dirty.begin(), dirty.end(), 0);
+    anyDirty = false;
+}
+
+template<typename T>
+inline const Matrix<T, 4, 4>& TransformHierarchy<T>::world(std::size_t node) const
+{
+    return worldMatrices[node];
+}
+
+template<typename T>
+inline const Matrix<T, 4, 4>* TransformHierarchy<T>::worlds() const
+{
+    return worldMatrices.data();
+}
+
+template<typename T>
+void TransformHierarchy<T>::updateNodes(const std::size_t* nodes, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::size_t node = nodes[i];
+
+        if (!dirty[node])
+            continue;
+
+        std::size_t p = parents[node];
+        worldMatrices[node] = p == noParent ? locals[node] : worldMatrices[p] * locals[node];
+    }
+}
+
+}
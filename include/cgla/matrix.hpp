@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <ostream>
 #include <type_traits>
+#include <utility>
 #include "config.hpp"
 #include "vector.hpp"
 
@@ -16,52 +17,99 @@ class Matrix
     static_assert(M > 0 && N > 0, "Arguments M and N must be greater than zero");
 
     public:
-        Matrix();
-        Matrix(const Matrix<T, M, N>& other);
-        template<typename... Args, typename = typename std::enable_if<sizeof...(Args) == M * N>::type> Matrix(Args... args);
-        template<std::size_t P = M * N, typename = typename std::enable_if<(P > 1)>::type> explicit Matrix(T v);
-        explicit Matrix(const T (&v)[M * N]);
-        explicit Matrix(const T (&v)[N][M]);
-        explicit Matrix(const Vector<T, M> (&v)[N]);
-        template<typename U> explicit Matrix(const Matrix<U, M, N>& other);
-
-        T* data();
-        const T* data() const;
-        T& operator[](std::size_t i);
-        T operator[](std::size_t i) const;
-        T& operator()(std::size_t i, std::size_t j);
-        T operator()(std::size_t i, std::size_t j) const;
-
-        Matrix<T, M, N>& operator=(const Matrix<T, M, N>& rhs);
-        Matrix<T, M, N>& operator+=(const Matrix<T, M, N>& rhs);
-        Matrix<T, M, N>& operator-=(const Matrix<T, M, N>& rhs);
-        template<typename U> Matrix<T, M, N>& operator*=(U rhs);
-        template<typename U> Matrix<T, M, N>& operator/=(U rhs);
-        bool operator==(const Matrix<T, M, N>& rhs) const;
-        bool operator!=(const Matrix<T, M, N>& rhs) const;
-        bool operator<(const Matrix<T, M, N>& rhs) const;
+        CGLA_CONSTEXPR Matrix();
+        Matrix(const Matrix<T, M, N>& other) = default;
+        explicit Matrix(Uninitialized);
+        template<typename... Args, typename = typename std::enable_if<sizeof...(Args) == M * N>::type> CGLA_CONSTEXPR Matrix(Args... args);
+        template<std::size_t P = M * N, typename = typename std::enable_if<(P > 1)>::type> CGLA_CONSTEXPR explicit Matrix(T v);
+        CGLA_CONSTEXPR explicit Matrix(const T (&v)[M * N]);
+        CGLA_CONSTEXPR explicit Matrix(const T (&v)[N][M]);
+        CGLA_CONSTEXPR explicit Matrix(const Vector<T, M> (&v)[N]);
+        template<typename U> CGLA_CONSTEXPR explicit Matrix(const Matrix<U, M, N>& other);
+        #ifdef CGLA_EXPRESSION_TEMPLATES
+        template<typename Op, typename L, typename R> CGLA_CONSTEXPR Matrix(const detail::Expression<Op, L, R, Matrix<T, M, N>>& e);
+        #endif
+
+        CGLA_CONSTEXPR T* data();
+        CGLA_CONSTEXPR const T* data() const;
+        CGLA_CONSTEXPR T& operator[](std::size_t i);
+        CGLA_CONSTEXPR T operator[](std::size_t i) const;
+        CGLA_CONSTEXPR T& operator()(std::size_t i, std::size_t j);
+        CGLA_CONSTEXPR T operator()(std::size_t i, std::size_t j) const;
+
+        Matrix<T, M, N>& operator=(const Matrix<T, M, N>& rhs) = default;
+        #ifdef CGLA_EXPRESSION_TEMPLATES
+        template<typename Op, typename L, typename R> CGLA_CONSTEXPR Matrix<T, M, N>& operator=(const detail::Expression<Op, L, R, Matrix<T, M, N>>& rhs);
+        #endif
+        CGLA_CONSTEXPR Matrix<T, M, N>& operator+=(const Matrix<T, M, N>& rhs);
+        CGLA_CONSTEXPR Matrix<T, M, N>& operator-=(const Matrix<T, M, N>& rhs);
+        template<typename U> CGLA_CONSTEXPR Matrix<T, M, N>& operator*=(U rhs);
+        template<typename U> CGLA_CONSTEXPR Matrix<T, M, N>& operator/=(U rhs);
+        CGLA_CONSTEXPR bool operator==(const Matrix<T, M, N>& rhs) const;
+        CGLA_CONSTEXPR bool operator!=(const Matrix<T, M, N>& rhs) const;
+        CGLA_CONSTEXPR bool operator<(const Matrix<T, M, N>& rhs) const;
 
     private:
         T values[M * N];
 };
 
-template<typename T, std::size_t M, std::size_t N> Matrix<T, M, N> operator-(Matrix<T, M, N> rhs);
-template<typename T, std::size_t M, std::size_t N> Matrix<T, M, N> operator+(Matrix<T, M, N> lhs, const Matrix<T, M, N>& rhs);
-template<typename T, std::size_t M, std::size_t N> Matrix<T, M, N> operator-(Matrix<T, M, N> lhs, const Matrix<T, M, N>& rhs);
-template<typename T, std::size_t M, std::size_t N, typename U> Matrix<T, M, N> operator*(Matrix<T, M, N> lhs, U rhs);
-template<typename T, std::size_t M, std::size_t N, typename U> Matrix<T, M, N> operator*(U lhs, Matrix<T, M, N> rhs);
-template<typename T, std::size_t L, std::size_t M, std::size_t N> Matrix<T, L, N> operator*(const Matrix<T, L, M>& lhs, const Matrix<T, M, N>& rhs);
-template<typename T, std::size_t M, std::size_t N> Vector<T, M> operator*(const Matrix<T, M, N>& lhs, const Vector<T, N>& rhs);
-template<typename T, std::size_t M, std::size_t N> Vector<T, N> operator*(const Vector<T, M>& lhs, const Matrix<T, M, N>& rhs);
-template<typename T, std::size_t M, std::size_t N, typename U> Matrix<T, M, N> operator/(Matrix<T, M, N> lhs, U rhs);
+#ifdef CGLA_EXPRESSION_TEMPLATES
+namespace detail {
+    template<typename T, std::size_t M, std::size_t N>
+    struct ExpressionTraits<Matrix<T, M, N>>
+    {
+        using result_type = Matrix<T, M, N>;
+        using value_type = T;
+        static constexpr std::size_t size = M * N;
+        static constexpr bool vector = false;
+    };
+
+    // a vector or matrix operand of a matrix product with an expression of type Result
+    template<typename E, typename Result>
+    struct IsProductOperand : std::integral_constant<bool, !IsExpression<E>::value && (IsMatrixOperand<E>::value || (IsVectorOperand<E>::value && IsMatrixOperand<Result>::value))> {};
+}
+#endif
+
+#ifndef CGLA_EXPRESSION_TEMPLATES
+template<typename T, std::size_t M, std::size_t N> CGLA_CONSTEXPR Matrix<T, M, N> operator-(Matrix<T, M, N> rhs);
+template<typename T, std::size_t M, std::size_t N> CGLA_CONSTEXPR Matrix<T, M, N> operator+(Matrix<T, M, N> lhs, const Matrix<T, M, N>& rhs);
+template<typename T, std::size_t M, std::size_t N> CGLA_CONSTEXPR Matrix<T, M, N> operator-(Matrix<T, M, N> lhs, const Matrix<T, M, N>& rhs);
+template<typename T, std::size_t M, std::size_t N, typename U> CGLA_CONSTEXPR Matrix<T, M, N> operator*(Matrix<T, M, N> lhs, U rhs);
+template<typename T, std::size_t M, std::size_t N, typename U> CGLA_CONSTEXPR Matrix<T, M, N> operator*(U lhs, Matrix<T, M, N> rhs);
+#endif
+template<typename T, std::size_t L, std::size_t M, std::size_t N> CGLA_CONSTEXPR Matrix<T, L, N> operator*(const Matrix<T, L, M>& lhs, const Matrix<T, M, N>& rhs);
+template<typename T, std::size_t M, std::size_t N> CGLA_CONSTEXPR Vector<T, M> operator*(const Matrix<T, M, N>& lhs, const Vector<T, N>& rhs);
+template<typename T, std::size_t M, std::size_t N> CGLA_CONSTEXPR Vector<T, N> operator*(const Vector<T, M>& lhs, const Matrix<T, M, N>& rhs);
+#ifdef CGLA_EXPRESSION_TEMPLATES
+template<typename Op, typename L, typename R, typename Result, typename Rhs, typename = typename std::enable_if<detail::IsProductOperand<Rhs, Result>::value>::type> CGLA_CONSTEXPR auto operator*(const detail::Expression<Op, L, R, Result>& lhs, const Rhs& rhs) -> decltype(std::declval<const Result&>() * rhs);
+template<typename Lhs, typename Op, typename L, typename R, typename Result, typename = typename std::enable_if<detail::IsProductOperand<Lhs, Result>::value>::type> CGLA_CONSTEXPR auto operator*(const Lhs& lhs, const detail::Expression<Op, L, R, Result>& rhs) -> decltype(lhs * std::declval<const Result&>());
+template<typename Op1, typename L1, typename R1, typename Result1, typename Op2, typename L2, typename R2, typename Result2, typename = typename std::enable_if<detail::IsMatrixOperand<Result1>::value || detail::IsMatrixOperand<Result2>::value>::type> CGLA_CONSTEXPR auto operator*(const detail::Expression<Op1, L1, R1, Result1>& lhs, const detail::Expression<Op2, L2, R2, Result2>& rhs) -> decltype(std::declval<const Result1&>() * std::declval<const Result2&>());
+#else
+template<typename T, std::size_t M, std::size_t N, typename U> CGLA_CONSTEXPR Matrix<T, M, N> operator/(Matrix<T, M, N> lhs, U rhs);
+#endif
 #ifdef CGLA_OSTREAM_OVERLOADS
 template<typename T, std::size_t M, std::size_t N> std::ostream& operator<<(std::ostream& lhs, const Matrix<T, M, N>& rhs);
 #endif
 
-template<typename T, std::size_t M, std::size_t N> Matrix<T, N, M> transpose(const Matrix<T, M, N>& mat);
-template<typename T, std::size_t M> Matrix<T, M, M> inverse(Matrix<T, M, M> mat);
-template<typename T, std::size_t M, std::size_t N> Matrix<T, M, N> matrixCompMult(const Matrix<T, M, N>& x, const Matrix<T, M, N>& y);
-template<typename T, std::size_t M, std::size_t N> Matrix<T, M, N> outerProduct(const Vector<T, M>& u, const Vector<T, N>& v);
+template<typename T, std::size_t M, std::size_t N> CGLA_CONSTEXPR Matrix<T, N, M> transpose(const Matrix<T, M, N>& mat);
+template<typename T, std::size_t M> T determinant(const Matrix<T, M, M>& mat);
+template<typename T, std::size_t M> Matrix<T, M, M> inverse(const Matrix<T, M, M>& mat);
+template<typename T, std::size_t M> bool tryInverse(const Matrix<T, M, M>& mat, Matrix<T, M, M>& res);
+template<typename T> Matrix<T, 4, 4> affineInverse(const Matrix<T, 4, 4>& mat);
+template<typename T> Matrix<T, 4, 4> rigidInverse(const Matrix<T, 4, 4>& mat);
+template<typename T, std::size_t M, std::size_t N> CGLA_CONSTEXPR Matrix<T, M, N> matrixCompMult(const Matrix<T, M, N>& x, const Matrix<T, M, N>& y);
+template<typename T, std::size_t M, std::size_t N> CGLA_CONSTEXPR Matrix<T, M, N> outerProduct(const Vector<T, M>& u, const Vector<T, N>& v);
+#ifdef CGLA_EXPRESSION_TEMPLATES
+// overloads of the functions above taking expressions, evaluated into their result type
+template<typename E, typename = detail::EnableIfExpression<E>> CGLA_CONSTEXPR auto transpose(const E& mat) -> decltype(transpose(detail::evaluate(mat)));
+template<typename E, typename = detail::EnableIfExpression<E>> auto determinant(const E& mat) -> decltype(determinant(detail::evaluate(mat)));
+template<typename E, typename = detail::EnableIfExpression<E>> auto inverse(const E& mat) -> decltype(inverse(detail::evaluate(mat)));
+template<typename E, typename Res, typename = detail::EnableIfExpression<E>> auto tryInverse(const E& mat, Res& res) -> decltype(tryInverse(detail::evaluate(mat), res));
+template<typename E, typename = detail::EnableIfExpression<E>> auto affineInverse(const E& mat) -> decltype(affineInverse(detail::evaluate(mat)));
+template<typename E, typename = detail::EnableIfExpression<E>> auto rigidInverse(const E& mat) -> decltype(rigidInverse(detail::evaluate(mat)));
+template<typename L, typename R, typename = detail::EnableIfExpression<L, R>> CGLA_CONSTEXPR auto matrixCompMult(const L& x, const R& y) -> decltype(matrixCompMult(detail::evaluate(x), detail::evaluate(y)));
+template<typename L, typename R, typename = detail::EnableIfExpression<L, R>> CGLA_CONSTEXPR auto outerProduct(const L& u, const R& v) -> decltype(outerProduct(detail::evaluate(u), detail::evaluate(v)));
+#endif
 
 #ifdef CGLA_TYPE_ALIASES
 using Matrix2x2i = Matrix<int, 2, 2>; using Matrix2x3i = Matrix<int, 2, 3>; using Matrix2x4i = Matrix<int, 2, 4>;
@@ -78,6 +126,9 @@ using Matrix4x2d = Matrix<double, 4, 2>; using Matrix4x3d = Matrix<double, 4, 3>
 using Matrix2d = Matrix2x2d; using Matrix3d = Matrix3x3d; using Matrix4d = Matrix4x4d;
 #endif
 
+static_assert(std::is_trivially_copyable<Matrix<float, 4, 4>>::value && std::is_standard_layout<Matrix<float, 4, 4>>::value, "Matrix<T, M, N> must be trivially copyable and standard-layout");
+static_assert(sizeof(Matrix<float, 4, 4>) == sizeof(float[16]) && alignof(Matrix<float, 4, 4>) == alignof(float), "Matrix<T, M, N> must be bit-compatible with T[M * N]");
+
 }
 
 #include "matrix.inl"
@@ -1,36 +1,53 @@
 #include <cstddef>
 #include <cmath>
 #include <algorithm>
+#include <limits>
 #include <ostream>
+#include <type_traits>
+#include <utility>
 #include "config.hpp"
 #include "vector.hpp"
+#ifdef CGLA_SSE
+#include <xmmintrin.h>
+#endif
 
 namespace cgla {
 
+namespace detail {
+    template<typename T, std::size_t M> T determinant(Matrix<T, M, M> mat);
+    template<typename T> T determinant(const Matrix<T, 1, 1>& mat);
+    template<typename T> T determinant(const Matrix<T, 2, 2>& mat);
+    template<typename T> T determinant(const Matrix<T, 3, 3>& mat);
+    template<typename T> T determinant(const Matrix<T, 4, 4>& mat);
+    template<typename T, std::size_t M> bool invert(Matrix<T, M, M> mat, Matrix<T, M, M>& inv);
+    template<typename T> bool invert(const Matrix<T, 2, 2>& mat, Matrix<T, 2, 2>& res);
+    template<typename T> bool invert(const Matrix<T, 3, 3>& mat, Matrix<T, 3, 3>& res);
+    template<typename T> bool invert(const Matrix<T, 4, 4>& mat, Matrix<T, 4, 4>& res);
+    template<typename T, std::size_t M, std::size_t N> void fillNaN(Matrix<T, M, N>& mat);
+}
+
 template<typename T, std::size_t M, std::size_t N>
-inline Matrix<T, M, N>::Matrix()
+CGLA_CONSTEXPR Matrix<T, M, N>::Matrix() :
+    values{}
 {
-    for (std::size_t i = 0; i < M * N; ++i)
-        values[i] = static_cast<T>(0);
 }
 
 template<typename T, std::size_t M, std::size_t N>
-inline Matrix<T, M, N>::Matrix(const Matrix<T, M, N>& other)
+inline Matrix<T, M, N>::Matrix(Uninitialized)
 {
-    for (std::size_t i = 0; i < M * N; ++i)
-        values[i] = other.values[i];
 }
 
 template<typename T, std::size_t M, std::size_t N>
 template<typename... Args, typename>
-inline Matrix<T, M, N>::Matrix(Args... args) :
+CGLA_CONSTEXPR Matrix<T, M, N>::Matrix(Args... args) :
     values{args...}
 {
 }
 
 template<typename T, std::size_t M, std::size_t N>
 template<std::size_t, typename>
-inline Matrix<T, M, N>::Matrix(T v)
+CGLA_CONSTEXPR Matrix<T, M, N>::Matrix(T v) :
+    values{}
 {
     for (std::size_t j = 0; j < N; ++j)
         for (std::size_t i = 0; i < M; ++i)
@@ -38,14 +55,16 @@ inline Matrix<T, M, N>::Matrix(T v)
 }
 
 template<typename T, std::size_t M, std::size_t N>
-inline Matrix<T, M, N>::Matrix(const T (&v)[M * N])
+CGLA_CONSTEXPR Matrix<T, M, N>::Matrix(const T (&v)[M * N]) :
+    values{}
 {
     for (std::size_t i = 0; i < M * N; ++i)
         values[i] = v[i];
 }
 
 template<typename T, std::size_t M, std::size_t N>
-inline Matrix<T, M, N>::Matrix(const T (&v)[N][M])
+CGLA_CONSTEXPR Matrix<T, M, N>::Matrix(const T (&v)[N][M]) :
+    values{}
 {
     for (std::size_t j = 0; j < N; ++j)
         for (std::size_t i = 0; i < M; ++i)
@@ -53,7 +72,8 @@ inline Matrix<T, M, N>::Matrix(const T (&v)[N][M])
 }
 
 template<typename T, std::size_t M, std::size_t N>
-inline Matrix<T, M, N>::Matrix(const Vector<T, M> (&v)[N])
+CGLA_CONSTEXPR Matrix<T, M, N>::Matrix(const Vector<T, M> (&v)[N]) :
+    values{}
 {
     for (std::size_t j = 0; j < N; ++j)
         for (std::size_t i = 0; i < M; ++i)
@@ -62,59 +82,74 @@ inline Matrix<T, M, N>::Matrix(const Vector<T, M> (&v)[N])
 
 template<typename T, std::size_t M, std::size_t N>
 template<typename U>
-inline Matrix<T, M, N>::Matrix(const Matrix<U, M, N>& other)
+CGLA_CONSTEXPR Matrix<T, M, N>::Matrix(const Matrix<U, M, N>& other) :
+    values{}
 {
     for (std::size_t i = 0; i < M * N; ++i)
         values[i] = static_cast<T>(other[i]);
 }
 
+#ifdef CGLA_EXPRESSION_TEMPLATES
+template<typename T, std::size_t M, std::size_t N>
+template<typename Op, typename L, typename R>
+CGLA_CONSTEXPR Matrix<T, M, N>::Matrix(const detail::Expression<Op, L, R, Matrix<T, M, N>>& e) :
+    values{}
+{
+    for (std::size_t i = 0; i < M * N; ++i)
+        values[i] = e[i];
+}
+#endif
+
 template<typename T, std::size_t M, std::size_t N>
-inline T* Matrix<T, M, N>::data()
+CGLA_CONSTEXPR T* Matrix<T, M, N>::data()
 {
     return values;
 }
 
 template<typename T, std::size_t M, std::size_t N>
-inline const T* Matrix<T, M, N>::data() const
+CGLA_CONSTEXPR const T* Matrix<T, M, N>::data() const
 {
     return values;
 }
 
 template<typename T, std::size_t M, std::size_t N>
-inline T& Matrix<T, M, N>::operator[](std::size_t i)
+CGLA_CONSTEXPR T& Matrix<T, M, N>::operator[](std::size_t i)
 {
     return values[i];
 }
 
 template<typename T, std::size_t M, std::size_t N>
-inline T Matrix<T, M, N>::operator[](std::size_t i) const
+CGLA_CONSTEXPR T Matrix<T, M, N>::operator[](std::size_t i) const
 {
     return values[i];
 }
 
 template<typename T, std::size_t M, std::size_t N>
-inline T& Matrix<T, M, N>::operator()(std::size_t i, std::size_t j)
+CGLA_CONSTEXPR T& Matrix<T, M, N>::operator()(std::size_t i, std::size_t j)
 {
     return values[j * M + i];
 }
 
 template<typename T, std::size_t M, std::size_t N>
-inline T Matrix<T, M, N>::operator()(std::size_t i, std::size_t j) const
+CGLA_CONSTEXPR T Matrix<T, M, N>::operator()(std::size_t i, std::size_t j) const
 {
     return values[j * M + i];
 }
 
+#ifdef CGLA_EXPRESSION_TEMPLATES
 template<typename T, std::size_t M, std::size_t N>
-inline Matrix<T, M, N>& Matrix<T, M, N>::operator=(const Matrix<T, M, N>& rhs)
+template<typename Op, typename L, typename R>
+CGLA_CONSTEXPR Matrix<T, M, N>& Matrix<T, M, N>::operator=(const detail::Expression<Op, L, R, Matrix<T, M, N>>& rhs)
 {
     for (std::size_t i = 0; i < M * N; ++i)
-        values[i] = rhs.values[i];
+        values[i] = rhs[i];
 
     return *this;
 }
+#endif
 
 template<typename T, std::size_t M, std::size_t N>
-inline Matrix<T, M, N>& Matrix<T, M, N>::operator+=(const Matrix<T, M, N>& rhs)
+CGLA_CONSTEXPR Matrix<T, M, N>& Matrix<T, M, N>::operator+=(const Matrix<T, M, N>& rhs)
 {
     for (std::size_t i = 0; i < M * N; ++i)
         values[i] += rhs.values[i];
@@ -123,7 +158,7 @@ inline Matrix<T, M, N>& Matrix<T, M, N>::operator+=(const Matrix<T, M, N>& rhs)
 }
 
 template<typename T, std::size_t M, std::size_t N>
-inline Matrix<T, M, N>& Matrix<T, M, N>::operator-=(const Matrix<T, M, N>& rhs)
+CGLA_CONSTEXPR Matrix<T, M, N>& Matrix<T, M, N>::operator-=(const Matrix<T, M, N>& rhs)
 {
     for (std::size_t i = 0; i < M * N; ++i)
         values[i] -= rhs.values[i];
@@ -133,7 +168,7 @@ inline Matrix<T, M, N>& Matrix<T, M, N>::operator-=(const Matrix<T, M, N>& rhs)
 
 template<typename T, std::size_t M, std::size_t N>
 template<typename U>
-inline Matrix<T, M, N>& Matrix<T, M, N>::operator*=(U rhs)
+CGLA_CONSTEXPR Matrix<T, M, N>& Matrix<T, M, N>::operator*=(U rhs)
 {
     for (std::size_t i = 0; i < M * N; ++i)
         values[i] *= rhs;
@@ -143,7 +178,7 @@ inline Matrix<T, M, N>& Matrix<T, M, N>::operator*=(U rhs)
 
 template<typename T, std::size_t M, std::size_t N>
 template<typename U>
-inline Matrix<T, M, N>& Matrix<T, M, N>::operator/=(U rhs)
+CGLA_CONSTEXPR Matrix<T, M, N>& Matrix<T, M, N>::operator/=(U rhs)
 {
     for (std::size_t i = 0; i < M * N; ++i)
         values[i] /= rhs;
@@ -152,7 +187,7 @@ inline Matrix<T, M, N>& Matrix<T, M, N>::operator/=(U rhs)
 }
 
 template<typename T, std::size_t M, std::size_t N>
-inline bool Matrix<T, M, N>::operator==(const Matrix<T, M, N>& rhs) const
+CGLA_CONSTEXPR bool Matrix<T, M, N>::operator==(const Matrix<T, M, N>& rhs) const
 {
     for (std::size_t i = 0; i < M * N; ++i)
         if (values[i] != rhs.values[i])
@@ -162,13 +197,13 @@ inline bool Matrix<T, M, N>::operator==(const Matrix<T, M, N>& rhs) const
 }
 
 template<typename T, std::size_t M, std::size_t N>
-inline bool Matrix<T, M, N>::operator!=(const Matrix<T, M, N>& rhs) const
+CGLA_CONSTEXPR bool Matrix<T, M, N>::operator!=(const Matrix<T, M, N>& rhs) const
 {
     return !(*this == rhs);
 }
 
 template<typename T, std::size_t M, std::size_t N>
-inline bool Matrix<T, M, N>::operator<(const Matrix<T, M, N>& rhs) const
+CGLA_CONSTEXPR bool Matrix<T, M, N>::operator<(const Matrix<T, M, N>& rhs) const
 {
     for (std::size_t i = 0; i < M * N; ++i)
         if (values[i] != rhs.values[i])
@@ -177,51 +212,189 @@ inline bool Matrix<T, M, N>::operator<(const Matrix<T, M, N>& rhs) const
     return false;
 }
 
+#ifndef CGLA_EXPRESSION_TEMPLATES
 template<typename T, std::size_t M, std::size_t N>
-inline Matrix<T, M, N> operator-(Matrix<T, M, N> rhs)
+CGLA_CONSTEXPR Matrix<T, M, N> operator-(Matrix<T, M, N> rhs)
 {
     return rhs *= -1;
 }
 
 template<typename T, std::size_t M, std::size_t N>
-inline Matrix<T, M, N> operator+(Matrix<T, M, N> lhs, const Matrix<T, M, N>& rhs)
+CGLA_CONSTEXPR Matrix<T, M, N> operator+(Matrix<T, M, N> lhs, const Matrix<T, M, N>& rhs)
 {
     return lhs += rhs;
 }
 
 template<typename T, std::size_t M, std::size_t N>
-inline Matrix<T, M, N> operator-(Matrix<T, M, N> lhs, const Matrix<T, M, N>& rhs)
+CGLA_CONSTEXPR Matrix<T, M, N> operator-(Matrix<T, M, N> lhs, const Matrix<T, M, N>& rhs)
 {
     return lhs -= rhs;
 }
 
 template<typename T, std::size_t M, std::size_t N, typename U>
-inline Matrix<T, M, N> operator*(Matrix<T, M, N> lhs, U rhs)
+CGLA_CONSTEXPR Matrix<T, M, N> operator*(Matrix<T, M, N> lhs, U rhs)
 {
     return lhs *= rhs;
 }
 
 template<typename T, std::size_t M, std::size_t N, typename U>
-inline Matrix<T, M, N> operator*(U lhs, Matrix<T, M, N> rhs)
+CGLA_CONSTEXPR Matrix<T, M, N> operator*(U lhs, Matrix<T, M, N> rhs)
 {
     return rhs *= lhs;
 }
+#endif
 
-template<typename T, std::size_t L, std::size_t M, std::size_t N>
-inline Matrix<T, L, N> operator*(const Matrix<T, L, M>& lhs, const Matrix<T, M, N>& rhs)
-{
-    Matrix<T, L, N> res;
+namespace detail {
+    // products of at least this many multiply-adds go through the blocked kernel, smaller ones are left to the compiler to unroll
+    constexpr std::size_t blockedProductSize = 16 * 16 * 16;
 
-    for (std::size_t j = 0; j < N; ++j)
-        for (std::size_t i = 0; i < L; ++i)
-            for (std::size_t k = 0; k < M; ++k)
-                res(i, j) += lhs(i, k) * rhs(k, j);
+    // rows x gemmKernelCols accumulators of the micro-kernel, sized to fit the vector registers
+    template<typename T>
+    struct GemmKernelRows : std::integral_constant<std::size_t, (sizeof(T) >= 8) ? 4 : 8> {};
 
-    return res;
+    constexpr std::size_t gemmKernelCols = 4;
+    constexpr std::size_t gemmTileRows = 64; // rows of the left operand kept in cache across a row of micro-tiles
+    constexpr std::size_t gemmTileDepth = 256; // inner dimension range of a cache tile
+
+    // c[R x C] += alpha * a[R x k] * b[k x C], a and c column-major with leading dimensions lda and ldc, b packed row by row
+    template<typename T, std::size_t R, std::size_t C>
+    inline void gemmKernel(std::size_t k, T alpha, const T* a, std::size_t lda, const T* b, T* c, std::size_t ldc)
+    {
+        T acc[C][R] = {};
+
+        for (std::size_t p = 0; p < k; ++p, a += lda, b += C)
+            for (std::size_t j = 0; j < C; ++j)
+                for (std::size_t i = 0; i < R; ++i)
+                    acc[j][i] += a[i] * b[j];
+
+        for (std::size_t j = 0; j < C; ++j)
+            for (std::size_t i = 0; i < R; ++i)
+                c[j * ldc + i] += alpha * acc[j][i];
+    }
+
+#ifdef CGLA_SSE
+    template<>
+    inline void gemmKernel<float, 8, 4>(std::size_t k, float alpha, const float* a, std::size_t lda, const float* b, float* c, std::size_t ldc)
+    {
+        __m128 acc[4][2];
+        for (std::size_t j = 0; j < 4; ++j)
+            acc[j][0] = acc[j][1] = _mm_setzero_ps();
+
+        for (std::size_t p = 0; p < k; ++p, a += lda, b += 4)
+        {
+            __m128 a0 = _mm_loadu_ps(a);
+            __m128 a1 = _mm_loadu_ps(a + 4);
+            __m128 row = _mm_loadu_ps(b);
+
+            __m128 s = _mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0));
+            acc[0][0] = _mm_add_ps(acc[0][0], _mm_mul_ps(a0, s));
+            acc[0][1] = _mm_add_ps(acc[0][1], _mm_mul_ps(a1, s));
+            s = _mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1));
+            acc[1][0] = _mm_add_ps(acc[1][0], _mm_mul_ps(a0, s));
+            acc[1][1] = _mm_add_ps(acc[1][1], _mm_mul_ps(a1, s));
+            s = _mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2));
+            acc[2][0] = _mm_add_ps(acc[2][0], _mm_mul_ps(a0, s));
+            acc[2][1] = _mm_add_ps(acc[2][1], _mm_mul_ps(a1, s));
+            s = _mm_shuffle_ps(row, row, _MM_SHUFFLE(3, 3, 3, 3));
+            acc[3][0] = _mm_add_ps(acc[3][0], _mm_mul_ps(a0, s));
+            acc[3][1] = _mm_add_ps(acc[3][1], _mm_mul_ps(a1, s));
+        }
+
+        __m128 scale = _mm_set1_ps(alpha);
+        for (std::size_t j = 0; j < 4; ++j, c += ldc)
+        {
+            _mm_storeu_ps(c, _mm_add_ps(_mm_loadu_ps(c), _mm_mul_ps(acc[j][0], scale)));
+            _mm_storeu_ps(c + 4, _mm_add_ps(_mm_loadu_ps(c + 4), _mm_mul_ps(acc[j][1], scale)));
+        }
+    }
+#endif
+
+    // same as gemmKernel for the partial tiles on the bottom and right edges (the packed b is zero-padded to C columns)
+    template<typename T, std::size_t R, std::size_t C>
+    inline void gemmEdge(std::size_t rows, std::size_t cols, std::size_t k, T alpha, const T* a, std::size_t lda, const T* b, T* c, std::size_t ldc)
+    {
+        T acc[C][R] = {};
+
+        for (std::size_t p = 0; p < k; ++p, a += lda, b += C)
+            for (std::size_t j = 0; j < C; ++j)
+                for (std::size_t i = 0; i < rows; ++i)
+                    acc[j][i] += a[i] * b[j];
+
+        for (std::size_t j = 0; j < cols; ++j)
+            for (std::size_t i = 0; i < rows; ++i)
+                c[j * ldc + i] += alpha * acc[j][i];
+    }
+
+    // c[m x n] += alpha * a[m x k] * b[k x n], column-major with leading dimensions lda, ldb and ldc
+    template<typename T>
+    inline void gemm(std::size_t m, std::size_t n, std::size_t k, T alpha, const T* a, std::size_t lda, const T* b, std::size_t ldb, T* c, std::size_t ldc)
+    {
+        constexpr std::size_t R = GemmKernelRows<T>::value;
+        constexpr std::size_t C = gemmKernelCols;
+        T packed[gemmTileDepth * C];
+
+        for (std::size_t p = 0; p < k; p += gemmTileDepth)
+        {
+            std::size_t depth = (k - p < gemmTileDepth) ? k - p : gemmTileDepth;
+
+            for (std::size_t i0 = 0; i0 < m; i0 += gemmTileRows)
+            {
+                std::size_t end = (m - i0 < gemmTileRows) ? m : i0 + gemmTileRows;
+
+                for (std::size_t j = 0; j < n; j += C)
+                {
+                    // the rows of the b sliver are interleaved so that the kernel reads it sequentially
+                    std::size_t cols = (n - j < C) ? n - j : C;
+                    for (std::size_t q = 0; q < depth; ++q)
+                        for (std::size_t jj = 0; jj < C; ++jj)
+                            packed[q * C + jj] = (jj < cols) ? b[(j + jj) * ldb + p + q] : static_cast<T>(0);
+
+                    for (std::size_t i = i0; i < end; i += R)
+                    {
+                        const T* ap = a + p * lda + i;
+                        T* cp = c + j * ldc + i;
+
+                        if (i + R <= end && cols == C)
+                            gemmKernel<T, R, C>(depth, alpha, ap, lda, packed, cp, ldc);
+                        else
+                            gemmEdge<T, R, C>((end - i < R) ? end - i : R, cols, depth, alpha, ap, lda, packed, cp, ldc);
+                    }
+                }
+            }
+        }
+    }
+
+    template<typename T, std::size_t L, std::size_t M, std::size_t N>
+    CGLA_CONSTEXPR Matrix<T, L, N> multiply(const Matrix<T, L, M>& lhs, const Matrix<T, M, N>& rhs, std::false_type)
+    {
+        Matrix<T, L, N> res;
+
+        for (std::size_t j = 0; j < N; ++j)
+            for (std::size_t i = 0; i < L; ++i)
+                for (std::size_t k = 0; k < M; ++k)
+                    res(i, j) += lhs(i, k) * rhs(k, j);
+
+        return res;
+    }
+
+    template<typename T, std::size_t L, std::size_t M, std::size_t N>
+    inline Matrix<T, L, N> multiply(const Matrix<T, L, M>& lhs, const Matrix<T, M, N>& rhs, std::true_type)
+    {
+        Matrix<T, L, N> res;
+        gemm(L, N, M, static_cast<T>(1), lhs.data(), L, rhs.data(), M, res.data(), L);
+
+        return res;
+    }
+}
+
+template<typename T, std::size_t L, std::size_t M, std::size_t N>
+CGLA_CONSTEXPR Matrix<T, L, N> operator*(const Matrix<T, L, M>& lhs, const Matrix<T, M, N>& rhs)
+{
+    return detail::multiply(lhs, rhs, std::integral_constant<bool, (L * M * N >= detail::blockedProductSize)>{});
 }
 
 template<typename T, std::size_t M, std::size_t N>
-inline Vector<T, M> operator*(const Matrix<T, M, N>& lhs, const Vector<T, N>& rhs)
+CGLA_CONSTEXPR Vector<T, M> operator*(const Matrix<T, M, N>& lhs, const Vector<T, N>& rhs)
 {
     Vector<T, M> res;
 
@@ -233,7 +406,7 @@ inline Vector<T, M> operator*(const Matrix<T, M, N>& lhs, const Vector<T, N>& rh
 }
 
 template<typename T, std::size_t M, std::size_t N>
-inline Vector<T, N> operator*(const Vector<T, M>& lhs, const Matrix<T, M, N>& rhs)
+CGLA_CONSTEXPR Vector<T, N> operator*(const Vector<T, M>& lhs, const Matrix<T, M, N>& rhs)
 {
     Vector<T, N> res;
 
@@ -244,11 +417,31 @@ inline Vector<T, N> operator*(const Vector<T, M>& lhs, const Matrix<T, M, N>& rh
     return res;
 }
 
+#ifdef CGLA_EXPRESSION_TEMPLATES
+template<typename Op, typename L, typename R, typename Result, typename Rhs, typename>
+CGLA_CONSTEXPR auto operator*(const detail::Expression<Op, L, R, Result>& lhs, const Rhs& rhs) -> decltype(std::declval<const Result&>() * rhs)
+{
+    return Result(lhs) * rhs;
+}
+
+template<typename Lhs, typename Op, typename L, typename R, typename Result, typename>
+CGLA_CONSTEXPR auto operator*(const Lhs& lhs, const detail::Expression<Op, L, R, Result>& rhs) -> decltype(lhs * std::declval<const Result&>())
+{
+    return lhs * Result(rhs);
+}
+
+template<typename Op1, typename L1, typename R1, typename Result1, typename Op2, typename L2, typename R2, typename Result2, typename>
+CGLA_CONSTEXPR auto operator*(const detail::Expression<Op1, L1, R1, Result1>& lhs, const detail::Expression<Op2, L2, R2, Result2>& rhs) -> decltype(std::declval<const Result1&>() * std::declval<const Result2&>())
+{
+    return Result1(lhs) * Result2(rhs);
+}
+#else
 template<typename T, std::size_t M, std::size_t N, typename U>
-inline Matrix<T, M, N> operator/(Matrix<T, M, N> lhs, U rhs)
+CGLA_CONSTEXPR Matrix<T, M, N> operator/(Matrix<T, M, N> lhs, U rhs)
 {
     return lhs /= rhs;
 }
+#endif
 
 #ifdef CGLA_OSTREAM_OVERLOADS
 template<typename T, std::size_t M, std::size_t N>
@@ -278,7 +471,7 @@ std::ostream& operator<<(std::ostream& lhs, const Matrix<T, M, N>& rhs)
 #endif
 
 template<typename T, std::size_t M, std::size_t N>
-inline Matrix<T, N, M> transpose(const Matrix<T, M, N>& mat)
+CGLA_CONSTEXPR Matrix<T, N, M> transpose(const Matrix<T, M, N>& mat)
 {
     Matrix<T, N, M> res;
 
@@ -290,79 +483,731 @@ inline Matrix<T, N, M> transpose(const Matrix<T, M, N>& mat)
 }
 
 template<typename T, std::size_t M>
-Matrix<T, M, M> inverse(Matrix<T, M, M> mat)
+inline T determinant(const Matrix<T, M, M>& mat)
 {
-    Matrix<T, M, M> inv{static_cast<T>(1)};
+    return detail::determinant(mat);
+}
 
-    for (std::size_t j = 0; j < M; ++j)
+template<typename T, std::size_t M>
+inline Matrix<T, M, M> inverse(const Matrix<T, M, M>& mat)
+{
+    Matrix<T, M, M> res{uninitialized};
+    if (!detail::invert(mat, res))
+        detail::fillNaN(res);
+
+    return res;
+}
+
+template<typename T, std::size_t M>
+inline bool tryInverse(const Matrix<T, M, M>& mat, Matrix<T, M, M>& res)
+{
+    return detail::invert(mat, res);
+}
+
+template<typename T>
+inline Matrix<T, 4, 4> affineInverse(const Matrix<T, 4, 4>& mat)
+{
+    Matrix<T, 3, 3> a{mat[0], mat[1], mat[2], mat[4], mat[5], mat[6], mat[8], mat[9], mat[10]};
+    Matrix<T, 3, 3> inv{uninitialized};
+    if (!detail::invert(a, inv))
+        detail::fillNaN(inv);
+
+    Matrix<T, 4, 4> res{uninitialized};
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+        for (std::size_t i = 0; i < 3; ++i)
+            res(i, j) = inv(i, j);
+        res(3, j) = static_cast<T>(0);
+    }
+
+    for (std::size_t i = 0; i < 3; ++i)
+        res(i, 3) = -(inv(i, 0) * mat[12] + inv(i, 1) * mat[13] + inv(i, 2) * mat[14]);
+    res(3, 3) = static_cast<T>(1);
+
+    return res;
+}
+
+template<typename T>
+inline Matrix<T, 4, 4> rigidInverse(const Matrix<T, 4, 4>& mat)
+{
+    Matrix<T, 4, 4> res{uninitialized};
+
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+        for (std::size_t i = 0; i < 3; ++i)
+            res(i, j) = mat(j, i);
+        res(3, j) = static_cast<T>(0);
+    }
+
+    for (std::size_t i = 0; i < 3; ++i)
+        res(i, 3) = -(mat(0, i) * mat[12] + mat(1, i) * mat[13] + mat(2, i) * mat[14]);
+    res(3, 3) = static_cast<T>(1);
+
+    return res;
+}
+
+template<typename T, std::size_t M, std::size_t N>
+CGLA_CONSTEXPR Matrix<T, M, N> matrixCompMult(const Matrix<T, M, N>& x, const Matrix<T, M, N>& y)
+{
+    Matrix<T, M, N> res;
+
+    for (std::size_t i = 0; i < M * N; ++i)
+        res[i] = x[i] * y[i];
+
+    return res;
+}
+
+template<typename T, std::size_t M, std::size_t N>
+CGLA_CONSTEXPR Matrix<T, M, N> outerProduct(const Vector<T, M>& u, const Vector<T, N>& v)
+{
+    Matrix<T, M, N> res;
+
+    for (std::size_t j = 0; j < N; ++j)
+        for (std::size_t i = 0; i < M; ++i)
+            res(i, j) = u[i] * v[j];
+
+    return res;
+}
+
+#ifdef CGLA_EXPRESSION_TEMPLATES
+template<typename E, typename>
+CGLA_CONSTEXPR auto transpose(const E& mat) -> decltype(transpose(detail::evaluate(mat)))
+{
+    return transpose(detail::evaluate(mat));
+}
+
+template<typename E, typename>
+inline auto determinant(const E& mat) -> decltype(determinant(detail::evaluate(mat)))
+{
+    return determinant(detail::evaluate(mat));
+}
+
+template<typename E, typename>
+inline auto inverse(const E& mat) -> decltype(inverse(detail::evaluate(mat)))
+{
+    return inverse(detail::evaluate(mat));
+}
+
+template<typename E, typename Res, typename>
+inline auto tryInverse(const E& mat, Res& res) -> decltype(tryInverse(detail::evaluate(mat), res))
+{
+    return tryInverse(detail::evaluate(mat), res);
+}
+
+template<typename E, typename>
+inline auto affineInverse(const E& mat) -> decltype(affineInverse(detail::evaluate(mat)))
+{
+    return affineInverse(detail::evaluate(mat));
+}
+
+template<typename E, typename>
+inline auto rigidInverse(const E& mat) -> decltype(rigidInverse(detail::evaluate(mat)))
+{
+    return rigidInverse(detail::evaluate(mat));
+}
+
+template<typename L, typename R, typename>
+CGLA_CONSTEXPR auto matrixCompMult(const L& x, const R& y) -> decltype(matrixCompMult(detail::evaluate(x), detail::evaluate(y)))
+{
+    return matrixCompMult(detail::evaluate(x), detail::evaluate(y));
+}
+
+template<typename L, typename R, typename>
+CGLA_CONSTEXPR auto outerProduct(const L& u, const R& v) -> decltype(outerProduct(detail::evaluate(u), detail::evaluate(v)))
+{
+    return outerProduct(detail::evaluate(u), detail::evaluate(v));
+}
+#endif
+
+namespace detail {
+    // the inverse of a singular matrix is all NaN (all zeros for integer types)
+    template<typename T, std::size_t M, std::size_t N>
+    inline void fillNaN(Matrix<T, M, N>& mat)
+    {
+        for (std::size_t i = 0; i < M * N; ++i)
+            mat[i] = std::numeric_limits<T>::quiet_NaN();
+    }
+
+    // the closed-form inverses treat a matrix as singular when its determinant is within the rounding error of the cofactor
+    // expansion, |det| <= M * epsilon * (product of the largest magnitude of each column), which is exact for integer types
+    template<typename T, std::size_t M>
+    inline bool negligibleDeterminant(const Matrix<T, M, M>& mat, T det)
+    {
+        T bound = static_cast<T>(M) * std::numeric_limits<T>::epsilon();
+
+        for (std::size_t j = 0; j < M; ++j)
+        {
+            T largest = static_cast<T>(0);
+            for (std::size_t i = 0; i < M; ++i)
+                largest = std::max(largest, static_cast<T>(std::abs(mat(i, j))));
+            bound *= largest;
+        }
+
+        return std::abs(det) <= bound;
+    }
+
+    // matrices of at least this order are inverted through a blocked LU factorization
+    constexpr std::size_t blockedInverseOrder = 16;
+    constexpr std::size_t luBlockSize = 16;
+
+    // in-place LU factorization with partial pivoting (PA = LU, L unit lower triangular), row i was swapped with row pivots[i]
+    // a singular matrix is factored completely, with zeros on the diagonal of U, and false is returned
+    template<typename T, std::size_t M>
+    inline bool luFactor(Matrix<T, M, M>& mat, std::size_t (&pivots)[M])
+    {
+        T* a = mat.data();
+        bool regular = true;
+
+        for (std::size_t k = 0; k < M; k += luBlockSize)
+        {
+            std::size_t end = (M - k < luBlockSize) ? M : k + luBlockSize;
+
+            for (std::size_t j = k; j < end; ++j)
+            {
+                std::size_t p = j;
+                T pval = std::abs(a[j * M + j]);
+
+                for (std::size_t i = j + 1; i < M; ++i)
+                {
+                    T val = std::abs(a[j * M + i]);
+                    if (val > pval)
+                    {
+                        p = i;
+                        pval = val;
+                    }
+                }
+
+                pivots[j] = p;
+                if (pval == static_cast<T>(0))
+                {
+                    // the column is already eliminated
+                    regular = false;
+                    continue;
+                }
+
+                if (p != j)
+                    for (std::size_t c = 0; c < M; ++c)
+                        std::swap(a[c * M + j], a[c * M + p]);
+
+                T* col = a + j * M;
+                T invPivot = static_cast<T>(1) / col[j];
+                for (std::size_t i = j + 1; i < M; ++i)
+                    col[i] *= invPivot;
+
+                for (std::size_t c = j + 1; c < end; ++c)
+                {
+                    T* dst = a + c * M;
+                    T s = dst[j];
+                    for (std::size_t i = j + 1; i < M; ++i)
+                        dst[i] -= col[i] * s;
+                }
+            }
+
+            // rows of U right of the panel, then the rank-update of the trailing matrix
+            for (std::size_t c = end; c < M; ++c)
+            {
+                T* dst = a + c * M;
+                for (std::size_t j = k; j < end; ++j)
+                {
+                    T s = dst[j];
+                    for (std::size_t i = j + 1; i < end; ++i)
+                        dst[i] -= a[j * M + i] * s;
+                }
+            }
+
+            if (end < M)
+                gemm(M - end, M - end, end - k, static_cast<T>(-1), a + k * M + end, M, a + end * M + k, M, a + end * M + end, M);
+        }
+
+        return regular;
+    }
+
+    // solves A X = B in place of B given the factorization of A computed by luFactor
+    template<typename T, std::size_t M, std::size_t N>
+    inline void luSolve(const Matrix<T, M, M>& lu, const std::size_t (&pivots)[M], Matrix<T, M, N>& b)
     {
-        std::size_t p = j;
-        T pval = std::abs(mat(j, j));
+        const T* a = lu.data();
+        T* x = b.data();
+
+        for (std::size_t i = 0; i < M; ++i)
+            if (pivots[i] != i)
+                for (std::size_t c = 0; c < N; ++c)
+                    std::swap(x[c * M + i], x[c * M + pivots[i]]);
 
-        for (std::size_t k = j + 1; k < M; ++k)
+        for (std::size_t k = 0; k < M; k += luBlockSize)
         {
-            T val = std::abs(mat(j, k));
-            if (val > pval)
+            std::size_t end = (M - k < luBlockSize) ? M : k + luBlockSize;
+
+            for (std::size_t c = 0; c < N; ++c)
             {
-                p = k;
-                pval = val;
+                T* col = x + c * M;
+                for (std::size_t j = k; j < end; ++j)
+                {
+                    T s = col[j];
+                    for (std::size_t i = j + 1; i < end; ++i)
+                        col[i] -= a[j * M + i] * s;
+                }
             }
+
+            if (end < M)
+                gemm(M - end, N, end - k, static_cast<T>(-1), a + k * M + end, M, x + k, M, x + end, M);
         }
 
-        if (p != j)
+        for (std::size_t end = M; end > 0;)
         {
-            for (std::size_t i = 0; i < M; ++i)
+            std::size_t k = ((end - 1) / luBlockSize) * luBlockSize;
+
+            for (std::size_t c = 0; c < N; ++c)
             {
-                std::swap(mat(i, j), mat(i, p));
-                std::swap(inv(i, j), inv(i, p));
+                T* col = x + c * M;
+                for (std::size_t j = end; j-- > k;)
+                {
+                    col[j] /= a[j * M + j];
+                    T s = col[j];
+                    for (std::size_t i = k; i < j; ++i)
+                        col[i] -= a[j * M + i] * s;
+                }
             }
+
+            if (k > 0)
+                gemm(k, N, end - k, static_cast<T>(-1), a + k * M, M, x + k, M, x, M);
+
+            end = k;
         }
+    }
 
-        T coeff = mat(j, j);
-        for (std::size_t i = 0; i < M; ++i)
+    template<typename T, std::size_t M>
+    inline T determinant(Matrix<T, M, M> mat, std::true_type)
+    {
+        std::size_t pivots[M];
+        if (!luFactor(mat, pivots))
+            return static_cast<T>(0);
+
+        T det = static_cast<T>(1);
+        for (std::size_t j = 0; j < M; ++j)
+            det *= (pivots[j] != j) ? -mat(j, j) : mat(j, j);
+
+        return det;
+    }
+
+    template<typename T, std::size_t M>
+    inline T determinant(Matrix<T, M, M> mat, std::false_type)
+    {
+        T det = static_cast<T>(1);
+
+        for (std::size_t j = 0; j < M; ++j)
         {
-            mat(i, j) /= coeff;
-            inv(i, j) /= coeff;
+            std::size_t p = j;
+            T pval = std::abs(mat(j, j));
+
+            for (std::size_t i = j + 1; i < M; ++i)
+            {
+                T val = std::abs(mat(i, j));
+                if (val > pval)
+                {
+                    p = i;
+                    pval = val;
+                }
+            }
+
+            if (pval == static_cast<T>(0))
+                return static_cast<T>(0);
+
+            if (p != j)
+            {
+                for (std::size_t k = j; k < M; ++k)
+                    std::swap(mat(j, k), mat(p, k));
+                det = -det;
+            }
+
+            det *= mat(j, j);
+
+            for (std::size_t i = j + 1; i < M; ++i)
+            {
+                T coeff = mat(i, j) / mat(j, j);
+                for (std::size_t k = j + 1; k < M; ++k)
+                    mat(i, k) -= coeff * mat(j, k);
+            }
         }
 
-        for (std::size_t i = 0; i < M; ++i)
+        return det;
+    }
+
+    template<typename T, std::size_t M>
+    inline T determinant(Matrix<T, M, M> mat)
+    {
+        return determinant(mat, std::integral_constant<bool, (M >= blockedInverseOrder)>{});
+    }
+
+    template<typename T>
+    inline T determinant(const Matrix<T, 1, 1>& mat)
+    {
+        return mat[0];
+    }
+
+    template<typename T>
+    inline T determinant(const Matrix<T, 2, 2>& mat)
+    {
+        return mat[0] * mat[3] - mat[2] * mat[1];
+    }
+
+    template<typename T>
+    inline T determinant(const Matrix<T, 3, 3>& mat)
+    {
+        return mat[0] * (mat[4] * mat[8] - mat[7] * mat[5])
+             - mat[3] * (mat[1] * mat[8] - mat[7] * mat[2])
+             + mat[6] * (mat[1] * mat[5] - mat[4] * mat[2]);
+    }
+
+    template<typename T>
+    inline T determinant(const Matrix<T, 4, 4>& mat)
+    {
+        T s0 = mat[0] * mat[5] - mat[4] * mat[1];
+        T s1 = mat[0] * mat[9] - mat[8] * mat[1];
+        T s2 = mat[0] * mat[13] - mat[12] * mat[1];
+        T s3 = mat[4] * mat[9] - mat[8] * mat[5];
+        T s4 = mat[4] * mat[13] - mat[12] * mat[5];
+        T s5 = mat[8] * mat[13] - mat[12] * mat[9];
+        T c5 = mat[10] * mat[15] - mat[14] * mat[11];
+        T c4 = mat[6] * mat[15] - mat[14] * mat[7];
+        T c3 = mat[6] * mat[11] - mat[10] * mat[7];
+        T c2 = mat[2] * mat[15] - mat[14] * mat[3];
+        T c1 = mat[2] * mat[11] - mat[10] * mat[3];
+        T c0 = mat[2] * mat[7] - mat[6] * mat[3];
+
+        return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    }
+
+    template<typename T, std::size_t M>
+    inline bool invert(Matrix<T, M, M> mat, Matrix<T, M, M>& inv, std::true_type)
+    {
+        std::size_t pivots[M];
+        if (!luFactor(mat, pivots))
+            return false;
+
+        inv = Matrix<T, M, M>{static_cast<T>(1)};
+        luSolve(mat, pivots, inv);
+
+        return true;
+    }
+
+    template<typename T, std::size_t M>
+    inline bool invert(Matrix<T, M, M> mat, Matrix<T, M, M>& inv, std::false_type)
+    {
+        inv = Matrix<T, M, M>{static_cast<T>(1)};
+
+        for (std::size_t j = 0; j < M; ++j)
         {
-            if (i != j)
+            std::size_t p = j;
+            T pval = std::abs(mat(j, j));
+
+            for (std::size_t k = j + 1; k < M; ++k)
             {
-                T coeff = mat(j, i);
-                for (std::size_t k = 0; k < M; ++k)
+                T val = std::abs(mat(j, k));
+                if (val > pval)
+                {
+                    p = k;
+                    pval = val;
+                }
+            }
+
+            if (p != j)
+            {
+                for (std::size_t i = 0; i < M; ++i)
+                {
+                    std::swap(mat(i, j), mat(i, p));
+                    std::swap(inv(i, j), inv(i, p));
+                }
+            }
+
+            T coeff = mat(j, j);
+            if (coeff == static_cast<T>(0))
+                return false;
+
+            for (std::size_t i = 0; i < M; ++i)
+            {
+                mat(i, j) /= coeff;
+                inv(i, j) /= coeff;
+            }
+
+            for (std::size_t i = 0; i < M; ++i)
+            {
+                if (i != j)
                 {
-                    mat(k, i) -= coeff * mat(k, j);
-                    inv(k, i) -= coeff * inv(k, j);
+                    T coeff = mat(j, i);
+                    for (std::size_t k = 0; k < M; ++k)
+                    {
+                        mat(k, i) -= coeff * mat(k, j);
+                        inv(k, i) -= coeff * inv(k, j);
+                    }
                 }
             }
         }
+
+        return true;
     }
 
-    return inv;
+    template<typename T, std::size_t M>
+    inline bool invert(Matrix<T, M, M> mat, Matrix<T, M, M>& inv)
+    {
+        return invert(mat, inv, std::integral_constant<bool, (M >= blockedInverseOrder)>{});
+    }
+
+    template<typename T>
+    inline bool invert(const Matrix<T, 2, 2>& mat, Matrix<T, 2, 2>& res)
+    {
+        T det = determinant(mat);
+        if (negligibleDeterminant(mat, det))
+            return false;
+
+        T invDet = static_cast<T>(1) / det;
+        T a = mat[0], b = mat[1], c = mat[2], d = mat[3];
+
+        res[0] = d * invDet;
+        res[1] = -b * invDet;
+        res[2] = -c * invDet;
+        res[3] = a * invDet;
+
+        return true;
+    }
+
+    template<typename T>
+    inline bool invert(const Matrix<T, 3, 3>& mat, Matrix<T, 3, 3>& res)
+    {
+        T c0 = mat[4] * mat[8] - mat[7] * mat[5];
+        T c1 = mat[7] * mat[2] - mat[1] * mat[8];
+        T c2 = mat[1] * mat[5] - mat[4] * mat[2];
+
+        T det = mat[0] * c0 + mat[3] * c1 + mat[6] * c2;
+        if (negligibleDeterminant(mat, det))
+            return false;
+
+        T invDet = static_cast<T>(1) / det;
+        Matrix<T, 3, 3> m = mat;
+
+        res[0] = c0 * invDet;
+        res[1] = c1 * invDet;
+        res[2] = c2 * invDet;
+        res[3] = (m[6] * m[5] - m[3] * m[8]) * invDet;
+        res[4] = (m[0] * m[8] - m[6] * m[2]) * invDet;
+        res[5] = (m[3] * m[2] - m[0] * m[5]) * invDet;
+        res[6] = (m[3] * m[7] - m[6] * m[4]) * invDet;
+        res[7] = (m[6] * m[1] - m[0] * m[7]) * invDet;
+        res[8] = (m[0] * m[4] - m[3] * m[1]) * invDet;
+
+        return true;
+    }
+
+    template<typename T>
+    inline bool invert(const Matrix<T, 4, 4>& mat, Matrix<T, 4, 4>& res)
+    {
+        const T* m = mat.data();
+
+        T s0 = m[0] * m[5] - m[4] * m[1];
+        T s1 = m[0] * m[9] - m[8] * m[1];
+        T s2 = m[0] * m[13] - m[12] * m[1];
+        T s3 = m[4] * m[9] - m[8] * m[5];
+        T s4 = m[4] * m[13] - m[12] * m[5];
+        T s5 = m[8] * m[13] - m[12] * m[9];
+        T c5 = m[10] * m[15] - m[14] * m[11];
+        T c4 = m[6] * m[15] - m[14] * m[7];
+        T c3 = m[6] * m[11] - m[10] * m[7];
+        T c2 = m[2] * m[15] - m[14] * m[3];
+        T c1 = m[2] * m[11] - m[10] * m[3];
+        T c0 = m[2] * m[7] - m[6] * m[3];
+
+        T det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        if (negligibleDeterminant(mat, det))
+            return false;
+
+        T invDet = static_cast<T>(1) / det;
+        Matrix<T, 4, 4> a = mat;
+
+        res[0] = (a[5] * c5 - a[9] * c4 + a[13] * c3) * invDet;
+        res[4] = (-a[4] * c5 + a[8] * c4 - a[12] * c3) * invDet;
+        res[8] = (a[7] * s5 - a[11] * s4 + a[15] * s3) * invDet;
+        res[12] = (-a[6] * s5 + a[10] * s4 - a[14] * s3) * invDet;
+
+        res[1] = (-a[1] * c5 + a[9] * c2 - a[13] * c1) * invDet;
+        res[5] = (a[0] * c5 - a[8] * c2 + a[12] * c1) * invDet;
+        res[9] = (-a[3] * s5 + a[11] * s2 - a[15] * s1) * invDet;
+        res[13] = (a[2] * s5 - a[10] * s2 + a[14] * s1) * invDet;
+
+        res[2] = (a[1] * c4 - a[5] * c2 + a[13] * c0) * invDet;
+        res[6] = (-a[0] * c4 + a[4] * c2 - a[12] * c0) * invDet;
+        res[10] = (a[3] * s4 - a[7] * s2 + a[15] * s0) * invDet;
+        res[14] = (-a[2] * s4 + a[6] * s2 - a[14] * s0) * invDet;
+
+        res[3] = (-a[1] * c3 + a[5] * c1 - a[9] * c0) * invDet;
+        res[7] = (a[0] * c3 - a[4] * c1 + a[8] * c0) * invDet;
+        res[11] = (-a[3] * s3 + a[7] * s1 - a[11] * s0) * invDet;
+        res[15] = (a[2] * s3 - a[6] * s1 + a[10] * s0) * invDet;
+
+        return true;
+    }
 }
 
-template<typename T, std::size_t M, std::size_t N>
-inline Matrix<T, M, N> matrixCompMult(const Matrix<T, M, N>& x, const Matrix<T, M, N>& y)
+#ifdef CGLA_SSE
+namespace detail {
+    // the SSE specializations below take the generic loops during constant evaluation
+    CGLA_CONSTEXPR bool constantEvaluated()
+    {
+#ifdef CGLA_CONSTANT_EVALUATED
+        return __builtin_is_constant_evaluated();
+#else
+        return false;
+#endif
+    }
+
+    inline void add4x4(float* lhs, const float* rhs)
+    {
+        for (std::size_t i = 0; i < 16; i += 4)
+            _mm_storeu_ps(lhs + i, _mm_add_ps(_mm_loadu_ps(lhs + i), _mm_loadu_ps(rhs + i)));
+    }
+
+    inline void subtract4x4(float* lhs, const float* rhs)
+    {
+        for (std::size_t i = 0; i < 16; i += 4)
+            _mm_storeu_ps(lhs + i, _mm_sub_ps(_mm_loadu_ps(lhs + i), _mm_loadu_ps(rhs + i)));
+    }
+
+    inline void scale4x4(float* lhs, float rhs)
+    {
+        __m128 s = _mm_set1_ps(rhs);
+        for (std::size_t i = 0; i < 16; i += 4)
+            _mm_storeu_ps(lhs + i, _mm_mul_ps(_mm_loadu_ps(lhs + i), s));
+    }
+
+    inline Matrix<float, 4, 4> multiply4x4(const Matrix<float, 4, 4>& lhs, const Matrix<float, 4, 4>& rhs)
+    {
+        Matrix<float, 4, 4> res{uninitialized};
+
+        const float* a = lhs.data();
+        const float* b = rhs.data();
+        __m128 c0 = _mm_loadu_ps(a);
+        __m128 c1 = _mm_loadu_ps(a + 4);
+        __m128 c2 = _mm_loadu_ps(a + 8);
+        __m128 c3 = _mm_loadu_ps(a + 12);
+
+        for (std::size_t j = 0; j < 16; j += 4)
+        {
+            __m128 col = _mm_mul_ps(c0, _mm_set1_ps(b[j]));
+            col = _mm_add_ps(col, _mm_mul_ps(c1, _mm_set1_ps(b[j + 1])));
+            col = _mm_add_ps(col, _mm_mul_ps(c2, _mm_set1_ps(b[j + 2])));
+            col = _mm_add_ps(col, _mm_mul_ps(c3, _mm_set1_ps(b[j + 3])));
+            _mm_storeu_ps(res.data() + j, col);
+        }
+
+        return res;
+    }
+
+    inline Vector<float, 4> multiply4x4(const Matrix<float, 4, 4>& lhs, const Vector<float, 4>& rhs)
+    {
+        Vector<float, 4> res{uninitialized};
+
+        const float* a = lhs.data();
+        __m128 col = _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(rhs[0]));
+        col = _mm_add_ps(col, _mm_mul_ps(_mm_loadu_ps(a + 4), _mm_set1_ps(rhs[1])));
+        col = _mm_add_ps(col, _mm_mul_ps(_mm_loadu_ps(a + 8), _mm_set1_ps(rhs[2])));
+        col = _mm_add_ps(col, _mm_mul_ps(_mm_loadu_ps(a + 12), _mm_set1_ps(rhs[3])));
+        _mm_storeu_ps(res.data(), col);
+
+        return res;
+    }
+
+    inline Matrix<float, 4, 4> transpose4x4(const Matrix<float, 4, 4>& mat)
+    {
+        Matrix<float, 4, 4> res{uninitialized};
+
+        __m128 c0 = _mm_loadu_ps(mat.data());
+        __m128 c1 = _mm_loadu_ps(mat.data() + 4);
+        __m128 c2 = _mm_loadu_ps(mat.data() + 8);
+        __m128 c3 = _mm_loadu_ps(mat.data() + 12);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        _mm_storeu_ps(res.data(), c0);
+        _mm_storeu_ps(res.data() + 4, c1);
+        _mm_storeu_ps(res.data() + 8, c2);
+        _mm_storeu_ps(res.data() + 12, c3);
+
+        return res;
+    }
+}
+
+template<>
+CGLA_SSE_CONSTEXPR Matrix<float, 4, 4>& Matrix<float, 4, 4>::operator+=(const Matrix<float, 4, 4>& rhs)
 {
-    Matrix<T, M, N> res;
+    if (!detail::constantEvaluated())
+        detail::add4x4(values, rhs.values);
+    else
+        for (std::size_t i = 0; i < 16; ++i)
+            values[i] += rhs.values[i];
 
-    for (std::size_t i = 0; i < M * N; ++i)
-        res[i] = x[i] * y[i];
+    return *this;
+}
+
+template<>
+CGLA_SSE_CONSTEXPR Matrix<float, 4, 4>& Matrix<float, 4, 4>::operator-=(const Matrix<float, 4, 4>& rhs)
+{
+    if (!detail::constantEvaluated())
+        detail::subtract4x4(values, rhs.values);
+    else
+        for (std::size_t i = 0; i < 16; ++i)
+            values[i] -= rhs.values[i];
+
+    return *this;
+}
+
+template<>
+template<>
+CGLA_SSE_CONSTEXPR Matrix<float, 4, 4>& Matrix<float, 4, 4>::operator*=<float>(float rhs)
+{
+    if (!detail::constantEvaluated())
+        detail::scale4x4(values, rhs);
+    else
+        for (std::size_t i = 0; i < 16; ++i)
+            values[i] *= rhs;
+
+    return *this;
+}
+
+template<>
+CGLA_SSE_CONSTEXPR Matrix<float, 4, 4> operator*<float, 4, 4, 4>(const Matrix<float, 4, 4>& lhs, const Matrix<float, 4, 4>& rhs)
+{
+    if (!detail::constantEvaluated())
+        return detail::multiply4x4(lhs, rhs);
+
+    return detail::multiply(lhs, rhs, std::false_type{});
+}
+
+template<>
+CGLA_SSE_CONSTEXPR Vector<float, 4> operator*<float, 4, 4>(const Matrix<float, 4, 4>& lhs, const Vector<float, 4>& rhs)
+{
+    if (!detail::constantEvaluated())
+        return detail::multiply4x4(lhs, rhs);
+
+    Vector<float, 4> res;
+
+    for (std::size_t i = 0; i < 4; ++i)
+        for (std::size_t j = 0; j < 4; ++j)
+            res[i] += lhs(i, j) * rhs[j];
 
     return res;
 }
 
-template<typename T, std::size_t M, std::size_t N>
-inline Matrix<T, M, N> outerProduct(const Vector<T, M>& u, const Vector<T, N>& v)
+template<>
+CGLA_SSE_CONSTEXPR Matrix<float, 4, 4> transpose<float, 4, 4>(const Matrix<float, 4, 4>& mat)
 {
-    Matrix<T, M, N> res;
+    if (!detail::constantEvaluated())
+        return detail::transpose4x4(mat);
 
-    for (std::size_t j = 0; j < N; ++j)
-        for (std::size_t i = 0; i < M; ++i)
-            res(i, j) = u[i] * v[j];
+    Matrix<float, 4, 4> res;
+
+    for (std::size_t j = 0; j < 4; ++j)
+        for (std::size_t i = 0; i < 4; ++i)
+            res(i, j) = mat(j, i);
 
     return res;
 }
+#endif
 
 }
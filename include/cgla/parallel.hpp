@@ -0,0 +1,65 @@
+#ifndef CGLA_PARALLEL_HPP
+#define CGLA_PARALLEL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "config.hpp"
+
+namespace cgla {
+
+// work-stealing pool : each worker runs the tasks of its own queue last in first out and steals the oldest tasks of the others
+class ThreadPool
+{
+    public:
+        explicit ThreadPool(std::size_t workerCount);
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ~ThreadPool();
+
+        std::size_t size() const;
+
+        // calls f(begin, end) on chunks of [0, count) of about grainSize items, the calling thread runs chunks too until all are done
+        // and then rethrows the first exception thrown by a chunk
+        template<typename F> void parallelFor(std::size_t count, std::size_t grainSize, const F& f);
+
+        // pool shared by the library, with one worker per hardware thread besides the calling thread
+        static ThreadPool& global();
+
+    private:
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        void submit(std::function<void()> task);
+        bool runOne();
+        void work(std::size_t index);
+        static std::size_t& currentQueue();
+
+        std::vector<std::unique_ptr<Queue>> queues; // one per worker, the last one receives the tasks of other threads
+        std::vector<std::thread> workers;
+        std::atomic<std::size_t> pending;
+        std::mutex sleepMutex;
+        std::condition_variable wake;
+        bool stopping;
+};
+
+constexpr std::size_t defaultGrainSize = 4096;
+
+template<typename U, typename V, typename F> void parallelTransform(const U* in, std::size_t count, V* out, F f, std::size_t grainSize = defaultGrainSize, ThreadPool& pool = ThreadPool::global());
+template<typename U, typename F> void parallelForEach(U* values, std::size_t count, F f, std::size_t grainSize = defaultGrainSize, ThreadPool& pool = ThreadPool::global());
+template<typename U, typename R, typename Op, typename Combine> R parallelReduce(const U* values, std::size_t count, R identity, Op op, Combine combine, std::size_t grainSize = defaultGrainSize, ThreadPool& pool = ThreadPool::global());
+
+}
+
+#include "parallel.inl"
+
+#endif
@@ -0,0 +1,255 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "config.hpp"
+
+namespace cgla {
+
+namespace detail {
+    template<typename F> void runChunked(std::size_t count, std::size_t threadCount, std::size_t grainSize, const F& f);
+}
+
+inline ThreadPool::ThreadPool(std::size_t workerCount) :
+    pending{0},
+    stopping{false}
+{
+    for (std::size_t i = 0; i <= workerCount; ++i)
+        queues.emplace_back(new Queue);
+
+    for (std::size_t i = 0; i < workerCount; ++i)
+        workers.emplace_back(&ThreadPool::work, this, i);
+}
+
+inline ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{sleepMutex};
+        stopping = true;
+    }
+
+    wake.notify_all();
+
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+inline std::size_t ThreadPool::size() const
+{
+    return workers.size();
+}
+
+template<typename F>
+void ThreadPool::parallelFor(std::size_t count, std::size_t grainSize, const F& f)
+{
+    if (count == 0)
+        return;
+
+    // a few chunks per thread so that stealing balances uneven chunks
+    grainSize = std::max(grainSize, static_cast<std::size_t>(1));
+    std::size_t maxChunks = 4 * (workers.size() + 1);
+    std::size_t chunks = std::min((count + grainSize - 1) / grainSize, maxChunks);
+
+    if (workers.empty() || chunks < 2)
+    {
+        f(static_cast<std::size_t>(0), count);
+        return;
+    }
+
+    std::size_t chunkSize = (count + chunks - 1) / chunks;
+    chunks = (count + chunkSize - 1) / chunkSize;
+    std::atomic<std::size_t> remaining{chunks - 1};
+
+    // the first exception thrown by a chunk is rethrown here once every chunk is done, as the tasks refer to this frame
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto run = [&f, &error, &errorMutex](std::size_t begin, std::size_t end)
+    {
+        try
+        {
+            f(begin, end);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock{errorMutex};
+            if (!error)
+                error = std::current_exception();
+        }
+    };
+
+    for (std::size_t c = 1; c < chunks; ++c)
+    {
+        submit([&run, &remaining, c, chunkSize, count]()
+        {
+            run(c * chunkSize, std::min((c + 1) * chunkSize, count));
+            remaining.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    run(static_cast<std::size_t>(0), chunkSize);
+
+    // help instead of blocking, which also makes nested calls from tasks safe
+    while (remaining.load(std::memory_order_acquire) > 0)
+        if (!runOne())
+            std::this_thread::yield();
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+inline ThreadPool& ThreadPool::global()
+{
+    static ThreadPool pool{std::max(std::thread::hardware_concurrency(), 1u) - 1};
+
+    return pool;
+}
+
+inline void ThreadPool::submit(std::function<void()> task)
+{
+    std::size_t index = std::min(currentQueue(), queues.size() - 1);
+
+    {
+        std::lock_guard<std::mutex> lock{queues[index]->mutex};
+        queues[index]->tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{sleepMutex};
+        ++pending;
+    }
+
+    wake.notify_one();
+}
+
+inline bool ThreadPool::runOne()
+{
+    std::size_t self = std::min(currentQueue(), queues.size() - 1);
+    std::function<void()> task;
+
+    for (std::size_t i = 0; i < queues.size() && !task; ++i)
+    {
+        std::size_t index = (self + i) % queues.size();
+        Queue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock{queue.mutex};
+
+        if (queue.tasks.empty())
+            continue;
+
+        if (index == self)
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+
+    if (!task)
+        return false;
+
+    --pending;
+    task();
+
+    return true;
+}
+
+inline void ThreadPool::work(std::size_t index)
+{
+    currentQueue() = index;
+
+    for (;;)
+    {
+        if (runOne())
+            continue;
+
+        std::unique_lock<std::mutex> lock{sleepMutex};
+        wake.wait(lock, [this]() { return stopping || pending > 0; });
+
+        if (stopping)
+            return;
+    }
+}
+
+// queue of the calling thread, threads outside the pool share the last one
+inline std::size_t& ThreadPool::currentQueue()
+{
+    static thread_local std::size_t index = static_cast<std::size_t>(-1);
+
+    return index;
+}
+
+template<typename U, typename V, typename F>
+inline void parallelTransform(const U* in, std::size_t count, V* out, F f, std::size_t grainSize, ThreadPool& pool)
+{
+    pool.parallelFor(count, grainSize, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            out[i] = f(in[i]);
+    });
+}
+
+template<typename U, typename F>
+inline void parallelForEach(U* values, std::size_t count, F f, std::size_t grainSize, ThreadPool& pool)
+{
+    pool.parallelFor(count, grainSize, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            f(values[i]);
+    });
+}
+
+template<typename U, typename R, typename Op, typename Combine>
+R parallelReduce(const U* values, std::size_t count, R identity, Op op, Combine combine, std::size_t grainSize, ThreadPool& pool)
+{
+    // partial results are combined in chunk order, so the result only depends on grainSize
+    grainSize = std::max(grainSize, static_cast<std::size_t>(1));
+    std::size_t chunks = (count + grainSize - 1) / grainSize;
+    std::vector<R> partials(chunks, identity);
+
+    pool.parallelFor(chunks, 1, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t c = begin; c < end; ++c)
+        {
+            R acc = identity;
+
+            for (std::size_t i = c * grainSize; i < std::min((c + 1) * grainSize, count); ++i)
+                acc = op(acc, values[i]);
+
+            partials[c] = acc;
+        }
+    });
+
+    R res = identity;
+
+    for (const R& partial : partials)
+        res = combine(res, partial);
+
+    return res;
+}
+
+namespace detail {
+    // splits [0, count) in up to threadCount chunks of at least grainSize items run on the global pool
+    template<typename F>
+    inline void runChunked(std::size_t count, std::size_t threadCount, std::size_t grainSize, const F& f)
+    {
+        std::size_t threads = std::min(threadCount, count / grainSize);
+
+        if (threads < 2)
+        {
+            f(static_cast<std::size_t>(0), count);
+            return;
+        }
+
+        ThreadPool::global().parallelFor(count, (count + threads - 1) / threads, f);
+    }
+}
+
+}
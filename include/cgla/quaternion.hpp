@@ -0,0 +1,126 @@
+#ifndef CGLA_QUATERNION_HPP
+#define CGLA_QUATERNION_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+#include "config.hpp"
+#include "vector.hpp"
+#include "vector_array.hpp"
+#include "matrix.hpp"
+
+namespace cgla {
+
+template<typename T>
+class Quaternion
+{
+    static_assert(std::is_floating_point<T>::value, "Argument T must be a floating point type");
+
+    public:
+        CGLA_CONSTEXPR Quaternion();
+        CGLA_CONSTEXPR Quaternion(T x, T y, T z, T w);
+        CGLA_CONSTEXPR Quaternion(const Vector<T, 3>& v, T w);
+        CGLA_CONSTEXPR explicit Quaternion(const Vector<T, 4>& v);
+        explicit Quaternion(Uninitialized);
+
+        CGLA_CONSTEXPR T* data();
+        CGLA_CONSTEXPR const T* data() const;
+        CGLA_CONSTEXPR T& operator[](std::size_t i);
+        CGLA_CONSTEXPR T operator[](std::size_t i) const;
+        CGLA_CONSTEXPR T& x();
+        CGLA_CONSTEXPR T x() const;
+        CGLA_CONSTEXPR T& y();
+        CGLA_CONSTEXPR T y() const;
+        CGLA_CONSTEXPR T& z();
+        CGLA_CONSTEXPR T z() const;
+        CGLA_CONSTEXPR T& w();
+        CGLA_CONSTEXPR T w() const;
+        CGLA_CONSTEXPR Vector<T, 3> vector() const;
+        CGLA_CONSTEXPR const Vector<T, 4>& coefficients() const;
+
+        CGLA_CONSTEXPR Quaternion<T>& operator+=(const Quaternion<T>& rhs);
+        CGLA_CONSTEXPR Quaternion<T>& operator-=(const Quaternion<T>& rhs);
+        CGLA_CONSTEXPR Quaternion<T>& operator*=(const Quaternion<T>& rhs);
+        CGLA_CONSTEXPR Quaternion<T>& operator*=(T rhs);
+        CGLA_CONSTEXPR Quaternion<T>& operator/=(T rhs);
+        CGLA_CONSTEXPR bool operator==(const Quaternion<T>& rhs) const;
+        CGLA_CONSTEXPR bool operator!=(const Quaternion<T>& rhs) const;
+
+    private:
+        Vector<T, 4> values;
+};
+
+template<typename T> CGLA_CONSTEXPR Quaternion<T> operator-(Quaternion<T> rhs);
+template<typename T> CGLA_CONSTEXPR Quaternion<T> operator+(Quaternion<T> lhs, const Quaternion<T>& rhs);
+template<typename T> CGLA_CONSTEXPR Quaternion<T> operator-(Quaternion<T> lhs, const Quaternion<T>& rhs);
+template<typename T> CGLA_CONSTEXPR Quaternion<T> operator*(const Quaternion<T>& lhs, const Quaternion<T>& rhs);
+template<typename T> CGLA_CONSTEXPR Quaternion<T> operator*(Quaternion<T> lhs, T rhs);
+template<typename T> CGLA_CONSTEXPR Quaternion<T> operator*(T lhs, Quaternion<T> rhs);
+template<typename T> CGLA_CONSTEXPR Quaternion<T> operator/(Quaternion<T> lhs, T rhs);
+#ifdef CGLA_OSTREAM_OVERLOADS
+template<typename T> std::ostream& operator<<(std::ostream& lhs, const Quaternion<T>& rhs);
+#endif
+
+template<typename T> CGLA_CONSTEXPR T dot(const Quaternion<T>& p, const Quaternion<T>& q);
+template<typename T> CGLA_CONSTEXPR T lengthSquared(const Quaternion<T>& q);
+template<typename T> T length(const Quaternion<T>& q);
+template<typename T> Quaternion<T> normalize(const Quaternion<T>& q);
+template<typename T> CGLA_CONSTEXPR Quaternion<T> conjugate(const Quaternion<T>& q);
+template<typename T> CGLA_CONSTEXPR Quaternion<T> inverse(const Quaternion<T>& q);
+template<typename T> Quaternion<T> angleAxis(T angle, const Vector<T, 3>& axis);
+template<typename T> CGLA_CONSTEXPR Vector<T, 3> rotate(const Quaternion<T>& q, const Vector<T, 3>& v);
+template<typename T> CGLA_CONSTEXPR Matrix<T, 3, 3> toMatrix3(const Quaternion<T>& q);
+template<typename T> CGLA_CONSTEXPR Matrix<T, 4, 4> toMatrix(const Quaternion<T>& q);
+template<typename T> Quaternion<T> fromMatrix(const Matrix<T, 3, 3>& mat);
+template<typename T> Quaternion<T> fromMatrix(const Matrix<T, 4, 4>& mat);
+template<typename T> Quaternion<T> nlerp(const Quaternion<T>& p, const Quaternion<T>& q, T t);
+template<typename T> Quaternion<T> slerp(const Quaternion<T>& p, const Quaternion<T>& q, T t);
+
+#ifdef CGLA_EXPRESSION_TEMPLATES
+// overloads taking vector expressions, evaluated into their result type; rotate also covers rotate(angle, axis) of transform.hpp
+template<typename L, typename R, typename = detail::EnableIfExpression<L, R>> auto angleAxis(const L& angle, const R& axis) -> decltype(angleAxis(detail::evaluate(angle), detail::evaluate(axis)));
+template<typename L, typename R, typename = detail::EnableIfExpression<L, R>> CGLA_CONSTEXPR auto rotate(const L& q, const R& v) -> decltype(rotate(detail::evaluate(q), detail::evaluate(v)));
+#endif
+
+template<typename T>
+class QuaternionArray
+{
+    static_assert(std::is_floating_point<T>::value, "Argument T must be a floating point type");
+
+    public:
+        QuaternionArray();
+        explicit QuaternionArray(std::size_t size);
+        QuaternionArray(const Quaternion<T>* q, std::size_t size);
+        explicit QuaternionArray(const std::vector<Quaternion<T>>& q);
+
+        std::size_t size() const;
+        void resize(std::size_t size);
+        T* data(std::size_t component);
+        const T* data(std::size_t component) const;
+        Quaternion<T> operator[](std::size_t i) const;
+        void set(std::size_t i, const Quaternion<T>& q);
+        void store(Quaternion<T>* q) const;
+        std::vector<Quaternion<T>> toQuaternions() const;
+
+    private:
+        VectorArray<T, 4> values;
+};
+
+template<typename T> QuaternionArray<T> operator*(const QuaternionArray<T>& lhs, const QuaternionArray<T>& rhs);
+template<typename T> QuaternionArray<T> conjugate(const QuaternionArray<T>& q);
+template<typename T> QuaternionArray<T> normalize(const QuaternionArray<T>& q);
+template<typename T> VectorArray<T, 3> rotate(const QuaternionArray<T>& q, const VectorArray<T, 3>& v);
+template<typename T> QuaternionArray<T> nlerp(const QuaternionArray<T>& p, const QuaternionArray<T>& q, T t);
+template<typename T> QuaternionArray<T> slerp(const QuaternionArray<T>& p, const QuaternionArray<T>& q, T t);
+
+#ifdef CGLA_TYPE_ALIASES
+using Quaternionf = Quaternion<float>; using Quaterniond = Quaternion<double>;
+using QuaternionArrayf = QuaternionArray<float>; using QuaternionArrayd = QuaternionArray<double>;
+#endif
+
+}
+
+#include "quaternion.inl"
+
+#endif
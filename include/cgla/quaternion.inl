@@ -0,0 +1,677 @@
+#include <cstddef>
+#include <cmath>
+#include <cassert>
+#include <vector>
+#include "config.hpp"
+#include "vector.hpp"
+#include "vector_array.hpp"
+#include "matrix.hpp"
+
+namespace cgla {
+
+namespace detail {
+    template<typename T> void slerpWeights(T cosTheta, T t, T& wp, T& wq);
+}
+
+template<typename T>
+CGLA_CONSTEXPR Quaternion<T>::Quaternion() :
+    values{static_cast<T>(0), static_cast<T>(0), static_cast<T>(0), static_cast<T>(1)}
+{
+}
+
+template<typename T>
+CGLA_CONSTEXPR Quaternion<T>::Quaternion(T x, T y, T z, T w) :
+    values{x, y, z, w}
+{
+}
+
+template<typename T>
+CGLA_CONSTEXPR Quaternion<T>::Quaternion(const Vector<T, 3>& v, T w) :
+    values{v[0], v[1], v[2], w}
+{
+}
+
+template<typename T>
+CGLA_CONSTEXPR Quaternion<T>::Quaternion(const Vector<T, 4>& v) :
+    values(v)
+{
+}
+
+template<typename T>
+inline Quaternion<T>::Quaternion(Uninitialized) :
+    values(uninitialized)
+{
+}
+
+template<typename T>
+CGLA_CONSTEXPR T* Quaternion<T>::data()
+{
+    return values.data();
+}
+
+template<typename T>
+CGLA_CONSTEXPR const T* Quaternion<T>::data() const
+{
+    return values.data();
+}
+
+template<typename T>
+CGLA_CONSTEXPR T& Quaternion<T>::operator[](std::size_t i)
+{
+    return values[i];
+}
+
+template<typename T>
+CGLA_CONSTEXPR T Quaternion<T>::operator[](std::size_t i) const
+{
+    return values[i];
+}
+
+template<typename T>
+CGLA_CONSTEXPR T& Quaternion<T>::x()
+{
+    return values[0];
+}
+
+template<typename T>
+CGLA_CONSTEXPR T Quaternion<T>::x() const
+{
+    return values[0];
+}
+
+template<typename T>
+CGLA_CONSTEXPR T& Quaternion<T>::y()
+{
+    return values[1];
+}
+
+template<typename T>
+CGLA_CONSTEXPR T Quaternion<T>::y() const
+{
+    return values[1];
+}
+
+template<typename T>
+CGLA_CONSTEXPR T& Quaternion<T>::z()
+{
+    return values[2];
+}
+
+template<typename T>
+CGLA_CONSTEXPR T Quaternion<T>::z() const
+{
+    return values[2];
+}
+
+template<typename T>
+CGLA_CONSTEXPR T& Quaternion<T>::w()
+{
+    return values[3];
+}
+
+template<typename T>
+CGLA_CONSTEXPR T Quaternion<T>::w() const
+{
+    return values[3];
+}
+
+template<typename T>
+CGLA_CONSTEXPR Vector<T, 3> Quaternion<T>::vector() const
+{
+    return {values[0], values[1], values[2]};
+}
+
+template<typename T>
+CGLA_CONSTEXPR const Vector<T, 4>& Quaternion<T>::coefficients() const
+{
+    return values;
+}
+
+template<typename T>
+CGLA_CONSTEXPR Quaternion<T>& Quaternion<T>::operator+=(const Quaternion<T>& rhs)
+{
+    for (std::size_t i = 0; i < 4; ++i)
+        values[i] += rhs[i];
+
+    return *this;
+}
+
+template<typename T>
+CGLA_CONSTEXPR Quaternion<T>& Quaternion<T>::operator-=(const Quaternion<T>& rhs)
+{
+    for (std::size_t i = 0; i < 4; ++i)
+        values[i] -= rhs[i];
+
+    return *this;
+}
+
+template<typename T>
+CGLA_CONSTEXPR Quaternion<T>& Quaternion<T>::operator*=(const Quaternion<T>& rhs)
+{
+    return *this = *this * rhs;
+}
+
+template<typename T>
+CGLA_CONSTEXPR Quaternion<T>& Quaternion<T>::operator*=(T rhs)
+{
+    for (std::size_t i = 0; i < 4; ++i)
+        values[i] *= rhs;
+
+    return *this;
+}
+
+template<typename T>
+CGLA_CONSTEXPR Quaternion<T>& Quaternion<T>::operator/=(T rhs)
+{
+    for (std::size_t i = 0; i < 4; ++i)
+        values[i] /= rhs;
+
+    return *this;
+}
+
+template<typename T>
+CGLA_CONSTEXPR bool Quaternion<T>::operator==(const Quaternion<T>& rhs) const
+{
+    return values == rhs.values;
+}
+
+template<typename T>
+CGLA_CONSTEXPR bool Quaternion<T>::operator!=(const Quaternion<T>& rhs) const
+{
+    return values != rhs.values;
+}
+
+template<typename T>
+CGLA_CONSTEXPR Quaternion<T> operator-(Quaternion<T> rhs)
+{
+    return rhs *= static_cast<T>(-1);
+}
+
+template<typename T>
+CGLA_CONSTEXPR Quaternion<T> operator+(Quaternion<T> lhs, const Quaternion<T>& rhs)
+{
+    return lhs += rhs;
+}
+
+template<typename T>
+CGLA_CONSTEXPR Quaternion<T> operator-(Quaternion<T> lhs, const Quaternion<T>& rhs)
+{
+    return lhs -= rhs;
+}
+
+template<typename T>
+CGLA_CONSTEXPR Quaternion<T> operator*(const Quaternion<T>& lhs, const Quaternion<T>& rhs)
+{
+    return {lhs[3] * rhs[0] + lhs[0] * rhs[3] + lhs[1] * rhs[2] - lhs[2] * rhs[1],
+            lhs[3] * rhs[1] - lhs[0] * rhs[2] + lhs[1] * rhs[3] + lhs[2] * rhs[0],
+            lhs[3] * rhs[2] + lhs[0] * rhs[1] - lhs[1] * rhs[0] + lhs[2] * rhs[3],
+            lhs[3] * rhs[3] - lhs[0] * rhs[0] - lhs[1] * rhs[1] - lhs[2] * rhs[2]};
+}
+
+template<typename T>
+CGLA_CONSTEXPR Quaternion<T> operator*(Quaternion<T> lhs, T rhs)
+{
+    return lhs *= rhs;
+}
+
+template<typename T>
+CGLA_CONSTEXPR Quaternion<T> operator*(T lhs, Quaternion<T> rhs)
+{
+    return rhs *= lhs;
+}
+
+template<typename T>
+CGLA_CONSTEXPR Quaternion<T> operator/(Quaternion<T> lhs, T rhs)
+{
+    return lhs /= rhs;
+}
+
+#ifdef CGLA_OSTREAM_OVERLOADS
+template<typename T>
+std::ostream& operator<<(std::ostream& lhs, const Quaternion<T>& rhs)
+{
+    return lhs << rhs.coefficients();
+}
+#endif
+
+template<typename T>
+CGLA_CONSTEXPR T dot(const Quaternion<T>& p, const Quaternion<T>& q)
+{
+    return p[0] * q[0] + p[1] * q[1] + p[2] * q[2] + p[3] * q[3];
+}
+
+template<typename T>
+CGLA_CONSTEXPR T lengthSquared(const Quaternion<T>& q)
+{
+    return dot(q, q);
+}
+
+template<typename T>
+inline T length(const Quaternion<T>& q)
+{
+    return std::sqrt(lengthSquared(q));
+}
+
+template<typename T>
+inline Quaternion<T> normalize(const Quaternion<T>& q)
+{
+    return q / length(q);
+}
+
+template<typename T>
+CGLA_CONSTEXPR Quaternion<T> conjugate(const Quaternion<T>& q)
+{
+    return {-q[0], -q[1], -q[2], q[3]};
+}
+
+template<typename T>
+CGLA_CONSTEXPR Quaternion<T> inverse(const Quaternion<T>& q)
+{
+    return conjugate(q) / lengthSquared(q);
+}
+
+template<typename T>
+Quaternion<T> angleAxis(T angle, const Vector<T, 3>& axis)
+{
+    T s = std::sin(angle / static_cast<T>(2)) / std::sqrt(lengthSquared(axis));
+
+    return {axis[0] * s, axis[1] * s, axis[2] * s, std::cos(angle / static_cast<T>(2))};
+}
+
+template<typename T>
+CGLA_CONSTEXPR Vector<T, 3> rotate(const Quaternion<T>& q, const Vector<T, 3>& v)
+{
+    // v' = v + w * t + cross(q.xyz, t) with t = 2 * cross(q.xyz, v)
+    T tx = static_cast<T>(2) * (q[1] * v[2] - q[2] * v[1]);
+    T ty = static_cast<T>(2) * (q[2] * v[0] - q[0] * v[2]);
+    T tz = static_cast<T>(2) * (q[0] * v[1] - q[1] * v[0]);
+
+    return {v[0] + q[3] * tx + q[1] * tz - q[2] * ty,
+            v[1] + q[3] * ty + q[2] * tx - q[0] * tz,
+            v[2] + q[3] * tz + q[0] * ty - q[1] * tx};
+}
+
+template<typename T>
+CGLA_CONSTEXPR Matrix<T, 3, 3> toMatrix3(const Quaternion<T>& q)
+{
+    Matrix<T, 3, 3> res{};
+
+    T x2 = q[0] + q[0];
+    T y2 = q[1] + q[1];
+    T z2 = q[2] + q[2];
+    T xx = q[0] * x2, xy = q[0] * y2, xz = q[0] * z2;
+    T yy = q[1] * y2, yz = q[1] * z2, zz = q[2] * z2;
+    T wx = q[3] * x2, wy = q[3] * y2, wz = q[3] * z2;
+
+    res[0] = static_cast<T>(1) - (yy + zz);
+    res[1] = xy + wz;
+    res[2] = xz - wy;
+
+    res[3] = xy - wz;
+    res[4] = static_cast<T>(1) - (xx + zz);
+    res[5] = yz + wx;
+
+    res[6] = xz + wy;
+    res[7] = yz - wx;
+    res[8] = static_cast<T>(1) - (xx + yy);
+
+    return res;
+}
+
+template<typename T>
+CGLA_CONSTEXPR Matrix<T, 4, 4> toMatrix(const Quaternion<T>& q)
+{
+    Matrix<T, 4, 4> res{};
+    Matrix<T, 3, 3> r = toMatrix3(q);
+
+    for (std::size_t j = 0; j < 3; ++j)
+        for (std::size_t i = 0; i < 3; ++i)
+            res(i, j) = r(i, j);
+
+    res[15] = static_cast<T>(1);
+
+    return res;
+}
+
+template<typename T>
+Quaternion<T> fromMatrix(const Matrix<T, 3, 3>& mat)
+{
+    // Shepperd's method: extract the largest component first for numerical stability
+    Quaternion<T> res{uninitialized};
+
+    T trace = mat(0, 0) + mat(1, 1) + mat(2, 2);
+
+    if (trace > static_cast<T>(0))
+    {
+        T s = static_cast<T>(0.5) / std::sqrt(trace + static_cast<T>(1));
+        res[0] = (mat(2, 1) - mat(1, 2)) * s;
+        res[1] = (mat(0, 2) - mat(2, 0)) * s;
+        res[2] = (mat(1, 0) - mat(0, 1)) * s;
+        res[3] = static_cast<T>(0.25) / s;
+    }
+    else if (mat(0, 0) > mat(1, 1) && mat(0, 0) > mat(2, 2))
+    {
+        T s = static_cast<T>(0.5) / std::sqrt(static_cast<T>(1) + mat(0, 0) - mat(1, 1) - mat(2, 2));
+        res[0] = static_cast<T>(0.25) / s;
+        res[1] = (mat(0, 1) + mat(1, 0)) * s;
+        res[2] = (mat(0, 2) + mat(2, 0)) * s;
+        res[3] = (mat(2, 1) - mat(1, 2)) * s;
+    }
+    else if (mat(1, 1) > mat(2, 2))
+    {
+        T s = static_cast<T>(0.5) / std::sqrt(static_cast<T>(1) + mat(1, 1) - mat(0, 0) - mat(2, 2));
+        res[0] = (mat(0, 1) + mat(1, 0)) * s;
+        res[1] = static_cast<T>(0.25) / s;
+        res[2] = (mat(1, 2) + mat(2, 1)) * s;
+        res[3] = (mat(0, 2) - mat(2, 0)) * s;
+    }
+    else
+    {
+        T s = static_cast<T>(0.5) / std::sqrt(static_cast<T>(1) + mat(2, 2) - mat(0, 0) - mat(1, 1));
+        res[0] = (mat(0, 2) + mat(2, 0)) * s;
+        res[1] = (mat(1, 2) + mat(2, 1)) * s;
+        res[2] = static_cast<T>(0.25) / s;
+        res[3] = (mat(1, 0) - mat(0, 1)) * s;
+    }
+
+    return res;
+}
+
+template<typename T>
+Quaternion<T> fromMatrix(const Matrix<T, 4, 4>& mat)
+{
+    Matrix<T, 3, 3> r{uninitialized};
+
+    for (std::size_t j = 0; j < 3; ++j)
+        for (std::size_t i = 0; i < 3; ++i)
+            r(i, j) = mat(i, j);
+
+    return fromMatrix(r);
+}
+
+template<typename T>
+Quaternion<T> nlerp(const Quaternion<T>& p, const Quaternion<T>& q, T t)
+{
+    T wq = dot(p, q) < static_cast<T>(0) ? -t : t;
+
+    return normalize(p * (static_cast<T>(1) - t) + q * wq);
+}
+
+template<typename T>
+Quaternion<T> slerp(const Quaternion<T>& p, const Quaternion<T>& q, T t)
+{
+    T wp, wq;
+    detail::slerpWeights(dot(p, q), t, wp, wq);
+
+    return normalize(p * wp + q * wq);
+}
+
+#ifdef CGLA_EXPRESSION_TEMPLATES
+template<typename L, typename R, typename>
+inline auto angleAxis(const L& angle, const R& axis) -> decltype(angleAxis(detail::evaluate(angle), detail::evaluate(axis)))
+{
+    return angleAxis(detail::evaluate(angle), detail::evaluate(axis));
+}
+
+template<typename L, typename R, typename>
+CGLA_CONSTEXPR auto rotate(const L& q, const R& v) -> decltype(rotate(detail::evaluate(q), detail::evaluate(v)))
+{
+    return rotate(detail::evaluate(q), detail::evaluate(v));
+}
+#endif
+
+template<typename T>
+inline QuaternionArray<T>::QuaternionArray()
+{
+}
+
+template<typename T>
+inline QuaternionArray<T>::QuaternionArray(std::size_t size) :
+    values(size, Vector<T, 4>{static_cast<T>(0), static_cast<T>(0), static_cast<T>(0), static_cast<T>(1)})
+{
+}
+
+template<typename T>
+inline QuaternionArray<T>::QuaternionArray(const Quaternion<T>* q, std::size_t size) :
+    values(size)
+{
+    for (std::size_t c = 0; c < 4; ++c)
+    {
+        T* dst = values.data(c);
+        for (std::size_t i = 0; i < size; ++i)
+            dst[i] = q[i][c];
+    }
+}
+
+template<typename T>
+inline QuaternionArray<T>::QuaternionArray(const std::vector<Quaternion<T>>& q) :
+    QuaternionArray(q.data(), q.size())
+{
+}
+
+template<typename T>
+inline std::size_t QuaternionArray<T>::size() const
+{
+    return values.size();
+}
+
+template<typename T>
+inline void QuaternionArray<T>::resize(std::size_t size)
+{
+    values.resize(size);
+}
+
+template<typename T>
+inline T* QuaternionArray<T>::data(std::size_t component)
+{
+    return values.data(component);
+}
+
+template<typename T>
+inline const T* QuaternionArray<T>::data(std::size_t component) const
+{
+    return values.data(component);
+}
+
+template<typename T>
+inline Quaternion<T> QuaternionArray<T>::operator[](std::size_t i) const
+{
+    return Quaternion<T>{values[i]};
+}
+
+template<typename T>
+inline void QuaternionArray<T>::set(std::size_t i, const Quaternion<T>& q)
+{
+    values.set(i, q.coefficients());
+}
+
+template<typename T>
+inline void QuaternionArray<T>::store(Quaternion<T>* q) const
+{
+    for (std::size_t c = 0; c < 4; ++c)
+    {
+        const T* src = values.data(c);
+        for (std::size_t i = 0; i < values.size(); ++i)
+            q[i][c] = src[i];
+    }
+}
+
+template<typename T>
+inline std::vector<Quaternion<T>> QuaternionArray<T>::toQuaternions() const
+{
+    std::vector<Quaternion<T>> res(values.size());
+    store(res.data());
+
+    return res;
+}
+
+template<typename T>
+QuaternionArray<T> operator*(const QuaternionArray<T>& lhs, const QuaternionArray<T>& rhs)
+{
+    assert(lhs.size() == rhs.size());
+
+    std::size_t count = lhs.size();
+    QuaternionArray<T> res(count);
+
+    const T* ax = lhs.data(0); const T* ay = lhs.data(1); const T* az = lhs.data(2); const T* aw = lhs.data(3);
+    const T* bx = rhs.data(0); const T* by = rhs.data(1); const T* bz = rhs.data(2); const T* bw = rhs.data(3);
+    T* rx = res.data(0); T* ry = res.data(1); T* rz = res.data(2); T* rw = res.data(3);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        rx[i] = aw[i] * bx[i] + ax[i] * bw[i] + ay[i] * bz[i] - az[i] * by[i];
+        ry[i] = aw[i] * by[i] - ax[i] * bz[i] + ay[i] * bw[i] + az[i] * bx[i];
+        rz[i] = aw[i] * bz[i] + ax[i] * by[i] - ay[i] * bx[i] + az[i] * bw[i];
+        rw[i] = aw[i] * bw[i] - ax[i] * bx[i] - ay[i] * by[i] - az[i] * bz[i];
+    }
+
+    return res;
+}
+
+template<typename T>
+QuaternionArray<T> conjugate(const QuaternionArray<T>& q)
+{
+    QuaternionArray<T> res{q};
+
+    for (std::size_t c = 0; c < 3; ++c)
+    {
+        T* dst = res.data(c);
+        for (std::size_t i = 0; i < res.size(); ++i)
+            dst[i] = -dst[i];
+    }
+
+    return res;
+}
+
+template<typename T>
+QuaternionArray<T> normalize(const QuaternionArray<T>& q)
+{
+    std::size_t count = q.size();
+    QuaternionArray<T> res(count);
+
+    const T* qx = q.data(0); const T* qy = q.data(1); const T* qz = q.data(2); const T* qw = q.data(3);
+    T* rx = res.data(0); T* ry = res.data(1); T* rz = res.data(2); T* rw = res.data(3);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        T s = static_cast<T>(1) / std::sqrt(qx[i] * qx[i] + qy[i] * qy[i] + qz[i] * qz[i] + qw[i] * qw[i]);
+        rx[i] = qx[i] * s;
+        ry[i] = qy[i] * s;
+        rz[i] = qz[i] * s;
+        rw[i] = qw[i] * s;
+    }
+
+    return res;
+}
+
+template<typename T>
+VectorArray<T, 3> rotate(const QuaternionArray<T>& q, const VectorArray<T, 3>& v)
+{
+    assert(q.size() == v.size());
+
+    std::size_t count = q.size();
+    VectorArray<T, 3> res(count);
+
+    const T* qx = q.data(0); const T* qy = q.data(1); const T* qz = q.data(2); const T* qw = q.data(3);
+    const T* vx = v.data(0); const T* vy = v.data(1); const T* vz = v.data(2);
+    T* rx = res.data(0); T* ry = res.data(1); T* rz = res.data(2);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        T tx = static_cast<T>(2) * (qy[i] * vz[i] - qz[i] * vy[i]);
+        T ty = static_cast<T>(2) * (qz[i] * vx[i] - qx[i] * vz[i]);
+        T tz = static_cast<T>(2) * (qx[i] * vy[i] - qy[i] * vx[i]);
+        rx[i] = vx[i] + qw[i] * tx + qy[i] * tz - qz[i] * ty;
+        ry[i] = vy[i] + qw[i] * ty + qz[i] * tx - qx[i] * tz;
+        rz[i] = vz[i] + qw[i] * tz + qx[i] * ty - qy[i] * tx;
+    }
+
+    return res;
+}
+
+template<typename T>
+QuaternionArray<T> nlerp(const QuaternionArray<T>& p, const QuaternionArray<T>& q, T t)
+{
+    assert(p.size() == q.size());
+
+    std::size_t count = p.size();
+    QuaternionArray<T> res(count);
+
+    const T* px = p.data(0); const T* py = p.data(1); const T* pz = p.data(2); const T* pw = p.data(3);
+    const T* qx = q.data(0); const T* qy = q.data(1); const T* qz = q.data(2); const T* qw = q.data(3);
+    T* rx = res.data(0); T* ry = res.data(1); T* rz = res.data(2); T* rw = res.data(3);
+
+    T wp = static_cast<T>(1) - t;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        T d = px[i] * qx[i] + py[i] * qy[i] + pz[i] * qz[i] + pw[i] * qw[i];
+        T wq = d < static_cast<T>(0) ? -t : t;
+        T x = px[i] * wp + qx[i] * wq;
+        T y = py[i] * wp + qy[i] * wq;
+        T z = pz[i] * wp + qz[i] * wq;
+        T w = pw[i] * wp + qw[i] * wq;
+        T s = static_cast<T>(1) / std::sqrt(x * x + y * y + z * z + w * w);
+        rx[i] = x * s;
+        ry[i] = y * s;
+        rz[i] = z * s;
+        rw[i] = w * s;
+    }
+
+    return res;
+}
+
+template<typename T>
+QuaternionArray<T> slerp(const QuaternionArray<T>& p, const QuaternionArray<T>& q, T t)
+{
+    assert(p.size() == q.size());
+
+    std::size_t count = p.size();
+    QuaternionArray<T> res(count);
+
+    const T* px = p.data(0); const T* py = p.data(1); const T* pz = p.data(2); const T* pw = p.data(3);
+    const T* qx = q.data(0); const T* qy = q.data(1); const T* qz = q.data(2); const T* qw = q.data(3);
+    T* rx = res.data(0); T* ry = res.data(1); T* rz = res.data(2); T* rw = res.data(3);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        T wp, wq;
+        detail::slerpWeights(px[i] * qx[i] + py[i] * qy[i] + pz[i] * qz[i] + pw[i] * qw[i], t, wp, wq);
+        T x = px[i] * wp + qx[i] * wq;
+        T y = py[i] * wp + qy[i] * wq;
+        T z = pz[i] * wp + qz[i] * wq;
+        T w = pw[i] * wp + qw[i] * wq;
+        T s = static_cast<T>(1) / std::sqrt(x * x + y * y + z * z + w * w);
+        rx[i] = x * s;
+        ry[i] = y * s;
+        rz[i] = z * s;
+        rw[i] = w * s;
+    }
+
+    return res;
+}
+
+namespace detail {
+    template<typename T>
+    inline void slerpWeights(T cosTheta, T t, T& wp, T& wq)
+    {
+        // take the shortest path and fall back to linear weights when the rotations are nearly parallel
+        T sign = cosTheta < static_cast<T>(0) ? static_cast<T>(-1) : static_cast<T>(1);
+        cosTheta *= sign;
+
+        if (cosTheta > static_cast<T>(0.9995))
+        {
+            wp = static_cast<T>(1) - t;
+            wq = t * sign;
+        }
+        else
+        {
+            T theta = std::acos(cosTheta);
+            T s = static_cast<T>(1) / std::sin(theta);
+            wp = std::sin((static_cast<T>(1) - t) * theta) * s;
+            wq = std::sin(t * theta) * s * sign;
+        }
+    }
+}
+
+}
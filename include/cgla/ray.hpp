@@ -0,0 +1,92 @@
+#ifndef CGLA_RAY_HPP
+#define CGLA_RAY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "config.hpp"
+#include "vector.hpp"
+#include "bounds.hpp"
+
+namespace cgla {
+
+// hits are searched in [0, tMax] along origin + t * direction
+template<typename T>
+struct Ray
+{
+    static_assert(std::is_floating_point<T>::value, "Argument T must be a floating point type");
+
+    Ray();
+    Ray(const Vector<T, 3>& origin, const Vector<T, 3>& direction);
+    Ray(const Vector<T, 3>& origin, const Vector<T, 3>& direction, T tMax);
+
+    CGLA_CONSTEXPR Vector<T, 3> at(T t) const;
+
+    Vector<T, 3> origin;
+    Vector<T, 3> direction;
+    T tMax;
+};
+
+// K rays stored as structure of arrays, with the inverse directions used by the box tests
+template<typename T, std::size_t K>
+struct RayPacket
+{
+    static_assert(std::is_floating_point<T>::value, "Argument T must be a floating point type");
+    static_assert(K == 4 || K == 8 || K == 16, "Argument K must be 4, 8 or 16");
+
+    RayPacket();
+    explicit RayPacket(const Ray<T>* rays);
+
+    void set(std::size_t i, const Ray<T>& ray);
+    Ray<T> get(std::size_t i) const;
+
+    alignas(16) T origin[3][K];
+    alignas(16) T direction[3][K];
+    alignas(16) T invDirection[3][K];
+    alignas(16) T tMax[K];
+};
+
+// K triangles stored as structure of arrays, as a vertex and two edges
+template<typename T, std::size_t K>
+struct TrianglePacket
+{
+    static_assert(std::is_floating_point<T>::value, "Argument T must be a floating point type");
+    static_assert(K == 4 || K == 8 || K == 16, "Argument K must be 4, 8 or 16");
+
+    TrianglePacket();
+
+    void set(std::size_t i, const Vector<T, 3>& v0, const Vector<T, 3>& v1, const Vector<T, 3>& v2);
+
+    alignas(16) T v0[3][K];
+    alignas(16) T edge1[3][K];
+    alignas(16) T edge2[3][K];
+};
+
+// distances and barycentric coordinates (of v1 and v2) of the hits of a packet test, unspecified for the lanes that miss
+template<typename T, std::size_t K>
+struct PacketHit
+{
+    alignas(16) T t[K];
+    alignas(16) T u[K];
+    alignas(16) T v[K];
+};
+
+template<typename T> bool intersectTriangle(const Ray<T>& ray, const Vector<T, 3>& v0, const Vector<T, 3>& v1, const Vector<T, 3>& v2, T& t, T& u, T& v);
+template<typename T, std::size_t K> std::uint32_t intersectTriangle(const RayPacket<T, K>& rays, const Vector<T, 3>& v0, const Vector<T, 3>& v1, const Vector<T, 3>& v2, PacketHit<T, K>& hit);
+template<typename T, std::size_t K> std::uint32_t intersectTriangles(const Ray<T>& ray, const TrianglePacket<T, K>& triangles, PacketHit<T, K>& hit);
+template<typename T> bool intersectBox(const Ray<T>& ray, const AABB<T, 3>& box, T& tNear);
+template<typename T, std::size_t K> std::uint32_t intersectBox(const RayPacket<T, K>& rays, const AABB<T, 3>& box, T* tNear);
+
+#ifdef CGLA_TYPE_ALIASES
+using Rayf = Ray<float>; using Rayd = Ray<double>;
+template<std::size_t K> using RayPacketf = RayPacket<float, K>;
+template<std::size_t K> using RayPacketd = RayPacket<double, K>;
+template<std::size_t K> using TrianglePacketf = TrianglePacket<float, K>;
+template<std::size_t K> using TrianglePacketd = TrianglePacket<double, K>;
+#endif
+
+}
+
+#include "ray.inl"
+
+#endif
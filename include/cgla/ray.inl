@@ -0,0 +1,395 @@
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include "config.hpp"
+#include "vector.hpp"
+#include "bounds.hpp"
+#ifdef CGLA_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace cgla {
+
+namespace detail {
+    template<typename T> bool intersectTriangleLane(const T* o, const T* d, T tMax, const T* v0, const T* e1, const T* e2, T& t, T& u, T& v);
+    template<typename T> bool intersectBoxLane(const T* o, const T* inv, T tMax, const AABB<T, 3>& box, T& tNear);
+    template<typename T, std::size_t K> std::uint32_t intersectTriangle(const RayPacket<T, K>& rays, const Vector<T, 3>& v0, const Vector<T, 3>& v1, const Vector<T, 3>& v2, PacketHit<T, K>& hit);
+    template<typename T, std::size_t K> std::uint32_t intersectTriangles(const Ray<T>& ray, const TrianglePacket<T, K>& triangles, PacketHit<T, K>& hit);
+    template<typename T, std::size_t K> std::uint32_t intersectBox(const RayPacket<T, K>& rays, const AABB<T, 3>& box, T* tNear);
+    #ifdef CGLA_SSE
+    __m128 intersectTriangle4(const __m128* o, const __m128* d, __m128 tMax, const __m128* v0, const __m128* e1, const __m128* e2, __m128& t, __m128& u, __m128& v);
+    template<std::size_t K> std::uint32_t intersectTriangle(const RayPacket<float, K>& rays, const Vector<float, 3>& v0, const Vector<float, 3>& v1, const Vector<float, 3>& v2, PacketHit<float, K>& hit);
+    template<std::size_t K> std::uint32_t intersectTriangles(const Ray<float>& ray, const TrianglePacket<float, K>& triangles, PacketHit<float, K>& hit);
+    template<std::size_t K> std::uint32_t intersectBox(const RayPacket<float, K>& rays, const AABB<float, 3>& box, float* tNear);
+    #endif
+}
+
+template<typename T>
+inline Ray<T>::Ray() :
+    origin{},
+    direction{static_cast<T>(0), static_cast<T>(0), static_cast<T>(1)},
+    tMax{std::numeric_limits<T>::infinity()}
+{
+}
+
+template<typename T>
+inline Ray<T>::Ray(const Vector<T, 3>& origin, const Vector<T, 3>& direction) :
+    origin{origin},
+    direction{direction},
+    tMax{std::numeric_limits<T>::infinity()}
+{
+}
+
+template<typename T>
+inline Ray<T>::Ray(const Vector<T, 3>& origin, const Vector<T, 3>& direction, T tMax) :
+    origin{origin},
+    direction{direction},
+    tMax{tMax}
+{
+}
+
+template<typename T>
+CGLA_CONSTEXPR Vector<T, 3> Ray<T>::at(T t) const
+{
+    return origin + direction * t;
+}
+
+template<typename T, std::size_t K>
+RayPacket<T, K>::RayPacket()
+{
+    for (std::size_t i = 0; i < K; ++i)
+        set(i, Ray<T>{});
+}
+
+template<typename T, std::size_t K>
+RayPacket<T, K>::RayPacket(const Ray<T>* rays)
+{
+    for (std::size_t i = 0; i < K; ++i)
+        set(i, rays[i]);
+}
+
+template<typename T, std::size_t K>
+inline void RayPacket<T, K>::set(std::size_t i, const Ray<T>& ray)
+{
+    // a zero direction component gives an infinite inverse, which the box tests handle
+    for (std::size_t c = 0; c < 3; ++c)
+    {
+        origin[c][i] = ray.origin[c];
+        direction[c][i] = ray.direction[c];
+        invDirection[c][i] = static_cast<T>(1) / ray.direction[c];
+    }
+
+    tMax[i] = ray.tMax;
+}
+
+template<typename T, std::size_t K>
+inline Ray<T> RayPacket<T, K>::get(std::size_t i) const
+{
+    return {Vector<T, 3>{origin[0][i], origin[1][i], origin[2][i]}, Vector<T, 3>{direction[0][i], direction[1][i], direction[2][i]}, tMax[i]};
+}
+
+template<typename T, std::size_t K>
+TrianglePacket<T, K>::TrianglePacket()
+{
+    // degenerate triangles, which are never hit
+    for (std::size_t i = 0; i < K; ++i)
+        set(i, Vector<T, 3>{}, Vector<T, 3>{}, Vector<T, 3>{});
+}
+
+template<typename T, std::size_t K>
+inline void TrianglePacket<T, K>::set(std::size_t i, const Vector<T, 3>& a, const Vector<T, 3>& b, const Vector<T, 3>& c)
+{
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+        v0[j][i] = a[j];
+        edge1[j][i] = b[j] - a[j];
+        edge2[j][i] = c[j] - a[j];
+    }
+}
+
+template<typename T>
+bool intersectTriangle(const Ray<T>& ray, const Vector<T, 3>& v0, const Vector<T, 3>& v1, const Vector<T, 3>& v2, T& t, T& u, T& v)
+{
+    Vector<T, 3> e1 = v1 - v0;
+    Vector<T, 3> e2 = v2 - v0;
+
+    return detail::intersectTriangleLane(ray.origin.data(), ray.direction.data(), ray.tMax, v0.data(), e1.data(), e2.data(), t, u, v);
+}
+
+template<typename T, std::size_t K>
+inline std::uint32_t intersectTriangle(const RayPacket<T, K>& rays, const Vector<T, 3>& v0, const Vector<T, 3>& v1, const Vector<T, 3>& v2, PacketHit<T, K>& hit)
+{
+    return detail::intersectTriangle(rays, v0, v1, v2, hit);
+}
+
+template<typename T, std::size_t K>
+inline std::uint32_t intersectTriangles(const Ray<T>& ray, const TrianglePacket<T, K>& triangles, PacketHit<T, K>& hit)
+{
+    return detail::intersectTriangles(ray, triangles, hit);
+}
+
+template<typename T>
+bool intersectBox(const Ray<T>& ray, const AABB<T, 3>& box, T& tNear)
+{
+    T inv[3] = {static_cast<T>(1) / ray.direction[0], static_cast<T>(1) / ray.direction[1], static_cast<T>(1) / ray.direction[2]};
+
+    return detail::intersectBoxLane(ray.origin.data(), inv, ray.tMax, box, tNear);
+}
+
+template<typename T, std::size_t K>
+inline std::uint32_t intersectBox(const RayPacket<T, K>& rays, const AABB<T, 3>& box, T* tNear)
+{
+    return detail::intersectBox(rays, box, tNear);
+}
+
+namespace detail {
+    // Moller-Trumbore, branchless so that packet loops vectorize
+    template<typename T>
+    inline bool intersectTriangleLane(const T* o, const T* d, T tMax, const T* v0, const T* e1, const T* e2, T& t, T& u, T& v)
+    {
+        T px = d[1] * e2[2] - d[2] * e2[1];
+        T py = d[2] * e2[0] - d[0] * e2[2];
+        T pz = d[0] * e2[1] - d[1] * e2[0];
+        T det = e1[0] * px + e1[1] * py + e1[2] * pz;
+        T inv = static_cast<T>(1) / det;
+
+        T sx = o[0] - v0[0];
+        T sy = o[1] - v0[1];
+        T sz = o[2] - v0[2];
+        T qx = sy * e1[2] - sz * e1[1];
+        T qy = sz * e1[0] - sx * e1[2];
+        T qz = sx * e1[1] - sy * e1[0];
+
+        u = (sx * px + sy * py + sz * pz) * inv;
+        v = (d[0] * qx + d[1] * qy + d[2] * qz) * inv;
+        t = (e2[0] * qx + e2[1] * qy + e2[2] * qz) * inv;
+
+        // rays parallel to the triangle and degenerate triangles : det is small relative to |e1| * |d x e2|
+        T eps = std::numeric_limits<T>::epsilon();
+        T scale = (e1[0] * e1[0] + e1[1] * e1[1] + e1[2] * e1[2]) * (px * px + py * py + pz * pz);
+        bool valid = det * det > eps * eps * scale;
+
+        return valid & (u >= static_cast<T>(0)) & (v >= static_cast<T>(0)) & (u + v <= static_cast<T>(1)) & (t >= static_cast<T>(0)) & (t <= tMax);
+    }
+
+    // slab test, NaNs from a ray lying in a slab plane (0 * inf) are ignored by the comparisons so that the box is closed
+    template<typename T>
+    inline bool intersectBoxLane(const T* o, const T* inv, T tMax, const AABB<T, 3>& box, T& tNear)
+    {
+        T lo = static_cast<T>(0);
+        T hi = tMax;
+
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            T a = (box.min[c] - o[c]) * inv[c];
+            T b = (box.max[c] - o[c]) * inv[c];
+            T n = inv[c] >= static_cast<T>(0) ? a : b;
+            T f = inv[c] >= static_cast<T>(0) ? b : a;
+            lo = n > lo ? n : lo;
+            hi = f < hi ? f : hi;
+        }
+
+        tNear = lo;
+
+        return lo <= hi;
+    }
+
+    template<typename T, std::size_t K>
+    inline std::uint32_t intersectTriangle(const RayPacket<T, K>& rays, const Vector<T, 3>& v0, const Vector<T, 3>& v1, const Vector<T, 3>& v2, PacketHit<T, K>& hit)
+    {
+        Vector<T, 3> e1 = v1 - v0;
+        Vector<T, 3> e2 = v2 - v0;
+        unsigned char hits[K];
+
+        for (std::size_t i = 0; i < K; ++i)
+        {
+            T o[3] = {rays.origin[0][i], rays.origin[1][i], rays.origin[2][i]};
+            T d[3] = {rays.direction[0][i], rays.direction[1][i], rays.direction[2][i]};
+            hits[i] = intersectTriangleLane(o, d, rays.tMax[i], v0.data(), e1.data(), e2.data(), hit.t[i], hit.u[i], hit.v[i]);
+        }
+
+        std::uint32_t mask = 0;
+
+        for (std::size_t i = 0; i < K; ++i)
+            mask |= static_cast<std::uint32_t>(hits[i]) << i;
+
+        return mask;
+    }
+
+    template<typename T, std::size_t K>
+    inline std::uint32_t intersectTriangles(const Ray<T>& ray, const TrianglePacket<T, K>& triangles, PacketHit<T, K>& hit)
+    {
+        unsigned char hits[K];
+
+        for (std::size_t i = 0; i < K; ++i)
+        {
+            T v0[3] = {triangles.v0[0][i], triangles.v0[1][i], triangles.v0[2][i]};
+            T e1[3] = {triangles.edge1[0][i], triangles.edge1[1][i], triangles.edge1[2][i]};
+            T e2[3] = {triangles.edge2[0][i], triangles.edge2[1][i], triangles.edge2[2][i]};
+            hits[i] = intersectTriangleLane(ray.origin.data(), ray.direction.data(), ray.tMax, v0, e1, e2, hit.t[i], hit.u[i], hit.v[i]);
+        }
+
+        std::uint32_t mask = 0;
+
+        for (std::size_t i = 0; i < K; ++i)
+            mask |= static_cast<std::uint32_t>(hits[i]) << i;
+
+        return mask;
+    }
+
+    template<typename T, std::size_t K>
+    inline std::uint32_t intersectBox(const RayPacket<T, K>& rays, const AABB<T, 3>& box, T* tNear)
+    {
+        unsigned char hits[K];
+
+        for (std::size_t i = 0; i < K; ++i)
+        {
+            T o[3] = {rays.origin[0][i], rays.origin[1][i], rays.origin[2][i]};
+            T inv[3] = {rays.invDirection[0][i], rays.invDirection[1][i], rays.invDirection[2][i]};
+            hits[i] = intersectBoxLane(o, inv, rays.tMax[i], box, tNear[i]);
+        }
+
+        std::uint32_t mask = 0;
+
+        for (std::size_t i = 0; i < K; ++i)
+            mask |= static_cast<std::uint32_t>(hits[i]) << i;
+
+        return mask;
+    }
+
+    #ifdef CGLA_SSE
+    inline __m128 cross4(const __m128* a, const __m128* b, std::size_t i)
+    {
+        std::size_t j = (i + 1) % 3, k = (i + 2) % 3;
+
+        return _mm_sub_ps(_mm_mul_ps(a[j], b[k]), _mm_mul_ps(a[k], b[j]));
+    }
+
+    inline __m128 dot4(const __m128* a, const __m128* b)
+    {
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])), _mm_mul_ps(a[2], b[2]));
+    }
+
+    // returns the hit mask of 4 ray-triangle pairs, see intersectTriangleLane
+    inline __m128 intersectTriangle4(const __m128* o, const __m128* d, __m128 tMax, const __m128* v0, const __m128* e1, const __m128* e2, __m128& t, __m128& u, __m128& v)
+    {
+        const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.f);
+        const __m128 eps2 = _mm_set1_ps(std::numeric_limits<float>::epsilon() * std::numeric_limits<float>::epsilon());
+
+        __m128 p[3] = {cross4(d, e2, 0), cross4(d, e2, 1), cross4(d, e2, 2)};
+        __m128 det = dot4(e1, p);
+        __m128 inv = _mm_div_ps(one, det);
+
+        __m128 s[3] = {_mm_sub_ps(o[0], v0[0]), _mm_sub_ps(o[1], v0[1]), _mm_sub_ps(o[2], v0[2])};
+        __m128 q[3] = {cross4(s, e1, 0), cross4(s, e1, 1), cross4(s, e1, 2)};
+
+        u = _mm_mul_ps(dot4(s, p), inv);
+        v = _mm_mul_ps(dot4(d, q), inv);
+        t = _mm_mul_ps(dot4(e2, q), inv);
+
+        __m128 scale = _mm_mul_ps(_mm_mul_ps(dot4(e1, e1), dot4(p, p)), eps2);
+        __m128 mask = _mm_cmpgt_ps(_mm_mul_ps(det, det), scale);
+        mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmpge_ps(v, zero)));
+        mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(u, v), one));
+        mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(t, zero), _mm_cmple_ps(t, tMax)));
+
+        return mask;
+    }
+
+    template<std::size_t K>
+    inline std::uint32_t intersectTriangle(const RayPacket<float, K>& rays, const Vector<float, 3>& v0, const Vector<float, 3>& v1, const Vector<float, 3>& v2, PacketHit<float, K>& hit)
+    {
+        __m128 a[3], e1[3], e2[3];
+
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            a[c] = _mm_set1_ps(v0[c]);
+            e1[c] = _mm_set1_ps(v1[c] - v0[c]);
+            e2[c] = _mm_set1_ps(v2[c] - v0[c]);
+        }
+
+        std::uint32_t mask = 0;
+
+        for (std::size_t i = 0; i < K; i += 4)
+        {
+            __m128 o[3] = {_mm_load_ps(rays.origin[0] + i), _mm_load_ps(rays.origin[1] + i), _mm_load_ps(rays.origin[2] + i)};
+            __m128 d[3] = {_mm_load_ps(rays.direction[0] + i), _mm_load_ps(rays.direction[1] + i), _mm_load_ps(rays.direction[2] + i)};
+            __m128 t, u, v;
+            __m128 m = intersectTriangle4(o, d, _mm_load_ps(rays.tMax + i), a, e1, e2, t, u, v);
+
+            _mm_store_ps(hit.t + i, t);
+            _mm_store_ps(hit.u + i, u);
+            _mm_store_ps(hit.v + i, v);
+            mask |= static_cast<std::uint32_t>(_mm_movemask_ps(m)) << i;
+        }
+
+        return mask;
+    }
+
+    template<std::size_t K>
+    inline std::uint32_t intersectTriangles(const Ray<float>& ray, const TrianglePacket<float, K>& triangles, PacketHit<float, K>& hit)
+    {
+        __m128 o[3], d[3];
+
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            o[c] = _mm_set1_ps(ray.origin[c]);
+            d[c] = _mm_set1_ps(ray.direction[c]);
+        }
+
+        __m128 tMax = _mm_set1_ps(ray.tMax);
+        std::uint32_t mask = 0;
+
+        for (std::size_t i = 0; i < K; i += 4)
+        {
+            __m128 a[3] = {_mm_load_ps(triangles.v0[0] + i), _mm_load_ps(triangles.v0[1] + i), _mm_load_ps(triangles.v0[2] + i)};
+            __m128 e1[3] = {_mm_load_ps(triangles.edge1[0] + i), _mm_load_ps(triangles.edge1[1] + i), _mm_load_ps(triangles.edge1[2] + i)};
+            __m128 e2[3] = {_mm_load_ps(triangles.edge2[0] + i), _mm_load_ps(triangles.edge2[1] + i), _mm_load_ps(triangles.edge2[2] + i)};
+            __m128 t, u, v;
+            __m128 m = intersectTriangle4(o, d, tMax, a, e1, e2, t, u, v);
+
+            _mm_store_ps(hit.t + i, t);
+            _mm_store_ps(hit.u + i, u);
+            _mm_store_ps(hit.v + i, v);
+            mask |= static_cast<std::uint32_t>(_mm_movemask_ps(m)) << i;
+        }
+
+        return mask;
+    }
+
+    template<std::size_t K>
+    inline std::uint32_t intersectBox(const RayPacket<float, K>& rays, const AABB<float, 3>& box, float* tNear)
+    {
+        const __m128 zero = _mm_setzero_ps();
+        std::uint32_t mask = 0;
+
+        for (std::size_t i = 0; i < K; i += 4)
+        {
+            __m128 lo = zero;
+            __m128 hi = _mm_load_ps(rays.tMax + i);
+
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+                __m128 o = _mm_load_ps(rays.origin[c] + i);
+                __m128 inv = _mm_load_ps(rays.invDirection[c] + i);
+                __m128 a = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.min[c]), o), inv);
+                __m128 b = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.max[c]), o), inv);
+                __m128 positive = _mm_cmpge_ps(inv, zero);
+                __m128 n = _mm_or_ps(_mm_and_ps(positive, a), _mm_andnot_ps(positive, b));
+                __m128 f = _mm_or_ps(_mm_and_ps(positive, b), _mm_andnot_ps(positive, a));
+
+                // maxps and minps return their second operand when one is NaN
+                lo = _mm_max_ps(n, lo);
+                hi = _mm_min_ps(f, hi);
+            }
+
+            _mm_storeu_ps(tNear + i, lo);
+            mask |= static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmple_ps(lo, hi))) << i;
+        }
+
+        return mask;
+    }
+    #endif
+}
+
+}
@@ -0,0 +1,54 @@
+#ifndef CGLA_SKINNING_HPP
+#define CGLA_SKINNING_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include "config.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "quaternion.hpp"
+#include "affine.hpp"
+
+namespace cgla {
+
+// vertex streams of a skinned mesh with K influences per vertex, the normal and tangent streams are optional
+template<typename T, std::size_t K>
+struct SkinStreams
+{
+    static_assert(std::is_floating_point<T>::value, "Argument T must be a floating point type");
+    static_assert(K > 0, "Argument K must be greater than zero");
+
+    const Vector<unsigned int, K>* indices = nullptr;
+    const Vector<T, K>* weights = nullptr;
+    const Vector<T, 3>* positions = nullptr;
+    const Vector<T, 3>* normals = nullptr;
+    const Vector<T, 4>* tangents = nullptr; // w (handedness) is copied as is
+    Vector<T, 3>* outPositions = nullptr;
+    Vector<T, 3>* outNormals = nullptr;
+    Vector<T, 4>* outTangents = nullptr;
+};
+
+// rigid transform as a unit dual quaternion : rotation in real, half the translation times the rotation in dual
+template<typename T>
+struct DualQuaternion
+{
+    Quaternion<T> real;
+    Quaternion<T> dual;
+};
+
+template<typename T> DualQuaternion<T> toDualQuaternion(const Quaternion<T>& rotation, const Vector<T, 3>& translation);
+template<typename T> DualQuaternion<T> toDualQuaternion(const Matrix<T, 4, 4>& mat);
+
+template<typename T, std::size_t K> void skinLinear(const Matrix<T, 4, 4>* palette, const SkinStreams<T, K>& streams, std::size_t count, std::size_t threadCount = 1);
+template<typename T, std::size_t K> void skinLinear(const Affine<T, 3>* palette, const SkinStreams<T, K>& streams, std::size_t count, std::size_t threadCount = 1);
+template<typename T, std::size_t K> void skinDualQuaternion(const DualQuaternion<T>* palette, const SkinStreams<T, K>& streams, std::size_t count, std::size_t threadCount = 1);
+
+#ifdef CGLA_TYPE_ALIASES
+using DualQuaternionf = DualQuaternion<float>; using DualQuaterniond = DualQuaternion<double>;
+#endif
+
+}
+
+#include "skinning.inl"
+
+#endif
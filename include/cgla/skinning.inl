@@ -0,0 +1,251 @@
+#include <cstddef>
+#include <cmath>
+#include "config.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "quaternion.hpp"
+#include "affine.hpp"
+#include "parallel.hpp"
+#ifdef CGLA_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace cgla {
+
+namespace detail {
+    // minimum number of vertices given to a thread
+    constexpr std::size_t skinningGrainSize = 4096;
+
+    template<typename T> void accumulate(T* blend, const Matrix<T, 4, 4>& mat, T w);
+    template<typename T> void accumulate(T* blend, const Affine<T, 3>& a, T w);
+    template<typename T, std::size_t K> void applyBlend(const T* blend, const SkinStreams<T, K>& streams, std::size_t v);
+    template<typename T, std::size_t K, typename Palette> void skinLinear(const Palette* palette, const SkinStreams<T, K>& streams, std::size_t begin, std::size_t end);
+    #ifdef CGLA_SSE
+    template<std::size_t K> void skinLinear(const Matrix<float, 4, 4>* palette, const SkinStreams<float, K>& streams, std::size_t begin, std::size_t end);
+    #endif
+    template<typename T, std::size_t K> void skinDualQuaternion(const DualQuaternion<T>* palette, const SkinStreams<T, K>& streams, std::size_t begin, std::size_t end);
+}
+
+template<typename T>
+DualQuaternion<T> toDualQuaternion(const Quaternion<T>& rotation, const Vector<T, 3>& translation)
+{
+    return {rotation, (Quaternion<T>{translation, static_cast<T>(0)} * rotation) * static_cast<T>(0.5)};
+}
+
+template<typename T>
+DualQuaternion<T> toDualQuaternion(const Matrix<T, 4, 4>& mat)
+{
+    return toDualQuaternion(fromMatrix(mat), Vector<T, 3>{mat[12], mat[13], mat[14]});
+}
+
+template<typename T, std::size_t K>
+void skinLinear(const Matrix<T, 4, 4>* palette, const SkinStreams<T, K>& streams, std::size_t count, std::size_t threadCount)
+{
+    detail::runChunked(count, threadCount, detail::skinningGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        detail::skinLinear(palette, streams, begin, end);
+    });
+}
+
+template<typename T, std::size_t K>
+void skinLinear(const Affine<T, 3>* palette, const SkinStreams<T, K>& streams, std::size_t count, std::size_t threadCount)
+{
+    detail::runChunked(count, threadCount, detail::skinningGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        detail::skinLinear(palette, streams, begin, end);
+    });
+}
+
+template<typename T, std::size_t K>
+void skinDualQuaternion(const DualQuaternion<T>* palette, const SkinStreams<T, K>& streams, std::size_t count, std::size_t threadCount)
+{
+    detail::runChunked(count, threadCount, detail::skinningGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        detail::skinDualQuaternion(palette, streams, begin, end);
+    });
+}
+
+namespace detail {
+    // the blended transform is kept as a column-major 3x4 matrix, the projective row is never needed
+    template<typename T>
+    inline void accumulate(T* blend, const Matrix<T, 4, 4>& mat, T w)
+    {
+        for (std::size_t j = 0; j < 4; ++j)
+            for (std::size_t i = 0; i < 3; ++i)
+                blend[j * 3 + i] += w * mat[j * 4 + i];
+    }
+
+    template<typename T>
+    inline void accumulate(T* blend, const Affine<T, 3>& a, T w)
+    {
+        const T* values = a.data();
+
+        for (std::size_t i = 0; i < 12; ++i)
+            blend[i] += w * values[i];
+    }
+
+    template<typename T, std::size_t K>
+    inline void applyBlend(const T* b, const SkinStreams<T, K>& streams, std::size_t v)
+    {
+        const Vector<T, 3>& p = streams.positions[v];
+        streams.outPositions[v] = {b[0] * p[0] + b[3] * p[1] + b[6] * p[2] + b[9],
+                                   b[1] * p[0] + b[4] * p[1] + b[7] * p[2] + b[10],
+                                   b[2] * p[0] + b[5] * p[1] + b[8] * p[2] + b[11]};
+
+        if (streams.normals)
+        {
+            // normals go through the cofactor matrix, det times the inverse transpose, whose columns are the cross products
+            // of the columns of the blended linear part; the normalization removes the size of det and its sign is applied
+            // so that mirrored bones keep the normals pointing outwards
+            T c0[3] = {b[4] * b[8] - b[5] * b[7], b[5] * b[6] - b[3] * b[8], b[3] * b[7] - b[4] * b[6]};
+            T c1[3] = {b[7] * b[2] - b[8] * b[1], b[8] * b[0] - b[6] * b[2], b[6] * b[1] - b[7] * b[0]};
+            T c2[3] = {b[1] * b[5] - b[2] * b[4], b[2] * b[3] - b[0] * b[5], b[0] * b[4] - b[1] * b[3]};
+            T det = b[0] * c0[0] + b[1] * c0[1] + b[2] * c0[2];
+
+            const Vector<T, 3>& n = streams.normals[v];
+            T x = c0[0] * n[0] + c1[0] * n[1] + c2[0] * n[2];
+            T y = c0[1] * n[0] + c1[1] * n[1] + c2[1] * n[2];
+            T z = c0[2] * n[0] + c1[2] * n[1] + c2[2] * n[2];
+            T s = std::copysign(static_cast<T>(1) / std::sqrt(x * x + y * y + z * z), det);
+            streams.outNormals[v] = {x * s, y * s, z * s};
+        }
+
+        if (streams.tangents)
+        {
+            const Vector<T, 4>& t = streams.tangents[v];
+            T x = b[0] * t[0] + b[3] * t[1] + b[6] * t[2];
+            T y = b[1] * t[0] + b[4] * t[1] + b[7] * t[2];
+            T z = b[2] * t[0] + b[5] * t[1] + b[8] * t[2];
+            T s = static_cast<T>(1) / std::sqrt(x * x + y * y + z * z);
+            streams.outTangents[v] = {x * s, y * s, z * s, t[3]};
+        }
+    }
+
+    template<typename T, std::size_t K, typename Palette>
+    inline void skinLinear(const Palette* palette, const SkinStreams<T, K>& streams, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t v = begin; v < end; ++v)
+        {
+            T blend[12] = {};
+
+            for (std::size_t k = 0; k < K; ++k)
+                accumulate(blend, palette[streams.indices[v][k]], streams.weights[v][k]);
+
+            applyBlend(blend, streams, v);
+        }
+    }
+
+    #ifdef CGLA_SSE
+    // u x v in the first three lanes
+    inline __m128 cross3(__m128 u, __m128 v)
+    {
+        __m128 c = _mm_sub_ps(_mm_mul_ps(u, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1))), _mm_mul_ps(_mm_shuffle_ps(u, u, _MM_SHUFFLE(3, 0, 2, 1)), v));
+        return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+
+    template<std::size_t K>
+    inline void skinLinear(const Matrix<float, 4, 4>* palette, const SkinStreams<float, K>& streams, std::size_t begin, std::size_t end)
+    {
+        // one register per blended column, the fourth lane is unused
+        alignas(16) float b[4];
+
+        for (std::size_t v = begin; v < end; ++v)
+        {
+            __m128 c0 = _mm_setzero_ps();
+            __m128 c1 = _mm_setzero_ps();
+            __m128 c2 = _mm_setzero_ps();
+            __m128 c3 = _mm_setzero_ps();
+
+            for (std::size_t k = 0; k < K; ++k)
+            {
+                const float* m = palette[streams.indices[v][k]].data();
+                __m128 w = _mm_set1_ps(streams.weights[v][k]);
+                c0 = _mm_add_ps(c0, _mm_mul_ps(w, _mm_loadu_ps(m)));
+                c1 = _mm_add_ps(c1, _mm_mul_ps(w, _mm_loadu_ps(m + 4)));
+                c2 = _mm_add_ps(c2, _mm_mul_ps(w, _mm_loadu_ps(m + 8)));
+                c3 = _mm_add_ps(c3, _mm_mul_ps(w, _mm_loadu_ps(m + 12)));
+            }
+
+            const Vector<float, 3>& p = streams.positions[v];
+            __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(p[0])), _mm_mul_ps(c1, _mm_set1_ps(p[1]))),
+                                  _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(p[2])), c3));
+            _mm_store_ps(b, r);
+            streams.outPositions[v] = {b[0], b[1], b[2]};
+
+            if (streams.normals)
+            {
+                // cofactor columns and the sign of det, as in applyBlend
+                const Vector<float, 3>& n = streams.normals[v];
+                __m128 k0 = cross3(c1, c2);
+                _mm_store_ps(b, _mm_mul_ps(c0, k0));
+                float det = b[0] + b[1] + b[2];
+                r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(k0, _mm_set1_ps(n[0])), _mm_mul_ps(cross3(c2, c0), _mm_set1_ps(n[1]))),
+                               _mm_mul_ps(cross3(c0, c1), _mm_set1_ps(n[2])));
+                _mm_store_ps(b, r);
+                float s = std::copysign(1.f / std::sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2]), det);
+                streams.outNormals[v] = {b[0] * s, b[1] * s, b[2] * s};
+            }
+
+            if (streams.tangents)
+            {
+                const Vector<float, 4>& t = streams.tangents[v];
+                r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(t[0])), _mm_mul_ps(c1, _mm_set1_ps(t[1]))), _mm_mul_ps(c2, _mm_set1_ps(t[2])));
+                _mm_store_ps(b, r);
+                float s = 1.f / std::sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2]);
+                streams.outTangents[v] = {b[0] * s, b[1] * s, b[2] * s, t[3]};
+            }
+        }
+    }
+    #endif
+
+    template<typename T, std::size_t K>
+    inline void skinDualQuaternion(const DualQuaternion<T>* palette, const SkinStreams<T, K>& streams, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t v = begin; v < end; ++v)
+        {
+            const Quaternion<T>& pivot = palette[streams.indices[v][0]].real;
+            T r[4] = {};
+            T d[4] = {};
+
+            // blend along the shortest path relative to the first influence
+            for (std::size_t k = 0; k < K; ++k)
+            {
+                const DualQuaternion<T>& q = palette[streams.indices[v][k]];
+                T w = dot(q.real, pivot) < static_cast<T>(0) ? -streams.weights[v][k] : streams.weights[v][k];
+
+                for (std::size_t i = 0; i < 4; ++i)
+                {
+                    r[i] += w * q.real[i];
+                    d[i] += w * q.dual[i];
+                }
+            }
+
+            T s = static_cast<T>(1) / std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3]);
+            Quaternion<T> real{r[0] * s, r[1] * s, r[2] * s, r[3] * s};
+            Quaternion<T> dual{d[0] * s, d[1] * s, d[2] * s, d[3] * s};
+
+            // translation = 2 * vector part of dual * conjugate(real)
+            Vector<T, 3> rv = real.vector();
+            Vector<T, 3> dv = dual.vector();
+            Vector<T, 3> c = cross(rv, dv);
+            T two = static_cast<T>(2);
+
+            Vector<T, 3> p = rotate(real, streams.positions[v]);
+            streams.outPositions[v] = {p[0] + two * (real[3] * dv[0] - dual[3] * rv[0] + c[0]),
+                                       p[1] + two * (real[3] * dv[1] - dual[3] * rv[1] + c[1]),
+                                       p[2] + two * (real[3] * dv[2] - dual[3] * rv[2] + c[2])};
+
+            if (streams.normals)
+                streams.outNormals[v] = rotate(real, streams.normals[v]);
+
+            if (streams.tangents)
+            {
+                const Vector<T, 4>& t = streams.tangents[v];
+                Vector<T, 3> u = rotate(real, Vector<T, 3>{t[0], t[1], t[2]});
+                streams.outTangents[v] = {u[0], u[1], u[2], t[3]};
+            }
+        }
+    }
+}
+
+}
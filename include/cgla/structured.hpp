@@ -0,0 +1,146 @@
+#ifndef CGLA_STRUCTURED_HPP
+#define CGLA_STRUCTURED_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <type_traits>
+#include "config.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "affine.hpp"
+
+namespace cgla {
+
+// diag(s, 1), the homogeneous scale of N-dimensional space
+template<typename T, std::size_t N>
+class Diagonal
+{
+    static_assert(std::is_arithmetic<T>::value, "Argument T must be an arithmetic type");
+    static_assert(N > 0, "Argument N must be greater than zero");
+
+    public:
+        CGLA_CONSTEXPR Diagonal();
+        explicit Diagonal(Uninitialized);
+        CGLA_CONSTEXPR explicit Diagonal(const Vector<T, N>& scale);
+        CGLA_CONSTEXPR explicit Diagonal(const Matrix<T, N + 1, N + 1>& mat); // only the diagonal is read
+
+        CGLA_CONSTEXPR T* data();
+        CGLA_CONSTEXPR const T* data() const;
+        CGLA_CONSTEXPR T& operator[](std::size_t i);
+        CGLA_CONSTEXPR T operator[](std::size_t i) const;
+        CGLA_CONSTEXPR T operator()(std::size_t i, std::size_t j) const; // component of the homogeneous matrix
+        CGLA_CONSTEXPR const Vector<T, N>& scale() const;
+
+        CGLA_CONSTEXPR Diagonal<T, N>& operator*=(const Diagonal<T, N>& rhs);
+        CGLA_CONSTEXPR bool operator==(const Diagonal<T, N>& rhs) const;
+        CGLA_CONSTEXPR bool operator!=(const Diagonal<T, N>& rhs) const;
+
+    private:
+        Vector<T, N> values;
+};
+
+// [I t], the homogeneous translation of N-dimensional space
+template<typename T, std::size_t N>
+class Translation
+{
+    static_assert(std::is_arithmetic<T>::value, "Argument T must be an arithmetic type");
+    static_assert(N > 0, "Argument N must be greater than zero");
+
+    public:
+        CGLA_CONSTEXPR Translation();
+        explicit Translation(Uninitialized);
+        CGLA_CONSTEXPR explicit Translation(const Vector<T, N>& translation);
+        CGLA_CONSTEXPR explicit Translation(const Matrix<T, N + 1, N + 1>& mat); // only the last column is read
+
+        CGLA_CONSTEXPR T* data();
+        CGLA_CONSTEXPR const T* data() const;
+        CGLA_CONSTEXPR T& operator[](std::size_t i);
+        CGLA_CONSTEXPR T operator[](std::size_t i) const;
+        CGLA_CONSTEXPR T operator()(std::size_t i, std::size_t j) const;
+        CGLA_CONSTEXPR const Vector<T, N>& translation() const;
+
+        CGLA_CONSTEXPR Translation<T, N>& operator*=(const Translation<T, N>& rhs);
+        CGLA_CONSTEXPR bool operator==(const Translation<T, N>& rhs) const;
+        CGLA_CONSTEXPR bool operator!=(const Translation<T, N>& rhs) const;
+
+    private:
+        Vector<T, N> values;
+};
+
+// the shape of frustum and perspective : only 6 of the 16 components are free and the last row is (0, 0, -1, 0)
+template<typename T>
+class Perspective
+{
+    static_assert(std::is_floating_point<T>::value, "Argument T must be a floating point type");
+
+    public:
+        explicit Perspective(Uninitialized);
+        CGLA_CONSTEXPR Perspective(T xScale, T yScale, T xOffset, T yOffset, T zScale, T zOffset);
+        CGLA_CONSTEXPR explicit Perspective(const Matrix<T, 4, 4>& mat); // only the free components are read
+
+        CGLA_CONSTEXPR T* data(); // xScale, yScale, xOffset, yOffset, zScale, zOffset
+        CGLA_CONSTEXPR const T* data() const;
+        CGLA_CONSTEXPR T operator()(std::size_t i, std::size_t j) const;
+
+        CGLA_CONSTEXPR bool operator==(const Perspective<T>& rhs) const;
+        CGLA_CONSTEXPR bool operator!=(const Perspective<T>& rhs) const;
+
+    private:
+        T values[6];
+};
+
+template<typename T, std::size_t N> CGLA_CONSTEXPR Diagonal<T, N> operator*(const Diagonal<T, N>& lhs, const Diagonal<T, N>& rhs);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Translation<T, N> operator*(const Translation<T, N>& lhs, const Translation<T, N>& rhs);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Affine<T, N> operator*(const Diagonal<T, N>& lhs, const Translation<T, N>& rhs);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Affine<T, N> operator*(const Translation<T, N>& lhs, const Diagonal<T, N>& rhs);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Affine<T, N> operator*(const Diagonal<T, N>& lhs, const Affine<T, N>& rhs);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Affine<T, N> operator*(const Affine<T, N>& lhs, const Diagonal<T, N>& rhs);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Affine<T, N> operator*(const Translation<T, N>& lhs, const Affine<T, N>& rhs);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Affine<T, N> operator*(const Affine<T, N>& lhs, const Translation<T, N>& rhs);
+template<typename T> CGLA_CONSTEXPR Matrix<T, 4, 4> operator*(const Perspective<T>& lhs, const Affine<T, 3>& rhs);
+
+// products with dense matrices skip the known zeros
+template<typename T, std::size_t N> CGLA_CONSTEXPR Matrix<T, N + 1, N + 1> operator*(const Diagonal<T, N>& lhs, const Matrix<T, N + 1, N + 1>& rhs);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Matrix<T, N + 1, N + 1> operator*(const Matrix<T, N + 1, N + 1>& lhs, const Diagonal<T, N>& rhs);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Matrix<T, N + 1, N + 1> operator*(const Translation<T, N>& lhs, const Matrix<T, N + 1, N + 1>& rhs);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Matrix<T, N + 1, N + 1> operator*(const Matrix<T, N + 1, N + 1>& lhs, const Translation<T, N>& rhs);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Matrix<T, N + 1, N + 1> operator*(const Matrix<T, N + 1, N + 1>& lhs, const Affine<T, N>& rhs);
+template<typename T> CGLA_CONSTEXPR Matrix<T, 4, 4> operator*(const Perspective<T>& lhs, const Matrix<T, 4, 4>& rhs);
+
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, N + 1> operator*(const Diagonal<T, N>& lhs, const Vector<T, N + 1>& rhs);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, N + 1> operator*(const Translation<T, N>& lhs, const Vector<T, N + 1>& rhs);
+template<typename T> CGLA_CONSTEXPR Vector<T, 4> operator*(const Perspective<T>& lhs, const Vector<T, 4>& rhs);
+
+#ifdef CGLA_OSTREAM_OVERLOADS
+template<typename T, std::size_t N> std::ostream& operator<<(std::ostream& lhs, const Diagonal<T, N>& rhs);
+template<typename T, std::size_t N> std::ostream& operator<<(std::ostream& lhs, const Translation<T, N>& rhs);
+template<typename T> std::ostream& operator<<(std::ostream& lhs, const Perspective<T>& rhs);
+#endif
+
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, N> transformPoint(const Diagonal<T, N>& d, const Vector<T, N>& p);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, N> transformDirection(const Diagonal<T, N>& d, const Vector<T, N>& v);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, N> transformPoint(const Translation<T, N>& t, const Vector<T, N>& p);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, N> transformDirection(const Translation<T, N>& t, const Vector<T, N>& v);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Diagonal<T, N> inverse(const Diagonal<T, N>& d);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Translation<T, N> inverse(const Translation<T, N>& t);
+
+template<typename T, std::size_t N> CGLA_CONSTEXPR Affine<T, N> toAffine(const Diagonal<T, N>& d);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Affine<T, N> toAffine(const Translation<T, N>& t);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Matrix<T, N + 1, N + 1> toMatrix(const Diagonal<T, N>& d);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Matrix<T, N + 1, N + 1> toMatrix(const Translation<T, N>& t);
+template<typename T> CGLA_CONSTEXPR Matrix<T, 4, 4> toMatrix(const Perspective<T>& p);
+
+#ifdef CGLA_TYPE_ALIASES
+using Diagonal2f = Diagonal<float, 2>; using Diagonal3f = Diagonal<float, 3>;
+using Diagonal2d = Diagonal<double, 2>; using Diagonal3d = Diagonal<double, 3>;
+using Translation2f = Translation<float, 2>; using Translation3f = Translation<float, 3>;
+using Translation2d = Translation<double, 2>; using Translation3d = Translation<double, 3>;
+using Perspectivef = Perspective<float>;
+using Perspectived = Perspective<double>;
+#endif
+
+}
+
+#include "structured.inl"
+
+#endif
@@ -0,0 +1,596 @@
+#include <cstddef>
+#include "config.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "affine.hpp"
+
+namespace cgla {
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Diagonal<T, N>::Diagonal() :
+    values{}
+{
+    for (std::size_t i = 0; i < N; ++i)
+        values[i] = static_cast<T>(1);
+}
+
+template<typename T, std::size_t N>
+inline Diagonal<T, N>::Diagonal(Uninitialized) :
+    values{uninitialized}
+{
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Diagonal<T, N>::Diagonal(const Vector<T, N>& scale) :
+    values{scale}
+{
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Diagonal<T, N>::Diagonal(const Matrix<T, N + 1, N + 1>& mat) :
+    values{}
+{
+    for (std::size_t i = 0; i < N; ++i)
+        values[i] = mat(i, i);
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR T* Diagonal<T, N>::data()
+{
+    return values.data();
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR const T* Diagonal<T, N>::data() const
+{
+    return values.data();
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR T& Diagonal<T, N>::operator[](std::size_t i)
+{
+    return values[i];
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR T Diagonal<T, N>::operator[](std::size_t i) const
+{
+    return values[i];
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR T Diagonal<T, N>::operator()(std::size_t i, std::size_t j) const
+{
+    if (i != j)
+        return static_cast<T>(0);
+
+    return (i == N) ? static_cast<T>(1) : values[i];
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR const Vector<T, N>& Diagonal<T, N>::scale() const
+{
+    return values;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Diagonal<T, N>& Diagonal<T, N>::operator*=(const Diagonal<T, N>& rhs)
+{
+    return *this = *this * rhs;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR bool Diagonal<T, N>::operator==(const Diagonal<T, N>& rhs) const
+{
+    return values == rhs.values;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR bool Diagonal<T, N>::operator!=(const Diagonal<T, N>& rhs) const
+{
+    return values != rhs.values;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Translation<T, N>::Translation() :
+    values{}
+{
+}
+
+template<typename T, std::size_t N>
+inline Translation<T, N>::Translation(Uninitialized) :
+    values{uninitialized}
+{
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Translation<T, N>::Translation(const Vector<T, N>& translation) :
+    values{translation}
+{
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Translation<T, N>::Translation(const Matrix<T, N + 1, N + 1>& mat) :
+    values{}
+{
+    for (std::size_t i = 0; i < N; ++i)
+        values[i] = mat(i, N);
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR T* Translation<T, N>::data()
+{
+    return values.data();
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR const T* Translation<T, N>::data() const
+{
+    return values.data();
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR T& Translation<T, N>::operator[](std::size_t i)
+{
+    return values[i];
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR T Translation<T, N>::operator[](std::size_t i) const
+{
+    return values[i];
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR T Translation<T, N>::operator()(std::size_t i, std::size_t j) const
+{
+    if (i == j)
+        return static_cast<T>(1);
+
+    return (j == N) ? values[i] : static_cast<T>(0);
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR const Vector<T, N>& Translation<T, N>::translation() const
+{
+    return values;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Translation<T, N>& Translation<T, N>::operator*=(const Translation<T, N>& rhs)
+{
+    return *this = *this * rhs;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR bool Translation<T, N>::operator==(const Translation<T, N>& rhs) const
+{
+    return values == rhs.values;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR bool Translation<T, N>::operator!=(const Translation<T, N>& rhs) const
+{
+    return values != rhs.values;
+}
+
+template<typename T>
+inline Perspective<T>::Perspective(Uninitialized)
+{
+}
+
+template<typename T>
+CGLA_CONSTEXPR Perspective<T>::Perspective(T xScale, T yScale, T xOffset, T yOffset, T zScale, T zOffset) :
+    values{xScale, yScale, xOffset, yOffset, zScale, zOffset}
+{
+}
+
+template<typename T>
+CGLA_CONSTEXPR Perspective<T>::Perspective(const Matrix<T, 4, 4>& mat) :
+    values{mat(0, 0), mat(1, 1), mat(0, 2), mat(1, 2), mat(2, 2), mat(2, 3)}
+{
+}
+
+template<typename T>
+CGLA_CONSTEXPR T* Perspective<T>::data()
+{
+    return values;
+}
+
+template<typename T>
+CGLA_CONSTEXPR const T* Perspective<T>::data() const
+{
+    return values;
+}
+
+template<typename T>
+CGLA_CONSTEXPR T Perspective<T>::operator()(std::size_t i, std::size_t j) const
+{
+    switch (j * 4 + i)
+    {
+        case 0: return values[0];
+        case 5: return values[1];
+        case 8: return values[2];
+        case 9: return values[3];
+        case 10: return values[4];
+        case 11: return -static_cast<T>(1);
+        case 14: return values[5];
+        default: return static_cast<T>(0);
+    }
+}
+
+template<typename T>
+CGLA_CONSTEXPR bool Perspective<T>::operator==(const Perspective<T>& rhs) const
+{
+    for (std::size_t i = 0; i < 6; ++i)
+        if (values[i] != rhs.values[i])
+            return false;
+
+    return true;
+}
+
+template<typename T>
+CGLA_CONSTEXPR bool Perspective<T>::operator!=(const Perspective<T>& rhs) const
+{
+    return !(*this == rhs);
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Diagonal<T, N> operator*(const Diagonal<T, N>& lhs, const Diagonal<T, N>& rhs)
+{
+    return Diagonal<T, N>{lhs.scale() * rhs.scale()};
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Translation<T, N> operator*(const Translation<T, N>& lhs, const Translation<T, N>& rhs)
+{
+    return Translation<T, N>{lhs.translation() + rhs.translation()};
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Affine<T, N> operator*(const Diagonal<T, N>& lhs, const Translation<T, N>& rhs)
+{
+    Affine<T, N> res{Matrix<T, N, N + 1>{}};
+
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        res(i, i) = lhs[i];
+        res(i, N) = lhs[i] * rhs[i];
+    }
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Affine<T, N> operator*(const Translation<T, N>& lhs, const Diagonal<T, N>& rhs)
+{
+    Affine<T, N> res{Matrix<T, N, N + 1>{}};
+
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        res(i, i) = rhs[i];
+        res(i, N) = lhs[i];
+    }
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Affine<T, N> operator*(const Diagonal<T, N>& lhs, const Affine<T, N>& rhs)
+{
+    // scales the rows
+    Affine<T, N> res{rhs};
+
+    for (std::size_t j = 0; j < N + 1; ++j)
+        for (std::size_t i = 0; i < N; ++i)
+            res(i, j) *= lhs[i];
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Affine<T, N> operator*(const Affine<T, N>& lhs, const Diagonal<T, N>& rhs)
+{
+    // scales the columns of the linear part
+    Affine<T, N> res{lhs};
+
+    for (std::size_t j = 0; j < N; ++j)
+        for (std::size_t i = 0; i < N; ++i)
+            res(i, j) *= rhs[j];
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Affine<T, N> operator*(const Translation<T, N>& lhs, const Affine<T, N>& rhs)
+{
+    Affine<T, N> res{rhs};
+
+    for (std::size_t i = 0; i < N; ++i)
+        res(i, N) += lhs[i];
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Affine<T, N> operator*(const Affine<T, N>& lhs, const Translation<T, N>& rhs)
+{
+    Affine<T, N> res{lhs};
+
+    for (std::size_t i = 0; i < N; ++i)
+        for (std::size_t k = 0; k < N; ++k)
+            res(i, N) += lhs(i, k) * rhs[k];
+
+    return res;
+}
+
+template<typename T>
+CGLA_CONSTEXPR Matrix<T, 4, 4> operator*(const Perspective<T>& lhs, const Affine<T, 3>& rhs)
+{
+    // 20 multiplications instead of 64, the last row of rhs is (0, 0, 0, 1)
+    Matrix<T, 4, 4> res{};
+    const T* p = lhs.data();
+
+    for (std::size_t j = 0; j < 4; ++j)
+    {
+        T z = rhs(2, j);
+
+        res(0, j) = p[0] * rhs(0, j) + p[2] * z;
+        res(1, j) = p[1] * rhs(1, j) + p[3] * z;
+        res(2, j) = p[4] * z;
+        res(3, j) = -z;
+    }
+
+    res(2, 3) += p[5];
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Matrix<T, N + 1, N + 1> operator*(const Diagonal<T, N>& lhs, const Matrix<T, N + 1, N + 1>& rhs)
+{
+    Matrix<T, N + 1, N + 1> res{rhs};
+
+    for (std::size_t j = 0; j < N + 1; ++j)
+        for (std::size_t i = 0; i < N; ++i)
+            res(i, j) *= lhs[i];
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Matrix<T, N + 1, N + 1> operator*(const Matrix<T, N + 1, N + 1>& lhs, const Diagonal<T, N>& rhs)
+{
+    Matrix<T, N + 1, N + 1> res{lhs};
+
+    for (std::size_t j = 0; j < N; ++j)
+        for (std::size_t i = 0; i < N + 1; ++i)
+            res(i, j) *= rhs[j];
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Matrix<T, N + 1, N + 1> operator*(const Translation<T, N>& lhs, const Matrix<T, N + 1, N + 1>& rhs)
+{
+    // adds the last row scaled by the translation to the other rows
+    Matrix<T, N + 1, N + 1> res{rhs};
+
+    for (std::size_t j = 0; j < N + 1; ++j)
+        for (std::size_t i = 0; i < N; ++i)
+            res(i, j) += lhs[i] * rhs(N, j);
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Matrix<T, N + 1, N + 1> operator*(const Matrix<T, N + 1, N + 1>& lhs, const Translation<T, N>& rhs)
+{
+    Matrix<T, N + 1, N + 1> res{lhs};
+
+    for (std::size_t i = 0; i < N + 1; ++i)
+        for (std::size_t k = 0; k < N; ++k)
+            res(i, N) += lhs(i, k) * rhs[k];
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Matrix<T, N + 1, N + 1> operator*(const Matrix<T, N + 1, N + 1>& lhs, const Affine<T, N>& rhs)
+{
+    // the implicit last row of rhs turns the last column into a plain addition
+    Matrix<T, N + 1, N + 1> res{};
+
+    for (std::size_t j = 0; j < N + 1; ++j)
+    {
+        for (std::size_t i = 0; i < N + 1; ++i)
+        {
+            T sum = (j == N) ? lhs(i, N) : static_cast<T>(0);
+
+            for (std::size_t k = 0; k < N; ++k)
+                sum += lhs(i, k) * rhs(k, j);
+
+            res(i, j) = sum;
+        }
+    }
+
+    return res;
+}
+
+template<typename T>
+CGLA_CONSTEXPR Matrix<T, 4, 4> operator*(const Perspective<T>& lhs, const Matrix<T, 4, 4>& rhs)
+{
+    Matrix<T, 4, 4> res{};
+    const T* p = lhs.data();
+
+    for (std::size_t j = 0; j < 4; ++j)
+    {
+        T z = rhs(2, j);
+
+        res(0, j) = p[0] * rhs(0, j) + p[2] * z;
+        res(1, j) = p[1] * rhs(1, j) + p[3] * z;
+        res(2, j) = p[4] * z + p[5] * rhs(3, j);
+        res(3, j) = -z;
+    }
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Vector<T, N + 1> operator*(const Diagonal<T, N>& lhs, const Vector<T, N + 1>& rhs)
+{
+    Vector<T, N + 1> res{rhs};
+
+    for (std::size_t i = 0; i < N; ++i)
+        res[i] *= lhs[i];
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Vector<T, N + 1> operator*(const Translation<T, N>& lhs, const Vector<T, N + 1>& rhs)
+{
+    Vector<T, N + 1> res{rhs};
+
+    for (std::size_t i = 0; i < N; ++i)
+        res[i] += lhs[i] * rhs[N];
+
+    return res;
+}
+
+template<typename T>
+CGLA_CONSTEXPR Vector<T, 4> operator*(const Perspective<T>& lhs, const Vector<T, 4>& rhs)
+{
+    // 6 multiplications instead of 16
+    const T* p = lhs.data();
+
+    return Vector<T, 4>{p[0] * rhs[0] + p[2] * rhs[2], p[1] * rhs[1] + p[3] * rhs[2], p[4] * rhs[2] + p[5] * rhs[3], -rhs[2]};
+}
+
+#ifdef CGLA_OSTREAM_OVERLOADS
+template<typename T, std::size_t N>
+std::ostream& operator<<(std::ostream& lhs, const Diagonal<T, N>& rhs)
+{
+    return lhs << toMatrix(rhs);
+}
+
+template<typename T, std::size_t N>
+std::ostream& operator<<(std::ostream& lhs, const Translation<T, N>& rhs)
+{
+    return lhs << toMatrix(rhs);
+}
+
+template<typename T>
+std::ostream& operator<<(std::ostream& lhs, const Perspective<T>& rhs)
+{
+    return lhs << toMatrix(rhs);
+}
+#endif
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Vector<T, N> transformPoint(const Diagonal<T, N>& d, const Vector<T, N>& p)
+{
+    return d.scale() * p;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Vector<T, N> transformDirection(const Diagonal<T, N>& d, const Vector<T, N>& v)
+{
+    return d.scale() * v;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Vector<T, N> transformPoint(const Translation<T, N>& t, const Vector<T, N>& p)
+{
+    return t.translation() + p;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Vector<T, N> transformDirection(const Translation<T, N>&, const Vector<T, N>& v)
+{
+    return v;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Diagonal<T, N> inverse(const Diagonal<T, N>& d)
+{
+    Diagonal<T, N> res{};
+
+    for (std::size_t i = 0; i < N; ++i)
+        res[i] = static_cast<T>(1) / d[i];
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Translation<T, N> inverse(const Translation<T, N>& t)
+{
+    return Translation<T, N>{-t.translation()};
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Affine<T, N> toAffine(const Diagonal<T, N>& d)
+{
+    Affine<T, N> res{};
+
+    for (std::size_t i = 0; i < N; ++i)
+        res(i, i) = d[i];
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Affine<T, N> toAffine(const Translation<T, N>& t)
+{
+    Affine<T, N> res{};
+
+    for (std::size_t i = 0; i < N; ++i)
+        res(i, N) = t[i];
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Matrix<T, N + 1, N + 1> toMatrix(const Diagonal<T, N>& d)
+{
+    Matrix<T, N + 1, N + 1> res{};
+
+    for (std::size_t i = 0; i < N; ++i)
+        res(i, i) = d[i];
+
+    res(N, N) = static_cast<T>(1);
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Matrix<T, N + 1, N + 1> toMatrix(const Translation<T, N>& t)
+{
+    Matrix<T, N + 1, N + 1> res{};
+
+    for (std::size_t i = 0; i < N + 1; ++i)
+        res(i, i) = static_cast<T>(1);
+
+    for (std::size_t i = 0; i < N; ++i)
+        res(i, N) = t[i];
+
+    return res;
+}
+
+template<typename T>
+CGLA_CONSTEXPR Matrix<T, 4, 4> toMatrix(const Perspective<T>& p)
+{
+    Matrix<T, 4, 4> res{};
+
+    res(0, 0) = p.data()[0];
+    res(1, 1) = p.data()[1];
+    res(0, 2) = p.data()[2];
+    res(1, 2) = p.data()[3];
+    res(2, 2) = p.data()[4];
+    res(3, 2) = -static_cast<T>(1);
+    res(2, 3) = p.data()[5];
+
+    return res;
+}
+
+}
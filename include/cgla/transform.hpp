@@ -1,22 +1,79 @@
 #ifndef CGLA_TRANSFORM_HPP
 #define CGLA_TRANSFORM_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include "config.hpp"
 #include "vector.hpp"
 #include "matrix.hpp"
+#include "quaternion.hpp"
 
 namespace cgla {
 
-template<typename T> Matrix<T, 4, 4> translate(const Vector<T, 3>& v);
-template<typename T> Matrix<T, 4, 4> scale(const Vector<T, 3>& v);
-template<typename T> Matrix<T, 4, 4> scale(T v);
+template<typename T> CGLA_CONSTEXPR Matrix<T, 4, 4> translate(const Vector<T, 3>& v);
+template<typename T> CGLA_CONSTEXPR Matrix<T, 4, 4> translate(const Matrix<T, 4, 4>& mat, const Vector<T, 3>& v);
+template<typename T> CGLA_CONSTEXPR Matrix<T, 4, 4> scale(const Vector<T, 3>& v);
+template<typename T> CGLA_CONSTEXPR Matrix<T, 4, 4> scale(T v);
+template<typename T> CGLA_CONSTEXPR Matrix<T, 4, 4> scale(const Matrix<T, 4, 4>& mat, const Vector<T, 3>& v);
+template<typename T> CGLA_CONSTEXPR Matrix<T, 4, 4> scale(const Matrix<T, 4, 4>& mat, T v);
 template<typename T> Matrix<T, 4, 4> rotateX(T angle);
+template<typename T> Matrix<T, 4, 4> rotateX(const Matrix<T, 4, 4>& mat, T angle);
 template<typename T> Matrix<T, 4, 4> rotateY(T angle);
+template<typename T> Matrix<T, 4, 4> rotateY(const Matrix<T, 4, 4>& mat, T angle);
 template<typename T> Matrix<T, 4, 4> rotateZ(T angle);
+template<typename T> Matrix<T, 4, 4> rotateZ(const Matrix<T, 4, 4>& mat, T angle);
 template<typename T> Matrix<T, 4, 4> rotate(T angle, const Vector<T, 3>& axis);
+template<typename T> Matrix<T, 4, 4> rotate(const Matrix<T, 4, 4>& mat, T angle, const Vector<T, 3>& axis);
+template<typename T> CGLA_CONSTEXPR Matrix<T, 4, 4> composeTRS(const Vector<T, 3>& translation, const Quaternion<T>& rotation, const Vector<T, 3>& scale);
+template<typename T> CGLA_CONSTEXPR Matrix<T, 4, 4> composeTRS(const Vector<T, 3>& translation, const Quaternion<T>& rotation, const Vector<T, 3>& scale, const Vector<T, 3>& shear);
+template<typename T> bool decomposeTRS(const Matrix<T, 4, 4>& mat, Vector<T, 3>& translation, Quaternion<T>& rotation, Vector<T, 3>& scale);
+template<typename T> bool decomposeTRS(const Matrix<T, 4, 4>& mat, Vector<T, 3>& translation, Quaternion<T>& rotation, Vector<T, 3>& scale, Vector<T, 3>& shear);
 template<typename T> Matrix<T, 4, 4> lookAt(const Vector<T, 3>& eye, const Vector<T, 3>& target, const Vector<T, 3>& up);
-template<typename T> Matrix<T, 4, 4> orthographic(T left, T right, T bottom, T top, T near, T far);
-template<typename T> Matrix<T, 4, 4> frustum(T left, T right, T bottom, T top, T near, T far);
+template<typename T> CGLA_CONSTEXPR Matrix<T, 4, 4> orthographic(T left, T right, T bottom, T top, T near, T far);
+template<typename T> CGLA_CONSTEXPR Matrix<T, 4, 4> frustum(T left, T right, T bottom, T top, T near, T far);
 template<typename T> Matrix<T, 4, 4> perspective(T fovy, T aspect, T near, T far);
+template<typename T> CGLA_CONSTEXPR Matrix<T, 4, 4> viewport(T x, T y, T width, T height);
+
+// camera-relative transforms : evaluated in T, where large world coordinates cancel, then narrowed to U
+template<typename U, typename T> Matrix<U, 4, 4> modelView(const Matrix<T, 4, 4>& view, const Matrix<T, 4, 4>& model); // view and model are affine
+template<typename U, typename T> Matrix<U, 4, 4> relativeModel(const Matrix<T, 4, 4>& model, const Vector<T, 3>& origin); // translate(-origin) * model
+template<typename U, typename T> Matrix<U, 4, 4> relativeView(const Matrix<T, 4, 4>& view, const Vector<T, 3>& origin); // view * translate(origin)
+
+#ifdef CGLA_EXPRESSION_TEMPLATES
+// overloads of the builders above taking expressions, evaluated into their result type (rotate(angle, axis) is in quaternion.hpp)
+template<typename E, typename = detail::EnableIfExpression<E>> CGLA_CONSTEXPR auto translate(const E& v) -> decltype(translate(detail::evaluate(v)));
+template<typename L, typename R, typename = detail::EnableIfExpression<L, R>> CGLA_CONSTEXPR auto translate(const L& mat, const R& v) -> decltype(translate(detail::evaluate(mat), detail::evaluate(v)));
+template<typename Op, typename L, typename R, typename T> CGLA_CONSTEXPR Matrix<T, 4, 4> scale(const detail::Expression<Op, L, R, Vector<T, 3>>& v); // more specialized than scale(T v)
+template<typename L, typename R, typename = detail::EnableIfExpression<L, R>> CGLA_CONSTEXPR auto scale(const L& mat, const R& v) -> decltype(scale(detail::evaluate(mat), detail::evaluate(v)));
+template<typename L, typename R, typename = detail::EnableIfExpression<L, R>> auto rotateX(const L& mat, const R& angle) -> decltype(rotateX(detail::evaluate(mat), detail::evaluate(angle)));
+template<typename L, typename R, typename = detail::EnableIfExpression<L, R>> auto rotateY(const L& mat, const R& angle) -> decltype(rotateY(detail::evaluate(mat), detail::evaluate(angle)));
+template<typename L, typename R, typename = detail::EnableIfExpression<L, R>> auto rotateZ(const L& mat, const R& angle) -> decltype(rotateZ(detail::evaluate(mat), detail::evaluate(angle)));
+template<typename A, typename B, typename C, typename = detail::EnableIfExpression<A, B, C>> auto rotate(const A& mat, const B& angle, const C& axis) -> decltype(rotate(detail::evaluate(mat), detail::evaluate(angle), detail::evaluate(axis)));
+template<typename A, typename B, typename C, typename = detail::EnableIfExpression<A, B, C>> CGLA_CONSTEXPR auto composeTRS(const A& translation, const B& rotation, const C& scale) -> decltype(composeTRS(detail::evaluate(translation), detail::evaluate(rotation), detail::evaluate(scale)));
+template<typename A, typename B, typename C, typename D, typename = detail::EnableIfExpression<A, B, C, D>> CGLA_CONSTEXPR auto composeTRS(const A& translation, const B& rotation, const C& scale, const D& shear) -> decltype(composeTRS(detail::evaluate(translation), detail::evaluate(rotation), detail::evaluate(scale), detail::evaluate(shear)));
+template<typename A, typename B, typename C, typename = detail::EnableIfExpression<A, B, C>> auto lookAt(const A& eye, const B& target, const C& up) -> decltype(lookAt(detail::evaluate(eye), detail::evaluate(target), detail::evaluate(up)));
+template<typename E, typename... Out, typename = detail::EnableIfExpression<E>> auto decomposeTRS(const E& mat, Out&... out) -> decltype(decomposeTRS(detail::evaluate(mat), out...));
+template<typename U, typename L, typename R, typename = detail::EnableIfExpression<L, R>> auto modelView(const L& view, const R& model) -> decltype(modelView<U>(detail::evaluate(view), detail::evaluate(model)));
+template<typename U, typename L, typename R, typename = detail::EnableIfExpression<L, R>> auto relativeModel(const L& model, const R& origin) -> decltype(relativeModel<U>(detail::evaluate(model), detail::evaluate(origin)));
+template<typename U, typename L, typename R, typename = detail::EnableIfExpression<L, R>> auto relativeView(const L& view, const R& origin) -> decltype(relativeView<U>(detail::evaluate(view), detail::evaluate(origin)));
+#endif
+
+template<typename T> void transformPoints(const Matrix<T, 4, 4>& mat, const Vector<T, 3>* in, Vector<T, 3>* out, std::size_t count, std::size_t threadCount = 1);
+template<typename T> void transformPoints(const Matrix<T, 4, 4>& mat, Vector<T, 3>* points, std::size_t count, std::size_t threadCount = 1);
+template<typename T> void transformPointsProjective(const Matrix<T, 4, 4>& mat, const Vector<T, 3>* in, Vector<T, 3>* out, std::size_t count, std::size_t threadCount = 1);
+template<typename T> void transformPointsProjective(const Matrix<T, 4, 4>& mat, Vector<T, 3>* points, std::size_t count, std::size_t threadCount = 1);
+// screen x, y and depth in [0, 1] of points seen through mat into the rectangle {x, y, width, height}, with a bitmask of (count + 31) / 32 words
+// where point i is bit i % 32 of word i / 32, set when the point lies in front of the camera and inside the clip volume
+template<typename T> void projectPoints(const Matrix<T, 4, 4>& mat, const Vector<T, 4>& rect, const Vector<T, 3>* in, Vector<T, 3>* out, std::uint32_t* mask, std::size_t count, std::size_t threadCount = 1);
+template<typename T> void projectPoints(const Matrix<T, 4, 4>& mat, const Vector<T, 4>& rect, Vector<T, 3>* points, std::uint32_t* mask, std::size_t count, std::size_t threadCount = 1);
+template<typename T> void transformDirections(const Matrix<T, 4, 4>& mat, const Vector<T, 3>* in, Vector<T, 3>* out, std::size_t count, std::size_t threadCount = 1);
+template<typename T> void transformDirections(const Matrix<T, 4, 4>& mat, Vector<T, 3>* directions, std::size_t count, std::size_t threadCount = 1);
+
+template<typename U, typename T> void modelView(const Matrix<T, 4, 4>& view, const Matrix<T, 4, 4>* models, Matrix<U, 4, 4>* out, std::size_t count, std::size_t threadCount = 1);
+template<typename U, typename T> void relativeModel(const Matrix<T, 4, 4>* models, const Vector<T, 3>& origin, Matrix<U, 4, 4>* out, std::size_t count, std::size_t threadCount = 1);
+
+template<typename T> void composeTRS(const Vector<T, 3>* translations, const Quaternion<T>* rotations, const Vector<T, 3>* scales, Matrix<T, 4, 4>* mats, std::size_t count, std::size_t threadCount = 1);
+template<typename T> bool decomposeTRS(const Matrix<T, 4, 4>* mats, Vector<T, 3>* translations, Quaternion<T>* rotations, Vector<T, 3>* scales, std::size_t count, std::size_t threadCount = 1);
 
 }
 
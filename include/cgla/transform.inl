@@ -1,11 +1,41 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <cmath>
+#include <limits>
+#include "config.hpp"
 #include "vector.hpp"
 #include "matrix.hpp"
+#include "quaternion.hpp"
+#include "parallel.hpp"
+#ifdef CGLA_SSE
+#include <xmmintrin.h>
+#endif
 
 namespace cgla {
 
+namespace detail {
+    // minimum number of vectors given to a thread by the batch transforms
+    constexpr std::size_t transformGrainSize = 16384;
+    // minimum number of matrices given to a thread by the batch compositions and decompositions
+    constexpr std::size_t trsGrainSize = 2048;
+
+    template<typename T> void rotateColumns(Matrix<T, 4, 4>& mat, std::size_t a, std::size_t b, T c, T s);
+    template<typename T> bool decomposeLinear(const Matrix<T, 4, 4>& mat, Matrix<T, 3, 3>& rotation, Vector<T, 3>& scale, Vector<T, 3>& shear);
+    template<typename T> void transform3(const Matrix<T, 4, 4>& mat, const Vector<T, 3>* in, Vector<T, 3>* out, std::size_t count, T w);
+    template<typename T> void transform3Projective(const Matrix<T, 4, 4>& mat, const Vector<T, 3>* in, Vector<T, 3>* out, std::size_t count);
+    template<typename T> void project3(const Matrix<T, 4, 4>& mat, const T (&bounds)[4], const Vector<T, 3>* in, Vector<T, 3>* out, std::uint32_t* mask, std::size_t count);
+    template<typename T> void projectChunked(const Matrix<T, 4, 4>& mat, const Vector<T, 4>& rect, const Vector<T, 3>* in, Vector<T, 3>* out, std::uint32_t* mask, std::size_t count, std::size_t threadCount);
+    #ifdef CGLA_SSE
+    void transform3(const Matrix<float, 4, 4>& mat, const Vector<float, 3>* in, Vector<float, 3>* out, std::size_t count, float w);
+    void transform3Projective(const Matrix<float, 4, 4>& mat, const Vector<float, 3>* in, Vector<float, 3>* out, std::size_t count);
+    void project3(const Matrix<float, 4, 4>& mat, const float (&bounds)[4], const Vector<float, 3>* in, Vector<float, 3>* out, std::uint32_t* mask, std::size_t count);
+    #endif
+}
+
 template<typename T>
-Matrix<T, 4, 4> translate(const Vector<T, 3>& v)
+CGLA_CONSTEXPR Matrix<T, 4, 4> translate(const Vector<T, 3>& v)
 {
     Matrix<T, 4, 4> res{static_cast<T>(1)};
 
@@ -17,7 +47,19 @@ Matrix<T, 4, 4> translate(const Vector<T, 3>& v)
 }
 
 template<typename T>
-Matrix<T, 4, 4> scale(const Vector<T, 3>& v)
+CGLA_CONSTEXPR Matrix<T, 4, 4> translate(const Matrix<T, 4, 4>& mat, const Vector<T, 3>& v)
+{
+    // mat * translate(v) only changes the last column
+    Matrix<T, 4, 4> res{mat};
+
+    for (std::size_t i = 0; i < 4; ++i)
+        res[12 + i] += mat[i] * v[0] + mat[4 + i] * v[1] + mat[8 + i] * v[2];
+
+    return res;
+}
+
+template<typename T>
+CGLA_CONSTEXPR Matrix<T, 4, 4> scale(const Vector<T, 3>& v)
 {
     Matrix<T, 4, 4> res{};
 
@@ -30,7 +72,7 @@ Matrix<T, 4, 4> scale(const Vector<T, 3>& v)
 }
 
 template<typename T>
-Matrix<T, 4, 4> scale(T v)
+CGLA_CONSTEXPR Matrix<T, 4, 4> scale(T v)
 {
     Matrix<T, 4, 4> res{};
 
@@ -42,6 +84,29 @@ Matrix<T, 4, 4> scale(T v)
     return res;
 }
 
+template<typename T>
+CGLA_CONSTEXPR Matrix<T, 4, 4> scale(const Matrix<T, 4, 4>& mat, const Vector<T, 3>& v)
+{
+    Matrix<T, 4, 4> res{mat};
+
+    for (std::size_t j = 0; j < 3; ++j)
+        for (std::size_t i = 0; i < 4; ++i)
+            res[j * 4 + i] *= v[j];
+
+    return res;
+}
+
+template<typename T>
+CGLA_CONSTEXPR Matrix<T, 4, 4> scale(const Matrix<T, 4, 4>& mat, T v)
+{
+    Matrix<T, 4, 4> res{mat};
+
+    for (std::size_t i = 0; i < 12; ++i)
+        res[i] *= v;
+
+    return res;
+}
+
 template<typename T>
 Matrix<T, 4, 4> rotateX(T angle)
 {
@@ -58,6 +123,15 @@ Matrix<T, 4, 4> rotateX(T angle)
     return res;
 }
 
+template<typename T>
+inline Matrix<T, 4, 4> rotateX(const Matrix<T, 4, 4>& mat, T angle)
+{
+    Matrix<T, 4, 4> res{mat};
+    detail::rotateColumns(res, 1, 2, std::cos(angle), std::sin(angle));
+
+    return res;
+}
+
 template<typename T>
 Matrix<T, 4, 4> rotateY(T angle)
 {
@@ -74,6 +148,15 @@ Matrix<T, 4, 4> rotateY(T angle)
     return res;
 }
 
+template<typename T>
+inline Matrix<T, 4, 4> rotateY(const Matrix<T, 4, 4>& mat, T angle)
+{
+    Matrix<T, 4, 4> res{mat};
+    detail::rotateColumns(res, 2, 0, std::cos(angle), std::sin(angle));
+
+    return res;
+}
+
 template<typename T>
 Matrix<T, 4, 4> rotateZ(T angle)
 {
@@ -90,6 +173,15 @@ Matrix<T, 4, 4> rotateZ(T angle)
     return res;
 }
 
+template<typename T>
+inline Matrix<T, 4, 4> rotateZ(const Matrix<T, 4, 4>& mat, T angle)
+{
+    Matrix<T, 4, 4> res{mat};
+    detail::rotateColumns(res, 0, 1, std::cos(angle), std::sin(angle));
+
+    return res;
+}
+
 template<typename T>
 Matrix<T, 4, 4> rotate(T angle, const Vector<T, 3>& axis)
 {
@@ -117,12 +209,92 @@ Matrix<T, 4, 4> rotate(T angle, const Vector<T, 3>& axis)
     return res;
 }
 
+template<typename T>
+Matrix<T, 4, 4> rotate(const Matrix<T, 4, 4>& mat, T angle, const Vector<T, 3>& axis)
+{
+    // mat * rotate(angle, axis) only changes the first three columns
+    Matrix<T, 4, 4> res{mat};
+    Matrix<T, 4, 4> r = rotate(angle, axis);
+
+    for (std::size_t j = 0; j < 3; ++j)
+        for (std::size_t i = 0; i < 4; ++i)
+            res[j * 4 + i] = mat[i] * r[j * 4] + mat[4 + i] * r[j * 4 + 1] + mat[8 + i] * r[j * 4 + 2];
+
+    return res;
+}
+
+template<typename T>
+CGLA_CONSTEXPR Matrix<T, 4, 4> composeTRS(const Vector<T, 3>& translation, const Quaternion<T>& rotation, const Vector<T, 3>& scale)
+{
+    // translate(translation) * toMatrix(rotation) * scale(scale), written directly
+    Matrix<T, 4, 4> res{};
+    Matrix<T, 3, 3> r = toMatrix3(rotation);
+
+    for (std::size_t j = 0; j < 3; ++j)
+        for (std::size_t i = 0; i < 3; ++i)
+            res[j * 4 + i] = r[j * 3 + i] * scale[j];
+
+    res[12] = translation[0];
+    res[13] = translation[1];
+    res[14] = translation[2];
+    res[15] = static_cast<T>(1);
+
+    return res;
+}
+
+template<typename T>
+CGLA_CONSTEXPR Matrix<T, 4, 4> composeTRS(const Vector<T, 3>& translation, const Quaternion<T>& rotation, const Vector<T, 3>& scale, const Vector<T, 3>& shear)
+{
+    // translate(translation) * toMatrix(rotation) * scale(scale) * shear, shear being unit upper triangular with
+    // (xy, xz, yz) above the diagonal
+    Matrix<T, 4, 4> res{};
+    Matrix<T, 3, 3> r = toMatrix3(rotation);
+
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        T x = r[i] * scale[0];
+        T y = r[3 + i] * scale[1];
+        T z = r[6 + i] * scale[2];
+
+        res[i] = x;
+        res[4 + i] = x * shear[0] + y;
+        res[8 + i] = x * shear[1] + y * shear[2] + z;
+    }
+
+    res[12] = translation[0];
+    res[13] = translation[1];
+    res[14] = translation[2];
+    res[15] = static_cast<T>(1);
+
+    return res;
+}
+
+template<typename T>
+inline bool decomposeTRS(const Matrix<T, 4, 4>& mat, Vector<T, 3>& translation, Quaternion<T>& rotation, Vector<T, 3>& scale)
+{
+    Vector<T, 3> shear{uninitialized};
+
+    return decomposeTRS(mat, translation, rotation, scale, shear);
+}
+
+template<typename T>
+bool decomposeTRS(const Matrix<T, 4, 4>& mat, Vector<T, 3>& translation, Quaternion<T>& rotation, Vector<T, 3>& scale, Vector<T, 3>& shear)
+{
+    Matrix<T, 3, 3> r{uninitialized};
+    bool regular = detail::decomposeLinear(mat, r, scale, shear);
+
+    translation = Vector<T, 3>{mat[12], mat[13], mat[14]};
+    rotation = fromMatrix(r);
+
+    return regular;
+}
+
 template<typename T>
 Matrix<T, 4, 4> lookAt(const Vector<T, 3>& eye, const Vector<T, 3>& target, const Vector<T, 3>& up)
 {
     Matrix<T, 4, 4> res{};
 
-    Vector<T, 3> f = normalize(eye - target);
+    Vector<T, 3> f = normalize(Vector<T, 3>(eye - target));
     Vector<T, 3> s = normalize(cross(up, f));
     Vector<T, 3> u = cross(f, s);
 
@@ -147,7 +319,7 @@ Matrix<T, 4, 4> lookAt(const Vector<T, 3>& eye, const Vector<T, 3>& target, cons
 }
 
 template<typename T>
-Matrix<T, 4, 4> orthographic(T left, T right, T bottom, T top, T near, T far)
+CGLA_CONSTEXPR Matrix<T, 4, 4> orthographic(T left, T right, T bottom, T top, T near, T far)
 {
     Matrix<T, 4, 4> res{};
 
@@ -163,7 +335,7 @@ Matrix<T, 4, 4> orthographic(T left, T right, T bottom, T top, T near, T far)
 }
 
 template<typename T>
-Matrix<T, 4, 4> frustum(T left, T right, T bottom, T top, T near, T far)
+CGLA_CONSTEXPR Matrix<T, 4, 4> frustum(T left, T right, T bottom, T top, T near, T far)
 {
     Matrix<T, 4, 4> res{};
 
@@ -194,4 +366,612 @@ Matrix<T, 4, 4> perspective(T fovy, T aspect, T near, T far)
     return res;
 }
 
+template<typename T>
+CGLA_CONSTEXPR Matrix<T, 4, 4> viewport(T x, T y, T width, T height)
+{
+    Matrix<T, 4, 4> res{};
+
+    res[0] = width / static_cast<T>(2);
+    res[5] = height / static_cast<T>(2);
+    res[10] = static_cast<T>(0.5);
+    res[12] = x + width / static_cast<T>(2);
+    res[13] = y + height / static_cast<T>(2);
+    res[14] = static_cast<T>(0.5);
+    res[15] = static_cast<T>(1);
+
+    return res;
+}
+
+template<typename U, typename T>
+Matrix<U, 4, 4> modelView(const Matrix<T, 4, 4>& view, const Matrix<T, 4, 4>& model)
+{
+    // 36 multiplications in T, the last rows are (0, 0, 0, 1)
+    Matrix<T, 4, 4> res{uninitialized};
+
+    for (std::size_t j = 0; j < 4; ++j)
+    {
+        for (std::size_t i = 0; i < 3; ++i)
+            res(i, j) = view(i, 0) * model(0, j) + view(i, 1) * model(1, j) + view(i, 2) * model(2, j);
+
+        res(3, j) = static_cast<T>(0);
+    }
+
+    for (std::size_t i = 0; i < 3; ++i)
+        res(i, 3) += view(i, 3);
+
+    res(3, 3) = static_cast<T>(1);
+
+    // narrowed as a whole so that the conversions vectorize
+    return Matrix<U, 4, 4>{res};
+}
+
+template<typename U, typename T>
+Matrix<U, 4, 4> relativeModel(const Matrix<T, 4, 4>& model, const Vector<T, 3>& origin)
+{
+    Matrix<T, 4, 4> res{model};
+
+    for (std::size_t j = 0; j < 4; ++j)
+        for (std::size_t i = 0; i < 3; ++i)
+            res(i, j) -= origin[i] * model(3, j);
+
+    return Matrix<U, 4, 4>{res};
+}
+
+template<typename U, typename T>
+Matrix<U, 4, 4> relativeView(const Matrix<T, 4, 4>& view, const Vector<T, 3>& origin)
+{
+    Matrix<T, 4, 4> res{view};
+
+    for (std::size_t i = 0; i < 4; ++i)
+        for (std::size_t k = 0; k < 3; ++k)
+            res(i, 3) += view(i, k) * origin[k];
+
+    return Matrix<U, 4, 4>{res};
+}
+
+#ifdef CGLA_EXPRESSION_TEMPLATES
+template<typename E, typename>
+CGLA_CONSTEXPR auto translate(const E& v) -> decltype(translate(detail::evaluate(v)))
+{
+    return translate(detail::evaluate(v));
+}
+
+template<typename L, typename R, typename>
+CGLA_CONSTEXPR auto translate(const L& mat, const R& v) -> decltype(translate(detail::evaluate(mat), detail::evaluate(v)))
+{
+    return translate(detail::evaluate(mat), detail::evaluate(v));
+}
+
+template<typename Op, typename L, typename R, typename T>
+CGLA_CONSTEXPR Matrix<T, 4, 4> scale(const detail::Expression<Op, L, R, Vector<T, 3>>& v)
+{
+    return scale(Vector<T, 3>(v));
+}
+
+template<typename L, typename R, typename>
+CGLA_CONSTEXPR auto scale(const L& mat, const R& v) -> decltype(scale(detail::evaluate(mat), detail::evaluate(v)))
+{
+    return scale(detail::evaluate(mat), detail::evaluate(v));
+}
+
+template<typename L, typename R, typename>
+inline auto rotateX(const L& mat, const R& angle) -> decltype(rotateX(detail::evaluate(mat), detail::evaluate(angle)))
+{
+    return rotateX(detail::evaluate(mat), detail::evaluate(angle));
+}
+
+template<typename L, typename R, typename>
+inline auto rotateY(const L& mat, const R& angle) -> decltype(rotateY(detail::evaluate(mat), detail::evaluate(angle)))
+{
+    return rotateY(detail::evaluate(mat), detail::evaluate(angle));
+}
+
+template<typename L, typename R, typename>
+inline auto rotateZ(const L& mat, const R& angle) -> decltype(rotateZ(detail::evaluate(mat), detail::evaluate(angle)))
+{
+    return rotateZ(detail::evaluate(mat), detail::evaluate(angle));
+}
+
+template<typename A, typename B, typename C, typename>
+inline auto rotate(const A& mat, const B& angle, const C& axis) -> decltype(rotate(detail::evaluate(mat), detail::evaluate(angle), detail::evaluate(axis)))
+{
+    return rotate(detail::evaluate(mat), detail::evaluate(angle), detail::evaluate(axis));
+}
+
+template<typename A, typename B, typename C, typename>
+CGLA_CONSTEXPR auto composeTRS(const A& translation, const B& rotation, const C& scale) -> decltype(composeTRS(detail::evaluate(translation), detail::evaluate(rotation), detail::evaluate(scale)))
+{
+    return composeTRS(detail::evaluate(translation), detail::evaluate(rotation), detail::evaluate(scale));
+}
+
+template<typename A, typename B, typename C, typename D, typename>
+CGLA_CONSTEXPR auto composeTRS(const A& translation, const B& rotation, const C& scale, const D& shear) -> decltype(composeTRS(detail::evaluate(translation), detail::evaluate(rotation), detail::evaluate(scale), detail::evaluate(shear)))
+{
+    return composeTRS(detail::evaluate(translation), detail::evaluate(rotation), detail::evaluate(scale), detail::evaluate(shear));
+}
+
+template<typename A, typename B, typename C, typename>
+inline auto lookAt(const A& eye, const B& target, const C& up) -> decltype(lookAt(detail::evaluate(eye), detail::evaluate(target), detail::evaluate(up)))
+{
+    return lookAt(detail::evaluate(eye), detail::evaluate(target), detail::evaluate(up));
+}
+
+template<typename E, typename... Out, typename>
+inline auto decomposeTRS(const E& mat, Out&... out) -> decltype(decomposeTRS(detail::evaluate(mat), out...))
+{
+    return decomposeTRS(detail::evaluate(mat), out...);
+}
+
+template<typename U, typename L, typename R, typename>
+inline auto modelView(const L& view, const R& model) -> decltype(modelView<U>(detail::evaluate(view), detail::evaluate(model)))
+{
+    return modelView<U>(detail::evaluate(view), detail::evaluate(model));
+}
+
+template<typename U, typename L, typename R, typename>
+inline auto relativeModel(const L& model, const R& origin) -> decltype(relativeModel<U>(detail::evaluate(model), detail::evaluate(origin)))
+{
+    return relativeModel<U>(detail::evaluate(model), detail::evaluate(origin));
+}
+
+template<typename U, typename L, typename R, typename>
+inline auto relativeView(const L& view, const R& origin) -> decltype(relativeView<U>(detail::evaluate(view), detail::evaluate(origin)))
+{
+    return relativeView<U>(detail::evaluate(view), detail::evaluate(origin));
+}
+#endif
+
+template<typename T>
+inline void transformPoints(const Matrix<T, 4, 4>& mat, const Vector<T, 3>* in, Vector<T, 3>* out, std::size_t count, std::size_t threadCount)
+{
+    detail::runChunked(count, threadCount, detail::transformGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        detail::transform3(mat, in + begin, out + begin, end - begin, static_cast<T>(1));
+    });
+}
+
+template<typename T>
+inline void transformPoints(const Matrix<T, 4, 4>& mat, Vector<T, 3>* points, std::size_t count, std::size_t threadCount)
+{
+    detail::runChunked(count, threadCount, detail::transformGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        detail::transform3(mat, points + begin, points + begin, end - begin, static_cast<T>(1));
+    });
+}
+
+template<typename T>
+inline void transformPointsProjective(const Matrix<T, 4, 4>& mat, const Vector<T, 3>* in, Vector<T, 3>* out, std::size_t count, std::size_t threadCount)
+{
+    detail::runChunked(count, threadCount, detail::transformGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        detail::transform3Projective(mat, in + begin, out + begin, end - begin);
+    });
+}
+
+template<typename T>
+inline void transformPointsProjective(const Matrix<T, 4, 4>& mat, Vector<T, 3>* points, std::size_t count, std::size_t threadCount)
+{
+    detail::runChunked(count, threadCount, detail::transformGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        detail::transform3Projective(mat, points + begin, points + begin, end - begin);
+    });
+}
+
+template<typename T>
+inline void projectPoints(const Matrix<T, 4, 4>& mat, const Vector<T, 4>& rect, const Vector<T, 3>* in, Vector<T, 3>* out, std::uint32_t* mask, std::size_t count, std::size_t threadCount)
+{
+    detail::projectChunked(mat, rect, in, out, mask, count, threadCount);
+}
+
+template<typename T>
+inline void projectPoints(const Matrix<T, 4, 4>& mat, const Vector<T, 4>& rect, Vector<T, 3>* points, std::uint32_t* mask, std::size_t count, std::size_t threadCount)
+{
+    detail::projectChunked(mat, rect, points, points, mask, count, threadCount);
+}
+
+template<typename T>
+inline void transformDirections(const Matrix<T, 4, 4>& mat, const Vector<T, 3>* in, Vector<T, 3>* out, std::size_t count, std::size_t threadCount)
+{
+    detail::runChunked(count, threadCount, detail::transformGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        detail::transform3(mat, in + begin, out + begin, end - begin, static_cast<T>(0));
+    });
+}
+
+template<typename T>
+inline void transformDirections(const Matrix<T, 4, 4>& mat, Vector<T, 3>* directions, std::size_t count, std::size_t threadCount)
+{
+    detail::runChunked(count, threadCount, detail::transformGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        detail::transform3(mat, directions + begin, directions + begin, end - begin, static_cast<T>(0));
+    });
+}
+
+template<typename U, typename T>
+void modelView(const Matrix<T, 4, 4>& view, const Matrix<T, 4, 4>* models, Matrix<U, 4, 4>* out, std::size_t count, std::size_t threadCount)
+{
+    detail::runChunked(count, threadCount, detail::trsGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            out[i] = modelView<U>(view, models[i]);
+    });
+}
+
+template<typename U, typename T>
+void relativeModel(const Matrix<T, 4, 4>* models, const Vector<T, 3>& origin, Matrix<U, 4, 4>* out, std::size_t count, std::size_t threadCount)
+{
+    detail::runChunked(count, threadCount, detail::trsGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            out[i] = relativeModel<U>(models[i], origin);
+    });
+}
+
+template<typename T>
+void composeTRS(const Vector<T, 3>* translations, const Quaternion<T>* rotations, const Vector<T, 3>* scales, Matrix<T, 4, 4>* mats, std::size_t count, std::size_t threadCount)
+{
+    detail::runChunked(count, threadCount, detail::trsGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            mats[i] = composeTRS(translations[i], rotations[i], scales[i]);
+    });
+}
+
+template<typename T>
+bool decomposeTRS(const Matrix<T, 4, 4>* mats, Vector<T, 3>* translations, Quaternion<T>* rotations, Vector<T, 3>* scales, std::size_t count, std::size_t threadCount)
+{
+    std::atomic<bool> regular{true};
+
+    detail::runChunked(count, threadCount, detail::trsGrainSize, [&](std::size_t begin, std::size_t end)
+    {
+        bool chunk = true;
+
+        for (std::size_t i = begin; i < end; ++i)
+            chunk = decomposeTRS(mats[i], translations[i], rotations[i], scales[i]) && chunk;
+
+        if (!chunk)
+            regular.store(false, std::memory_order_relaxed);
+    });
+
+    return regular.load(std::memory_order_relaxed);
+}
+
+namespace detail {
+    template<typename T>
+    inline void rotateColumns(Matrix<T, 4, 4>& mat, std::size_t a, std::size_t b, T c, T s)
+    {
+        // plane rotation of columns a and b, the other columns are unaffected
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            T u = mat[a * 4 + i];
+            T v = mat[b * 4 + i];
+            mat[a * 4 + i] = c * u + s * v;
+            mat[b * 4 + i] = c * v - s * u;
+        }
+    }
+
+    // unit vector orthogonal to the unit vector v, the axis of its smallest component made orthogonal to it
+    template<typename T>
+    inline Vector<T, 3> orthogonal(const Vector<T, 3>& v)
+    {
+        std::size_t k = 0;
+        for (std::size_t i = 1; i < 3; ++i)
+            k = std::abs(v[i]) < std::abs(v[k]) ? i : k;
+
+        Vector<T, 3> res = v * -v[k];
+        res[k] += static_cast<T>(1);
+
+        return res / std::sqrt(lengthSquared(res));
+    }
+
+    // unit vector of v, or false when it vanishes below the tolerance (length returns a float, norms are taken in T)
+    template<typename T>
+    inline bool unit(const Vector<T, 3>& v, T tolerance, Vector<T, 3>& res)
+    {
+        T l = std::sqrt(lengthSquared(v));
+        if (!(l > tolerance) || l == static_cast<T>(0))
+            return false;
+
+        res = v / l;
+        return true;
+    }
+
+    template<typename T>
+    bool decomposeLinear(const Matrix<T, 4, 4>& mat, Matrix<T, 3, 3>& rotation, Vector<T, 3>& scale, Vector<T, 3>& shear)
+    {
+        // Gram-Schmidt on the columns of the upper 3x3 block, L = R * diag(scale) * shear. The third axis is the cross
+        // product of the first two so that R is a rotation and a reflection shows as a negative scale[2]. An axis
+        // that vanishes against the largest column is chosen orthogonal to the others so that L is still recomposed.
+        Vector<T, 3> c0{mat[0], mat[1], mat[2]};
+        Vector<T, 3> c1{mat[4], mat[5], mat[6]};
+        Vector<T, 3> c2{mat[8], mat[9], mat[10]};
+
+        T largest = std::max(lengthSquared(c0), std::max(lengthSquared(c1), lengthSquared(c2)));
+        T tolerance = static_cast<T>(8) * std::numeric_limits<T>::epsilon() * std::sqrt(largest);
+
+        Vector<T, 3> r0{uninitialized};
+        Vector<T, 3> r1{uninitialized};
+        bool regular = unit(c0, tolerance, r0);
+
+        if (!regular && !unit(cross(c1, c2), tolerance * std::sqrt(largest), r0))
+        {
+            // c1 and c2 are parallel or vanish too
+            Vector<T, 3> c{uninitialized};
+            if (unit(c1, tolerance, c) || unit(c2, tolerance, c))
+                r0 = orthogonal(c);
+            else
+                r0 = Vector<T, 3>{static_cast<T>(1), static_cast<T>(0), static_cast<T>(0)};
+        }
+
+        T xy = dot(r0, c1);
+        if (!unit(Vector<T, 3>(c1 - r0 * xy), tolerance, r1))
+        {
+            regular = false;
+            if (!unit(cross(c2, r0), tolerance, r1))
+                r1 = orthogonal(r0);
+        }
+
+        Vector<T, 3> r2 = cross(r0, r1);
+        T sx = dot(r0, c0);
+        T sy = dot(r1, c1);
+        T sz = dot(r2, c2);
+        T xz = dot(r0, c2);
+        T yz = dot(r1, c2);
+        regular = regular && std::abs(sz) > tolerance;
+
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            rotation[i] = r0[i];
+            rotation[3 + i] = r1[i];
+            rotation[6 + i] = r2[i];
+        }
+
+        // the shear is relative to the scaled axes, zero along a vanished one
+        T inverseX = sx != static_cast<T>(0) ? static_cast<T>(1) / sx : static_cast<T>(0);
+        T inverseY = sy != static_cast<T>(0) ? static_cast<T>(1) / sy : static_cast<T>(0);
+        scale = Vector<T, 3>{sx, sy, sz};
+        shear = Vector<T, 3>{xy * inverseX, xz * inverseX, yz * inverseY};
+
+        return regular;
+    }
+
+    template<typename T>
+    inline void transform3(const Matrix<T, 4, 4>& mat, const Vector<T, 3>* in, Vector<T, 3>* out, std::size_t count, T w)
+    {
+        const T m0 = mat[0], m1 = mat[1], m2 = mat[2];
+        const T m4 = mat[4], m5 = mat[5], m6 = mat[6];
+        const T m8 = mat[8], m9 = mat[9], m10 = mat[10];
+        const T m12 = mat[12] * w, m13 = mat[13] * w, m14 = mat[14] * w;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            T x = in[i][0], y = in[i][1], z = in[i][2];
+
+            out[i][0] = m0 * x + m4 * y + m8 * z + m12;
+            out[i][1] = m1 * x + m5 * y + m9 * z + m13;
+            out[i][2] = m2 * x + m6 * y + m10 * z + m14;
+        }
+    }
+
+    template<typename T>
+    inline void transform3Projective(const Matrix<T, 4, 4>& mat, const Vector<T, 3>* in, Vector<T, 3>* out, std::size_t count)
+    {
+        const T m0 = mat[0], m1 = mat[1], m2 = mat[2], m3 = mat[3];
+        const T m4 = mat[4], m5 = mat[5], m6 = mat[6], m7 = mat[7];
+        const T m8 = mat[8], m9 = mat[9], m10 = mat[10], m11 = mat[11];
+        const T m12 = mat[12], m13 = mat[13], m14 = mat[14], m15 = mat[15];
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            T x = in[i][0], y = in[i][1], z = in[i][2];
+            T invW = static_cast<T>(1) / (m3 * x + m7 * y + m11 * z + m15);
+
+            out[i][0] = (m0 * x + m4 * y + m8 * z + m12) * invW;
+            out[i][1] = (m1 * x + m5 * y + m9 * z + m13) * invW;
+            out[i][2] = (m2 * x + m6 * y + m10 * z + m14) * invW;
+        }
+    }
+
+    template<typename T>
+    inline void project3(const Matrix<T, 4, 4>& mat, const T (&bounds)[4], const Vector<T, 3>* in, Vector<T, 3>* out, std::uint32_t* mask, std::size_t count)
+    {
+        const T m0 = mat[0], m1 = mat[1], m2 = mat[2], m3 = mat[3];
+        const T m4 = mat[4], m5 = mat[5], m6 = mat[6], m7 = mat[7];
+        const T m8 = mat[8], m9 = mat[9], m10 = mat[10], m11 = mat[11];
+        const T m12 = mat[12], m13 = mat[13], m14 = mat[14], m15 = mat[15];
+        const T xmin = bounds[0], xmax = bounds[1], ymin = bounds[2], ymax = bounds[3];
+        const T zero = static_cast<T>(0), one = static_cast<T>(1);
+
+        for (std::size_t base = 0; base < count; base += 32)
+        {
+            std::size_t n = std::min(count - base, static_cast<std::size_t>(32));
+            T sx[32], sy[32], sz[32], sw[32];
+            unsigned char inside[32];
+
+            // the clip test runs on contiguous scratch so that it vectorizes despite the packed inputs
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                T x = in[base + j][0], y = in[base + j][1], z = in[base + j][2];
+                T w = m3 * x + m7 * y + m11 * z + m15;
+                T invW = one / w;
+
+                sx[j] = (m0 * x + m4 * y + m8 * z + m12) * invW;
+                sy[j] = (m1 * x + m5 * y + m9 * z + m13) * invW;
+                sz[j] = (m2 * x + m6 * y + m10 * z + m14) * invW;
+                sw[j] = w;
+            }
+
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                unsigned char front = sw[j] > zero;
+                unsigned char inX = (sx[j] >= xmin) & (sx[j] <= xmax);
+                unsigned char inY = (sy[j] >= ymin) & (sy[j] <= ymax);
+                unsigned char inZ = (sz[j] >= zero) & (sz[j] <= one);
+                inside[j] = front & inX & inY & inZ;
+            }
+
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                out[base + j][0] = sx[j];
+                out[base + j][1] = sy[j];
+                out[base + j][2] = sz[j];
+            }
+
+            std::uint32_t bits = 0;
+
+            for (std::size_t j = 0; j < n; ++j)
+                bits |= static_cast<std::uint32_t>(inside[j]) << j;
+
+            mask[base / 32] = bits;
+        }
+    }
+
+    template<typename T>
+    inline void projectChunked(const Matrix<T, 4, 4>& mat, const Vector<T, 4>& rect, const Vector<T, 3>* in, Vector<T, 3>* out, std::uint32_t* mask, std::size_t count, std::size_t threadCount)
+    {
+        // the viewport is folded into the matrix, the clip volume becomes the rectangle and [0, 1] depths after the divide
+        Matrix<T, 4, 4> screen = viewport(rect[0], rect[1], rect[2], rect[3]) * mat;
+        const T bounds[4] = {
+            std::min(rect[0], rect[0] + rect[2]), std::max(rect[0], rect[0] + rect[2]),
+            std::min(rect[1], rect[1] + rect[3]), std::max(rect[1], rect[1] + rect[3])
+        };
+
+        // whole mask words per thread
+        runChunked((count + 31) / 32, threadCount, transformGrainSize / 32, [&](std::size_t begin, std::size_t end)
+        {
+            std::size_t first = begin * 32;
+            std::size_t last = std::min(end * 32, count);
+            project3(screen, bounds, in + first, out + first, mask + begin, last - first);
+        });
+    }
+
+    #ifdef CGLA_SSE
+    // returns {p[I], p[I], q[J], q[J]}
+    template<int I, int J>
+    inline __m128 pair(__m128 p, __m128 q)
+    {
+        return _mm_shuffle_ps(p, q, _MM_SHUFFLE(J, J, I, I));
+    }
+
+    // loads 4 packed Vector<float, 3> and transposes them to x, y, z registers
+    inline void load3x4(const float* p, __m128& x, __m128& y, __m128& z)
+    {
+        __m128 a = _mm_loadu_ps(p);
+        __m128 b = _mm_loadu_ps(p + 4);
+        __m128 c = _mm_loadu_ps(p + 8);
+
+        __m128 xlo = pair<0, 3>(a, a), xhi = pair<2, 1>(b, c);
+        __m128 ylo = pair<1, 0>(a, b), yhi = pair<3, 2>(b, c);
+        __m128 zlo = pair<2, 1>(a, b), zhi = pair<0, 3>(c, c);
+
+        x = _mm_shuffle_ps(xlo, xhi, _MM_SHUFFLE(2, 0, 2, 0));
+        y = _mm_shuffle_ps(ylo, yhi, _MM_SHUFFLE(2, 0, 2, 0));
+        z = _mm_shuffle_ps(zlo, zhi, _MM_SHUFFLE(2, 0, 2, 0));
+    }
+
+    // transposes x, y, z registers back and stores them as 4 packed Vector<float, 3>
+    inline void store3x4(float* p, __m128 x, __m128 y, __m128 z)
+    {
+        __m128 alo = pair<0, 0>(x, y), ahi = pair<0, 1>(z, x);
+        __m128 blo = pair<1, 1>(y, z), bhi = pair<2, 2>(x, y);
+        __m128 clo = pair<2, 3>(z, x), chi = pair<3, 3>(y, z);
+
+        _mm_storeu_ps(p, _mm_shuffle_ps(alo, ahi, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(p + 4, _mm_shuffle_ps(blo, bhi, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(p + 8, _mm_shuffle_ps(clo, chi, _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+
+    inline void transform3(const Matrix<float, 4, 4>& mat, const Vector<float, 3>* in, Vector<float, 3>* out, std::size_t count, float w)
+    {
+        const __m128 m0 = _mm_set1_ps(mat[0]), m1 = _mm_set1_ps(mat[1]), m2 = _mm_set1_ps(mat[2]);
+        const __m128 m4 = _mm_set1_ps(mat[4]), m5 = _mm_set1_ps(mat[5]), m6 = _mm_set1_ps(mat[6]);
+        const __m128 m8 = _mm_set1_ps(mat[8]), m9 = _mm_set1_ps(mat[9]), m10 = _mm_set1_ps(mat[10]);
+        const __m128 m12 = _mm_set1_ps(mat[12] * w), m13 = _mm_set1_ps(mat[13] * w), m14 = _mm_set1_ps(mat[14] * w);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 x, y, z;
+            load3x4(in[i].data(), x, y, z);
+
+            __m128 rx = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m4, y)), _mm_mul_ps(m8, z)), m12);
+            __m128 ry = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, x), _mm_mul_ps(m5, y)), _mm_mul_ps(m9, z)), m13);
+            __m128 rz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m2, x), _mm_mul_ps(m6, y)), _mm_mul_ps(m10, z)), m14);
+
+            store3x4(out[i].data(), rx, ry, rz);
+        }
+
+        transform3<float>(mat, in + i, out + i, count - i, w);
+    }
+
+    inline void transform3Projective(const Matrix<float, 4, 4>& mat, const Vector<float, 3>* in, Vector<float, 3>* out, std::size_t count)
+    {
+        const __m128 m0 = _mm_set1_ps(mat[0]), m1 = _mm_set1_ps(mat[1]), m2 = _mm_set1_ps(mat[2]), m3 = _mm_set1_ps(mat[3]);
+        const __m128 m4 = _mm_set1_ps(mat[4]), m5 = _mm_set1_ps(mat[5]), m6 = _mm_set1_ps(mat[6]), m7 = _mm_set1_ps(mat[7]);
+        const __m128 m8 = _mm_set1_ps(mat[8]), m9 = _mm_set1_ps(mat[9]), m10 = _mm_set1_ps(mat[10]), m11 = _mm_set1_ps(mat[11]);
+        const __m128 m12 = _mm_set1_ps(mat[12]), m13 = _mm_set1_ps(mat[13]), m14 = _mm_set1_ps(mat[14]), m15 = _mm_set1_ps(mat[15]);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 x, y, z;
+            load3x4(in[i].data(), x, y, z);
+
+            __m128 rw = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m3, x), _mm_mul_ps(m7, y)), _mm_mul_ps(m11, z)), m15);
+            __m128 invW = _mm_div_ps(_mm_set1_ps(1.f), rw);
+            __m128 rx = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m4, y)), _mm_mul_ps(m8, z)), m12);
+            __m128 ry = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, x), _mm_mul_ps(m5, y)), _mm_mul_ps(m9, z)), m13);
+            __m128 rz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m2, x), _mm_mul_ps(m6, y)), _mm_mul_ps(m10, z)), m14);
+
+            store3x4(out[i].data(), _mm_mul_ps(rx, invW), _mm_mul_ps(ry, invW), _mm_mul_ps(rz, invW));
+        }
+
+        transform3Projective<float>(mat, in + i, out + i, count - i);
+    }
+
+    // eight registers of four points per mask word
+    inline void project3(const Matrix<float, 4, 4>& mat, const float (&bounds)[4], const Vector<float, 3>* in, Vector<float, 3>* out, std::uint32_t* mask, std::size_t count)
+    {
+        const __m128 m0 = _mm_set1_ps(mat[0]), m1 = _mm_set1_ps(mat[1]), m2 = _mm_set1_ps(mat[2]), m3 = _mm_set1_ps(mat[3]);
+        const __m128 m4 = _mm_set1_ps(mat[4]), m5 = _mm_set1_ps(mat[5]), m6 = _mm_set1_ps(mat[6]), m7 = _mm_set1_ps(mat[7]);
+        const __m128 m8 = _mm_set1_ps(mat[8]), m9 = _mm_set1_ps(mat[9]), m10 = _mm_set1_ps(mat[10]), m11 = _mm_set1_ps(mat[11]);
+        const __m128 m12 = _mm_set1_ps(mat[12]), m13 = _mm_set1_ps(mat[13]), m14 = _mm_set1_ps(mat[14]), m15 = _mm_set1_ps(mat[15]);
+        const __m128 xmin = _mm_set1_ps(bounds[0]), xmax = _mm_set1_ps(bounds[1]);
+        const __m128 ymin = _mm_set1_ps(bounds[2]), ymax = _mm_set1_ps(bounds[3]);
+        const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.f);
+        std::size_t full = count & ~static_cast<std::size_t>(31);
+
+        for (std::size_t base = 0; base < full; base += 32)
+        {
+            std::uint32_t bits = 0;
+
+            for (std::size_t j = 0; j < 32; j += 4)
+            {
+                std::size_t i = base + j;
+                __m128 x, y, z;
+                load3x4(in[i].data(), x, y, z);
+
+                __m128 rw = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m3, x), _mm_mul_ps(m7, y)), _mm_mul_ps(m11, z)), m15);
+                __m128 invW = _mm_div_ps(one, rw);
+                __m128 sx = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m4, y)), _mm_mul_ps(m8, z)), m12), invW);
+                __m128 sy = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, x), _mm_mul_ps(m5, y)), _mm_mul_ps(m9, z)), m13), invW);
+                __m128 sz = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m2, x), _mm_mul_ps(m6, y)), _mm_mul_ps(m10, z)), m14), invW);
+
+                store3x4(out[i].data(), sx, sy, sz);
+
+                __m128 inside = _mm_and_ps(_mm_cmpgt_ps(rw, zero), _mm_and_ps(_mm_cmpge_ps(sz, zero), _mm_cmple_ps(sz, one)));
+                inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(sx, xmin), _mm_cmple_ps(sx, xmax)));
+                inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(sy, ymin), _mm_cmple_ps(sy, ymax)));
+                bits |= static_cast<std::uint32_t>(_mm_movemask_ps(inside)) << j;
+            }
+
+            mask[base / 32] = bits;
+        }
+
+        if (full < count)
+            project3<float>(mat, bounds, in + full, out + full, mask + full / 32, count - full);
+    }
+    #endif
+}
+
 }
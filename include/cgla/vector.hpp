@@ -8,6 +8,20 @@
 
 namespace cgla {
 
+#ifdef CGLA_EXPRESSION_TEMPLATES
+namespace detail {
+    template<typename Op, typename L, typename R, typename Result> class Expression;
+    template<typename... E> struct AnyExpression;
+    template<typename... E> using EnableIfExpression = typename std::enable_if<AnyExpression<E...>::value>::type;
+    template<typename E> CGLA_CONSTEXPR const E& evaluate(const E& e);
+    template<typename Op, typename L, typename R, typename Result> CGLA_CONSTEXPR Result evaluate(const Expression<Op, L, R, Result>& e);
+}
+#endif
+
+// tag selecting the constructors leaving the components uninitialized
+struct Uninitialized {};
+constexpr Uninitialized uninitialized{};
+
 template<typename T, std::size_t N>
 class Vector
 {
@@ -15,93 +29,120 @@ class Vector
     static_assert(N > 0, "Argument N must be greater than zero");
 
     public:
-        Vector();
-        Vector(const Vector<T, N>& other);
-        template<typename... Args> Vector(const Args&... args);
-        template<std::size_t M = N, typename = typename std::enable_if<(M > 1)>::type> explicit Vector(T v);
-        explicit Vector(const T (&v)[N]);
-        template<typename U> explicit Vector(const Vector<U, N>& other);
-
-        T* data();
-        const T* data() const;
-        T& operator[](std::size_t i);
-        T operator[](std::size_t i) const;
-        T& x();
-        T x() const;
-        template<std::size_t M = N, typename = typename std::enable_if<(M > 1)>::type> T& y();
-        template<std::size_t M = N, typename = typename std::enable_if<(M > 1)>::type> T y() const;
-        template<std::size_t M = N, typename = typename std::enable_if<(M > 2)>::type> T& z();
-        template<std::size_t M = N, typename = typename std::enable_if<(M > 2)>::type> T z() const;
-        template<std::size_t M = N, typename = typename std::enable_if<(M > 3)>::type> T& w();
-        template<std::size_t M = N, typename = typename std::enable_if<(M > 3)>::type> T w() const;
+        CGLA_CONSTEXPR Vector();
+        Vector(const Vector<T, N>& other) = default;
+        explicit Vector(Uninitialized);
+        template<typename... Args> CGLA_CONSTEXPR Vector(const Args&... args);
+        template<std::size_t M = N, typename = typename std::enable_if<(M > 1)>::type> CGLA_CONSTEXPR explicit Vector(T v);
+        CGLA_CONSTEXPR explicit Vector(const T (&v)[N]);
+        template<typename U> CGLA_CONSTEXPR explicit Vector(const Vector<U, N>& other);
+        #ifdef CGLA_EXPRESSION_TEMPLATES
+        template<typename Op, typename L, typename R> CGLA_CONSTEXPR Vector(const detail::Expression<Op, L, R, Vector<T, N>>& e);
+        #endif
+
+        CGLA_CONSTEXPR T* data();
+        CGLA_CONSTEXPR const T* data() const;
+        CGLA_CONSTEXPR T& operator[](std::size_t i);
+        CGLA_CONSTEXPR T operator[](std::size_t i) const;
+        CGLA_CONSTEXPR T& x();
+        CGLA_CONSTEXPR T x() const;
+        template<std::size_t M = N, typename = typename std::enable_if<(M > 1)>::type> CGLA_CONSTEXPR T& y();
+        template<std::size_t M = N, typename = typename std::enable_if<(M > 1)>::type> CGLA_CONSTEXPR T y() const;
+        template<std::size_t M = N, typename = typename std::enable_if<(M > 2)>::type> CGLA_CONSTEXPR T& z();
+        template<std::size_t M = N, typename = typename std::enable_if<(M > 2)>::type> CGLA_CONSTEXPR T z() const;
+        template<std::size_t M = N, typename = typename std::enable_if<(M > 3)>::type> CGLA_CONSTEXPR T& w();
+        template<std::size_t M = N, typename = typename std::enable_if<(M > 3)>::type> CGLA_CONSTEXPR T w() const;
         #ifdef CGLA_RGBA_ACCESSORS
-        T& r();
-        T r() const;
-        template<std::size_t M = N, typename = typename std::enable_if<(M > 1)>::type> T& g();
-        template<std::size_t M = N, typename = typename std::enable_if<(M > 1)>::type> T g() const;
-        template<std::size_t M = N, typename = typename std::enable_if<(M > 2)>::type> T& b();
-        template<std::size_t M = N, typename = typename std::enable_if<(M > 2)>::type> T b() const;
-        template<std::size_t M = N, typename = typename std::enable_if<(M > 3)>::type> T& a();
-        template<std::size_t M = N, typename = typename std::enable_if<(M > 3)>::type> T a() const;
+        CGLA_CONSTEXPR T& r();
+        CGLA_CONSTEXPR T r() const;
+        template<std::size_t M = N, typename = typename std::enable_if<(M > 1)>::type> CGLA_CONSTEXPR T& g();
+        template<std::size_t M = N, typename = typename std::enable_if<(M > 1)>::type> CGLA_CONSTEXPR T g() const;
+        template<std::size_t M = N, typename = typename std::enable_if<(M > 2)>::type> CGLA_CONSTEXPR T& b();
+        template<std::size_t M = N, typename = typename std::enable_if<(M > 2)>::type> CGLA_CONSTEXPR T b() const;
+        template<std::size_t M = N, typename = typename std::enable_if<(M > 3)>::type> CGLA_CONSTEXPR T& a();
+        template<std::size_t M = N, typename = typename std::enable_if<(M > 3)>::type> CGLA_CONSTEXPR T a() const;
         #endif
         #ifdef CGLA_STPQ_ACCESSORS
-        T& s();
-        T s() const;
-        template<std::size_t M = N, typename = typename std::enable_if<(M > 1)>::type> T& t();
-        template<std::size_t M = N, typename = typename std::enable_if<(M > 1)>::type> T t() const;
-        template<std::size_t M = N, typename = typename std::enable_if<(M > 2)>::type> T& p();
-        template<std::size_t M = N, typename = typename std::enable_if<(M > 2)>::type> T p() const;
-        template<std::size_t M = N, typename = typename std::enable_if<(M > 3)>::type> T& q();
-        template<std::size_t M = N, typename = typename std::enable_if<(M > 3)>::type> T q() const;
+        CGLA_CONSTEXPR T& s();
+        CGLA_CONSTEXPR T s() const;
+        template<std::size_t M = N, typename = typename std::enable_if<(M > 1)>::type> CGLA_CONSTEXPR T& t();
+        template<std::size_t M = N, typename = typename std::enable_if<(M > 1)>::type> CGLA_CONSTEXPR T t() const;
+        template<std::size_t M = N, typename = typename std::enable_if<(M > 2)>::type> CGLA_CONSTEXPR T& p();
+        template<std::size_t M = N, typename = typename std::enable_if<(M > 2)>::type> CGLA_CONSTEXPR T p() const;
+        template<std::size_t M = N, typename = typename std::enable_if<(M > 3)>::type> CGLA_CONSTEXPR T& q();
+        template<std::size_t M = N, typename = typename std::enable_if<(M > 3)>::type> CGLA_CONSTEXPR T q() const;
         #endif
 
-        Vector<T, N>& operator=(const Vector<T, N>& rhs);
-        Vector<T, N>& operator+=(const Vector<T, N>& rhs);
-        Vector<T, N>& operator-=(const Vector<T, N>& rhs);
-        template<typename U> Vector<T, N>& operator*=(U rhs);
-        Vector<T, N>& operator*=(const Vector<T, N>& rhs);
-        template<typename U> Vector<T, N>& operator/=(U rhs);
-        Vector<T, N>& operator/=(const Vector<T, N>& rhs);
-        bool operator==(const Vector<T, N>& rhs) const;
-        bool operator!=(const Vector<T, N>& rhs) const;
-        bool operator<(const Vector<T, N>& rhs) const;
+        Vector<T, N>& operator=(const Vector<T, N>& rhs) = default;
+        #ifdef CGLA_EXPRESSION_TEMPLATES
+        template<typename Op, typename L, typename R> CGLA_CONSTEXPR Vector<T, N>& operator=(const detail::Expression<Op, L, R, Vector<T, N>>& rhs);
+        #endif
+        CGLA_CONSTEXPR Vector<T, N>& operator+=(const Vector<T, N>& rhs);
+        CGLA_CONSTEXPR Vector<T, N>& operator-=(const Vector<T, N>& rhs);
+        template<typename U> CGLA_CONSTEXPR Vector<T, N>& operator*=(U rhs);
+        CGLA_CONSTEXPR Vector<T, N>& operator*=(const Vector<T, N>& rhs);
+        template<typename U> CGLA_CONSTEXPR Vector<T, N>& operator/=(U rhs);
+        CGLA_CONSTEXPR Vector<T, N>& operator/=(const Vector<T, N>& rhs);
+        CGLA_CONSTEXPR bool operator==(const Vector<T, N>& rhs) const;
+        CGLA_CONSTEXPR bool operator!=(const Vector<T, N>& rhs) const;
+        CGLA_CONSTEXPR bool operator<(const Vector<T, N>& rhs) const;
 
     private:
         T values[N];
 };
 
-template<typename T, std::size_t N> Vector<T, N> operator-(Vector<T, N> rhs);
-template<typename T, std::size_t N> Vector<T, N> operator+(Vector<T, N> lhs, const Vector<T, N>& rhs);
-template<typename T, std::size_t N> Vector<T, N> operator-(Vector<T, N> lhs, const Vector<T, N>& rhs);
-template<typename T, std::size_t N, typename U> Vector<T, N> operator*(Vector<T, N> lhs, U rhs);
-template<typename T, std::size_t N, typename U> Vector<T, N> operator*(U lhs, Vector<T, N> rhs);
-template<typename T, std::size_t N> Vector<T, N> operator*(Vector<T, N> lhs, const Vector<T, N>& rhs);
-template<typename T, std::size_t N, typename U> Vector<T, N> operator/(Vector<T, N> lhs, U rhs);
-template<typename T, std::size_t N, typename U> Vector<T, N> operator/(U lhs, const Vector<T, N>& rhs);
-template<typename T, std::size_t N> Vector<T, N> operator/(Vector<T, N> lhs, const Vector<T, N>& rhs);
+#ifndef CGLA_EXPRESSION_TEMPLATES
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, N> operator-(Vector<T, N> rhs);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, N> operator+(Vector<T, N> lhs, const Vector<T, N>& rhs);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, N> operator-(Vector<T, N> lhs, const Vector<T, N>& rhs);
+template<typename T, std::size_t N, typename U> CGLA_CONSTEXPR Vector<T, N> operator*(Vector<T, N> lhs, U rhs);
+template<typename T, std::size_t N, typename U> CGLA_CONSTEXPR Vector<T, N> operator*(U lhs, Vector<T, N> rhs);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, N> operator*(Vector<T, N> lhs, const Vector<T, N>& rhs);
+template<typename T, std::size_t N, typename U> CGLA_CONSTEXPR Vector<T, N> operator/(Vector<T, N> lhs, U rhs);
+template<typename T, std::size_t N, typename U> CGLA_CONSTEXPR Vector<T, N> operator/(U lhs, const Vector<T, N>& rhs);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, N> operator/(Vector<T, N> lhs, const Vector<T, N>& rhs);
+#endif
 #ifdef CGLA_OSTREAM_OVERLOADS
 template<typename T, std::size_t N> std::ostream& operator<<(std::ostream& lhs, const Vector<T, N>& rhs);
 #endif
 
-template<typename T, std::size_t N> T dot(const Vector<T, N>& u, const Vector<T, N>& v);
-template<typename T> Vector<T, 3> cross(const Vector<T, 3>& u, const Vector<T, 3>& v);
-template<typename T, std::size_t N> T lengthSquared(const Vector<T, N>& v);
+template<typename T, std::size_t N> CGLA_CONSTEXPR T dot(const Vector<T, N>& u, const Vector<T, N>& v);
+template<typename T> CGLA_CONSTEXPR Vector<T, 3> cross(const Vector<T, 3>& u, const Vector<T, 3>& v);
+template<typename T, std::size_t N> CGLA_CONSTEXPR T lengthSquared(const Vector<T, N>& v);
 template<typename T, std::size_t N> float length(const Vector<T, N>& v);
-template<typename T, std::size_t N> T distanceSquared(const Vector<T, N>& u, const Vector<T, N>& v);
+template<typename T, std::size_t N> CGLA_CONSTEXPR T distanceSquared(const Vector<T, N>& u, const Vector<T, N>& v);
 template<typename T, std::size_t N> float distance(const Vector<T, N>& u, const Vector<T, N>& v);
 template<typename T, std::size_t N> Vector<T, N> normalize(const Vector<T, N>& v);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, N> min(const Vector<T, N>& u, const Vector<T, N>& v);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, N> max(const Vector<T, N>& u, const Vector<T, N>& v);
 
-template<std::size_t... Indices, typename T, std::size_t N> Vector<T, sizeof...(Indices)> swizzle(const Vector<T, N>& v);
-template<typename T, std::size_t N> Vector<T, 2> xy(const Vector<T, N>& v);
-template<typename T, std::size_t N> Vector<T, 3> xyz(const Vector<T, N>& v);
+template<std::size_t... Indices, typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, sizeof...(Indices)> swizzle(const Vector<T, N>& v);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, 2> xy(const Vector<T, N>& v);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, 3> xyz(const Vector<T, N>& v);
 #ifdef CGLA_RGBA_ACCESSORS
-template<typename T, std::size_t N> Vector<T, 3> rgb(const Vector<T, N>& v);
-template<typename T, std::size_t N> Vector<T, 3> bgr(const Vector<T, N>& v);
-template<typename T, std::size_t N> Vector<T, 4> bgra(const Vector<T, N>& v);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, 3> rgb(const Vector<T, N>& v);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, 3> bgr(const Vector<T, N>& v);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, 4> bgra(const Vector<T, N>& v);
 #endif
 #ifdef CGLA_STPQ_ACCESSORS
-template<typename T, std::size_t N> Vector<T, 2> st(const Vector<T, N>& v);
-template<typename T, std::size_t N> Vector<T, 2> pq(const Vector<T, N>& v);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, 2> st(const Vector<T, N>& v);
+template<typename T, std::size_t N> CGLA_CONSTEXPR Vector<T, 2> pq(const Vector<T, N>& v);
+#endif
+
+#ifdef CGLA_EXPRESSION_TEMPLATES
+// overloads of the functions above taking expressions, evaluated into their result type
+template<typename L, typename R, typename = detail::EnableIfExpression<L, R>> CGLA_CONSTEXPR auto dot(const L& u, const R& v) -> decltype(dot(detail::evaluate(u), detail::evaluate(v)));
+template<typename L, typename R, typename = detail::EnableIfExpression<L, R>> CGLA_CONSTEXPR auto cross(const L& u, const R& v) -> decltype(cross(detail::evaluate(u), detail::evaluate(v)));
+template<typename E, typename = detail::EnableIfExpression<E>> CGLA_CONSTEXPR auto lengthSquared(const E& v) -> decltype(lengthSquared(detail::evaluate(v)));
+template<typename E, typename = detail::EnableIfExpression<E>> auto length(const E& v) -> decltype(length(detail::evaluate(v)));
+template<typename L, typename R, typename = detail::EnableIfExpression<L, R>> CGLA_CONSTEXPR auto distanceSquared(const L& u, const R& v) -> decltype(distanceSquared(detail::evaluate(u), detail::evaluate(v)));
+template<typename L, typename R, typename = detail::EnableIfExpression<L, R>> auto distance(const L& u, const R& v) -> decltype(distance(detail::evaluate(u), detail::evaluate(v)));
+template<typename E, typename = detail::EnableIfExpression<E>> auto normalize(const E& v) -> decltype(normalize(detail::evaluate(v)));
+template<typename L, typename R, typename = detail::EnableIfExpression<L, R>> CGLA_CONSTEXPR auto min(const L& u, const R& v) -> decltype(min(detail::evaluate(u), detail::evaluate(v)));
+template<typename L, typename R, typename = detail::EnableIfExpression<L, R>> CGLA_CONSTEXPR auto max(const L& u, const R& v) -> decltype(max(detail::evaluate(u), detail::evaluate(v)));
+template<std::size_t... Indices, typename E, typename = detail::EnableIfExpression<E>> CGLA_CONSTEXPR auto swizzle(const E& v) -> decltype(swizzle<Indices...>(detail::evaluate(v)));
+template<typename E, typename = detail::EnableIfExpression<E>> CGLA_CONSTEXPR auto xy(const E& v) -> decltype(xy(detail::evaluate(v)));
+template<typename E, typename = detail::EnableIfExpression<E>> CGLA_CONSTEXPR auto xyz(const E& v) -> decltype(xyz(detail::evaluate(v)));
 #endif
 
 #ifdef CGLA_TYPE_ALIASES
@@ -111,8 +152,15 @@ using Vector2d = Vector<double, 2>; using Vector3d = Vector<double, 3>; using Ve
 using Vector2ui = Vector<unsigned int, 2>; using Vector3ui = Vector<unsigned int, 3>; using Vector4ui = Vector<unsigned int, 4>;
 #endif
 
+static_assert(std::is_trivially_copyable<Vector<float, 3>>::value && std::is_standard_layout<Vector<float, 3>>::value, "Vector<T, N> must be trivially copyable and standard-layout");
+static_assert(sizeof(Vector<float, 3>) == sizeof(float[3]) && alignof(Vector<float, 3>) == alignof(float), "Vector<T, N> must be bit-compatible with T[N]");
+
 }
 
+#ifdef CGLA_EXPRESSION_TEMPLATES
+#include "expression.hpp"
+#endif
+
 #include "vector.inl"
 
 #endif
@@ -7,44 +7,44 @@
 namespace cgla {
 
 namespace detail {
-    template<std::size_t Index, typename T, std::size_t N> T at(const Vector<T, N>& v);
-    template<std::size_t Index = 0, typename T, std::size_t N> void insert(Vector<T, N>& u, T v);
-    template<std::size_t Index = 0, typename T, std::size_t N, typename... Args> void insert(Vector<T, N>& u, T v, const Args&... args);
-    template<std::size_t Index = 0, typename T, std::size_t N, std::size_t M> void insert(Vector<T, N>& u, const Vector<T, M>& v);
-    template<std::size_t Index = 0, typename T, std::size_t N, std::size_t M, typename... Args> void insert(Vector<T, N>& u, const Vector<T, M>& v, const Args&... args);
+    template<std::size_t Index, typename T, std::size_t N> CGLA_CONSTEXPR T at(const Vector<T, N>& v);
+    template<std::size_t Index = 0, typename T, std::size_t N> CGLA_CONSTEXPR void insert(Vector<T, N>& u, T v);
+    template<std::size_t Index = 0, typename T, std::size_t N, typename... Args> CGLA_CONSTEXPR void insert(Vector<T, N>& u, T v, const Args&... args);
+    template<std::size_t Index = 0, typename T, std::size_t N, std::size_t M> CGLA_CONSTEXPR void insert(Vector<T, N>& u, const Vector<T, M>& v);
+    template<std::size_t Index = 0, typename T, std::size_t N, std::size_t M, typename... Args> CGLA_CONSTEXPR void insert(Vector<T, N>& u, const Vector<T, M>& v, const Args&... args);
 }
 
 template<typename T, std::size_t N>
-inline Vector<T, N>::Vector()
+CGLA_CONSTEXPR Vector<T, N>::Vector() :
+    values{}
 {
-    for (std::size_t i = 0; i < N; ++i)
-        values[i] = static_cast<T>(0);
 }
 
 template<typename T, std::size_t N>
-inline Vector<T, N>::Vector(const Vector<T, N>& other)
+inline Vector<T, N>::Vector(Uninitialized)
 {
-    for (std::size_t i = 0; i < N; ++i)
-        values[i] = other.values[i];
 }
 
 template<typename T, std::size_t N>
 template<typename... Args>
-inline Vector<T, N>::Vector(const Args&... args)
+CGLA_CONSTEXPR Vector<T, N>::Vector(const Args&... args) :
+    values{}
 {
     detail::insert(*this, args...);
 }
 
 template<typename T, std::size_t N>
 template<std::size_t, typename>
-inline Vector<T, N>::Vector(T v)
+CGLA_CONSTEXPR Vector<T, N>::Vector(T v) :
+    values{}
 {
     for (std::size_t i = 0; i < N; ++i)
         values[i] = v;
 }
 
 template<typename T, std::size_t N>
-inline Vector<T, N>::Vector(const T (&v)[N])
+CGLA_CONSTEXPR Vector<T, N>::Vector(const T (&v)[N]) :
+    values{}
 {
     for (std::size_t i = 0; i < N; ++i)
         values[i] = v[i];
@@ -52,141 +52,153 @@ inline Vector<T, N>::Vector(const T (&v)[N])
 
 template<typename T, std::size_t N>
 template<typename U>
-inline Vector<T, N>::Vector(const Vector<U, N>& other)
+CGLA_CONSTEXPR Vector<T, N>::Vector(const Vector<U, N>& other) :
+    values{}
 {
     for (std::size_t i = 0; i < N; ++i)
         values[i] = static_cast<T>(other[i]);
 }
 
+#ifdef CGLA_EXPRESSION_TEMPLATES
+template<typename T, std::size_t N>
+template<typename Op, typename L, typename R>
+CGLA_CONSTEXPR Vector<T, N>::Vector(const detail::Expression<Op, L, R, Vector<T, N>>& e) :
+    values{}
+{
+    for (std::size_t i = 0; i < N; ++i)
+        values[i] = e[i];
+}
+#endif
+
 template<typename T, std::size_t N>
-inline T* Vector<T, N>::data()
+CGLA_CONSTEXPR T* Vector<T, N>::data()
 {
     return values;
 }
 
 template<typename T, std::size_t N>
-inline const T* Vector<T, N>::data() const
+CGLA_CONSTEXPR const T* Vector<T, N>::data() const
 {
     return values;
 }
 
 template<typename T, std::size_t N>
-inline T& Vector<T, N>::operator[](std::size_t i)
+CGLA_CONSTEXPR T& Vector<T, N>::operator[](std::size_t i)
 {
     return values[i];
 }
 
 template<typename T, std::size_t N>
-inline T Vector<T, N>::operator[](std::size_t i) const
+CGLA_CONSTEXPR T Vector<T, N>::operator[](std::size_t i) const
 {
     return values[i];
 }
 
 template<typename T, std::size_t N>
-inline T& Vector<T, N>::x()
+CGLA_CONSTEXPR T& Vector<T, N>::x()
 {
     return values[0];
 }
 
 template<typename T, std::size_t N>
-inline T Vector<T, N>::x() const
+CGLA_CONSTEXPR T Vector<T, N>::x() const
 {
     return values[0];
 }
 
 template<typename T, std::size_t N>
 template<std::size_t, typename>
-inline T& Vector<T, N>::y()
+CGLA_CONSTEXPR T& Vector<T, N>::y()
 {
     return values[1];
 }
 
 template<typename T, std::size_t N>
 template<std::size_t, typename>
-inline T Vector<T, N>::y() const
+CGLA_CONSTEXPR T Vector<T, N>::y() const
 {
     return values[1];
 }
 
 template<typename T, std::size_t N>
 template<std::size_t, typename>
-inline T& Vector<T, N>::z()
+CGLA_CONSTEXPR T& Vector<T, N>::z()
 {
     return values[2];
 }
 
 template<typename T, std::size_t N>
 template<std::size_t, typename>
-inline T Vector<T, N>::z() const
+CGLA_CONSTEXPR T Vector<T, N>::z() const
 {
     return values[2];
 }
 
 template<typename T, std::size_t N>
 template<std::size_t, typename>
-inline T& Vector<T, N>::w()
+CGLA_CONSTEXPR T& Vector<T, N>::w()
 {
     return values[3];
 }
 
 template<typename T, std::size_t N>
 template<std::size_t, typename>
-inline T Vector<T, N>::w() const
+CGLA_CONSTEXPR T Vector<T, N>::w() const
 {
     return values[3];
 }
 
 #ifdef CGLA_RGBA_ACCESSORS
 template<typename T, std::size_t N>
-inline T& Vector<T, N>::r()
+CGLA_CONSTEXPR T& Vector<T, N>::r()
 {
     return values[0];
 }
 
 template<typename T, std::size_t N>
-inline T Vector<T, N>::r() const
+CGLA_CONSTEXPR T Vector<T, N>::r() const
 {
     return values[0];
 }
 
 template<typename T, std::size_t N>
 template<std::size_t, typename>
-inline T& Vector<T, N>::g()
+CGLA_CONSTEXPR T& Vector<T, N>::g()
 {
     return values[1];
 }
 
 template<typename T, std::size_t N>
 template<std::size_t, typename>
-inline T Vector<T, N>::g() const
+CGLA_CONSTEXPR T Vector<T, N>::g() const
 {
     return values[1];
 }
 
 template<typename T, std::size_t N>
 template<std::size_t, typename>
-inline T& Vector<T, N>::b()
+CGLA_CONSTEXPR T& Vector<T, N>::b()
 {
     return values[2];
 }
 
 template<typename T, std::size_t N>
 template<std::size_t, typename>
-inline T Vector<T, N>::b() const
+CGLA_CONSTEXPR T Vector<T, N>::b() const
 {
     return values[2];
 }
 
 template<typename T, std::size_t N>
 template<std::size_t, typename>
-inline T& Vector<T, N>::a()
+CGLA_CONSTEXPR T& Vector<T, N>::a()
 {
     return values[3];
 }
 
 template<typename T, std::size_t N>
 template<std::size_t, typename>
-inline T Vector<T, N>::a() const
+CGLA_CONSTEXPR T Vector<T, N>::a() const
 {
     return values[3];
 }
@@ -194,71 +206,74 @@ inline T Vector<T, N>::a() const
 
 #ifdef CGLA_STPQ_ACCESSORS
 template<typename T, std::size_t N>
-inline T& Vector<T, N>::s()
+CGLA_CONSTEXPR T& Vector<T, N>::s()
 {
     return values[0];
 }
 
 template<typename T, std::size_t N>
-inline T Vector<T, N>::s() const
+CGLA_CONSTEXPR T Vector<T, N>::s() const
 {
     return values[0];
 }
 
 template<typename T, std::size_t N>
 template<std::size_t, typename>
-inline T& Vector<T, N>::t()
+CGLA_CONSTEXPR T& Vector<T, N>::t()
 {
     return values[1];
 }
 
 template<typename T, std::size_t N>
 template<std::size_t, typename>
-inline T Vector<T, N>::t() const
+CGLA_CONSTEXPR T Vector<T, N>::t() const
 {
     return values[1];
 }
 
 template<typename T, std::size_t N>
 template<std::size_t, typename>
-inline T& Vector<T, N>::p()
+CGLA_CONSTEXPR T& Vector<T, N>::p()
 {
     return values[2];
 }
 
 template<typename T, std::size_t N>
 template<std::size_t, typename>
-inline T Vector<T, N>::p() const
+CGLA_CONSTEXPR T Vector<T, N>::p() const
 {
     return values[2];
 }
 
 template<typename T, std::size_t N>
 template<std::size_t, typename>
-inline T& Vector<T, N>::q()
+CGLA_CONSTEXPR T& Vector<T, N>::q()
 {
     return values[3];
 }
 
 template<typename T, std::size_t N>
 template<std::size_t, typename>
-inline T Vector<T, N>::q() const
+CGLA_CONSTEXPR T Vector<T, N>::q() const
 {
     return values[3];
 }
 #endif
 
+#ifdef CGLA_EXPRESSION_TEMPLATES
 template<typename T, std::size_t N>
-inline Vector<T, N>& Vector<T, N>::operator=(const Vector<T, N>& rhs)
+template<typename Op, typename L, typename R>
+CGLA_CONSTEXPR Vector<T, N>& Vector<T, N>::operator=(const detail::Expression<Op, L, R, Vector<T, N>>& rhs)
 {
     for (std::size_t i = 0; i < N; ++i)
-        values[i] = rhs.values[i];
+        values[i] = rhs[i];
 
     return *this;
 }
+#endif
 
 template<typename T, std::size_t N>
-inline Vector<T, N>& Vector<T, N>::operator+=(const Vector<T, N>& rhs)
+CGLA_CONSTEXPR Vector<T, N>& Vector<T, N>::operator+=(const Vector<T, N>& rhs)
 {
     for (std::size_t i = 0; i < N; ++i)
         values[i] += rhs.values[i];
@@ -267,7 +282,7 @@ inline Vector<T, N>& Vector<T, N>::operator+=(const Vector<T, N>& rhs)
 }
 
 template<typename T, std::size_t N>
-inline Vector<T, N>& Vector<T, N>::operator-=(const Vector<T, N>& rhs)
+CGLA_CONSTEXPR Vector<T, N>& Vector<T, N>::operator-=(const Vector<T, N>& rhs)
 {
     for (std::size_t i = 0; i < N; ++i)
         values[i] -= rhs.values[i];
@@ -277,7 +292,7 @@ inline Vector<T, N>& Vector<T, N>::operator-=(const Vector<T, N>& rhs)
 
 template<typename T, std::size_t N>
 template<typename U>
-inline Vector<T, N>& Vector<T, N>::operator*=(U rhs)
+CGLA_CONSTEXPR Vector<T, N>& Vector<T, N>::operator*=(U rhs)
 {
     for (std::size_t i = 0; i < N; ++i)
         values[i] *= rhs;
@@ -286,7 +301,7 @@ inline Vector<T, N>& Vector<T, N>::operator*=(U rhs)
 }
 
 template<typename T, std::size_t N>
-inline Vector<T, N>& Vector<T, N>::operator*=(const Vector<T, N>& rhs)
+CGLA_CONSTEXPR Vector<T, N>& Vector<T, N>::operator*=(const Vector<T, N>& rhs)
 {
     for (std::size_t i = 0; i < N; ++i)
         values[i] *= rhs.values[i];
@@ -296,7 +311,7 @@ inline Vector<T, N>& Vector<T, N>::operator*=(const Vector<T, N>& rhs)
 
 template<typename T, std::size_t N>
 template<typename U>
-inline Vector<T, N>& Vector<T, N>::operator/=(U rhs)
+CGLA_CONSTEXPR Vector<T, N>& Vector<T, N>::operator/=(U rhs)
 {
     for (std::size_t i = 0; i < N; ++i)
         values[i] /= rhs;
@@ -305,7 +320,7 @@ inline Vector<T, N>& Vector<T, N>::operator/=(U rhs)
 }
 
 template<typename T, std::size_t N>
-inline Vector<T, N>& Vector<T, N>::operator/=(const Vector<T, N>& rhs)
+CGLA_CONSTEXPR Vector<T, N>& Vector<T, N>::operator/=(const Vector<T, N>& rhs)
 {
     for (std::size_t i = 0; i < N; ++i)
         values[i] /= rhs.values[i];
@@ -314,7 +329,7 @@ inline Vector<T, N>& Vector<T, N>::operator/=(const Vector<T, N>& rhs)
 }
 
 template<typename T, std::size_t N>
-inline bool Vector<T, N>::operator==(const Vector<T, N>& rhs) const
+CGLA_CONSTEXPR bool Vector<T, N>::operator==(const Vector<T, N>& rhs) const
 {
     for (std::size_t i = 0; i < N; ++i)
         if (values[i] != rhs.values[i])
@@ -324,13 +339,13 @@ inline bool Vector<T, N>::operator==(const Vector<T, N>& rhs) const
 }
 
 template<typename T, std::size_t N>
-inline bool Vector<T, N>::operator!=(const Vector<T, N>& rhs) const
+CGLA_CONSTEXPR bool Vector<T, N>::operator!=(const Vector<T, N>& rhs) const
 {
     return !(*this == rhs);
 }
 
 template<typename T, std::size_t N>
-inline bool Vector<T, N>::operator<(const Vector<T, N>& rhs) const
+CGLA_CONSTEXPR bool Vector<T, N>::operator<(const Vector<T, N>& rhs) const
 {
     for (std::size_t i = 0; i < N; ++i)
         if (values[i] != rhs.values[i])
@@ -339,50 +354,51 @@ inline bool Vector<T, N>::operator<(const Vector<T, N>& rhs) const
     return false;
 }
 
+#ifndef CGLA_EXPRESSION_TEMPLATES
 template<typename T, std::size_t N>
-inline Vector<T, N> operator-(Vector<T, N> rhs)
+CGLA_CONSTEXPR Vector<T, N> operator-(Vector<T, N> rhs)
 {
     return rhs *= -1;
 }
 
 template<typename T, std::size_t N>
-inline Vector<T, N> operator+(Vector<T, N> lhs, const Vector<T, N>& rhs)
+CGLA_CONSTEXPR Vector<T, N> operator+(Vector<T, N> lhs, const Vector<T, N>& rhs)
 {
     return lhs += rhs;
 }
 
 template<typename T, std::size_t N>
-inline Vector<T, N> operator-(Vector<T, N> lhs, const Vector<T, N>& rhs)
+CGLA_CONSTEXPR Vector<T, N> operator-(Vector<T, N> lhs, const Vector<T, N>& rhs)
 {
     return lhs -= rhs;
 }
 
 template<typename T, std::size_t N, typename U>
-inline Vector<T, N> operator*(Vector<T, N> lhs, U rhs)
+CGLA_CONSTEXPR Vector<T, N> operator*(Vector<T, N> lhs, U rhs)
 {
     return lhs *= rhs;
 }
 
 template<typename T, std::size_t N, typename U>
-inline Vector<T, N> operator*(U lhs, Vector<T, N> rhs)
+CGLA_CONSTEXPR Vector<T, N> operator*(U lhs, Vector<T, N> rhs)
 {
     return rhs *= lhs;
 }
 
 template<typename T, std::size_t N>
-inline Vector<T, N> operator*(Vector<T, N> lhs, const Vector<T, N>& rhs)
+CGLA_CONSTEXPR Vector<T, N> operator*(Vector<T, N> lhs, const Vector<T, N>& rhs)
 {
     return lhs *= rhs;
 }
 
 template<typename T, std::size_t N, typename U>
-inline Vector<T, N> operator/(Vector<T, N> lhs, U rhs)
+CGLA_CONSTEXPR Vector<T, N> operator/(Vector<T, N> lhs, U rhs)
 {
     return lhs /= rhs;
 }
 
 template<typename T, std::size_t N, typename U>
-inline Vector<T, N> operator/(U lhs, const Vector<T, N>& rhs)
+CGLA_CONSTEXPR Vector<T, N> operator/(U lhs, const Vector<T, N>& rhs)
 {
     Vector<T, N> res;
 
@@ -393,10 +409,11 @@ inline Vector<T, N> operator/(U lhs, const Vector<T, N>& rhs)
 }
 
 template<typename T, std::size_t N>
-inline Vector<T, N> operator/(Vector<T, N> lhs, const Vector<T, N>& rhs)
+CGLA_CONSTEXPR Vector<T, N> operator/(Vector<T, N> lhs, const Vector<T, N>& rhs)
 {
     return lhs /= rhs;
 }
+#endif
 
 #ifdef CGLA_OSTREAM_OVERLOADS
 template<typename T, std::size_t N>
@@ -414,7 +431,7 @@ std::ostream& operator<<(std::ostream& lhs, const Vector<T, N>& rhs)
 #endif
 
 template<typename T, std::size_t N>
-inline T dot(const Vector<T, N>& u, const Vector<T, N>& v)
+CGLA_CONSTEXPR T dot(const Vector<T, N>& u, const Vector<T, N>& v)
 {
     T res = static_cast<T>(0);
     for (std::size_t i = 0; i < N; ++i)
@@ -424,7 +441,7 @@ inline T dot(const Vector<T, N>& u, const Vector<T, N>& v)
 }
 
 template<typename T>
-inline Vector<T, 3> cross(const Vector<T, 3>& u, const Vector<T, 3>& v)
+CGLA_CONSTEXPR Vector<T, 3> cross(const Vector<T, 3>& u, const Vector<T, 3>& v)
 {
     return Vector<T, 3>({u[1] * v[2] - u[2] * v[1],
                          u[2] * v[0] - u[0] * v[2],
@@ -432,7 +449,7 @@ inline Vector<T, 3> cross(const Vector<T, 3>& u, const Vector<T, 3>& v)
 }
 
 template<typename T, std::size_t N>
-inline T lengthSquared(const Vector<T, N>& v)
+CGLA_CONSTEXPR T lengthSquared(const Vector<T, N>& v)
 {
     return dot(v, v);
 }
@@ -444,15 +461,15 @@ inline float length(const Vector<T, N>& v)
 }
 
 template<typename T, std::size_t N>
-inline T distanceSquared(const Vector<T, N>& u, const Vector<T, N>& v)
+CGLA_CONSTEXPR T distanceSquared(const Vector<T, N>& u, const Vector<T, N>& v)
 {
-    return lengthSquared(u - v);
+    return lengthSquared(Vector<T, N>(u - v));
 }
 
 template<typename T, std::size_t N>
 inline float distance(const Vector<T, N>& u, const Vector<T, N>& v)
 {
-    return length(u - v);
+    return length(Vector<T, N>(u - v));
 }
 
 template<typename T, std::size_t N>
@@ -461,39 +478,63 @@ inline Vector<T, N> normalize(const Vector<T, N>& v)
     return v / length(v);
 }
 
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Vector<T, N> min(const Vector<T, N>& u, const Vector<T, N>& v)
+{
+    Vector<T, N> res{u};
+
+    for (std::size_t i = 0; i < N; ++i)
+        if (v[i] < res[i])
+            res[i] = v[i];
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+CGLA_CONSTEXPR Vector<T, N> max(const Vector<T, N>& u, const Vector<T, N>& v)
+{
+    Vector<T, N> res{u};
+
+    for (std::size_t i = 0; i < N; ++i)
+        if (res[i] < v[i])
+            res[i] = v[i];
+
+    return res;
+}
+
 template<std::size_t... Indices, typename T, std::size_t N>
-inline Vector<T, sizeof...(Indices)> swizzle(const Vector<T, N>& v)
+CGLA_CONSTEXPR Vector<T, sizeof...(Indices)> swizzle(const Vector<T, N>& v)
 {
     return {detail::at<Indices>(v)...};
 }
 
 template<typename T, std::size_t N>
-inline Vector<T, 2> xy(const Vector<T, N>& v)
+CGLA_CONSTEXPR Vector<T, 2> xy(const Vector<T, N>& v)
 {
     return swizzle<0, 1>(v);
 }
 
 template<typename T, std::size_t N>
-inline Vector<T, 3> xyz(const Vector<T, N>& v)
+CGLA_CONSTEXPR Vector<T, 3> xyz(const Vector<T, N>& v)
 {
     return swizzle<0, 1, 2>(v);
 }
 
 #ifdef CGLA_RGBA_ACCESSORS
 template<typename T, std::size_t N>
-inline Vector<T, 3> rgb(const Vector<T, N>& v)
+CGLA_CONSTEXPR Vector<T, 3> rgb(const Vector<T, N>& v)
 {
     return swizzle<0, 1, 2>(v);
 }
 
 template<typename T, std::size_t N>
-inline Vector<T, 3> bgr(const Vector<T, N>& v)
+CGLA_CONSTEXPR Vector<T, 3> bgr(const Vector<T, N>& v)
 {
     return swizzle<2, 1, 0>(v);
 }
 
 template<typename T, std::size_t N>
-inline Vector<T, 4> bgra(const Vector<T, N>& v)
+CGLA_CONSTEXPR Vector<T, 4> bgra(const Vector<T, N>& v)
 {
     return swizzle<2, 1, 0, 3>(v);
 }
@@ -501,21 +542,95 @@ inline Vector<T, 4> bgra(const Vector<T, N>& v)
 
 #ifdef CGLA_STPQ_ACCESSORS
 template<typename T, std::size_t N>
-inline Vector<T, 2> st(const Vector<T, N>& v)
+CGLA_CONSTEXPR Vector<T, 2> st(const Vector<T, N>& v)
 {
     return swizzle<0, 1>(v);
 }
 
 template<typename T, std::size_t N>
-inline Vector<T, 2> pq(const Vector<T, N>& v)
+CGLA_CONSTEXPR Vector<T, 2> pq(const Vector<T, N>& v)
 {
     return swizzle<2, 3>(v);
 }
 #endif
 
+#ifdef CGLA_EXPRESSION_TEMPLATES
+template<typename L, typename R, typename>
+CGLA_CONSTEXPR auto dot(const L& u, const R& v) -> decltype(dot(detail::evaluate(u), detail::evaluate(v)))
+{
+    return dot(detail::evaluate(u), detail::evaluate(v));
+}
+
+template<typename L, typename R, typename>
+CGLA_CONSTEXPR auto cross(const L& u, const R& v) -> decltype(cross(detail::evaluate(u), detail::evaluate(v)))
+{
+    return cross(detail::evaluate(u), detail::evaluate(v));
+}
+
+template<typename E, typename>
+CGLA_CONSTEXPR auto lengthSquared(const E& v) -> decltype(lengthSquared(detail::evaluate(v)))
+{
+    return lengthSquared(detail::evaluate(v));
+}
+
+template<typename E, typename>
+inline auto length(const E& v) -> decltype(length(detail::evaluate(v)))
+{
+    return length(detail::evaluate(v));
+}
+
+template<typename L, typename R, typename>
+CGLA_CONSTEXPR auto distanceSquared(const L& u, const R& v) -> decltype(distanceSquared(detail::evaluate(u), detail::evaluate(v)))
+{
+    return distanceSquared(detail::evaluate(u), detail::evaluate(v));
+}
+
+template<typename L, typename R, typename>
+inline auto distance(const L& u, const R& v) -> decltype(distance(detail::evaluate(u), detail::evaluate(v)))
+{
+    return distance(detail::evaluate(u), detail::evaluate(v));
+}
+
+template<typename E, typename>
+inline auto normalize(const E& v) -> decltype(normalize(detail::evaluate(v)))
+{
+    return normalize(detail::evaluate(v));
+}
+
+template<typename L, typename R, typename>
+CGLA_CONSTEXPR auto min(const L& u, const R& v) -> decltype(min(detail::evaluate(u), detail::evaluate(v)))
+{
+    return min(detail::evaluate(u), detail::evaluate(v));
+}
+
+template<typename L, typename R, typename>
+CGLA_CONSTEXPR auto max(const L& u, const R& v) -> decltype(max(detail::evaluate(u), detail::evaluate(v)))
+{
+    return max(detail::evaluate(u), detail::evaluate(v));
+}
+
+template<std::size_t... Indices, typename E, typename>
+CGLA_CONSTEXPR auto swizzle(const E& v) -> decltype(swizzle<Indices...>(detail::evaluate(v)))
+{
+    return swizzle<Indices...>(detail::evaluate(v));
+}
+
+template<typename E, typename>
+CGLA_CONSTEXPR auto xy(const E& v) -> decltype(xy(detail::evaluate(v)))
+{
+    return xy(detail::evaluate(v));
+}
+
+template<typename E, typename>
+CGLA_CONSTEXPR auto xyz(const E& v) -> decltype(xyz(detail::evaluate(v)))
+{
+    return xyz(detail::evaluate(v));
+}
+#endif
+
 namespace detail {
     template<std::size_t Index, typename T, std::size_t N>
-    inline T at(const Vector<T, N>& v)
+    CGLA_CONSTEXPR T at(const Vector<T, N>& v)
     {
         static_assert(Index < N, "swizzle: Index out of range");
 
@@ -523,7 +638,7 @@ namespace detail {
     }
 
     template<std::size_t Index, typename T, std::size_t N>
-    inline void insert(Vector<T, N>& u, T v)
+    CGLA_CONSTEXPR void insert(Vector<T, N>& u, T v)
     {
         static_assert(Index < N, "Too many components");
         static_assert(Index + 2 > N, "Not enough components");
@@ -532,7 +647,7 @@ namespace detail {
     }
 
     template<std::size_t Index, typename T, std::size_t N, typename... Args>
-    inline void insert(Vector<T, N>& u, T v, const Args&... args)
+    CGLA_CONSTEXPR void insert(Vector<T, N>& u, T v, const Args&... args)
     {
         static_assert(Index < N, "Too many components");
 
@@ -542,7 +657,7 @@ namespace detail {
     }
 
     template<std::size_t Index, typename T, std::size_t N, std::size_t M>
-    inline void insert(Vector<T, N>& u, const Vector<T, M>& v)
+    CGLA_CONSTEXPR void insert(Vector<T, N>& u, const Vector<T, M>& v)
     {
         static_assert(Index + M - 1 < N, "Too many components");
         static_assert(Index + M + 1 > N, "Not enough components");
@@ -552,7 +667,7 @@ namespace detail {
     }
 
     template<std::size_t Index, typename T, std::size_t N, std::size_t M, typename... Args>
-    inline void insert(Vector<T, N>& u, const Vector<T, M>& v, const Args&... args)
+    CGLA_CONSTEXPR void insert(Vector<T, N>& u, const Vector<T, M>& v, const Args&... args)
     {
         static_assert(Index + M - 1 < N, "Too many components");
 
@@ -0,0 +1,78 @@
+#ifndef CGLA_VECTOR_ARRAY_HPP
+#define CGLA_VECTOR_ARRAY_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include "config.hpp"
+#include "vector.hpp"
+
+namespace cgla {
+
+template<typename T, std::size_t N>
+class VectorArray
+{
+    static_assert(std::is_arithmetic<T>::value, "Argument T must be an arithmetic type");
+    static_assert(N > 0, "Argument N must be greater than zero");
+
+    public:
+        VectorArray();
+        explicit VectorArray(std::size_t size);
+        VectorArray(std::size_t size, const Vector<T, N>& v);
+        VectorArray(const Vector<T, N>* v, std::size_t size);
+        explicit VectorArray(const std::vector<Vector<T, N>>& v);
+
+        std::size_t size() const;
+        void resize(std::size_t size);
+        T* data(std::size_t component);
+        const T* data(std::size_t component) const;
+        Vector<T, N> operator[](std::size_t i) const;
+        void set(std::size_t i, const Vector<T, N>& v);
+        void store(Vector<T, N>* v) const;
+        std::vector<Vector<T, N>> toVectors() const;
+
+        VectorArray<T, N>& operator+=(const VectorArray<T, N>& rhs);
+        VectorArray<T, N>& operator+=(const Vector<T, N>& rhs);
+        VectorArray<T, N>& operator-=(const VectorArray<T, N>& rhs);
+        VectorArray<T, N>& operator-=(const Vector<T, N>& rhs);
+        template<typename U> VectorArray<T, N>& operator*=(U rhs);
+        VectorArray<T, N>& operator*=(const VectorArray<T, N>& rhs);
+        template<typename U> VectorArray<T, N>& operator/=(U rhs);
+        VectorArray<T, N>& operator/=(const VectorArray<T, N>& rhs);
+        bool operator==(const VectorArray<T, N>& rhs) const;
+        bool operator!=(const VectorArray<T, N>& rhs) const;
+
+    private:
+        std::size_t count;
+        std::vector<T> values[N];
+};
+
+template<typename T, std::size_t N> VectorArray<T, N> operator-(VectorArray<T, N> rhs);
+template<typename T, std::size_t N> VectorArray<T, N> operator+(VectorArray<T, N> lhs, const VectorArray<T, N>& rhs);
+template<typename T, std::size_t N> VectorArray<T, N> operator-(VectorArray<T, N> lhs, const VectorArray<T, N>& rhs);
+template<typename T, std::size_t N, typename U> VectorArray<T, N> operator*(VectorArray<T, N> lhs, U rhs);
+template<typename T, std::size_t N, typename U> VectorArray<T, N> operator*(U lhs, VectorArray<T, N> rhs);
+template<typename T, std::size_t N> VectorArray<T, N> operator*(VectorArray<T, N> lhs, const VectorArray<T, N>& rhs);
+template<typename T, std::size_t N, typename U> VectorArray<T, N> operator/(VectorArray<T, N> lhs, U rhs);
+template<typename T, std::size_t N> VectorArray<T, N> operator/(VectorArray<T, N> lhs, const VectorArray<T, N>& rhs);
+
+template<typename T, std::size_t N> std::vector<T> dot(const VectorArray<T, N>& u, const VectorArray<T, N>& v);
+template<typename T> VectorArray<T, 3> cross(const VectorArray<T, 3>& u, const VectorArray<T, 3>& v);
+template<typename T, std::size_t N> std::vector<T> lengthSquared(const VectorArray<T, N>& v);
+template<typename T, std::size_t N> std::vector<T> length(const VectorArray<T, N>& v);
+template<typename T, std::size_t N> VectorArray<T, N> normalize(const VectorArray<T, N>& v);
+
+template<std::size_t... Indices, typename T, std::size_t N> VectorArray<T, sizeof...(Indices)> swizzle(const VectorArray<T, N>& v);
+
+#ifdef CGLA_TYPE_ALIASES
+using VectorArray2i = VectorArray<int, 2>; using VectorArray3i = VectorArray<int, 3>; using VectorArray4i = VectorArray<int, 4>;
+using VectorArray2f = VectorArray<float, 2>; using VectorArray3f = VectorArray<float, 3>; using VectorArray4f = VectorArray<float, 4>;
+using VectorArray2d = VectorArray<double, 2>; using VectorArray3d = VectorArray<double, 3>; using VectorArray4d = VectorArray<double, 4>;
+using VectorArray2ui = VectorArray<unsigned int, 2>; using VectorArray3ui = VectorArray<unsigned int, 3>; using VectorArray4ui = VectorArray<unsigned int, 4>;
+#endif
+
+}
+
+#include "vector_array.inl"
+
+#endif
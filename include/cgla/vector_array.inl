@@ -0,0 +1,411 @@
+#include <cstddef>
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <vector>
+#include "config.hpp"
+#include "vector.hpp"
+
+namespace cgla {
+
+namespace detail {
+    template<std::size_t Index, std::size_t N> constexpr std::size_t checkIndex();
+}
+
+template<typename T, std::size_t N>
+inline VectorArray<T, N>::VectorArray() :
+    count{0}
+{
+}
+
+template<typename T, std::size_t N>
+inline VectorArray<T, N>::VectorArray(std::size_t size) :
+    count{size}
+{
+    for (std::size_t c = 0; c < N; ++c)
+        values[c].resize(size, static_cast<T>(0));
+}
+
+template<typename T, std::size_t N>
+inline VectorArray<T, N>::VectorArray(std::size_t size, const Vector<T, N>& v) :
+    count{size}
+{
+    for (std::size_t c = 0; c < N; ++c)
+        values[c].resize(size, v[c]);
+}
+
+template<typename T, std::size_t N>
+inline VectorArray<T, N>::VectorArray(const Vector<T, N>* v, std::size_t size) :
+    count{size}
+{
+    for (std::size_t c = 0; c < N; ++c)
+    {
+        values[c].resize(size);
+
+        T* dst = values[c].data();
+        for (std::size_t i = 0; i < size; ++i)
+            dst[i] = v[i][c];
+    }
+}
+
+template<typename T, std::size_t N>
+inline VectorArray<T, N>::VectorArray(const std::vector<Vector<T, N>>& v) :
+    VectorArray(v.data(), v.size())
+{
+}
+
+template<typename T, std::size_t N>
+inline std::size_t VectorArray<T, N>::size() const
+{
+    return count;
+}
+
+template<typename T, std::size_t N>
+inline void VectorArray<T, N>::resize(std::size_t size)
+{
+    for (std::size_t c = 0; c < N; ++c)
+        values[c].resize(size, static_cast<T>(0));
+
+    count = size;
+}
+
+template<typename T, std::size_t N>
+inline T* VectorArray<T, N>::data(std::size_t component)
+{
+    return values[component].data();
+}
+
+template<typename T, std::size_t N>
+inline const T* VectorArray<T, N>::data(std::size_t component) const
+{
+    return values[component].data();
+}
+
+template<typename T, std::size_t N>
+inline Vector<T, N> VectorArray<T, N>::operator[](std::size_t i) const
+{
+    Vector<T, N> res;
+
+    for (std::size_t c = 0; c < N; ++c)
+        res[c] = values[c][i];
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+inline void VectorArray<T, N>::set(std::size_t i, const Vector<T, N>& v)
+{
+    for (std::size_t c = 0; c < N; ++c)
+        values[c][i] = v[c];
+}
+
+template<typename T, std::size_t N>
+inline void VectorArray<T, N>::store(Vector<T, N>* v) const
+{
+    for (std::size_t c = 0; c < N; ++c)
+    {
+        const T* src = values[c].data();
+        for (std::size_t i = 0; i < count; ++i)
+            v[i][c] = src[i];
+    }
+}
+
+template<typename T, std::size_t N>
+inline std::vector<Vector<T, N>> VectorArray<T, N>::toVectors() const
+{
+    std::vector<Vector<T, N>> res(count);
+    store(res.data());
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+inline VectorArray<T, N>& VectorArray<T, N>::operator+=(const VectorArray<T, N>& rhs)
+{
+    assert(count == rhs.count);
+
+    for (std::size_t c = 0; c < N; ++c)
+    {
+        T* dst = values[c].data();
+        const T* src = rhs.values[c].data();
+        for (std::size_t i = 0; i < count; ++i)
+            dst[i] += src[i];
+    }
+
+    return *this;
+}
+
+template<typename T, std::size_t N>
+inline VectorArray<T, N>& VectorArray<T, N>::operator+=(const Vector<T, N>& rhs)
+{
+    for (std::size_t c = 0; c < N; ++c)
+    {
+        T* dst = values[c].data();
+        T v = rhs[c];
+        for (std::size_t i = 0; i < count; ++i)
+            dst[i] += v;
+    }
+
+    return *this;
+}
+
+template<typename T, std::size_t N>
+inline VectorArray<T, N>& VectorArray<T, N>::operator-=(const VectorArray<T, N>& rhs)
+{
+    assert(count == rhs.count);
+
+    for (std::size_t c = 0; c < N; ++c)
+    {
+        T* dst = values[c].data();
+        const T* src = rhs.values[c].data();
+        for (std::size_t i = 0; i < count; ++i)
+            dst[i] -= src[i];
+    }
+
+    return *this;
+}
+
+template<typename T, std::size_t N>
+inline VectorArray<T, N>& VectorArray<T, N>::operator-=(const Vector<T, N>& rhs)
+{
+    for (std::size_t c = 0; c < N; ++c)
+    {
+        T* dst = values[c].data();
+        T v = rhs[c];
+        for (std::size_t i = 0; i < count; ++i)
+            dst[i] -= v;
+    }
+
+    return *this;
+}
+
+template<typename T, std::size_t N>
+template<typename U>
+inline VectorArray<T, N>& VectorArray<T, N>::operator*=(U rhs)
+{
+    for (std::size_t c = 0; c < N; ++c)
+    {
+        T* dst = values[c].data();
+        for (std::size_t i = 0; i < count; ++i)
+            dst[i] *= rhs;
+    }
+
+    return *this;
+}
+
+template<typename T, std::size_t N>
+inline VectorArray<T, N>& VectorArray<T, N>::operator*=(const VectorArray<T, N>& rhs)
+{
+    assert(count == rhs.count);
+
+    for (std::size_t c = 0; c < N; ++c)
+    {
+        T* dst = values[c].data();
+        const T* src = rhs.values[c].data();
+        for (std::size_t i = 0; i < count; ++i)
+            dst[i] *= src[i];
+    }
+
+    return *this;
+}
+
+template<typename T, std::size_t N>
+template<typename U>
+inline VectorArray<T, N>& VectorArray<T, N>::operator/=(U rhs)
+{
+    for (std::size_t c = 0; c < N; ++c)
+    {
+        T* dst = values[c].data();
+        for (std::size_t i = 0; i < count; ++i)
+            dst[i] /= rhs;
+    }
+
+    return *this;
+}
+
+template<typename T, std::size_t N>
+inline VectorArray<T, N>& VectorArray<T, N>::operator/=(const VectorArray<T, N>& rhs)
+{
+    assert(count == rhs.count);
+
+    for (std::size_t c = 0; c < N; ++c)
+    {
+        T* dst = values[c].data();
+        const T* src = rhs.values[c].data();
+        for (std::size_t i = 0; i < count; ++i)
+            dst[i] /= src[i];
+    }
+
+    return *this;
+}
+
+template<typename T, std::size_t N>
+inline bool VectorArray<T, N>::operator==(const VectorArray<T, N>& rhs) const
+{
+    if (count != rhs.count)
+        return false;
+
+    for (std::size_t c = 0; c < N; ++c)
+        if (values[c] != rhs.values[c])
+            return false;
+
+    return true;
+}
+
+template<typename T, std::size_t N>
+inline bool VectorArray<T, N>::operator!=(const VectorArray<T, N>& rhs) const
+{
+    return !(*this == rhs);
+}
+
+template<typename T, std::size_t N>
+inline VectorArray<T, N> operator-(VectorArray<T, N> rhs)
+{
+    return rhs *= -1;
+}
+
+template<typename T, std::size_t N>
+inline VectorArray<T, N> operator+(VectorArray<T, N> lhs, const VectorArray<T, N>& rhs)
+{
+    return lhs += rhs;
+}
+
+template<typename T, std::size_t N>
+inline VectorArray<T, N> operator-(VectorArray<T, N> lhs, const VectorArray<T, N>& rhs)
+{
+    return lhs -= rhs;
+}
+
+template<typename T, std::size_t N, typename U>
+inline VectorArray<T, N> operator*(VectorArray<T, N> lhs, U rhs)
+{
+    return lhs *= rhs;
+}
+
+template<typename T, std::size_t N, typename U>
+inline VectorArray<T, N> operator*(U lhs, VectorArray<T, N> rhs)
+{
+    return rhs *= lhs;
+}
+
+template<typename T, std::size_t N>
+inline VectorArray<T, N> operator*(VectorArray<T, N> lhs, const VectorArray<T, N>& rhs)
+{
+    return lhs *= rhs;
+}
+
+template<typename T, std::size_t N, typename U>
+inline VectorArray<T, N> operator/(VectorArray<T, N> lhs, U rhs)
+{
+    return lhs /= rhs;
+}
+
+template<typename T, std::size_t N>
+inline VectorArray<T, N> operator/(VectorArray<T, N> lhs, const VectorArray<T, N>& rhs)
+{
+    return lhs /= rhs;
+}
+
+template<typename T, std::size_t N>
+inline std::vector<T> dot(const VectorArray<T, N>& u, const VectorArray<T, N>& v)
+{
+    assert(u.size() == v.size());
+
+    std::size_t size = u.size();
+    std::vector<T> res(size, static_cast<T>(0));
+
+    T* dst = res.data();
+    for (std::size_t c = 0; c < N; ++c)
+    {
+        const T* a = u.data(c);
+        const T* b = v.data(c);
+        for (std::size_t i = 0; i < size; ++i)
+            dst[i] += a[i] * b[i];
+    }
+
+    return res;
+}
+
+template<typename T>
+inline VectorArray<T, 3> cross(const VectorArray<T, 3>& u, const VectorArray<T, 3>& v)
+{
+    assert(u.size() == v.size());
+
+    std::size_t size = u.size();
+    VectorArray<T, 3> res{size};
+
+    const T* ux = u.data(0); const T* uy = u.data(1); const T* uz = u.data(2);
+    const T* vx = v.data(0); const T* vy = v.data(1); const T* vz = v.data(2);
+    T* x = res.data(0); T* y = res.data(1); T* z = res.data(2);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        x[i] = uy[i] * vz[i] - uz[i] * vy[i];
+        y[i] = uz[i] * vx[i] - ux[i] * vz[i];
+        z[i] = ux[i] * vy[i] - uy[i] * vx[i];
+    }
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+inline std::vector<T> lengthSquared(const VectorArray<T, N>& v)
+{
+    return dot(v, v);
+}
+
+template<typename T, std::size_t N>
+inline std::vector<T> length(const VectorArray<T, N>& v)
+{
+    std::vector<T> res = lengthSquared(v);
+
+    for (std::size_t i = 0; i < res.size(); ++i)
+        res[i] = std::sqrt(res[i]);
+
+    return res;
+}
+
+template<typename T, std::size_t N>
+inline VectorArray<T, N> normalize(const VectorArray<T, N>& v)
+{
+    std::size_t size = v.size();
+    std::vector<T> inv = lengthSquared(v);
+
+    for (std::size_t i = 0; i < size; ++i)
+        inv[i] = static_cast<T>(1) / std::sqrt(inv[i]);
+
+    VectorArray<T, N> res{size};
+    for (std::size_t c = 0; c < N; ++c)
+    {
+        const T* src = v.data(c);
+        T* dst = res.data(c);
+        for (std::size_t i = 0; i < size; ++i)
+            dst[i] = src[i] * inv[i];
+    }
+
+    return res;
+}
+
+template<std::size_t... Indices, typename T, std::size_t N>
+inline VectorArray<T, sizeof...(Indices)> swizzle(const VectorArray<T, N>& v)
+{
+    const std::size_t indices[] = {detail::checkIndex<Indices, N>()...};
+
+    VectorArray<T, sizeof...(Indices)> res{v.size()};
+    for (std::size_t c = 0; c < sizeof...(Indices); ++c)
+        std::copy(v.data(indices[c]), v.data(indices[c]) + v.size(), res.data(c));
+
+    return res;
+}
+
+namespace detail {
+    template<std::size_t Index, std::size_t N>
+    constexpr std::size_t checkIndex()
+    {
+        static_assert(Index < N, "swizzle: Index out of range");
+
+        return Index;
+    }
+}
+
+}
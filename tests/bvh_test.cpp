@@ -0,0 +1,279 @@
+// MeshBVH queries against brute force over every triangle, for trees built on one and several threads (the parallel
+// build splices subtrees built separately) and for meshes too small to split
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <cgla/cgla.hpp>
+#include "test.hpp"
+
+namespace {
+
+constexpr std::size_t largeCount = 20000;
+constexpr std::size_t rayCount = 300;
+constexpr std::size_t boxCount = 100;
+
+template<typename T>
+using V3 = cgla::Vector<T, 3>;
+
+template<typename T>
+V3<T> randomVector(T min, T max)
+{
+    return V3<T>{test::random(min, max), test::random(min, max), test::random(min, max)};
+}
+
+template<typename T>
+cgla::AABB<T, 3> triangleBounds(const V3<T>* vertices, const cgla::Vector<unsigned int, 3>& tri)
+{
+    return cgla::merge(cgla::merge(cgla::AABB<T, 3>{vertices[tri[0]]}, vertices[tri[1]]), vertices[tri[2]]);
+}
+
+// small triangles scattered in a cube
+template<typename T>
+struct Mesh
+{
+    std::vector<V3<T>> vertices;
+    std::vector<cgla::Vector<unsigned int, 3>> triangles;
+
+    explicit Mesh(std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            V3<T> center = randomVector(static_cast<T>(-10), static_cast<T>(10));
+            unsigned int first = static_cast<unsigned int>(vertices.size());
+
+            for (std::size_t k = 0; k < 3; ++k)
+                vertices.push_back(center + randomVector(static_cast<T>(-0.5), static_cast<T>(0.5)));
+
+            triangles.push_back(cgla::Vector<unsigned int, 3>{first, first + 1, first + 2});
+        }
+    }
+};
+
+// every primitive is referenced by exactly one leaf reachable from the root, and every box holds its subtree
+template<typename T>
+void checkStructure(const Mesh<T>& mesh, const cgla::BVH<T>& bvh)
+{
+    using Node = typename cgla::BVH<T>::Node;
+
+    const std::vector<Node>& nodes = bvh.nodes();
+    const std::vector<std::uint32_t>& order = bvh.primitiveOrder();
+    std::vector<std::size_t> seen(mesh.triangles.size(), 0);
+    std::vector<std::size_t> visits(nodes.size(), 0);
+    std::vector<std::uint32_t> stack;
+
+    if (!nodes.empty())
+        stack.push_back(0);
+
+    while (!stack.empty())
+    {
+        std::uint32_t n = stack.back();
+        stack.pop_back();
+        ++visits[n];
+
+        for (std::size_t s = 0; s < cgla::BVH<T>::width; ++s)
+        {
+            if (nodes[n].child[s] == cgla::BVH<T>::emptySlot)
+                continue;
+
+            cgla::AABB<T, 3> box;
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+                box.min[c] = nodes[n].min[c][s];
+                box.max[c] = nodes[n].max[c][s];
+            }
+
+            if (nodes[n].count[s] == 0)
+            {
+                std::uint32_t child = nodes[n].child[s];
+                CGLA_CHECK(child > n && child < nodes.size());
+
+                if (child > n && child < nodes.size())
+                {
+                    for (std::size_t k = 0; k < cgla::BVH<T>::width; ++k)
+                        for (std::size_t c = 0; c < 3; ++c)
+                            if (nodes[child].child[k] != cgla::BVH<T>::emptySlot)
+                                CGLA_CHECK(box.min[c] <= nodes[child].min[c][k] && nodes[child].max[c][k] <= box.max[c]);
+
+                    stack.push_back(child);
+                }
+            }
+            else
+            {
+                CGLA_CHECK(nodes[n].count[s] <= order.size() && nodes[n].child[s] <= order.size() - nodes[n].count[s]);
+
+                for (std::uint32_t k = nodes[n].child[s]; k < nodes[n].child[s] + nodes[n].count[s] && k < order.size(); ++k)
+                {
+                    ++seen[order[k]];
+                    cgla::AABB<T, 3> bounds = triangleBounds(mesh.vertices.data(), mesh.triangles[order[k]]);
+                    CGLA_CHECK(cgla::contains(box, bounds));
+                }
+            }
+        }
+    }
+
+    CGLA_CHECK(std::all_of(seen.begin(), seen.end(), [](std::size_t c) { return c == 1; }));
+    CGLA_CHECK(std::all_of(visits.begin(), visits.end(), [](std::size_t c) { return c == 1; }));
+}
+
+// random triangles are never hit at the same distance, so the closest hit is unique
+template<typename T>
+bool bruteClosest(const Mesh<T>& mesh, const cgla::Ray<T>& ray, cgla::MeshHit<T>& hit)
+{
+    bool found = false;
+
+    for (std::size_t i = 0; i < mesh.triangles.size(); ++i)
+    {
+        const cgla::Vector<unsigned int, 3>& tri = mesh.triangles[i];
+        T t, u, v;
+
+        if (cgla::intersectTriangle(ray, mesh.vertices[tri[0]], mesh.vertices[tri[1]], mesh.vertices[tri[2]], t, u, v) && (!found || t < hit.t))
+        {
+            hit = {t, u, v, i};
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+template<typename T>
+void checkQueries(const Mesh<T>& mesh, const cgla::MeshBVH<T>& bvh)
+{
+    for (std::size_t r = 0; r < rayCount; ++r)
+    {
+        // rays from outside the cube towards a point inside it, some of them cut short
+        V3<T> origin = randomVector(static_cast<T>(-15), static_cast<T>(15));
+        V3<T> target = randomVector(static_cast<T>(-10), static_cast<T>(10));
+        cgla::Ray<T> ray{origin, target - origin};
+        if (r % 4 == 0)
+            ray.tMax = test::random(static_cast<T>(0), static_cast<T>(1));
+
+        cgla::MeshHit<T> hit{}, reference{};
+        bool found = bvh.closestHit(ray, hit);
+        bool expected = bruteClosest(mesh, ray, reference);
+
+        CGLA_CHECK(found == expected);
+        CGLA_CHECK(bvh.anyHit(ray) == expected);
+
+        if (found && expected)
+            CGLA_CHECK(hit.t == reference.t && hit.u == reference.u && hit.v == reference.v && hit.triangle == reference.triangle);
+    }
+
+    for (std::size_t b = 0; b < boxCount; ++b)
+    {
+        V3<T> center = randomVector(static_cast<T>(-12), static_cast<T>(12));
+        V3<T> half = randomVector(static_cast<T>(0), static_cast<T>(3));
+        cgla::AABB<T, 3> box{center - half, center + half};
+
+        std::vector<std::size_t> result, reference;
+        bvh.overlap(box, result);
+
+        for (std::size_t i = 0; i < mesh.triangles.size(); ++i)
+            if (cgla::overlaps(triangleBounds(mesh.vertices.data(), mesh.triangles[i]), box))
+                reference.push_back(i);
+
+        std::sort(result.begin(), result.end());
+        CGLA_CHECK(result == reference);
+    }
+}
+
+template<typename T>
+void testMesh(std::size_t count, std::size_t threadCount)
+{
+    Mesh<T> mesh{count};
+    cgla::MeshBVH<T> bvh{mesh.vertices.data(), mesh.triangles.data(), count, threadCount};
+
+    CGLA_CHECK(bvh.hierarchy().size() == count);
+    checkStructure(mesh, bvh.hierarchy());
+    checkQueries(mesh, bvh);
+}
+
+// the nodes of a and b hold the same boxes and leaves, wherever the subtrees were stored
+template<typename T>
+bool sameTree(const cgla::BVH<T>& a, std::uint32_t na, const cgla::BVH<T>& b, std::uint32_t nb)
+{
+    const typename cgla::BVH<T>::Node& x = a.nodes()[na];
+    const typename cgla::BVH<T>::Node& y = b.nodes()[nb];
+
+    for (std::size_t s = 0; s < cgla::BVH<T>::width; ++s)
+    {
+        for (std::size_t c = 0; c < 3; ++c)
+            if (x.min[c][s] != y.min[c][s] || x.max[c][s] != y.max[c][s])
+                return false;
+
+        if (x.count[s] != y.count[s] || (x.child[s] == cgla::BVH<T>::emptySlot) != (y.child[s] == cgla::BVH<T>::emptySlot))
+            return false;
+
+        if (x.child[s] == cgla::BVH<T>::emptySlot)
+            continue;
+
+        if (x.count[s] != 0 ? x.child[s] != y.child[s] : !sameTree(a, x.child[s], b, y.child[s]))
+            return false;
+    }
+
+    return true;
+}
+
+// the subtrees built as tasks are appended after the others, with their child indices rebased : the parallel build
+// partitions the primitives like the serial one and gives the same tree
+template<typename T>
+void testParallelBuild()
+{
+    Mesh<T> mesh{largeCount};
+    cgla::BVH<T> serial = cgla::MeshBVH<T>{mesh.vertices.data(), mesh.triangles.data(), largeCount, 1}.hierarchy();
+
+    for (std::size_t threadCount : {2, 3, 8})
+    {
+        cgla::BVH<T> parallel = cgla::MeshBVH<T>{mesh.vertices.data(), mesh.triangles.data(), largeCount, threadCount}.hierarchy();
+
+        CGLA_CHECK(parallel.primitiveOrder() == serial.primitiveOrder());
+        CGLA_CHECK(parallel.nodes().size() == serial.nodes().size() && sameTree(parallel, 0, serial, 0));
+    }
+}
+
+template<typename T>
+void testEmpty()
+{
+    cgla::MeshBVH<T> bvh{nullptr, nullptr, 0};
+    cgla::MeshHit<T> hit{};
+    std::vector<std::size_t> result;
+    cgla::Ray<T> ray{V3<T>{}, V3<T>{static_cast<T>(0), static_cast<T>(0), static_cast<T>(1)}};
+
+    CGLA_CHECK(bvh.hierarchy().size() == 0 && bvh.hierarchy().nodes().empty());
+    CGLA_CHECK(!bvh.closestHit(ray, hit) && !bvh.anyHit(ray));
+
+    bvh.overlap(cgla::AABB<T, 3>{V3<T>{static_cast<T>(-1)}, V3<T>{static_cast<T>(1)}}, result);
+    CGLA_CHECK(result.empty());
+
+    cgla::MeshBVH<T> defaulted;
+    CGLA_CHECK(!defaulted.closestHit(ray, hit) && !defaulted.anyHit(ray));
+}
+
+template<typename T>
+void testAll()
+{
+    testEmpty<T>();
+
+    // a single leaf under the root
+    for (std::size_t count : {1, 2, 3, 4})
+    {
+        testMesh<T>(count, 1);
+        testMesh<T>(count, 4);
+    }
+
+    testMesh<T>(3000, 1);
+    testMesh<T>(largeCount, 1);
+    testMesh<T>(largeCount, 8);
+    testParallelBuild<T>();
+}
+
+}
+
+int main()
+{
+    testAll<float>();
+    testAll<double>();
+
+    return test::report("bvh_test");
+}
@@ -0,0 +1,91 @@
+// constexpr construction and arithmetic, checked at compile time (built with and without CGLA_SSE)
+#include <cgla/cgla.hpp>
+#include "test.hpp"
+
+namespace {
+
+using V3 = cgla::Vector<int, 3>;
+using M2 = cgla::Matrix<double, 2, 2>;
+using M4 = cgla::Matrix<float, 4, 4>;
+using V4 = cgla::Vector<float, 4>;
+
+// vectors, results of the arithmetic operators are converted so that they also compare with CGLA_EXPRESSION_TEMPLATES
+constexpr V3 u{1, 2, 3};
+constexpr V3 v{4, 5, 6};
+
+static_assert(V3{}[0] == 0 && V3{}[2] == 0, "default constructor");
+static_assert(V3{7} == V3{7, 7, 7}, "scalar constructor");
+static_assert(cgla::Vector<int, 4>{u, 4} == cgla::Vector<int, 4>{1, 2, 3, 4}, "concatenating constructor");
+static_assert(cgla::Vector<double, 3>{u}[1] == 2.0, "converting constructor");
+static_assert(u.x() == 1 && u.y() == 2 && u.z() == 3, "accessors");
+static_assert(V3(u + v) == V3{5, 7, 9}, "addition");
+static_assert(V3(v - u) == V3{3, 3, 3}, "subtraction");
+static_assert(V3(-u) == V3{-1, -2, -3}, "negation");
+static_assert(V3(u * 2) == V3{2, 4, 6} && V3(2 * u) == V3{2, 4, 6}, "scaling");
+static_assert(V3(u * v) == V3{4, 10, 18}, "component-wise product");
+static_assert(V3(v / 2) == V3{2, 2, 3}, "division");
+static_assert(cgla::dot(u, v) == 32, "dot");
+static_assert(cgla::cross(u, v) == V3{-3, 6, -3}, "cross");
+static_assert(cgla::lengthSquared(u) == 14, "lengthSquared");
+static_assert(cgla::distanceSquared(u, v) == 27, "distanceSquared");
+static_assert(cgla::min(u, V3{2}) == V3{1, 2, 2} && cgla::max(u, V3{2}) == V3{2, 2, 3}, "min and max");
+static_assert(u < v && u != v, "comparisons");
+
+constexpr V3 accumulate()
+{
+    V3 res{1, 1, 1};
+    res += u;
+    res -= V3{1, 0, 0};
+    res *= 3;
+    return res;
+}
+
+static_assert(accumulate() == V3{3, 9, 12}, "compound assignment");
+
+// matrices
+constexpr M2 a{1.0, 2.0, 3.0, 4.0};
+constexpr M2 b{5.0, 6.0, 7.0, 8.0};
+
+static_assert(M2{}[0] == 0.0 && M2{}[3] == 0.0, "default constructor");
+static_assert(M2{1.0} == M2{1.0, 0.0, 0.0, 1.0}, "identity constructor");
+static_assert(a(0, 1) == 3.0 && a(1, 0) == 2.0, "column-major accessors");
+static_assert(M2(a + b) == M2{6.0, 8.0, 10.0, 12.0}, "addition");
+static_assert(M2(b - a) == M2{4.0, 4.0, 4.0, 4.0}, "subtraction");
+static_assert(M2(a * 2.0) == M2{2.0, 4.0, 6.0, 8.0}, "scaling");
+static_assert(a * b == M2{23.0, 34.0, 31.0, 46.0}, "product");
+static_assert(a * cgla::Vector<double, 2>{1.0, 1.0} == cgla::Vector<double, 2>{4.0, 6.0}, "matrix-vector product");
+static_assert(cgla::transpose(a) == M2{1.0, 3.0, 2.0, 4.0}, "transpose");
+static_assert(cgla::matrixCompMult(a, b) == M2{5.0, 12.0, 21.0, 32.0}, "matrixCompMult");
+static_assert(cgla::outerProduct(cgla::Vector<double, 2>{1.0, 2.0}, cgla::Vector<double, 2>{3.0, 4.0}) == M2{3.0, 6.0, 4.0, 8.0}, "outerProduct");
+
+// float 4x4, which has SSE specializations when CGLA_SSE is defined
+#if !defined(CGLA_SSE) || defined(CGLA_CONSTANT_EVALUATED)
+constexpr M4 t = cgla::translate(cgla::Vector<float, 3>{1.f, 2.f, 3.f});
+constexpr M4 s = cgla::scale(2.f);
+
+constexpr M4 accumulate4()
+{
+    M4 res{1.f};
+    res += s;
+    res -= M4{1.f};
+    res *= 0.5f;
+    return res;
+}
+
+static_assert((t * s)(0, 3) == 1.f && (t * s)(0, 0) == 2.f && (s * t)(0, 3) == 2.f, "product");
+static_assert(t * V4{0.f, 0.f, 0.f, 1.f} == V4{1.f, 2.f, 3.f, 1.f}, "matrix-vector product");
+static_assert(cgla::transpose(t)(3, 1) == 2.f && cgla::transpose(t)(1, 3) == 0.f, "transpose");
+static_assert(accumulate4() == cgla::scale(1.f) - M4{0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.5f}, "compound assignment");
+static_assert(cgla::orthographic(-1.f, 1.f, -1.f, 1.f, -1.f, 1.f) * V4{1.f, 1.f, 1.f, 1.f} == V4{1.f, 1.f, -1.f, 1.f}, "orthographic");
+#endif
+
+}
+
+int main()
+{
+    // the static_asserts above do the checking, this only keeps the results usable at run time as well
+    CGLA_CHECK(accumulate() == V3(3, 9, 12));
+    CGLA_CHECK(a * b == M2(23.0, 34.0, 31.0, 46.0));
+
+    return test::report("constexpr_test");
+}
@@ -0,0 +1,156 @@
+// cullSpheres and cullBoxes against Frustum::intersectsSphere and intersectsBox, bit for bit, with counts that leave a
+// partial mask word (built with and without CGLA_SSE)
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <cgla/cgla.hpp>
+#include "test.hpp"
+
+namespace {
+
+template<typename T>
+using V3 = cgla::Vector<T, 3>;
+
+template<typename T>
+V3<T> randomVector(T min, T max)
+{
+    return V3<T>{test::random(min, max), test::random(min, max), test::random(min, max)};
+}
+
+template<typename T>
+cgla::Frustum<T> randomFrustum()
+{
+    V3<T> eye = randomVector(static_cast<T>(-5), static_cast<T>(5));
+    V3<T> target = randomVector(static_cast<T>(-1), static_cast<T>(1));
+    cgla::Matrix<T, 4, 4> projection = cgla::perspective(test::random(static_cast<T>(0.5), static_cast<T>(1.5)), static_cast<T>(1.5), static_cast<T>(0.1), static_cast<T>(20));
+
+    return cgla::Frustum<T>{projection * cgla::lookAt(eye, target, V3<T>{static_cast<T>(0), static_cast<T>(1), static_cast<T>(0)})};
+}
+
+bool bit(const std::vector<std::uint32_t>& mask, std::size_t i)
+{
+    return (mask[i / 32] >> (i % 32)) & 1u;
+}
+
+// the bits past count in the last word are cleared
+void checkPadding(const std::vector<std::uint32_t>& mask, std::size_t count)
+{
+    if (count % 32 != 0)
+        CGLA_CHECK((mask.back() >> (count % 32)) == 0u);
+}
+
+template<typename T>
+void checkSpheres(const cgla::Frustum<T>& frustum, const std::vector<V3<T>>& centers, const std::vector<T>& radii)
+{
+    std::size_t count = centers.size();
+    std::vector<std::uint32_t> mask(cgla::cullMaskSize(count), 0xAAAAAAAAu);
+    cgla::cullSpheres(frustum, cgla::VectorArray<T, 3>{centers}, radii.data(), mask.data());
+
+    for (std::size_t i = 0; i < count; ++i)
+        CGLA_CHECK(bit(mask, i) == frustum.intersectsSphere(centers[i], radii[i]));
+
+    checkPadding(mask, count);
+}
+
+template<typename T>
+void checkBoxes(const cgla::Frustum<T>& frustum, const std::vector<V3<T>>& mins, const std::vector<V3<T>>& maxs)
+{
+    std::size_t count = mins.size();
+    std::vector<std::uint32_t> mask(cgla::cullMaskSize(count), 0xAAAAAAAAu);
+    cgla::cullBoxes(frustum, cgla::VectorArray<T, 3>{mins}, cgla::VectorArray<T, 3>{maxs}, mask.data());
+
+    for (std::size_t i = 0; i < count; ++i)
+        CGLA_CHECK(bit(mask, i) == frustum.intersectsBox(mins[i], maxs[i]));
+
+    checkPadding(mask, count);
+}
+
+// objects around the frustum, so that every plane rejects some of them
+template<typename T>
+void testRandom(std::size_t count)
+{
+    for (std::size_t f = 0; f < 20; ++f)
+    {
+        cgla::Frustum<T> frustum = randomFrustum<T>();
+        std::vector<V3<T>> centers(count), mins(count), maxs(count);
+        std::vector<T> radii(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            centers[i] = randomVector(static_cast<T>(-25), static_cast<T>(25));
+            radii[i] = test::random(static_cast<T>(0), static_cast<T>(4));
+            V3<T> half = randomVector(static_cast<T>(0), static_cast<T>(4));
+            mins[i] = centers[i] - half;
+            maxs[i] = centers[i] + half;
+        }
+
+        checkSpheres(frustum, centers, radii);
+        checkBoxes(frustum, mins, maxs);
+    }
+}
+
+// the default frustum is the [-1, 1] cube : objects touching a face from outside are visible, the tests are inclusive
+template<typename T>
+void testTouching()
+{
+    cgla::Frustum<T> frustum;
+    std::vector<V3<T>> centers, mins, maxs;
+    std::vector<T> radii;
+
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        for (T side : {static_cast<T>(-1), static_cast<T>(1)})
+        {
+            for (T gap : {static_cast<T>(0), static_cast<T>(0.25)})
+            {
+                V3<T> c{};
+                c[axis] = side * (static_cast<T>(2) + gap);
+                centers.push_back(c);
+                radii.push_back(static_cast<T>(1));
+
+                V3<T> lo{static_cast<T>(-0.5)}, hi{static_cast<T>(0.5)};
+                lo[axis] = side < static_cast<T>(0) ? side * (static_cast<T>(3) + gap) : side * (static_cast<T>(1) + gap);
+                hi[axis] = side < static_cast<T>(0) ? side * (static_cast<T>(1) + gap) : side * (static_cast<T>(3) + gap);
+                mins.push_back(lo);
+                maxs.push_back(hi);
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < centers.size(); ++i)
+    {
+        CGLA_CHECK(frustum.intersectsSphere(centers[i], radii[i]) == (i % 2 == 0));
+        CGLA_CHECK(frustum.intersectsBox(mins[i], maxs[i]) == (i % 2 == 0));
+    }
+
+    // past 32 objects so that the SSE path sees them too
+    for (std::size_t i = 0; i < 24; ++i)
+    {
+        centers.push_back(centers[i]);
+        radii.push_back(radii[i]);
+        mins.push_back(mins[i]);
+        maxs.push_back(maxs[i]);
+    }
+
+    checkSpheres(frustum, centers, radii);
+    checkBoxes(frustum, mins, maxs);
+}
+
+template<typename T>
+void testAll()
+{
+    for (std::size_t count : {0, 1, 31, 32, 33, 100, 1000})
+        testRandom<T>(count);
+
+    testTouching<T>();
+}
+
+}
+
+int main()
+{
+    testAll<float>();
+    testAll<double>();
+
+    return test::report("culling_test");
+}
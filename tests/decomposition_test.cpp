@@ -0,0 +1,279 @@
+// svd, symmetricEigen and polarDecomposition of 3x3 matrices : reconstruction and orthogonality within the documented
+// accuracy, including repeated singular values and eigenvalues, rank-deficient and reflecting inputs
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include <cgla/cgla.hpp>
+#include "test.hpp"
+
+namespace {
+
+constexpr std::size_t sampleCount = 200;
+
+// relative to the largest entry of the decomposed matrix, a small multiple of the accuracy given in the README
+template<typename T> double accuracy(bool rankDeficient);
+template<> double accuracy<float>(bool rankDeficient) { return rankDeficient ? 2e-5 : 1e-5; }
+template<> double accuracy<double>(bool) { return 1e-13; }
+
+template<typename T>
+using Mat = cgla::Matrix<T, 3, 3>;
+
+template<typename T>
+using V = cgla::Vector<T, 3>;
+
+template<typename T>
+V<T> vec(double x, double y, double z)
+{
+    return V<T>{static_cast<T>(x), static_cast<T>(y), static_cast<T>(z)};
+}
+
+template<typename T>
+Mat<T> randomMatrix()
+{
+    Mat<T> res{cgla::uninitialized};
+    test::randomize(res, 9, static_cast<T>(-1), static_cast<T>(1));
+    return res;
+}
+
+template<typename T>
+Mat<T> randomRotation()
+{
+    Mat<double> q = cgla::QR<double, 3, 3>{Mat<double>{randomMatrix<T>()}}.matrixQ();
+    if (cgla::determinant(q) < 0.0)
+        for (std::size_t i = 0; i < 3; ++i)
+            q(i, 0) = -q(i, 0);
+
+    return Mat<T>{q};
+}
+
+template<typename T>
+Mat<T> diagonal(const V<T>& d)
+{
+    Mat<T> res;
+    for (std::size_t i = 0; i < 3; ++i)
+        res(i, i) = d[i];
+    return res;
+}
+
+// u * diag(sigma) * transpose(v), computed in double
+template<typename T>
+Mat<double> compose(const Mat<T>& u, const V<T>& sigma, const Mat<T>& v)
+{
+    return Mat<double>{u} * diagonal(V<double>{sigma}) * cgla::transpose(Mat<double>{v});
+}
+
+template<typename T>
+bool isRotation(const Mat<T>& r, double tolerance)
+{
+    Mat<double> m{r};
+    return test::maxDifference(Mat<double>(cgla::transpose(m) * m), Mat<double>{1.0}, 9) <= tolerance && cgla::determinant(m) > 0.0;
+}
+
+template<typename T>
+void checkSVD(const Mat<T>& a, bool rankDeficient)
+{
+    Mat<T> u, v;
+    V<T> sigma;
+    cgla::svd(a, u, sigma, v);
+
+    double scale = std::fmax(test::maxAbs(a, 9), 1e-30);
+    double tolerance = accuracy<T>(rankDeficient);
+
+    CGLA_CHECK(test::maxDifference(compose(u, sigma, v), Mat<double>{a}, 9) <= tolerance * scale);
+    CGLA_CHECK(isRotation(u, tolerance) && isRotation(v, tolerance));
+    CGLA_CHECK(sigma[0] >= static_cast<T>(0) && sigma[1] >= static_cast<T>(0));
+
+    // repeated singular values may come out in either order within the accuracy
+    CGLA_CHECK(sigma[1] - sigma[0] <= tolerance * scale && std::fabs(sigma[2]) - sigma[1] <= tolerance * scale);
+
+    // the sign of sigma[2] follows the orientation of a, unless a is (close to) singular
+    double det = cgla::determinant(Mat<double>{a});
+    if (std::fabs(det) > tolerance * scale * scale * scale)
+        CGLA_CHECK((sigma[2] < static_cast<T>(0)) == (det < 0.0));
+}
+
+// a = u * diag(sigma) * transpose(v) built from random rotations, with the given singular values
+template<typename T>
+void testSingularValues(const V<T>& expected, bool rankDeficient)
+{
+    for (std::size_t s = 0; s < sampleCount; ++s)
+    {
+        Mat<T> a{compose(randomRotation<T>(), expected, randomRotation<T>())};
+        checkSVD(a, rankDeficient);
+
+        Mat<T> u, v;
+        V<T> sigma;
+        cgla::svd(a, u, sigma, v);
+        CGLA_CHECK(test::maxDifference(sigma, expected, 3) <= accuracy<T>(rankDeficient) * std::fabs(static_cast<double>(expected[0])) * 4.0);
+    }
+}
+
+template<typename T>
+void testSVD()
+{
+    for (std::size_t s = 0; s < sampleCount; ++s)
+        checkSVD(randomMatrix<T>(), false);
+
+    testSingularValues<T>(vec<T>(2, 2, 1), false);
+    testSingularValues<T>(vec<T>(3, 1, 1), false);
+    testSingularValues<T>(vec<T>(1, 1, 1), false);
+    testSingularValues<T>(vec<T>(2, 1, -1), false); // reflection
+    testSingularValues<T>(vec<T>(2, 1, 0), true);
+    testSingularValues<T>(vec<T>(1, 1, 0), true);
+    testSingularValues<T>(vec<T>(1, 0, 0), true);
+
+    // exactly rank deficient entries : a repeated column and a zero column
+    Mat<T> a = randomMatrix<T>();
+    for (std::size_t i = 0; i < 3; ++i)
+        a(i, 2) = a(i, 0);
+    checkSVD(a, true);
+    for (std::size_t i = 0; i < 3; ++i)
+        a(i, 1) = static_cast<T>(0);
+    checkSVD(a, true);
+
+    Mat<T> u, v;
+    V<T> sigma;
+    cgla::svd(Mat<T>{}, u, sigma, v);
+    CGLA_CHECK(sigma == V<T>{} && isRotation(u, accuracy<T>(true)) && isRotation(v, accuracy<T>(true)));
+}
+
+template<typename T>
+void checkEigen(const Mat<T>& s, bool rankDeficient)
+{
+    Mat<T> vectors;
+    V<T> values;
+    cgla::symmetricEigen(s, vectors, values);
+
+    double scale = std::fmax(test::maxAbs(s, 9), 1e-30);
+    double tolerance = accuracy<T>(rankDeficient);
+
+    CGLA_CHECK(test::maxDifference(compose(vectors, values, vectors), Mat<double>{s}, 9) <= tolerance * scale);
+    CGLA_CHECK(isRotation(vectors, tolerance));
+    CGLA_CHECK(values[1] - values[0] <= tolerance * scale && values[2] - values[1] <= tolerance * scale);
+}
+
+// q * diag(values) * transpose(q) with the given eigenvalues
+template<typename T>
+void testEigenvalues(const V<T>& expected, bool rankDeficient)
+{
+    for (std::size_t s = 0; s < sampleCount; ++s)
+    {
+        Mat<T> q = randomRotation<T>();
+        Mat<T> sym{compose(q, expected, q)};
+        checkEigen(sym, rankDeficient);
+
+        Mat<T> vectors;
+        V<T> values;
+        cgla::symmetricEigen(sym, vectors, values);
+        CGLA_CHECK(test::maxDifference(values, expected, 3) <= accuracy<T>(rankDeficient) * test::maxAbs(expected, 3) * 4.0);
+    }
+}
+
+template<typename T>
+void testEigen()
+{
+    for (std::size_t s = 0; s < sampleCount; ++s)
+    {
+        Mat<T> a = randomMatrix<T>();
+        checkEigen(Mat<T>(a + cgla::transpose(a)), false);
+    }
+
+    testEigenvalues<T>(vec<T>(2, 2, -1), false);
+    testEigenvalues<T>(vec<T>(1, -3, -3), false);
+    testEigenvalues<T>(vec<T>(1, 1, 1), false);
+    testEigenvalues<T>(vec<T>(3, 0, 0), true);
+    testEigenvalues<T>(vec<T>(2, 1, 0), true);
+}
+
+template<typename T>
+void checkPolar(const Mat<T>& a, bool rankDeficient)
+{
+    Mat<T> r, s;
+    cgla::polarDecomposition(a, r, s);
+
+    double scale = std::fmax(test::maxAbs(a, 9), 1e-30);
+    double tolerance = accuracy<T>(rankDeficient);
+
+    CGLA_CHECK(test::maxDifference(Mat<double>(Mat<double>{r} * Mat<double>{s}), Mat<double>{a}, 9) <= tolerance * scale);
+    CGLA_CHECK(isRotation(r, tolerance));
+    CGLA_CHECK(test::maxDifference(s, cgla::transpose(s), 9) <= tolerance * scale);
+
+    // s is positive semidefinite unless a reflects
+    if (cgla::determinant(Mat<double>{a}) >= 0.0)
+    {
+        Mat<T> vectors;
+        V<T> values;
+        cgla::symmetricEigen(s, vectors, values);
+        CGLA_CHECK(static_cast<double>(values[2]) >= -tolerance * scale);
+    }
+}
+
+template<typename T>
+void testPolar()
+{
+    for (std::size_t s = 0; s < sampleCount; ++s)
+    {
+        checkPolar(randomMatrix<T>(), false);
+        checkPolar(Mat<T>{compose(randomRotation<T>(), vec<T>(2, 2, 1), randomRotation<T>())}, false);
+        checkPolar(Mat<T>{compose(randomRotation<T>(), vec<T>(1, 1, 0), randomRotation<T>())}, true);
+
+        // a pure rotation is its own rotational part, with s the identity
+        Mat<T> rotation = randomRotation<T>();
+        Mat<T> r, sym;
+        cgla::polarDecomposition(rotation, r, sym);
+        CGLA_CHECK(test::maxDifference(r, rotation, 9) <= accuracy<T>(false) * 4.0);
+        CGLA_CHECK(test::maxDifference(sym, Mat<T>{static_cast<T>(1)}, 9) <= accuracy<T>(false) * 4.0);
+    }
+}
+
+// the batched overloads meet the same bounds, over a count that is not a multiple of the lane count
+template<typename T>
+void testBatches()
+{
+    constexpr std::size_t count = 37;
+    std::vector<Mat<T>> mats(count), u(count), v(count), vectors(count), r(count), s(count);
+    std::vector<V<T>> sigma(count), values(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+        mats[i] = (i % 3 == 0) ? Mat<T>{compose(randomRotation<T>(), vec<T>(2, 2, 0), randomRotation<T>())} : randomMatrix<T>();
+
+    cgla::svd(mats.data(), u.data(), sigma.data(), v.data(), count);
+    cgla::polarDecomposition(mats.data(), r.data(), s.data(), count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        double scale = test::maxAbs(mats[i], 9);
+        double tolerance = accuracy<T>(true);
+
+        CGLA_CHECK(test::maxDifference(compose(u[i], sigma[i], v[i]), Mat<double>{mats[i]}, 9) <= tolerance * scale);
+        CGLA_CHECK(isRotation(u[i], tolerance) && isRotation(v[i], tolerance));
+        CGLA_CHECK(test::maxDifference(Mat<double>(Mat<double>{r[i]} * Mat<double>{s[i]}), Mat<double>{mats[i]}, 9) <= tolerance * scale);
+        CGLA_CHECK(isRotation(r[i], tolerance));
+
+        mats[i] = mats[i] + cgla::transpose(mats[i]);
+    }
+
+    cgla::symmetricEigen(mats.data(), vectors.data(), values.data(), count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        CGLA_CHECK(test::maxDifference(compose(vectors[i], values[i], vectors[i]), Mat<double>{mats[i]}, 9) <= accuracy<T>(true) * test::maxAbs(mats[i], 9));
+        CGLA_CHECK(isRotation(vectors[i], accuracy<T>(true)));
+    }
+}
+
+}
+
+int main()
+{
+    testSVD<float>();
+    testSVD<double>();
+    testEigen<float>();
+    testEigen<double>();
+    testPolar<float>();
+    testPolar<double>();
+    testBatches<float>();
+    testBatches<double>();
+
+    return test::report("decomposition_test");
+}
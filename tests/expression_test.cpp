@@ -0,0 +1,114 @@
+// with CGLA_EXPRESSION_TEMPLATES, the free functions taking expressions give the results of their evaluated arguments
+#include <cstddef>
+#include <cgla/cgla.hpp>
+#include "test.hpp"
+
+#ifndef CGLA_EXPRESSION_TEMPLATES
+#error "expression_test must be built with CGLA_EXPRESSION_TEMPLATES"
+#endif
+
+namespace {
+
+using V2 = cgla::Vector<double, 2>;
+using V3 = cgla::Vector<double, 3>;
+using M3 = cgla::Matrix<double, 3, 3>;
+using M4 = cgla::Matrix<double, 4, 4>;
+using Q = cgla::Quaternion<double>;
+
+constexpr std::size_t sampleCount = 100;
+
+V3 randomVector()
+{
+    V3 res{cgla::uninitialized};
+    test::randomize(res, 3, -2.0, 2.0);
+    return res;
+}
+
+template<typename Mat>
+Mat randomMatrix()
+{
+    Mat res{cgla::uninitialized};
+    test::randomize(res, sizeof(Mat) / sizeof(double), -2.0, 2.0);
+    return res;
+}
+
+// the references take evaluated copies of the expression arguments
+void testVector()
+{
+    for (std::size_t s = 0; s < sampleCount; ++s)
+    {
+        V3 a = randomVector(), b = randomVector(), c = randomVector();
+        V3 sum = a + b, difference = a - b;
+
+        CGLA_CHECK(cgla::dot(a + b, c) == cgla::dot(sum, c) && cgla::dot(c, a + b) == cgla::dot(c, sum) && cgla::dot(a + b, a - b) == cgla::dot(sum, difference));
+        CGLA_CHECK(cgla::cross(a + b, c) == cgla::cross(sum, c) && cgla::cross(c, a - b) == cgla::cross(c, difference));
+        CGLA_CHECK(cgla::lengthSquared(a - b) == cgla::lengthSquared(difference) && cgla::length(a - b) == cgla::length(difference));
+        CGLA_CHECK(cgla::distanceSquared(a + b, c) == cgla::distanceSquared(sum, c) && cgla::distance(c, a - b) == cgla::distance(c, difference));
+        CGLA_CHECK(cgla::normalize(a - b) == cgla::normalize(difference));
+        CGLA_CHECK(cgla::min(a + b, c) == cgla::min(sum, c) && cgla::max(c, a - b) == cgla::max(c, difference));
+        CGLA_CHECK(cgla::swizzle<2, 0>(a + b) == cgla::swizzle<2, 0>(sum) && cgla::xy(a + b) == cgla::xy(sum) && cgla::xyz(a * 2.0) == cgla::xyz(V3(a * 2.0)));
+    }
+}
+
+void testMatrix()
+{
+    for (std::size_t s = 0; s < sampleCount; ++s)
+    {
+        M4 a = randomMatrix<M4>(), b = randomMatrix<M4>();
+        M4 sum = a + b, scaled = a * 0.5;
+        M3 c = randomMatrix<M3>();
+        V3 u = randomVector(), v = randomVector();
+
+        CGLA_CHECK(cgla::transpose(a + b) == cgla::transpose(sum));
+        CGLA_CHECK(cgla::determinant(a + b) == cgla::determinant(sum) && cgla::determinant(c * 2.0) == cgla::determinant(M3(c * 2.0)));
+        CGLA_CHECK(cgla::inverse(a + b) == cgla::inverse(sum));
+
+        M4 res, reference;
+        CGLA_CHECK(cgla::tryInverse(a * 0.5, res) == cgla::tryInverse(scaled, reference) && res == reference);
+        CGLA_CHECK(cgla::affineInverse(a * 0.5) == cgla::affineInverse(scaled) && cgla::rigidInverse(a * 0.5) == cgla::rigidInverse(scaled));
+        CGLA_CHECK(cgla::matrixCompMult(a + b, a) == cgla::matrixCompMult(sum, a) && cgla::matrixCompMult(a, a + b) == cgla::matrixCompMult(a, sum));
+        CGLA_CHECK(cgla::outerProduct(u + v, V2{1.0, -2.0}) == cgla::outerProduct(V3(u + v), V2{1.0, -2.0}));
+    }
+}
+
+void testTransform()
+{
+    for (std::size_t s = 0; s < sampleCount; ++s)
+    {
+        V3 a = randomVector(), b = randomVector();
+        V3 sum = a + b, difference = a - b;
+        M4 m = cgla::translate(a) * cgla::rotate(0.5, b) * cgla::scale(V3{2.0, 3.0, 0.5});
+        M4 scaled = m * 2.0;
+        Q q = cgla::angleAxis(0.3, a - b);
+
+        CGLA_CHECK(q == cgla::angleAxis(0.3, difference) && cgla::rotate(q, a + b) == cgla::rotate(q, sum));
+        CGLA_CHECK(cgla::translate(a + b) == cgla::translate(sum) && cgla::translate(m * 2.0, a - b) == cgla::translate(scaled, difference));
+        CGLA_CHECK(cgla::scale(a + b) == cgla::scale(sum) && cgla::scale(m * 2.0, a - b) == cgla::scale(scaled, difference) && cgla::scale(m * 2.0, 3.0) == cgla::scale(scaled, 3.0));
+        CGLA_CHECK(cgla::rotateX(m * 2.0, 0.5) == cgla::rotateX(scaled, 0.5) && cgla::rotateY(m * 2.0, 0.5) == cgla::rotateY(scaled, 0.5) && cgla::rotateZ(m * 2.0, 0.5) == cgla::rotateZ(scaled, 0.5));
+        CGLA_CHECK(cgla::rotate(0.5, a - b) == cgla::rotate(0.5, difference) && cgla::rotate(m * 2.0, 0.5, a - b) == cgla::rotate(scaled, 0.5, difference));
+        CGLA_CHECK(cgla::composeTRS(a + b, q, a - b) == cgla::composeTRS(sum, q, difference));
+        CGLA_CHECK(cgla::composeTRS(a + b, q, a - b, b * 0.1) == cgla::composeTRS(sum, q, difference, V3(b * 0.1)));
+        CGLA_CHECK(cgla::lookAt(a + b, a - b, V3{0.0, 0.0, 1.0}) == cgla::lookAt(sum, difference, V3{0.0, 0.0, 1.0}));
+        CGLA_CHECK(cgla::modelView<float>(m * 2.0, m) == cgla::modelView<float>(scaled, m));
+        CGLA_CHECK(cgla::relativeModel<float>(m * 2.0, a - b) == cgla::relativeModel<float>(scaled, difference));
+        CGLA_CHECK(cgla::relativeView<float>(m * 2.0, a - b) == cgla::relativeView<float>(scaled, difference));
+
+        V3 t, sc, sh, tr, scr, shr;
+        Q rotation, rotationReference;
+        CGLA_CHECK(cgla::decomposeTRS(m * 2.0, t, rotation, sc) == cgla::decomposeTRS(scaled, tr, rotationReference, scr));
+        CGLA_CHECK(t == tr && rotation == rotationReference && sc == scr);
+        CGLA_CHECK(cgla::decomposeTRS(m * 2.0, t, rotation, sc, sh) == cgla::decomposeTRS(scaled, tr, rotationReference, scr, shr));
+        CGLA_CHECK(t == tr && rotation == rotationReference && sc == scr && sh == shr);
+    }
+}
+
+}
+
+int main()
+{
+    testVector();
+    testMatrix();
+    testTransform();
+
+    return test::report("expression_test");
+}
@@ -0,0 +1,326 @@
+// LU, Cholesky and QR against reconstructions of the factored matrix and residuals of the solutions, including singular,
+// indefinite and rank-deficient inputs
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include <cgla/cgla.hpp>
+#include "test.hpp"
+
+namespace {
+
+constexpr std::size_t sampleCount = 50;
+
+// backward-stable algorithms keep their errors within a small multiple of M * epsilon relative to the norms involved
+template<typename T, std::size_t M>
+double tolerance()
+{
+    return 16.0 * static_cast<double>(M) * static_cast<double>(std::numeric_limits<T>::epsilon());
+}
+
+template<typename T, std::size_t M, std::size_t N>
+cgla::Matrix<T, M, N> randomMatrix()
+{
+    cgla::Matrix<T, M, N> res{cgla::uninitialized};
+    test::randomize(res, M * N, static_cast<T>(-1), static_cast<T>(1));
+    return res;
+}
+
+template<typename T, std::size_t M>
+cgla::Vector<T, M> randomVector()
+{
+    cgla::Vector<T, M> res{cgla::uninitialized};
+    test::randomize(res, M, static_cast<T>(-1), static_cast<T>(1));
+    return res;
+}
+
+// B^T B + I / 2, symmetric positive definite and reasonably conditioned
+template<typename T, std::size_t M>
+cgla::Matrix<T, M, M> randomSPD()
+{
+    cgla::Matrix<T, M, M> b = randomMatrix<T, M, M>();
+    return cgla::Matrix<T, M, M>(cgla::transpose(b) * b + cgla::Matrix<T, M, M>{static_cast<T>(0.5)});
+}
+
+template<typename T, std::size_t M, std::size_t N>
+cgla::Vector<T, M> column(const cgla::Matrix<T, M, N>& mat, std::size_t j)
+{
+    cgla::Vector<T, M> res{cgla::uninitialized};
+    for (std::size_t i = 0; i < M; ++i)
+        res[i] = mat(i, j);
+    return res;
+}
+
+// the product of the 2-norms of the columns bounds the determinant (Hadamard's inequality)
+template<typename T, std::size_t M>
+double hadamardBound(const cgla::Matrix<T, M, M>& a)
+{
+    double res = 1.0;
+
+    for (std::size_t j = 0; j < M; ++j)
+    {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < M; ++i)
+            sum += static_cast<double>(a(i, j)) * static_cast<double>(a(i, j));
+        res *= std::sqrt(sum);
+    }
+
+    return res;
+}
+
+// |A x - b| within tolerance of |A| |x| + |b|
+template<typename T, std::size_t M, std::size_t N>
+bool smallResidual(const cgla::Matrix<T, M, N>& a, const cgla::Vector<T, N>& x, const cgla::Vector<T, M>& b)
+{
+    cgla::Vector<T, M> r = a * x;
+    double scale = static_cast<double>(N) * test::maxAbs(a, M * N) * test::maxAbs(x, N) + test::maxAbs(b, M);
+    return test::maxDifference(r, b, M) <= tolerance<T, M>() * scale;
+}
+
+template<typename T, std::size_t M>
+void testLU()
+{
+    using Mat = cgla::Matrix<T, M, M>;
+
+    for (std::size_t s = 0; s < sampleCount; ++s)
+    {
+        Mat a = randomMatrix<T, M, M>();
+        cgla::LU<T, M> lu{a};
+        CGLA_CHECK(lu.invertible());
+        CGLA_CHECK(lu.rcond() > static_cast<T>(0) && lu.rcond() <= static_cast<T>(1));
+
+        cgla::Vector<T, M> b = randomVector<T, M>();
+        CGLA_CHECK(smallResidual(a, lu.solve(b), b));
+
+        // every column of a multi-column solve is a solution
+        cgla::Matrix<T, M, 2> bs = randomMatrix<T, M, 2>();
+        cgla::Matrix<T, M, 2> xs = lu.solve(bs);
+        for (std::size_t j = 0; j < 2; ++j)
+            CGLA_CHECK(smallResidual(a, column(xs, j), column(bs, j)));
+
+        // the determinant agrees with the one of QR
+        cgla::QR<T, M, M> qr{a};
+        CGLA_CHECK(std::fabs(static_cast<double>(lu.determinant() - qr.determinant())) <= tolerance<T, M>() * hadamardBound(a));
+
+        // diagonally dominant, so that the inverse is accurate to a few ulps
+        Mat d = a + Mat{static_cast<T>(M)};
+        Mat inv = cgla::LU<T, M>{d}.inverse();
+        CGLA_CHECK(test::maxDifference(Mat(d * inv), Mat{static_cast<T>(1)}, M * M) <= tolerance<T, M>() * static_cast<double>(M));
+    }
+
+    // an exact zero column is singular
+    Mat singular = randomMatrix<T, M, M>();
+    for (std::size_t i = 0; i < M; ++i)
+        singular(i, M / 2) = static_cast<T>(0);
+    cgla::LU<T, M> lu{singular};
+    CGLA_CHECK(!lu.invertible());
+    CGLA_CHECK(lu.rcond() == static_cast<T>(0));
+    CGLA_CHECK(lu.determinant() == static_cast<T>(0));
+
+    // a duplicated column may leave a rounding-sized pivot, but then the condition estimate reports it
+    Mat duplicate = randomMatrix<T, M, M>();
+    for (std::size_t i = 0; i < M; ++i)
+        duplicate(i, M - 1) = duplicate(i, 0);
+    cgla::LU<T, M> dlu{duplicate};
+    CGLA_CHECK(!dlu.invertible() || static_cast<double>(dlu.rcond()) <= tolerance<T, M>());
+}
+
+template<typename T, std::size_t M>
+void testCholesky()
+{
+    using Mat = cgla::Matrix<T, M, M>;
+
+    for (std::size_t s = 0; s < sampleCount; ++s)
+    {
+        Mat a = randomSPD<T, M>();
+        cgla::Cholesky<T, M> chol{a};
+        CGLA_CHECK(chol.positiveDefinite());
+        CGLA_CHECK(chol.rcond() > static_cast<T>(0) && chol.rcond() <= static_cast<T>(1));
+
+        // L is lower triangular with a positive diagonal and L L^T reconstructs A
+        Mat l = chol.matrixL();
+        bool lower = true;
+        for (std::size_t j = 0; j < M; ++j)
+        {
+            lower = lower && l(j, j) > static_cast<T>(0);
+            for (std::size_t i = 0; i < j; ++i)
+                lower = lower && l(i, j) == static_cast<T>(0);
+        }
+        CGLA_CHECK(lower);
+        CGLA_CHECK(test::maxDifference(Mat(l * cgla::transpose(l)), a, M * M) <= tolerance<T, M>() * test::maxAbs(a, M * M));
+
+        // only the lower triangle is read
+        Mat upper = a;
+        for (std::size_t j = 1; j < M; ++j)
+            for (std::size_t i = 0; i < j; ++i)
+                upper(i, j) = static_cast<T>(1000);
+        CGLA_CHECK(cgla::Cholesky<T, M>{upper}.matrixL() == l);
+
+        cgla::Vector<T, M> b = randomVector<T, M>();
+        CGLA_CHECK(smallResidual(a, chol.solve(b), b));
+
+        double det = static_cast<double>(cgla::LU<T, M>{a}.determinant());
+        CGLA_CHECK(std::fabs(static_cast<double>(chol.determinant()) - det) <= tolerance<T, M>() * std::fabs(det) * static_cast<double>(M));
+
+        Mat inv = chol.inverse();
+        CGLA_CHECK(test::maxDifference(Mat(a * inv), Mat{static_cast<T>(1)}, M * M) <= tolerance<T, M>() * static_cast<double>(M) / static_cast<double>(chol.rcond()));
+    }
+
+    // symmetric and indefinite : one negative eigenvalue
+    Mat q = cgla::QR<T, M, M>{randomMatrix<T, M, M>()}.matrixQ();
+    Mat diagonal{static_cast<T>(1)};
+    diagonal(M - 1, M - 1) = static_cast<T>(-1);
+    Mat indefinite = q * diagonal * cgla::transpose(q);
+    cgla::Cholesky<T, M> chol{indefinite};
+    CGLA_CHECK(!chol.positiveDefinite());
+    CGLA_CHECK(chol.rcond() == static_cast<T>(0));
+
+    // positive semidefinite with an exact zero row and column
+    Mat semidefinite = randomSPD<T, M>();
+    for (std::size_t i = 0; i < M; ++i)
+        semidefinite(i, 0) = semidefinite(0, i) = static_cast<T>(0);
+    CGLA_CHECK(!cgla::Cholesky<T, M>{semidefinite}.positiveDefinite());
+}
+
+template<typename T, std::size_t M, std::size_t N>
+void checkQR(const cgla::Matrix<T, M, N>& a, const cgla::QR<T, M, N>& qr)
+{
+    cgla::Matrix<T, M, M> q = qr.matrixQ();
+    cgla::Matrix<T, M, N> r = qr.matrixR();
+
+    // Q orthogonal, R upper triangular with a non-increasing diagonal, and QR reconstructs the permuted A
+    CGLA_CHECK(test::maxDifference(cgla::Matrix<T, M, M>(cgla::transpose(q) * q), cgla::Matrix<T, M, M>{static_cast<T>(1)}, M * M) <= tolerance<T, M>());
+
+    bool upper = true;
+    for (std::size_t j = 0; j < N; ++j)
+        for (std::size_t i = j + 1; i < M; ++i)
+            upper = upper && r(i, j) == static_cast<T>(0);
+    CGLA_CHECK(upper);
+
+    for (std::size_t j = 1; j < qr.rank(); ++j)
+        CGLA_CHECK(std::fabs(r(j, j)) <= std::fabs(r(j - 1, j - 1)) * static_cast<T>(1.0001));
+
+    cgla::Matrix<T, M, N> ap{cgla::uninitialized};
+    bool permutation = true;
+    std::vector<bool> seen(N, false);
+    for (std::size_t j = 0; j < N; ++j)
+    {
+        std::size_t c = qr.permutation(j);
+        permutation = permutation && c < N && !seen[c];
+        seen[c < N ? c : 0] = true;
+        for (std::size_t i = 0; i < M; ++i)
+            ap(i, j) = a(i, c < N ? c : 0);
+    }
+    CGLA_CHECK(permutation);
+    CGLA_CHECK(test::maxDifference(cgla::Matrix<T, M, N>(q * r), ap, M * N) <= tolerance<T, M>() * test::maxAbs(a, M * N) * static_cast<double>(M));
+}
+
+// least squares : the residual is orthogonal to the columns of A
+template<typename T, std::size_t M, std::size_t N>
+bool leastSquares(const cgla::Matrix<T, M, N>& a, const cgla::Vector<T, N>& x, const cgla::Vector<T, M>& b)
+{
+    cgla::Vector<T, M> r = cgla::Vector<T, M>(a * x) - b;
+    cgla::Vector<T, N> g = cgla::transpose(a) * r;
+    double scale = test::maxAbs(a, M * N) * (static_cast<double>(N) * test::maxAbs(a, M * N) * test::maxAbs(x, N) + test::maxAbs(b, M));
+    return test::maxAbs(g, N) <= tolerance<T, M>() * static_cast<double>(M) * scale;
+}
+
+template<typename T, std::size_t M, std::size_t N>
+void testQR()
+{
+    using Mat = cgla::Matrix<T, M, N>;
+
+    for (std::size_t s = 0; s < sampleCount; ++s)
+    {
+        Mat a = randomMatrix<T, M, N>();
+        cgla::QR<T, M, N> qr{a};
+        CGLA_CHECK(qr.rank() == N);
+        checkQR(a, qr);
+
+        cgla::Vector<T, M> b = randomVector<T, M>();
+        CGLA_CHECK(leastSquares(a, qr.solve(b), b));
+
+        // rank 2 : every column a combination of two random ones
+        cgla::Matrix<T, M, 2> basis = randomMatrix<T, M, 2>();
+        Mat deficient = basis * randomMatrix<T, 2, N>();
+        cgla::QR<T, M, N> dqr{deficient};
+        CGLA_CHECK(dqr.rank() == 2);
+        checkQR(deficient, dqr);
+
+        // the solution is a least squares one, with zeros for the unknowns of the dropped columns
+        cgla::Vector<T, N> x = dqr.solve(b);
+        CGLA_CHECK(leastSquares(deficient, x, b));
+        for (std::size_t j = 2; j < N; ++j)
+            CGLA_CHECK(x[dqr.permutation(j)] == static_cast<T>(0));
+    }
+
+    cgla::QR<T, M, N> zero{Mat{}};
+    CGLA_CHECK(zero.rank() == 0);
+    CGLA_CHECK(zero.rcond() == static_cast<T>(0));
+    CGLA_CHECK(zero.solve(randomVector<T, M>()) == (cgla::Vector<T, N>{}));
+}
+
+// the batched solvers match the factorizations and zero the systems they cannot solve
+template<typename T, std::size_t M>
+void testBatches()
+{
+    using Mat = cgla::Matrix<T, M, M>;
+    using V = cgla::Vector<T, M>;
+
+    constexpr std::size_t count = 37; // not a multiple of the 8 lanes
+    std::vector<Mat> mats(count);
+    std::vector<V> rhs(count), res(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        mats[i] = randomSPD<T, M>();
+        rhs[i] = randomVector<T, M>();
+    }
+
+    CGLA_CHECK(cgla::solveLU(mats.data(), rhs.data(), res.data(), count));
+    for (std::size_t i = 0; i < count; ++i)
+        CGLA_CHECK(smallResidual(mats[i], res[i], rhs[i]));
+
+    CGLA_CHECK(cgla::solveCholesky(mats.data(), rhs.data(), res.data(), count));
+    for (std::size_t i = 0; i < count; ++i)
+        CGLA_CHECK(smallResidual(mats[i], res[i], rhs[i]));
+
+    mats[5] = Mat{};
+    mats[count - 1](0, 0) = static_cast<T>(-1000);
+
+    CGLA_CHECK(!cgla::solveLU(mats.data(), rhs.data(), res.data(), count));
+    CGLA_CHECK(res[5] == V{});
+    CGLA_CHECK(smallResidual(mats[count - 1], res[count - 1], rhs[count - 1]));
+
+    CGLA_CHECK(!cgla::solveCholesky(mats.data(), rhs.data(), res.data(), count));
+    CGLA_CHECK(res[5] == V{} && res[count - 1] == V{});
+    for (std::size_t i = 0; i + 1 < count; ++i)
+        if (i != 5)
+            CGLA_CHECK(smallResidual(mats[i], res[i], rhs[i]));
+}
+
+}
+
+int main()
+{
+    testLU<double, 3>();
+    testLU<double, 4>();
+    testLU<double, 7>();
+    testLU<double, 20>(); // blocked
+    testLU<float, 4>();
+
+    testCholesky<double, 3>();
+    testCholesky<double, 6>();
+    testCholesky<double, 20>();
+    testCholesky<float, 4>();
+
+    testQR<double, 3, 3>();
+    testQR<double, 6, 4>();
+    testQR<double, 20, 12>();
+    testQR<float, 5, 3>();
+
+    testBatches<double, 3>();
+    testBatches<float, 4>();
+
+    return test::report("factorization_test");
+}
@@ -0,0 +1,97 @@
+// ThreadPool::parallelFor covers every index exactly once, handles empty ranges and zero grain sizes, and rethrows exceptions
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include <cgla/cgla.hpp>
+#include "test.hpp"
+
+namespace {
+
+void testCoverage(cgla::ThreadPool& pool)
+{
+    const std::size_t counts[] = {1, 7, 1000, 100000};
+    const std::size_t grainSizes[] = {0, 1, 64, 1000000};
+
+    for (std::size_t count : counts)
+    {
+        for (std::size_t grainSize : grainSizes)
+        {
+            std::vector<std::atomic<int>> hits(count);
+            for (std::atomic<int>& h : hits)
+                h = 0;
+
+            pool.parallelFor(count, grainSize, [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                    ++hits[i];
+            });
+
+            bool once = true;
+            for (const std::atomic<int>& h : hits)
+                once = once && h == 1;
+            CGLA_CHECK(once);
+        }
+    }
+
+    bool called = false;
+    pool.parallelFor(0, 0, [&](std::size_t, std::size_t) { called = true; });
+    pool.parallelFor(0, 16, [&](std::size_t, std::size_t) { called = true; });
+    CGLA_CHECK(!called);
+}
+
+void testExceptions(cgla::ThreadPool& pool)
+{
+    for (std::size_t thrower : {std::size_t{0}, std::size_t{5000}, std::size_t{99999}})
+    {
+        std::atomic<std::size_t> done{0};
+        std::atomic<std::size_t> thrown{0};
+        bool caught = false;
+
+        try
+        {
+            pool.parallelFor(100000, 100, [&](std::size_t begin, std::size_t end)
+            {
+                if (begin <= thrower && thrower < end)
+                {
+                    thrown = end - begin;
+                    throw std::runtime_error{"chunk"};
+                }
+
+                done += end - begin;
+            });
+        }
+        catch (const std::runtime_error&)
+        {
+            caught = true;
+        }
+
+        // the other chunks ran to completion before the exception reached the caller
+        CGLA_CHECK(caught);
+        CGLA_CHECK(done + thrown == 100000);
+    }
+
+    // the pool is still usable afterwards, nested calls included
+    std::atomic<std::size_t> sum{0};
+    pool.parallelFor(64, 1, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            pool.parallelFor(1000, 10, [&](std::size_t b, std::size_t e) { sum += e - b; });
+    });
+    CGLA_CHECK(sum == 64000);
+}
+
+}
+
+int main()
+{
+    cgla::ThreadPool empty{0};
+    cgla::ThreadPool pool{3};
+
+    testCoverage(empty);
+    testCoverage(pool);
+    testExceptions(empty);
+    testExceptions(pool);
+
+    return test::report("parallel_test");
+}
@@ -0,0 +1,207 @@
+// projectPoints against mat * Vector<T, 4>{p, 1} followed by the perspective divide and the viewport mapping, with points
+// behind the camera and outside every clip plane (built with and without CGLA_SSE)
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <cgla/cgla.hpp>
+#include "test.hpp"
+
+namespace {
+
+constexpr std::size_t pointCount = 1000 + 13;
+constexpr std::size_t largeCount = 3 * 16384 + 7;
+
+template<typename T> double accuracy();
+template<> double accuracy<float>() { return 1e-4; }
+template<> double accuracy<double>() { return 1e-12; }
+
+template<typename T>
+using V3 = cgla::Vector<T, 3>;
+
+template<typename T>
+using V4 = cgla::Vector<T, 4>;
+
+template<typename T>
+V3<T> randomVector(T min, T max)
+{
+    return V3<T>{test::random(min, max), test::random(min, max), test::random(min, max)};
+}
+
+template<typename T>
+cgla::Matrix<T, 4, 4> randomViewProjection()
+{
+    V3<T> eye = randomVector(static_cast<T>(-5), static_cast<T>(5));
+    V3<T> target = randomVector(static_cast<T>(-1), static_cast<T>(1));
+    cgla::Matrix<T, 4, 4> projection = cgla::perspective(test::random(static_cast<T>(0.5), static_cast<T>(1.5)), static_cast<T>(16) / static_cast<T>(9), static_cast<T>(0.1), static_cast<T>(20));
+
+    return projection * cgla::lookAt(eye, target, V3<T>{static_cast<T>(0), static_cast<T>(1), static_cast<T>(0)});
+}
+
+bool bit(const std::vector<std::uint32_t>& mask, std::size_t i)
+{
+    return (mask[i / 32] >> (i % 32)) & 1u;
+}
+
+// the reference in double : clip coordinates, visibility in clip space, then the divide and the viewport
+template<typename T>
+void checkProjection(const cgla::Matrix<T, 4, 4>& mat, const V4<T>& rect, const std::vector<V3<T>>& in, const std::vector<V3<T>>& out, const std::vector<std::uint32_t>& mask)
+{
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+        cgla::Vector<double, 4> clip{cgla::Matrix<double, 4, 4>(mat) * cgla::Vector<double, 4>{cgla::Vector<double, 3>(in[i]), 1.0}};
+        double w = clip[3];
+        bool inside = w > 0.0 && std::fabs(clip[0]) <= w && std::fabs(clip[1]) <= w && std::fabs(clip[2]) <= w;
+
+        // clip coordinates within rounding of a plane may land on either side
+        double margin = accuracy<T>() * std::fmax(std::fabs(w), 1.0);
+        bool borderline = std::fabs(w) <= margin || std::fabs(std::fabs(clip[0]) - w) <= margin || std::fabs(std::fabs(clip[1]) - w) <= margin || std::fabs(std::fabs(clip[2]) - w) <= margin;
+
+        if (!borderline)
+            CGLA_CHECK(bit(mask, i) == inside);
+
+        if (!inside || borderline)
+            continue;
+
+        double x = rect[0] + (clip[0] / w + 1.0) * 0.5 * rect[2];
+        double y = rect[1] + (clip[1] / w + 1.0) * 0.5 * rect[3];
+        double z = (clip[2] / w + 1.0) * 0.5;
+        double size = std::fmax(std::fabs(rect[2]), std::fabs(rect[3]));
+
+        CGLA_CHECK(std::fabs(out[i][0] - x) <= accuracy<T>() * size * 10.0 && std::fabs(out[i][1] - y) <= accuracy<T>() * size * 10.0);
+        CGLA_CHECK(std::fabs(out[i][2] - z) <= accuracy<T>() * 10.0 / w);
+    }
+
+    // the bits past the last point are cleared
+    if (in.size() % 32 != 0)
+        CGLA_CHECK((mask.back() >> (in.size() % 32)) == 0u);
+}
+
+// points in a box around the frustum, many of them behind the camera
+template<typename T>
+std::vector<V3<T>> randomPoints(std::size_t count)
+{
+    std::vector<V3<T>> res(count);
+
+    for (V3<T>& p : res)
+        p = randomVector(static_cast<T>(-25), static_cast<T>(25));
+
+    return res;
+}
+
+template<typename T>
+void testRandom()
+{
+    // the usual flipped rectangle, and one with an offset
+    const V4<T> rects[] = {
+        V4<T>{static_cast<T>(0), static_cast<T>(1080), static_cast<T>(1920), static_cast<T>(-1080)},
+        V4<T>{static_cast<T>(100), static_cast<T>(50), static_cast<T>(640), static_cast<T>(480)}
+    };
+
+    for (std::size_t f = 0; f < 40; ++f)
+    {
+        // a perspective rejects the points behind the camera by their depth alone, arbitrary matrices do not
+        cgla::Matrix<T, 4, 4> mat{cgla::uninitialized};
+        if (f % 2 == 0)
+            mat = randomViewProjection<T>();
+        else
+            test::randomize(mat, 16, static_cast<T>(-0.2), static_cast<T>(0.2));
+
+        std::vector<V3<T>> in = randomPoints<T>(pointCount);
+
+        for (const V4<T>& rect : rects)
+        {
+            std::vector<V3<T>> out(pointCount);
+            std::vector<std::uint32_t> mask(cgla::cullMaskSize(pointCount), 0xAAAAAAAAu);
+            cgla::projectPoints(mat, rect, in.data(), out.data(), mask.data(), pointCount);
+            checkProjection(mat, rect, in, out, mask);
+
+            // in place
+            std::vector<V3<T>> points = in;
+            std::vector<std::uint32_t> inPlaceMask(mask.size());
+            cgla::projectPoints(mat, rect, points.data(), inPlaceMask.data(), pointCount);
+            CGLA_CHECK(points == out && inPlaceMask == mask);
+        }
+    }
+}
+
+template<typename T>
+void checkMask(const cgla::Matrix<T, 4, 4>& mat, const std::vector<V3<T>>& points, const bool* visible)
+{
+    V4<T> rect{static_cast<T>(0), static_cast<T>(0), static_cast<T>(100), static_cast<T>(100)};
+    std::vector<V3<T>> in, out;
+
+    // past 32 points so that the SSE path sees them too
+    for (std::size_t i = 0; i < 40; ++i)
+        in.push_back(points[i % points.size()]);
+
+    out.resize(in.size());
+    std::vector<std::uint32_t> mask(cgla::cullMaskSize(in.size()));
+    cgla::projectPoints(mat, rect, in.data(), out.data(), mask.data(), in.size());
+
+    for (std::size_t i = 0; i < in.size(); ++i)
+        CGLA_CHECK(bit(mask, i) == visible[i % points.size()]);
+
+    CGLA_CHECK(std::fabs(out[0][0] - static_cast<T>(50)) <= accuracy<T>() * 100.0 && std::fabs(out[0][1] - static_cast<T>(50)) <= accuracy<T>() * 100.0);
+    checkProjection(mat, rect, in, out, mask);
+}
+
+template<typename T>
+void testBehind()
+{
+    cgla::Matrix<T, 4, 4> mat = cgla::perspective(static_cast<T>(1), static_cast<T>(1), static_cast<T>(1), static_cast<T>(10));
+
+    // looking down -z : in front, behind, beyond far, before near, and at the origin (w = 0)
+    const std::vector<V3<T>> points = {
+        V3<T>{static_cast<T>(0), static_cast<T>(0), static_cast<T>(-5)},
+        V3<T>{static_cast<T>(0), static_cast<T>(0), static_cast<T>(5)},
+        V3<T>{static_cast<T>(1), static_cast<T>(-1), static_cast<T>(5)},
+        V3<T>{static_cast<T>(0), static_cast<T>(0), static_cast<T>(-20)},
+        V3<T>{static_cast<T>(0), static_cast<T>(0), static_cast<T>(-0.5)},
+        V3<T>{static_cast<T>(0), static_cast<T>(0), static_cast<T>(0)}
+    };
+    const bool visible[] = {true, false, false, false, false, false};
+    checkMask(mat, points, visible);
+
+    // with every depth at 0, only the sign of w rejects the points behind the camera that the divide mirrors inside
+    for (std::size_t j = 0; j < 4; ++j)
+        mat(2, j) = static_cast<T>(0);
+
+    const bool flat[] = {true, false, false, true, true, false};
+    checkMask(mat, points, flat);
+}
+
+// threads share whole mask words and give the results of a single thread
+template<typename T>
+void testThreads()
+{
+    cgla::Matrix<T, 4, 4> mat = randomViewProjection<T>();
+    V4<T> rect{static_cast<T>(0), static_cast<T>(1080), static_cast<T>(1920), static_cast<T>(-1080)};
+    std::vector<V3<T>> in = randomPoints<T>(largeCount);
+    std::vector<V3<T>> out(largeCount), parallelOut(largeCount);
+    std::vector<std::uint32_t> mask(cgla::cullMaskSize(largeCount)), parallelMask(mask.size());
+
+    cgla::projectPoints(mat, rect, in.data(), out.data(), mask.data(), largeCount, 1);
+    cgla::projectPoints(mat, rect, in.data(), parallelOut.data(), parallelMask.data(), largeCount, 4);
+
+    CGLA_CHECK(out == parallelOut && mask == parallelMask);
+    checkProjection(mat, rect, in, out, mask);
+}
+
+template<typename T>
+void testAll()
+{
+    testRandom<T>();
+    testBehind<T>();
+    testThreads<T>();
+}
+
+}
+
+int main()
+{
+    testAll<float>();
+    testAll<double>();
+
+    return test::report("projection_test");
+}
@@ -0,0 +1,216 @@
+// ray-triangle and ray-box edge cases, and the packet tests against the scalar ones (built with and without CGLA_SSE)
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <cgla/cgla.hpp>
+#include "test.hpp"
+
+namespace {
+
+constexpr std::size_t sampleCount = 2000;
+
+template<typename T>
+using V3 = cgla::Vector<T, 3>;
+
+template<typename T>
+V3<T> vec(double x, double y, double z)
+{
+    return V3<T>{static_cast<T>(x), static_cast<T>(y), static_cast<T>(z)};
+}
+
+template<typename T>
+bool hitsTriangle(const cgla::Ray<T>& ray, const V3<T>& v0, const V3<T>& v1, const V3<T>& v2)
+{
+    T t, u, v;
+    return cgla::intersectTriangle(ray, v0, v1, v2, t, u, v);
+}
+
+template<typename T>
+bool hitsBox(const cgla::Ray<T>& ray, const cgla::AABB<T, 3>& box)
+{
+    T tNear;
+    return cgla::intersectBox(ray, box, tNear);
+}
+
+template<typename T>
+void testTriangle()
+{
+    const V3<T> a = vec<T>(0, 0, 0), b = vec<T>(1, 0, 0), c = vec<T>(0, 1, 0);
+    const V3<T> up = vec<T>(0, 0, 1);
+    T t, u, v;
+
+    CGLA_CHECK(cgla::intersectTriangle(cgla::Ray<T>{vec<T>(0.25, 0.5, -2), up}, a, b, c, t, u, v));
+    CGLA_CHECK(t == static_cast<T>(2) && u == static_cast<T>(0.25) && v == static_cast<T>(0.5));
+
+    // both faces, edges and vertices included
+    CGLA_CHECK(hitsTriangle(cgla::Ray<T>{vec<T>(0.25, 0.25, 2), vec<T>(0, 0, -1)}, a, b, c));
+    CGLA_CHECK(hitsTriangle(cgla::Ray<T>{vec<T>(0.5, 0, -1), up}, a, b, c));
+    CGLA_CHECK(hitsTriangle(cgla::Ray<T>{vec<T>(0.5, 0.5, -1), up}, a, b, c));
+    CGLA_CHECK(hitsTriangle(cgla::Ray<T>{vec<T>(0, 0, -1), up}, a, b, c));
+    CGLA_CHECK(hitsTriangle(cgla::Ray<T>{vec<T>(1, 0, -1), up}, a, b, c));
+    CGLA_CHECK(!hitsTriangle(cgla::Ray<T>{vec<T>(0.75, 0.5, -1), up}, a, b, c));
+    CGLA_CHECK(!hitsTriangle(cgla::Ray<T>{vec<T>(-0.01, 0.5, -1), up}, a, b, c));
+
+    // behind the origin, and the tMax cut-off (inclusive)
+    CGLA_CHECK(!hitsTriangle(cgla::Ray<T>{vec<T>(0.25, 0.25, 1), up}, a, b, c));
+    CGLA_CHECK(!hitsTriangle(cgla::Ray<T>{vec<T>(0.25, 0.25, -2), up, static_cast<T>(1.5)}, a, b, c));
+    CGLA_CHECK(hitsTriangle(cgla::Ray<T>{vec<T>(0.25, 0.25, -2), up, static_cast<T>(2)}, a, b, c));
+    CGLA_CHECK(hitsTriangle(cgla::Ray<T>{vec<T>(0.25, 0.25, 0), up, static_cast<T>(0)}, a, b, c));
+
+    // rays parallel to the triangle, in its plane or off it
+    CGLA_CHECK(!hitsTriangle(cgla::Ray<T>{vec<T>(-1, 0.25, 0), vec<T>(1, 0, 0)}, a, b, c));
+    CGLA_CHECK(!hitsTriangle(cgla::Ray<T>{vec<T>(-1, 0.25, 0.5), vec<T>(1, 0, 0)}, a, b, c));
+    CGLA_CHECK(!hitsTriangle(cgla::Ray<T>{vec<T>(-1, -1, 0), vec<T>(1, 1, 0)}, a, b, c));
+
+    // degenerate triangles : collinear, two coincident and all coincident vertices, and a zero direction
+    CGLA_CHECK(!hitsTriangle(cgla::Ray<T>{vec<T>(0.5, 0, -1), up}, a, b, vec<T>(2, 0, 0)));
+    CGLA_CHECK(!hitsTriangle(cgla::Ray<T>{vec<T>(0.5, 0, -1), up}, a, b, b));
+    CGLA_CHECK(!hitsTriangle(cgla::Ray<T>{vec<T>(0, 0, -1), up}, a, a, a));
+    CGLA_CHECK(!hitsTriangle(cgla::Ray<T>{vec<T>(0.25, 0.25, 0), vec<T>(0, 0, 0)}, a, b, c));
+}
+
+template<typename T>
+void testBox()
+{
+    const cgla::AABB<T, 3> box{vec<T>(0, 0, 0), vec<T>(1, 1, 1)};
+    const T inf = std::numeric_limits<T>::infinity();
+    T tNear;
+
+    // zero direction components give infinite inverses
+    CGLA_CHECK(cgla::intersectBox(cgla::Ray<T>{vec<T>(0.5, 0.5, -2), vec<T>(0, 0, 1)}, box, tNear) && tNear == static_cast<T>(2));
+    CGLA_CHECK(cgla::intersectBox(cgla::Ray<T>{vec<T>(0.5, 0.5, 3), vec<T>(0, 0, -1)}, box, tNear) && tNear == static_cast<T>(2));
+    CGLA_CHECK(cgla::intersectBox(cgla::Ray<T>{vec<T>(0.5, 0.5, -2), vec<T>(-0.0, -0.0, 1)}, box, tNear) && tNear == static_cast<T>(2));
+    CGLA_CHECK(!hitsBox(cgla::Ray<T>{vec<T>(1.5, 0.5, -2), vec<T>(0, 0, 1)}, box));
+    CGLA_CHECK(!hitsBox(cgla::Ray<T>{vec<T>(0.5, 0.5, -2), vec<T>(0, 0, -1)}, box));
+
+    // rays lying in a face plane (0 * inf is NaN) hit the closed box, rays just outside do not
+    CGLA_CHECK(hitsBox(cgla::Ray<T>{vec<T>(0, 0.5, -2), vec<T>(0, 0, 1)}, box));
+    CGLA_CHECK(hitsBox(cgla::Ray<T>{vec<T>(1, 0.5, -2), vec<T>(0, 0, 1)}, box));
+    CGLA_CHECK(hitsBox(cgla::Ray<T>{vec<T>(0, 1, -2), vec<T>(0, 0, 1)}, box));
+    CGLA_CHECK(!hitsBox(cgla::Ray<T>{vec<T>(0.5, 0, -2), vec<T>(0, 0, -1)}, box));
+    CGLA_CHECK(hitsBox(cgla::Ray<T>{vec<T>(0.5, 0, 0.5), vec<T>(1, 0, 0)}, box));
+    CGLA_CHECK(!hitsBox(cgla::Ray<T>{vec<T>(-0.01, 0.5, -2), vec<T>(0, 0, 1)}, box));
+    CGLA_CHECK(!hitsBox(cgla::Ray<T>{vec<T>(1.01, 0.5, -2), vec<T>(0, 0, 1)}, box));
+
+    // grazing an edge
+    CGLA_CHECK(hitsBox(cgla::Ray<T>{vec<T>(-1, 0, -1), vec<T>(1, 0, 1)}, box));
+
+    // origins inside the box enter at 0, whatever the direction
+    CGLA_CHECK(cgla::intersectBox(cgla::Ray<T>{vec<T>(0.5, 0.5, 0.5), vec<T>(0, 0, 1)}, box, tNear) && tNear == static_cast<T>(0));
+    CGLA_CHECK(cgla::intersectBox(cgla::Ray<T>{vec<T>(0.5, 0.5, 0.5), vec<T>(-1, 2, -3)}, box, tNear) && tNear == static_cast<T>(0));
+    CGLA_CHECK(cgla::intersectBox(cgla::Ray<T>{vec<T>(0, 0, 0), vec<T>(-1, -1, -1)}, box, tNear) && tNear == static_cast<T>(0));
+
+    // tMax cut-off (inclusive), and infinite boxes
+    CGLA_CHECK(!hitsBox(cgla::Ray<T>{vec<T>(0.5, 0.5, -2), vec<T>(0, 0, 1), static_cast<T>(1.5)}, box));
+    CGLA_CHECK(hitsBox(cgla::Ray<T>{vec<T>(0.5, 0.5, -2), vec<T>(0, 0, 1), static_cast<T>(2)}, box));
+    CGLA_CHECK(hitsBox(cgla::Ray<T>{vec<T>(0.5, 0.5, -2), vec<T>(1, 0, 0)}, cgla::AABB<T, 3>{vec<T>(0, 0, -inf), V3<T>{inf}}));
+}
+
+template<typename T>
+V3<T> randomVector(T min, T max)
+{
+    return V3<T>{test::random(min, max), test::random(min, max), test::random(min, max)};
+}
+
+// rays aimed around the unit box, with zero direction components, origins in face planes and inside, and short tMax
+template<typename T>
+cgla::Ray<T> randomRay()
+{
+    V3<T> origin = randomVector(static_cast<T>(-3), static_cast<T>(3));
+    V3<T> target = randomVector(static_cast<T>(-0.5), static_cast<T>(1.5));
+    int kind = static_cast<int>(test::random(0.0, 5.999));
+
+    if (kind == 1)
+        target[0] = origin[0];
+    else if (kind == 2)
+        origin[1] = target[1] = static_cast<T>(test::random(0.0, 1.0) < 0.5 ? 0 : 1);
+    else if (kind == 3)
+        origin = randomVector(static_cast<T>(0), static_cast<T>(1));
+
+    T tMax = kind == 4 ? test::random(static_cast<T>(0), static_cast<T>(1)) : std::numeric_limits<T>::infinity();
+
+    return {origin, target - origin, tMax};
+}
+
+template<typename T, std::size_t K>
+void testPackets()
+{
+    const cgla::AABB<T, 3> box{vec<T>(0, 0, 0), vec<T>(1, 1, 1)};
+
+    for (std::size_t s = 0; s < sampleCount; ++s)
+    {
+        cgla::Ray<T> rays[K];
+        for (cgla::Ray<T>& ray : rays)
+            ray = randomRay<T>();
+
+        V3<T> v0 = randomVector(static_cast<T>(-0.5), static_cast<T>(1.5));
+        V3<T> v1 = randomVector(static_cast<T>(-0.5), static_cast<T>(1.5));
+        V3<T> v2 = (s % 8 == 0) ? V3<T>(v0 + (v1 - v0) * static_cast<T>(2)) : randomVector(static_cast<T>(-0.5), static_cast<T>(1.5));
+
+        cgla::RayPacket<T, K> packet{rays};
+        cgla::PacketHit<T, K> hit;
+        T tNear[K];
+        std::uint32_t triangleMask = cgla::intersectTriangle(packet, v0, v1, v2, hit);
+        std::uint32_t boxMask = cgla::intersectBox(packet, box, tNear);
+
+        for (std::size_t i = 0; i < K; ++i)
+        {
+            T t, u, v, near;
+            bool triangleHit = cgla::intersectTriangle(rays[i], v0, v1, v2, t, u, v);
+            bool boxHit = cgla::intersectBox(rays[i], box, near);
+
+            CGLA_CHECK(((triangleMask >> i) & 1u) == static_cast<std::uint32_t>(triangleHit));
+            CGLA_CHECK(!triangleHit || (hit.t[i] == t && hit.u[i] == u && hit.v[i] == v));
+            CGLA_CHECK(((boxMask >> i) & 1u) == static_cast<std::uint32_t>(boxHit));
+            CGLA_CHECK(!boxHit || tNear[i] == near);
+        }
+
+        // one ray against a packet of triangles
+        cgla::TrianglePacket<T, K> triangles;
+        V3<T> vertices[K][3];
+        for (std::size_t i = 0; i < K; ++i)
+        {
+            for (V3<T>& vertex : vertices[i])
+                vertex = randomVector(static_cast<T>(-0.5), static_cast<T>(1.5));
+            if (i % 5 == 0)
+                vertices[i][2] = vertices[i][1];
+            triangles.set(i, vertices[i][0], vertices[i][1], vertices[i][2]);
+        }
+
+        triangleMask = cgla::intersectTriangles(rays[0], triangles, hit);
+
+        for (std::size_t i = 0; i < K; ++i)
+        {
+            T t, u, v;
+            bool triangleHit = cgla::intersectTriangle(rays[0], vertices[i][0], vertices[i][1], vertices[i][2], t, u, v);
+
+            CGLA_CHECK(((triangleMask >> i) & 1u) == static_cast<std::uint32_t>(triangleHit));
+            CGLA_CHECK(!triangleHit || (hit.t[i] == t && hit.u[i] == u && hit.v[i] == v));
+        }
+    }
+
+    // default packets : rays along +z from the origin against degenerate triangles
+    cgla::RayPacket<T, K> packet;
+    cgla::TrianglePacket<T, K> triangles;
+    cgla::PacketHit<T, K> hit;
+    CGLA_CHECK(cgla::intersectTriangles(packet.get(0), triangles, hit) == 0u);
+    CGLA_CHECK(cgla::intersectTriangle(packet, vec<T>(-1, -1, 1), vec<T>(2, -1, 1), vec<T>(-1, 2, 1), hit) == static_cast<std::uint32_t>((std::uint64_t{1} << K) - 1));
+}
+
+}
+
+int main()
+{
+    testTriangle<float>();
+    testTriangle<double>();
+    testBox<float>();
+    testBox<double>();
+    testPackets<float, 4>();
+    testPackets<float, 8>();
+    testPackets<float, 16>();
+    testPackets<double, 4>();
+    testPackets<double, 8>();
+    testPackets<double, 16>();
+
+    return test::report("ray_test");
+}
@@ -0,0 +1,176 @@
+// skinLinear against the blended matrices applied directly, normals through their inverse transpose, with proper and
+// mirrored palettes (built with and without CGLA_SSE)
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include <cgla/cgla.hpp>
+#include "test.hpp"
+
+namespace {
+
+constexpr std::size_t boneCount = 8;
+constexpr std::size_t vertexCount = 1000;
+constexpr std::size_t influenceCount = 4;
+
+template<typename T> double accuracy();
+template<> double accuracy<float>() { return 1e-4; }
+template<> double accuracy<double>() { return 1e-12; }
+
+template<typename T>
+using V3 = cgla::Vector<T, 3>;
+
+template<typename T>
+using Mat = cgla::Matrix<T, 4, 4>;
+
+// cgla::length is evaluated in float, the references are normalized in T
+template<typename T>
+V3<T> unit(const V3<T>& v)
+{
+    return v / std::sqrt(cgla::lengthSquared(v));
+}
+
+template<typename T>
+V3<T> randomVector(T min, T max)
+{
+    return V3<T>{test::random(min, max), test::random(min, max), test::random(min, max)};
+}
+
+// close rotations and scales of one sign keep the blends well conditioned, mirror negates the x axis of every bone
+template<typename T>
+std::vector<Mat<T>> randomPalette(bool mirror)
+{
+    std::vector<Mat<T>> res(boneCount);
+
+    for (Mat<T>& bone : res)
+    {
+        V3<T> axis = cgla::normalize(randomVector(static_cast<T>(-1), static_cast<T>(1)));
+        V3<T> s = randomVector(static_cast<T>(0.5), static_cast<T>(2));
+        if (mirror)
+            s[0] = -s[0];
+
+        bone = cgla::translate(randomVector(static_cast<T>(-10), static_cast<T>(10))) * cgla::rotate(test::random(static_cast<T>(-0.5), static_cast<T>(0.5)), axis) * cgla::scale(s);
+    }
+
+    return res;
+}
+
+template<typename T>
+struct Mesh
+{
+    std::vector<cgla::Vector<unsigned int, influenceCount>> indices;
+    std::vector<cgla::Vector<T, influenceCount>> weights;
+    std::vector<V3<T>> positions, normals, outPositions, outNormals;
+    std::vector<cgla::Vector<T, 4>> tangents, outTangents;
+    cgla::SkinStreams<T, influenceCount> streams;
+
+    Mesh() : indices(vertexCount), weights(vertexCount), positions(vertexCount), normals(vertexCount), outPositions(vertexCount),
+             outNormals(vertexCount), tangents(vertexCount), outTangents(vertexCount)
+    {
+        for (std::size_t v = 0; v < vertexCount; ++v)
+        {
+            T sum = static_cast<T>(0);
+            for (std::size_t k = 0; k < influenceCount; ++k)
+            {
+                indices[v][k] = static_cast<unsigned int>(test::random(0.0, boneCount - 0.001));
+                weights[v][k] = test::random(static_cast<T>(0.1), static_cast<T>(1));
+                sum += weights[v][k];
+            }
+            weights[v] /= sum;
+
+            positions[v] = randomVector(static_cast<T>(-5), static_cast<T>(5));
+            normals[v] = cgla::normalize(randomVector(static_cast<T>(-1), static_cast<T>(1)));
+            V3<T> t = cgla::normalize(cgla::cross(normals[v], randomVector(static_cast<T>(-1), static_cast<T>(1))));
+            tangents[v] = {t, static_cast<T>(1)};
+        }
+
+        streams.indices = indices.data();
+        streams.weights = weights.data();
+        streams.positions = positions.data();
+        streams.normals = normals.data();
+        streams.tangents = tangents.data();
+        streams.outPositions = outPositions.data();
+        streams.outNormals = outNormals.data();
+        streams.outTangents = outTangents.data();
+    }
+};
+
+template<typename T>
+void checkMesh(const std::vector<Mat<T>>& palette, const Mesh<T>& mesh)
+{
+    for (std::size_t v = 0; v < vertexCount; ++v)
+    {
+        Mat<T> blend{};
+        for (std::size_t k = 0; k < influenceCount; ++k)
+            blend += palette[mesh.indices[v][k]] * mesh.weights[v][k];
+
+        cgla::Matrix<T, 3, 3> linear{cgla::uninitialized};
+        for (std::size_t j = 0; j < 3; ++j)
+            for (std::size_t i = 0; i < 3; ++i)
+                linear(i, j) = blend(i, j);
+
+        cgla::Vector<T, 4> p = blend * cgla::Vector<T, 4>{mesh.positions[v], static_cast<T>(1)};
+        V3<T> n = unit(cgla::transpose(cgla::inverse(linear)) * mesh.normals[v]);
+        V3<T> t = unit(linear * V3<T>{mesh.tangents[v][0], mesh.tangents[v][1], mesh.tangents[v][2]});
+
+        CGLA_CHECK(test::maxDifference(mesh.outPositions[v], p, 3) <= accuracy<T>() * 20.0);
+        CGLA_CHECK(test::maxDifference(mesh.outNormals[v], n, 3) <= accuracy<T>());
+        CGLA_CHECK(test::maxDifference(mesh.outTangents[v], t, 3) <= accuracy<T>() && mesh.outTangents[v][3] == mesh.tangents[v][3]);
+
+        // normals stay perpendicular to the skinned tangents
+        CGLA_CHECK(std::fabs(cgla::dot(mesh.outNormals[v], t)) <= accuracy<T>());
+    }
+}
+
+template<typename T>
+void testSkinLinear(bool mirror)
+{
+    std::vector<Mat<T>> palette = randomPalette<T>(mirror);
+    std::vector<cgla::Affine<T, 3>> affinePalette;
+    for (const Mat<T>& bone : palette)
+        affinePalette.emplace_back(bone);
+
+    Mesh<T> mesh;
+    cgla::skinLinear(palette.data(), mesh.streams, vertexCount);
+    checkMesh(palette, mesh);
+
+    cgla::skinLinear(affinePalette.data(), mesh.streams, vertexCount);
+    checkMesh(palette, mesh);
+}
+
+// a single mirrored bone flips the normal along the mirrored axis
+template<typename T>
+void testMirror()
+{
+    Mat<T> bone = cgla::scale(V3<T>{static_cast<T>(-1), static_cast<T>(1), static_cast<T>(1)});
+    cgla::Vector<unsigned int, 1> index{0u};
+    cgla::Vector<T, 1> weight{static_cast<T>(1)};
+    V3<T> position{static_cast<T>(1), static_cast<T>(2), static_cast<T>(3)};
+    V3<T> normal{static_cast<T>(1), static_cast<T>(0), static_cast<T>(0)};
+    V3<T> outPosition, outNormal;
+
+    cgla::SkinStreams<T, 1> streams;
+    streams.indices = &index;
+    streams.weights = &weight;
+    streams.positions = &position;
+    streams.normals = &normal;
+    streams.outPositions = &outPosition;
+    streams.outNormals = &outNormal;
+
+    cgla::skinLinear(&bone, streams, 1);
+    CGLA_CHECK(outPosition == V3<T>(static_cast<T>(-1), static_cast<T>(2), static_cast<T>(3)));
+    CGLA_CHECK(outNormal == V3<T>(static_cast<T>(-1), static_cast<T>(0), static_cast<T>(0)));
+}
+
+}
+
+int main()
+{
+    testMirror<float>();
+    testMirror<double>();
+    testSkinLinear<float>(false);
+    testSkinLinear<float>(true);
+    testSkinLinear<double>(false);
+    testSkinLinear<double>(true);
+
+    return test::report("skinning_test");
+}
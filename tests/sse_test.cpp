@@ -0,0 +1,164 @@
+// the SSE implementations must agree with the scalar ones, up to the sign of zero (compared with ==)
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <cgla/cgla.hpp>
+#include "test.hpp"
+
+#ifndef CGLA_SSE
+#error "sse_test must be built with CGLA_SSE"
+#endif
+
+namespace {
+
+using Mat = cgla::Matrix<float, 4, 4>;
+using V3 = cgla::Vector<float, 3>;
+using V4 = cgla::Vector<float, 4>;
+
+constexpr std::size_t sampleCount = 1000;
+
+Mat randomMatrix()
+{
+    Mat res{cgla::uninitialized};
+
+    for (std::size_t i = 0; i < 16; ++i)
+        res[i] = test::random(-4.f, 4.f);
+
+    // exact zeros of both signs exercise the sign of zero
+    res[static_cast<std::size_t>(test::random(0.f, 15.f))] = (test::random(-1.f, 1.f) < 0.f) ? -0.f : 0.f;
+
+    return res;
+}
+
+// the scalar references follow the summation order of the generic templates
+Mat multiplyReference(const Mat& a, const Mat& b)
+{
+    Mat res{};
+
+    for (std::size_t j = 0; j < 4; ++j)
+        for (std::size_t i = 0; i < 4; ++i)
+            for (std::size_t k = 0; k < 4; ++k)
+                res(i, j) += a(i, k) * b(k, j);
+
+    return res;
+}
+
+V4 multiplyReference(const Mat& a, const V4& v)
+{
+    V4 res{};
+
+    for (std::size_t i = 0; i < 4; ++i)
+        for (std::size_t j = 0; j < 4; ++j)
+            res[i] += a(i, j) * v[j];
+
+    return res;
+}
+
+void testMatrix4x4()
+{
+    for (std::size_t n = 0; n < sampleCount; ++n)
+    {
+        Mat a = randomMatrix();
+        Mat b = randomMatrix();
+        V4 v{test::random(-4.f, 4.f), test::random(-4.f, 4.f), test::random(-4.f, 4.f), test::random(-4.f, 4.f)};
+        float s = test::random(-4.f, 4.f);
+
+        CGLA_CHECK(a * b == multiplyReference(a, b));
+        CGLA_CHECK(a * v == multiplyReference(a, v));
+
+        Mat t{cgla::uninitialized};
+        for (std::size_t j = 0; j < 4; ++j)
+            for (std::size_t i = 0; i < 4; ++i)
+                t(i, j) = a(j, i);
+        CGLA_CHECK(cgla::transpose(a) == t);
+
+        Mat sum = a, difference = a, scaled = a, sumReference{cgla::uninitialized}, differenceReference{cgla::uninitialized}, scaledReference{cgla::uninitialized};
+        sum += b;
+        difference -= b;
+        scaled *= s;
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            sumReference[i] = a[i] + b[i];
+            differenceReference[i] = a[i] - b[i];
+            scaledReference[i] = a[i] * s;
+        }
+        CGLA_CHECK(sum == sumReference);
+        CGLA_CHECK(difference == differenceReference);
+        CGLA_CHECK(scaled == scaledReference);
+    }
+}
+
+// the blocked product accumulates in another order, so it is compared with a tolerance against a double reference
+void testBlockedProduct()
+{
+    constexpr std::size_t size = 37;
+    cgla::Matrix<float, size, size> a{cgla::uninitialized}, b{cgla::uninitialized};
+
+    for (std::size_t i = 0; i < size * size; ++i)
+    {
+        a[i] = test::random(-1.f, 1.f);
+        b[i] = test::random(-1.f, 1.f);
+    }
+
+    cgla::Matrix<float, size, size> c = a * b;
+    double error = 0.0;
+
+    for (std::size_t j = 0; j < size; ++j)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            double sum = 0.0;
+
+            for (std::size_t k = 0; k < size; ++k)
+                sum += static_cast<double>(a(i, k)) * b(k, j);
+
+            error = std::fmax(error, std::fabs(sum - c(i, j)));
+        }
+    }
+
+    CGLA_CHECK(error < 1e-4);
+}
+
+// the batch kernels against their generic versions, over counts that leave a scalar tail
+void testBatches()
+{
+    const std::size_t count = 103;
+    std::vector<V3> in(count);
+    std::vector<V3> simd(count), scalar(count);
+    std::vector<std::uint32_t> simdMask((count + 31) / 32), scalarMask((count + 31) / 32);
+
+    for (V3& p : in)
+        p = V3{test::random(-2.f, 2.f), test::random(-2.f, 2.f), test::random(-2.f, 2.f)};
+
+    Mat mat = randomMatrix();
+    Mat projection = cgla::perspective(0.9f, 1.5f, 0.1f, 10.f) * cgla::lookAt(V3{0.f, 0.f, -3.f}, V3{}, V3{0.f, 1.f, 0.f});
+
+    for (float w : {0.f, 1.f})
+    {
+        cgla::detail::transform3(mat, in.data(), simd.data(), count, w);
+        cgla::detail::transform3<float>(mat, in.data(), scalar.data(), count, w);
+        CGLA_CHECK(simd == scalar);
+    }
+
+    cgla::detail::transform3Projective(mat, in.data(), simd.data(), count);
+    cgla::detail::transform3Projective<float>(mat, in.data(), scalar.data(), count);
+    CGLA_CHECK(simd == scalar);
+
+    const float bounds[4] = {0.f, 640.f, 0.f, 480.f};
+    Mat screen = cgla::viewport(0.f, 0.f, 640.f, 480.f) * projection;
+    cgla::detail::project3(screen, bounds, in.data(), simd.data(), simdMask.data(), count);
+    cgla::detail::project3<float>(screen, bounds, in.data(), scalar.data(), scalarMask.data(), count);
+    CGLA_CHECK(simd == scalar);
+    CGLA_CHECK(simdMask == scalarMask);
+}
+
+}
+
+int main()
+{
+    testMatrix4x4();
+    testBlockedProduct();
+    testBatches();
+
+    return test::report("sse_test");
+}
@@ -0,0 +1,89 @@
+#ifndef CGLA_TEST_HPP
+#define CGLA_TEST_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <random>
+
+namespace test {
+
+inline std::size_t& failures()
+{
+    static std::size_t count = 0;
+    return count;
+}
+
+inline void check(bool condition, const char* expression, const char* file, int line)
+{
+    if (!condition)
+    {
+        std::printf("%s:%d: check failed: %s\n", file, line, expression);
+        ++failures();
+    }
+}
+
+// exit code of a test executable
+inline int report(const char* name)
+{
+    if (failures() != 0)
+    {
+        std::printf("%s: %zu failed checks\n", name, failures());
+        return 1;
+    }
+
+    std::printf("%s: passed\n", name);
+    return 0;
+}
+
+inline std::mt19937& rng()
+{
+    static std::mt19937 engine{7};
+    return engine;
+}
+
+// uniform in [min, max]
+template<typename T>
+inline T random(T min, T max)
+{
+    return std::uniform_real_distribution<T>{min, max}(rng());
+}
+
+// fills the size components of an array uniformly in [min, max]
+template<typename A, typename T>
+inline void randomize(A& a, std::size_t size, T min, T max)
+{
+    for (std::size_t i = 0; i < size; ++i)
+        a[i] = random(min, max);
+}
+
+// largest absolute component of an array
+template<typename A>
+inline double maxAbs(const A& a, std::size_t size)
+{
+    double res = 0.0;
+
+    for (std::size_t i = 0; i < size; ++i)
+        res = std::fmax(res, std::fabs(static_cast<double>(a[i])));
+
+    return res;
+}
+
+// largest absolute difference between the components of two arrays of the same shape
+template<typename A, typename B>
+inline double maxDifference(const A& a, const B& b, std::size_t size)
+{
+    double res = 0.0;
+
+    for (std::size_t i = 0; i < size; ++i)
+        res = std::fmax(res, std::fabs(static_cast<double>(a[i]) - static_cast<double>(b[i])));
+
+    return res;
+}
+
+}
+
+// variadic so that conditions may contain template argument lists
+#define CGLA_CHECK(...) ::test::check((__VA_ARGS__), #__VA_ARGS__, __FILE__, __LINE__)
+
+#endif
@@ -0,0 +1,204 @@
+// decomposeTRS then composeTRS gives back the matrix, with shear, negative scales and singular matrices, for the scalar
+// and batched overloads
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include <cgla/cgla.hpp>
+#include "test.hpp"
+
+namespace {
+
+constexpr std::size_t sampleCount = 1000;
+
+template<typename T> double accuracy();
+template<> double accuracy<float>() { return 1e-4; }
+template<> double accuracy<double>() { return 1e-12; }
+
+template<typename T>
+using V3 = cgla::Vector<T, 3>;
+
+template<typename T>
+using Mat = cgla::Matrix<T, 4, 4>;
+
+template<typename T>
+V3<T> randomVector(T min, T max)
+{
+    return V3<T>{test::random(min, max), test::random(min, max), test::random(min, max)};
+}
+
+template<typename T>
+cgla::Quaternion<T> randomRotation()
+{
+    cgla::Quaternion<T> q{randomVector(static_cast<T>(-1), static_cast<T>(1)), test::random(static_cast<T>(-1), static_cast<T>(1))};
+    T norm = std::sqrt(cgla::dot(q, q));
+
+    return cgla::Quaternion<T>{q[0] / norm, q[1] / norm, q[2] / norm, q[3] / norm};
+}
+
+// scales of either sign away from zero
+template<typename T>
+V3<T> randomScale(bool negative)
+{
+    V3<T> res = randomVector(static_cast<T>(0.25), static_cast<T>(4));
+
+    if (negative)
+        for (std::size_t i = 0; i < 3; ++i)
+            if (test::random(0.0, 1.0) < 0.5)
+                res[i] = -res[i];
+
+    return res;
+}
+
+template<typename T>
+double unitError(const cgla::Quaternion<T>& q)
+{
+    return std::fabs(static_cast<double>(cgla::dot(q, q)) - 1.0);
+}
+
+template<typename T>
+double determinant3(const Mat<T>& m)
+{
+    return m[0] * (static_cast<double>(m[5]) * m[10] - static_cast<double>(m[6]) * m[9])
+         - m[4] * (static_cast<double>(m[1]) * m[10] - static_cast<double>(m[2]) * m[9])
+         + m[8] * (static_cast<double>(m[1]) * m[6] - static_cast<double>(m[2]) * m[5]);
+}
+
+// the decomposition recomposes the matrix, its translation is copied and its rotation is a unit quaternion
+template<typename T>
+void checkRoundTrip(const Mat<T>& m, bool regular)
+{
+    double size = std::fmax(test::maxAbs(m, 16), 1.0);
+    V3<T> t, s, sh;
+    cgla::Quaternion<T> q;
+
+    CGLA_CHECK(cgla::decomposeTRS(m, t, q, s, sh) == regular);
+    CGLA_CHECK(t == V3<T>(m[12], m[13], m[14]) && unitError(q) <= accuracy<T>());
+    CGLA_CHECK(test::maxDifference(cgla::composeTRS(t, q, s, sh), m, 16) <= accuracy<T>() * size);
+
+    // a reflection is carried by the scale alone
+    if (regular)
+        CGLA_CHECK((s[0] * s[1] * s[2] < static_cast<T>(0)) == (determinant3(m) < 0.0));
+}
+
+template<typename T>
+void testProper()
+{
+    for (std::size_t k = 0; k < sampleCount; ++k)
+    {
+        V3<T> t = randomVector(static_cast<T>(-10), static_cast<T>(10));
+        cgla::Quaternion<T> q = randomRotation<T>();
+        V3<T> s = randomScale<T>(false);
+        V3<T> sh = randomVector(static_cast<T>(-1), static_cast<T>(1));
+
+        // positive scales give back the parameters, up to the sign of the quaternion
+        V3<T> t2, s2, sh2;
+        cgla::Quaternion<T> q2;
+        CGLA_CHECK(cgla::decomposeTRS(cgla::composeTRS(t, q, s, sh), t2, q2, s2, sh2));
+        CGLA_CHECK(t2 == t && std::fabs(std::fabs(static_cast<double>(cgla::dot(q, q2))) - 1.0) <= accuracy<T>());
+        CGLA_CHECK(test::maxDifference(s2, s, 3) <= accuracy<T>() * 4.0 && test::maxDifference(sh2, sh, 3) <= accuracy<T>() * 4.0);
+
+        checkRoundTrip(cgla::composeTRS(t, q, s, sh), true);
+
+        // the overload without shear is exact for composeTRS without shear
+        Mat<T> m = cgla::composeTRS(t, q, s);
+        CGLA_CHECK(cgla::decomposeTRS(m, t2, q2, s2));
+        CGLA_CHECK(test::maxDifference(cgla::composeTRS(t2, q2, s2), m, 16) <= accuracy<T>() * 10.0);
+        checkRoundTrip(m, true);
+    }
+}
+
+template<typename T>
+void testNegative()
+{
+    for (std::size_t k = 0; k < sampleCount; ++k)
+    {
+        V3<T> s = randomScale<T>(true);
+        Mat<T> m = cgla::composeTRS(randomVector(static_cast<T>(-10), static_cast<T>(10)), randomRotation<T>(), s, randomVector(static_cast<T>(-1), static_cast<T>(1)));
+        checkRoundTrip(m, true);
+    }
+
+    // a mirror
+    checkRoundTrip(cgla::scale(V3<T>{static_cast<T>(-1), static_cast<T>(1), static_cast<T>(1)}), true);
+    checkRoundTrip(cgla::scale(V3<T>{static_cast<T>(-2), static_cast<T>(-3), static_cast<T>(-4)}), true);
+}
+
+// singular matrices return false and still recompose
+template<typename T>
+void testSingular()
+{
+    V3<T> t = randomVector(static_cast<T>(-10), static_cast<T>(10));
+    cgla::Quaternion<T> q = randomRotation<T>();
+
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        V3<T> s = randomScale<T>(true);
+        s[axis] = static_cast<T>(0);
+        checkRoundTrip(cgla::composeTRS(t, q, s), false);
+        checkRoundTrip(cgla::composeTRS(t, q, s, randomVector(static_cast<T>(-1), static_cast<T>(1))), false);
+    }
+
+    checkRoundTrip(cgla::composeTRS(t, q, V3<T>{static_cast<T>(2), static_cast<T>(0), static_cast<T>(0)}), false);
+    checkRoundTrip(cgla::translate(t) * cgla::scale(V3<T>{}), false);
+
+    // two equal columns
+    Mat<T> m = cgla::composeTRS(t, q, randomScale<T>(false));
+    for (std::size_t i = 0; i < 3; ++i)
+        m[8 + i] = m[4 + i];
+    checkRoundTrip(m, false);
+}
+
+// the batched overloads match the scalar ones and report a singular matrix anywhere in the array
+template<typename T>
+void testBatched()
+{
+    std::vector<V3<T>> t(sampleCount), s(sampleCount), t2(sampleCount), s2(sampleCount);
+    std::vector<cgla::Quaternion<T>> q(sampleCount), q2(sampleCount);
+    std::vector<Mat<T>> m(sampleCount);
+
+    for (std::size_t k = 0; k < sampleCount; ++k)
+    {
+        t[k] = randomVector(static_cast<T>(-10), static_cast<T>(10));
+        q[k] = randomRotation<T>();
+        s[k] = randomScale<T>(true);
+    }
+
+    for (std::size_t threadCount : {1, 4})
+    {
+        cgla::composeTRS(t.data(), q.data(), s.data(), m.data(), sampleCount, threadCount);
+        CGLA_CHECK(cgla::decomposeTRS(m.data(), t2.data(), q2.data(), s2.data(), sampleCount, threadCount));
+
+        for (std::size_t k = 0; k < sampleCount; ++k)
+        {
+            V3<T> t3, s3;
+            cgla::Quaternion<T> q3;
+            cgla::decomposeTRS(m[k], t3, q3, s3);
+
+            CGLA_CHECK(m[k] == cgla::composeTRS(t[k], q[k], s[k]));
+            CGLA_CHECK(t2[k] == t3 && q2[k] == q3 && s2[k] == s3);
+        }
+
+        Mat<T> regular = m[sampleCount / 2];
+        m[sampleCount / 2] = cgla::scale(V3<T>{static_cast<T>(1), static_cast<T>(0), static_cast<T>(1)});
+        CGLA_CHECK(!cgla::decomposeTRS(m.data(), t2.data(), q2.data(), s2.data(), sampleCount, threadCount));
+        m[sampleCount / 2] = regular;
+    }
+}
+
+template<typename T>
+void testAll()
+{
+    testProper<T>();
+    testNegative<T>();
+    testSingular<T>();
+    testBatched<T>();
+}
+
+}
+
+int main()
+{
+    testAll<float>();
+    testAll<double>();
+
+    return test::report("trs_test");
+}